@@ -0,0 +1,382 @@
+// Benchmark of the parameter/value function editors.
+//
+// The piecewise and color transfer function editors (both midpoint/sharpness
+// Hermite editors) are created in a withdrawn toplevel, loaded with functions
+// of increasing size and a large histogram, then driven through scripted
+// drag, zoom and pan sequences. For each editor, function size and kind of
+// operation, the latency percentiles and the number of Tcl evaluations
+// issued per operation (see vtkKWTclProfiler, including the ones issued
+// by the redraws scheduled at idle time) are reported.
+//
+// A display is required: on headless machines, run it on a virtual X server
+// (say, xvfb-run KWWidgetsBenchmarkFunctionEditors).
+// Options:
+//   --test     small functions and few operations (used as a test)
+//   --display  show the toplevel, so that Tk rendering is measured too
+
+#include "vtkKWApplication.h"
+#include "vtkKWColorTransferFunctionEditor.h"
+#include "vtkKWHistogram.h"
+#include "vtkKWPiecewiseFunctionEditor.h"
+#include "vtkKWTclProfiler.h"
+#include "vtkKWTopLevel.h"
+
+#include "vtkColorTransferFunction.h"
+#include "vtkDoubleArray.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+#include <vtksys/stl/algorithm>
+#include <vtksys/stl/vector>
+
+#include <math.h>
+#include <stdio.h>
+
+#define BENCHMARK_CANVAS_WIDTH  600
+#define BENCHMARK_CANVAS_HEIGHT 150
+#define BENCHMARK_RANGE_MAX     1000.0
+
+// Deterministic pseudo-random sequence in [0, 1]
+
+static double NextRandom(unsigned long *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (double)((*seed >> 16) & 0x7fff) / 32767.0;
+}
+
+// Latencies (in ms) and Tcl evaluations of a series of operations
+
+class OperationStatistics
+{
+public:
+  vtksys_stl::vector<double> Latencies;
+  unsigned long NumberOfTclEvaluations;
+
+  OperationStatistics() { this->NumberOfTclEvaluations = 0; }
+
+  double GetPercentile(double p)
+    {
+      if (this->Latencies.empty())
+        {
+        return 0.0;
+        }
+      vtksys_stl::sort(this->Latencies.begin(), this->Latencies.end());
+      int n = (int)this->Latencies.size();
+      int i = (int)ceil(p / 100.0 * (double)n) - 1;
+      return this->Latencies[i < 0 ? 0 : (i >= n ? n - 1 : i)];
+    }
+};
+
+// Time one operation: the editor call itself, then the idle tasks it
+// scheduled (Tk geometry and redisplay, coalesced redraws, etc.)
+
+static double StartOperation(vtkKWApplication *app,
+                             OperationStatistics *stats)
+{
+  stats->NumberOfTclEvaluations -= 
+    app->GetTclProfiler()->GetNumberOfEvaluations();
+  return vtkTimerLog::GetUniversalTime();
+}
+
+static void EndOperation(vtkKWApplication *app,
+                         OperationStatistics *stats,
+                         double start)
+{
+  app->Script("update idletasks");
+  double end = vtkTimerLog::GetUniversalTime();
+  stats->Latencies.push_back((end - start) * 1000.0);
+  stats->NumberOfTclEvaluations += 
+    app->GetTclProfiler()->GetNumberOfEvaluations() - 1; // not 'update'
+}
+
+static void PrintStatistics(const char *editor, int nb_points,
+                            const char *operation, OperationStatistics *stats)
+{
+  int count = (int)stats->Latencies.size();
+  char buffer[256];
+  sprintf(buffer, "%-10s %6d  %-5s %5d %9.3f %9.3f %9.3f %9.3f %9.1f",
+          editor, nb_points, operation, count,
+          stats->GetPercentile(50.0),
+          stats->GetPercentile(90.0),
+          stats->GetPercentile(99.0),
+          stats->GetPercentile(100.0),
+          count ? (double)stats->NumberOfTclEvaluations / (double)count : 0.0);
+  cout << buffer << endl;
+}
+
+// Create functions of 'nb_points' points over the benchmark range, with
+// random values, midpoints and sharpnesses
+
+static void FillPiecewiseFunction(vtkPiecewiseFunction *func, int nb_points)
+{
+  unsigned long seed = 12345;
+  func->RemoveAllPoints();
+  for (int i = 0; i < nb_points; i++)
+    {
+    double x = BENCHMARK_RANGE_MAX * (double)i / (double)(nb_points - 1);
+    double y = NextRandom(&seed);
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+    double midpoint = 0.2 + 0.6 * NextRandom(&seed);
+    double sharpness = NextRandom(&seed);
+    func->AddPoint(x, y, midpoint, sharpness);
+#else
+    func->AddPoint(x, y);
+#endif
+    }
+}
+
+static void FillColorTransferFunction(vtkColorTransferFunction *func,
+                                      int nb_points)
+{
+  unsigned long seed = 54321;
+  func->RemoveAllPoints();
+  for (int i = 0; i < nb_points; i++)
+    {
+    double x = BENCHMARK_RANGE_MAX * (double)i / (double)(nb_points - 1);
+    double r = NextRandom(&seed);
+    double g = NextRandom(&seed);
+    double b = NextRandom(&seed);
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+    double midpoint = 0.2 + 0.6 * NextRandom(&seed);
+    double sharpness = NextRandom(&seed);
+    func->AddRGBPoint(x, r, g, b, midpoint, sharpness);
+#else
+    func->AddRGBPoint(x, r, g, b);
+#endif
+    }
+}
+
+// Run all the sequences on an editor, for a given function size
+
+static void BenchmarkEditor(vtkKWApplication *app,
+                            vtkKWParameterValueFunctionEditor *editor,
+                            const char *editor_name,
+                            int nb_points,
+                            int nb_operations)
+{
+  vtkKWPiecewiseFunctionEditor *pwf_editor =
+    vtkKWPiecewiseFunctionEditor::SafeDownCast(editor);
+  vtkKWColorTransferFunctionEditor *ctf_editor =
+    vtkKWColorTransferFunctionEditor::SafeDownCast(editor);
+
+  vtkPiecewiseFunction *pwf = vtkPiecewiseFunction::New();
+  vtkColorTransferFunction *ctf = vtkColorTransferFunction::New();
+  FillPiecewiseFunction(pwf, nb_points);
+  FillColorTransferFunction(ctf, nb_points);
+
+  OperationStatistics load, zoom, pan, drag;
+  double start;
+  int i;
+
+  // Load (set the function, reset the ranges, and redraw)
+
+  int nb_loads = nb_operations < 5 ? nb_operations : 5;
+  for (i = 0; i < nb_loads; i++)
+    {
+    if (pwf_editor)
+      {
+      pwf_editor->SetPiecewiseFunction(NULL);
+      }
+    if (ctf_editor)
+      {
+      ctf_editor->SetColorTransferFunction(NULL);
+      }
+    app->Script("update idletasks");
+
+    start = StartOperation(app, &load);
+    if (pwf_editor)
+      {
+      pwf_editor->SetPiecewiseFunction(pwf);
+      }
+    if (ctf_editor)
+      {
+      ctf_editor->SetColorTransferFunction(ctf);
+      }
+    editor->SetWholeParameterRange(0.0, BENCHMARK_RANGE_MAX);
+    editor->SetVisibleParameterRangeToWholeParameterRange();
+    editor->Update();
+    EndOperation(app, &load, start);
+    }
+
+  // Zoom in and out around the center of the range
+
+  for (i = 0; i < nb_operations; i++)
+    {
+    double half_width =
+      0.5 * BENCHMARK_RANGE_MAX / (double)(1 + (i % 20));
+    start = StartOperation(app, &zoom);
+    editor->SetVisibleParameterRange(
+      0.5 * BENCHMARK_RANGE_MAX - half_width,
+      0.5 * BENCHMARK_RANGE_MAX + half_width);
+    EndOperation(app, &zoom, start);
+    }
+
+  // Pan a 10% window from one end of the range to the other
+
+  double width = 0.1 * BENCHMARK_RANGE_MAX;
+  for (i = 0; i < nb_operations; i++)
+    {
+    double p = (BENCHMARK_RANGE_MAX - width) *
+      (double)i / (double)(nb_operations > 1 ? nb_operations - 1 : 1);
+    start = StartOperation(app, &pan);
+    editor->SetVisibleParameterRange(p, p + width);
+    EndOperation(app, &pan, start);
+    }
+
+  // Drag the point in the middle of the function around
+  // Direct move is used so that the drag can start anywhere in the canvas.
+
+  editor->SetVisibleParameterRangeToWholeParameterRange();
+  app->Script("update idletasks");
+
+  int old_direct_move = editor->GetEnableDirectMove();
+  editor->EnableDirectMoveOn();
+  editor->SelectPoint(nb_points / 2);
+
+  int x = BENCHMARK_CANVAS_WIDTH / 2, y = BENCHMARK_CANVAS_HEIGHT / 2;
+  editor->StartInteractionCallback(x, y, 0);
+  for (i = 0; i < nb_operations; i++)
+    {
+    x = BENCHMARK_CANVAS_WIDTH / 2 + (int)(100.0 * sin((double)i * 0.2));
+    y = BENCHMARK_CANVAS_HEIGHT / 2 + (int)(50.0 * cos((double)i * 0.3));
+    start = StartOperation(app, &drag);
+    editor->MovePointCallback(x, y, 0);
+    EndOperation(app, &drag, start);
+    }
+  editor->EndInteractionCallback(x, y);
+  editor->SetEnableDirectMove(old_direct_move);
+
+  PrintStatistics(editor_name, nb_points, "load", &load);
+  PrintStatistics(editor_name, nb_points, "zoom", &zoom);
+  PrintStatistics(editor_name, nb_points, "pan", &pan);
+  PrintStatistics(editor_name, nb_points, "drag", &drag);
+
+  if (pwf_editor)
+    {
+    pwf_editor->SetPiecewiseFunction(NULL);
+    }
+  if (ctf_editor)
+    {
+    ctf_editor->SetColorTransferFunction(NULL);
+    }
+
+  pwf->Delete();
+  ctf->Delete();
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize Tcl
+
+  Tcl_Interp *interp = vtkKWApplication::InitializeTcl(argc, argv, &cerr);
+  if (!interp)
+    {
+    cerr << "Error: InitializeTcl failed" << endl ;
+    return 1;
+    }
+
+  int option_test = 0, option_display = 0;
+  vtksys::CommandLineArguments args;
+  args.Initialize(argc, argv);
+  args.AddArgument(
+    "--test", vtksys::CommandLineArguments::NO_ARGUMENT, &option_test, "");
+  args.AddArgument(
+    "--display", vtksys::CommandLineArguments::NO_ARGUMENT, &option_display,
+    "");
+  args.Parse();
+
+  vtkKWApplication *app = vtkKWApplication::New();
+  app->SetName("KWWidgetsBenchmarkFunctionEditors");
+  app->SetRegistryLevel(0);
+  app->PromptBeforeExitOff();
+
+  // Sizes of the functions and of the histogram, number of operations
+
+  int sizes[] = { 10, 100, 1000, 10000 };
+  int nb_sizes = option_test ? 2 : 4;
+  int nb_operations = option_test ? 10 : 200;
+  vtkIdType nb_scalars = option_test ? 10000 : 1000000;
+
+  // A large histogram, shared by both editors
+
+  vtkDoubleArray *scalars = vtkDoubleArray::New();
+  scalars->SetNumberOfTuples(nb_scalars);
+  unsigned long seed = 6789;
+  for (vtkIdType s = 0; s < nb_scalars; s++)
+    {
+    // Sum of uniforms, bell-shaped
+
+    double v = NextRandom(&seed) + NextRandom(&seed) + NextRandom(&seed);
+    scalars->SetValue(s, v * BENCHMARK_RANGE_MAX / 3.0);
+    }
+  vtkKWHistogram *hist = vtkKWHistogram::New();
+  hist->SetMaximumNumberOfBins(65536);
+  hist->BuildHistogram(scalars, 0);
+  scalars->Delete();
+
+  // The editors, in a withdrawn toplevel
+
+  vtkKWTopLevel *toplevel = vtkKWTopLevel::New();
+  toplevel->SetApplication(app);
+  toplevel->Create();
+  toplevel->SetTitle("Function Editors Benchmark");
+
+  vtkKWPiecewiseFunctionEditor *pwf_editor =
+    vtkKWPiecewiseFunctionEditor::New();
+  vtkKWColorTransferFunctionEditor *ctf_editor =
+    vtkKWColorTransferFunctionEditor::New();
+
+  vtkKWParameterValueFunctionEditor *editors[2];
+  editors[0] = pwf_editor;
+  editors[1] = ctf_editor;
+  const char *editor_names[2] = { "piecewise", "color" };
+
+  int e;
+  for (e = 0; e < 2; e++)
+    {
+    editors[e]->SetParent(toplevel);
+    editors[e]->ExpandCanvasWidthOff();
+    editors[e]->SetCanvasWidth(BENCHMARK_CANVAS_WIDTH);
+    editors[e]->SetCanvasHeight(BENCHMARK_CANVAS_HEIGHT);
+    editors[e]->Create();
+    editors[e]->SetHistogram(hist);
+    app->Script("pack %s -side top -fill x", editors[e]->GetWidgetName());
+    }
+
+  if (option_display)
+    {
+    toplevel->Display();
+    }
+  app->Script("update");
+
+  // Run
+
+  app->GetTclProfiler()->EnabledOn();
+
+  cout << "editor     points  op    count  p50 (ms)  p90 (ms)  p99 (ms)"
+       << "  max (ms) Tcl evals" << endl;
+  for (int size = 0; size < nb_sizes; size++)
+    {
+    for (e = 0; e < 2; e++)
+      {
+      BenchmarkEditor(
+        app, editors[e], editor_names[e], sizes[size], nb_operations);
+      }
+    }
+
+  app->GetTclProfiler()->EnabledOff();
+
+  // Deallocate and exit
+
+  for (e = 0; e < 2; e++)
+    {
+    editors[e]->SetHistogram(NULL);
+    editors[e]->Delete();
+    }
+  hist->Delete();
+  toplevel->Delete();
+  app->Delete();
+
+  return 0;
+}
@@ -0,0 +1,199 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkKWColorTransferFunctionEditor.h"
+#include "vtkKWLabel.h"
+
+#include "vtkColorTransferFunction.h"
+
+#define TEST_NB_POINTS     8
+
+// Count the ramp updates made in place, and allow a full redraw to be
+// forced
+
+class TestColorRampCacheEditor
+  : public TestFunctionEditor<vtkKWColorTransferFunctionEditor>
+{
+public:
+  static TestColorRampCacheEditor* New()
+    { return new TestColorRampCacheEditor; }
+
+  int NumberOfColumnUpdates;
+  int ForceFullRedraw;
+
+  virtual int UpdateColorRampColumns(
+    vtkColorTransferFunction *func, double p_v_range_ext[2],
+    int img_width, int img_height, int img_offset_x,
+    unsigned char margin_rgb[3])
+    {
+      if (this->ForceFullRedraw)
+        {
+        return 0;
+        }
+      int res = vtkKWColorTransferFunctionEditor::UpdateColorRampColumns(
+        func, p_v_range_ext, img_width, img_height, img_offset_x,
+        margin_rgb);
+      this->NumberOfColumnUpdates += res;
+      return res;
+    }
+
+  // Redraw the ramp if the function changed (in place, if possible)
+
+  void RedrawRampIfNeeded()
+    {
+      if (!this->IsColorRampUpToDate())
+        {
+        this->RedrawColorRamp();
+        }
+    }
+
+  void RedrawRampFully()
+    {
+      this->ForceFullRedraw = 1;
+      this->RedrawColorRamp();
+      this->ForceFullRedraw = 0;
+      this->NumberOfColumnUpdates = 0;
+    }
+
+  // The pixels of the ramp, as a list of rows of #rrggbb colors
+
+  vtksys_stl::string GetRampPixels()
+    {
+      const char *photo = this->ColorRamp->GetConfigurationOption("-image");
+      if (!photo || !*photo)
+        {
+        return vtksys_stl::string();
+        }
+      return vtksys_stl::string(this->Script("%s data", photo));
+    }
+
+protected:
+  TestColorRampCacheEditor()
+    {
+      this->NumberOfColumnUpdates = 0;
+      this->ForceFullRedraw = 0;
+    }
+};
+
+// Once the function was edited (the ramp was last redrawn from scratch),
+// check that the ramp was updated in place, and that a full redraw gives
+// the same pixels
+
+static int CheckRamp(TestColorRampCacheEditor *editor, const char *test)
+{
+  editor->RedrawRampIfNeeded();
+  if (!editor->NumberOfColumnUpdates)
+    {
+    cout << "Error! " << test << ": the ramp was not updated in place"
+         << endl;
+    return 1;
+    }
+
+  vtksys_stl::string updated(editor->GetRampPixels());
+  editor->RedrawRampFully();
+  vtksys_stl::string redrawn(editor->GetRampPixels());
+  if (updated.empty() || updated != redrawn)
+    {
+    cout << "Error! " << test << ": the ramp updated in place differs from "
+         << "the ramp redrawn from scratch (position "
+         << editor->GetColorRampPosition() << ", outline "
+         << editor->GetColorRampOutlineStyle() << ")" << endl;
+    return 1;
+    }
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(argc, argv, "KWWidgetsTestColorRampCache"))
+    {
+    return 1;
+    }
+  vtkKWApplication *app = fixture.Application;
+
+  TestColorRampCacheEditor *editor = TestColorRampCacheEditor::New();
+  editor->ColorRampVisibilityOn();
+  fixture.CreateEditor(editor);
+
+  // Random colors, midpoints and sharpnesses, over the whole range
+
+  vtkColorTransferFunction *func = vtkColorTransferFunction::New();
+  unsigned long seed = 8765;
+  int i;
+  for (i = 0; i < TEST_NB_POINTS; i++)
+    {
+    double x = TEST_RANGE_MAX * (double)i / (double)(TEST_NB_POINTS - 1);
+    double r = TestNextRandom(&seed);
+    double g = TestNextRandom(&seed);
+    double b = TestNextRandom(&seed);
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+    double midpoint = 0.2 + 0.6 * TestNextRandom(&seed);
+    double sharpness = TestNextRandom(&seed);
+    func->AddRGBPoint(x, r, g, b, midpoint, sharpness);
+#else
+    func->AddRGBPoint(x, r, g, b);
+#endif
+    }
+
+  editor->SetColorTransferFunction(func);
+  fixture.ShowWholeRange(editor);
+
+  int res = 0;
+
+  // Below the canvas or in the canvas, with each outline style
+
+  int positions[] =
+    {
+      vtkKWColorTransferFunctionEditor::ColorRampPositionDefault,
+      vtkKWColorTransferFunctionEditor::ColorRampPositionCanvas
+    };
+  int styles[] =
+    {
+      vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleNone,
+      vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid,
+      vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken
+    };
+
+  for (int p = 0; p < 2; p++)
+    {
+    editor->SetColorRampPosition(positions[p]);
+    for (int s = 0; s < 3; s++)
+      {
+      editor->SetColorRampOutlineStyle(styles[s]);
+      editor->Update();
+      app->Script("update");
+      editor->RedrawRampFully();
+
+      // Move a point in the middle
+
+      double prev, next;
+      int id = TEST_NB_POINTS / 2;
+      editor->GetFunctionPointParameter(id - 1, &prev);
+      editor->GetFunctionPointParameter(id + 1, &next);
+      editor->MovePointToParameter(id, prev + (0.2 + 0.1 * s) * (next - prev));
+      res += CheckRamp(editor, "middle point moved");
+
+      // Change the color of the first and last points (they extend to the
+      // ends of the ramp), then of two points apart
+
+      editor->SetPointColorAsRGB(0, 0.2 * s, 1.0, 0.5);
+      res += CheckRamp(editor, "first point color changed");
+
+      editor->SetPointColorAsRGB(TEST_NB_POINTS - 1, 0.5, 0.2 * s, 1.0);
+      res += CheckRamp(editor, "last point color changed");
+
+      editor->SetPointColorAsRGB(1, 0.1 * s, 0.5, 1.0 - 0.1 * s);
+      editor->SetPointColorAsRGB(TEST_NB_POINTS - 3, 1.0, 0.2 * s, 0.0);
+      res += CheckRamp(editor, "colors changed");
+      }
+    }
+
+  // Deallocate and exit
+
+  editor->SetColorTransferFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
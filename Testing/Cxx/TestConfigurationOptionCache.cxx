@@ -0,0 +1,94 @@
+#include "vtkKWApplication.h"
+#include "vtkKWLabel.h"
+#include "vtkKWOptionDataBase.h"
+#include "vtkKWTopLevel.h"
+
+// Check that an option of a widget matches the expected value
+
+static int CheckOption(vtkKWCoreWidget *widget, const char *test,
+                       const char *option, const char *expected)
+{
+  const char *value = widget->GetConfigurationOption(option);
+  if (!value || strcmp(value, expected))
+    {
+    cout << "Error! " << test << ": " << option << " is ["
+         << (value ? value : "(null)") << "], expected ["
+         << expected << "]" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize Tcl
+
+  Tcl_Interp *interp = vtkKWApplication::InitializeTcl(argc, argv, &cerr);
+  if (!interp)
+    {
+    cerr << "Error: InitializeTcl failed" << endl ;
+    return 1;
+    }
+
+  vtkKWApplication *app = vtkKWApplication::New();
+  app->SetName("KWWidgetsTestConfigurationOptionCache");
+  app->SetRegistryLevel(0);
+  app->PromptBeforeExitOff();
+
+  vtkKWTopLevel *toplevel = vtkKWTopLevel::New();
+  toplevel->SetApplication(app);
+  toplevel->Create();
+
+  vtkKWLabel *label = vtkKWLabel::New();
+  label->SetParent(toplevel);
+  label->Create();
+
+  const char *name = label->GetWidgetName();
+  int res = 0;
+
+  // Values that were set or retrieved are served from the cache (changing
+  // them behind the widget's back goes unnoticed)
+
+  label->SetConfigurationOption("-width", "5");
+  app->Script("%s configure -width 6", name);
+  res += CheckOption(label, "cached value", "-width", "5");
+
+  // Setting an option drops the values of its synonyms
+
+  label->SetConfigurationOption("-background", "#ff0000");
+  res += CheckOption(label, "synonym (before)", "-background", "#ff0000");
+  label->SetConfigurationOption("-bg", "#00ff00");
+  res += CheckOption(label, "synonym", "-background", "#00ff00");
+  label->SetConfigurationOption("-background", "#0000ff");
+  res += CheckOption(label, "synonym (reverse)", "-bg", "#0000ff");
+
+  // Adding an entry to the option database invalidates all the caches
+
+  label->SetConfigurationOption("-width", "5");
+  app->Script("%s configure -width 7", name);
+  app->GetOptionDataBase()->AddEntry(
+    "vtkKWTestConfigurationOptionCacheNoSuchClass", "SetWidth", "1");
+  res += CheckOption(label, "option database entry", "-width", "7");
+
+  // Volatile options are never served from the cache
+
+  label->SetConfigurationOption("-text", "set");
+  app->Script("%s configure -text {changed in Tcl}", name);
+  res += CheckOption(label, "volatile -text", "-text", "changed in Tcl");
+
+  label->SetConfigurationOption("-relief", "flat");
+  app->Script("%s configure -relief sunken", name);
+  res += CheckOption(label, "volatile -relief", "-relief", "sunken");
+
+  label->SetConfigurationOption("-state", "normal");
+  app->Script("%s configure -state disabled", name);
+  res += CheckOption(label, "volatile -state", "-state", "disabled");
+
+  // Deallocate and exit
+
+  label->Delete();
+  toplevel->Delete();
+  app->Delete();
+
+  return res ? 1 : 0;
+}
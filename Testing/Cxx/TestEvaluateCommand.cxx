@@ -0,0 +1,145 @@
+#include "vtkKWTkUtilities.h"
+#include "vtkTcl.h"
+
+#include <vtksys/ios/sstream>
+#include <vtksys/stl/string>
+
+// The strings that would need to be escaped in a script
+
+static const char *Values[] =
+{
+  "a b",
+  "{a} {b",
+  "$a",
+  "[set a]",
+  "a \\n \"b\";",
+  "",
+  NULL
+};
+
+// Check that a result matches the expected value
+
+static int CheckResult(const char *test, const char *res, const char *expected)
+{
+  if (!res || strcmp(res, expected))
+    {
+    cout << "Error! " << test << ": got [" << (res ? res : "(null)")
+         << "], expected [" << expected << "]" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  // Only the Tcl interpreter is needed, no display
+
+  Tcl_FindExecutable(argc ? argv[0] : NULL);
+  Tcl_Interp *interp = Tcl_CreateInterp();
+  if (!interp)
+    {
+    cout << "Error! Tcl_CreateInterp failed" << endl;
+    return 1;
+    }
+
+  int res = 0, i;
+  vtkKWTkCommandArguments args;
+  const char *result;
+
+  // Strings are passed verbatim: no substitution, no parsing
+
+  for (i = 0; Values[i]; i++)
+    {
+    args.RemoveAllArguments();
+    args.AddString("::value");
+    args.AddString(Values[i]);
+    result = vtkKWTkUtilities::EvaluateCommand(interp, "set", NULL, &args);
+    res += CheckResult("set", result, Values[i]);
+    res += CheckResult(
+      "set (variable)", Tcl_GetVar(interp, "::value", TCL_GLOBAL_ONLY),
+      Values[i]);
+
+    args.RemoveAllArguments();
+    args.AddString(Values[i]);
+    result = vtkKWTkUtilities::EvaluateCommand(
+      interp, "string", "length", &args);
+    vtksys_ios::ostringstream length;
+    length << strlen(Values[i]);
+    res += CheckResult("string length", result, length.str().c_str());
+    }
+
+  // Each argument is a single word, whatever its contents
+
+  args.RemoveAllArguments();
+  for (i = 0; Values[i]; i++)
+    {
+    args.AddString(Values[i]);
+    }
+  result = vtkKWTkUtilities::EvaluateCommand(interp, "list", NULL, &args);
+  Tcl_Obj *list = Tcl_NewStringObj(result, -1);
+  Tcl_IncrRefCount(list);
+  int nb_elements = 0;
+  Tcl_ListObjLength(interp, list, &nb_elements);
+  if (nb_elements != args.GetNumberOfArguments())
+    {
+    cout << "Error! list: got " << nb_elements << " elements, expected "
+         << args.GetNumberOfArguments() << endl;
+    res++;
+    }
+  for (i = 0; i < nb_elements && Values[i]; i++)
+    {
+    Tcl_Obj *element;
+    Tcl_ListObjIndex(interp, list, i, &element);
+    res += CheckResult("list element", Tcl_GetString(element), Values[i]);
+    }
+  Tcl_DecrRefCount(list);
+
+  // Numbers
+
+  args.RemoveAllArguments();
+  args.AddInt(-12);
+  args.AddString("+");
+  args.AddDouble(0.5);
+  result = vtkKWTkUtilities::EvaluateCommand(interp, "expr", NULL, &args);
+  res += CheckResult("expr", result, "-11.5");
+
+  // More arguments than fit on the stack (both in the argument list and
+  // in the command vector)
+
+  args.RemoveAllArguments();
+  vtksys_stl::string expected;
+  for (i = 0; i < 100; i++)
+    {
+    args.AddInt(i);
+    vtksys_ios::ostringstream value;
+    value << (i ? " " : "") << i;
+    expected += value.str();
+    }
+  if (args.GetNumberOfArguments() != 100)
+    {
+    cout << "Error! " << args.GetNumberOfArguments()
+         << " arguments, expected 100" << endl;
+    res++;
+    }
+  result = vtkKWTkUtilities::EvaluateCommand(interp, "list", NULL, &args);
+  res += CheckResult("list (100 arguments)", result, expected.c_str());
+
+  // Errors: the error message is returned
+
+  args.RemoveAllArguments();
+  args.AddString("{failed} $here");
+  result = vtkKWTkUtilities::EvaluateCommand(interp, "error", NULL, &args);
+  res += CheckResult("error", result, "{failed} $here");
+
+  // No command
+
+  if (vtkKWTkUtilities::EvaluateCommand(interp, NULL, NULL, &args))
+    {
+    cout << "Error! a NULL command was evaluated" << endl;
+    res++;
+    }
+
+  Tcl_DeleteInterp(interp);
+
+  return res ? 1 : 0;
+}
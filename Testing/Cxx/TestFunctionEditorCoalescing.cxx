@@ -0,0 +1,135 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkPiecewiseFunction.h"
+
+#define TEST_NB_POINTS     5
+
+// Check the number of times the Changing and Changed events were invoked
+
+static int CheckCounts(TestFunctionEditorObserver *observer,
+                       const char *test, int changing, int changed)
+{
+  int point_changing = observer->GetCount(
+    vtkKWParameterValueFunctionEditor::PointChangingEvent);
+  int function_changing = observer->GetCount(
+    vtkKWParameterValueFunctionEditor::FunctionChangingEvent);
+  int point_changed = observer->GetCount(
+    vtkKWParameterValueFunctionEditor::PointChangedEvent);
+  int function_changed = observer->GetCount(
+    vtkKWParameterValueFunctionEditor::FunctionChangedEvent);
+  if (point_changing != changing || function_changing != changing ||
+      point_changed != changed || function_changed != changed)
+    {
+    cout << "Error! " << test << ": PointChanging/FunctionChanging invoked "
+         << point_changing << "/" << function_changing << " time(s), "
+         << "expected " << changing << ", PointChanged/FunctionChanged "
+         << point_changed << "/" << function_changed << " time(s), "
+         << "expected " << changed << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(
+        argc, argv, "KWWidgetsTestFunctionEditorCoalescing"))
+    {
+    return 1;
+    }
+  vtkKWApplication *app = fixture.Application;
+
+  TestPiecewiseFunctionEditor *editor = TestPiecewiseFunctionEditor::New();
+  fixture.CreateEditor(editor);
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  int i;
+  for (i = 0; i < TEST_NB_POINTS; i++)
+    {
+    func->AddPoint(
+      TEST_RANGE_MAX * (double)i / (double)(TEST_NB_POINTS - 1), 0.5);
+    }
+
+  editor->SetPiecewiseFunction(func);
+  fixture.ShowWholeRange(editor);
+
+  TestFunctionEditorObserver *observer = TestFunctionEditorObserver::New();
+  observer->Observe(editor);
+
+  int res = 0;
+
+  // Drag the point in the middle. The point is moved on each motion event,
+  // but it is only redrawn, and the Changing events invoked, once the
+  // application is idle.
+
+  editor->CoalesceInteractiveRedrawsOn();
+
+  int id = TEST_NB_POINTS / 2, x, y;
+  double parameter, last_parameter;
+  editor->GetPointWindowCoordinates(id, &x, &y);
+  editor->GetFunctionPointParameter(id, &last_parameter);
+  editor->StartInteractionCallback(x, y, 0);
+  if (editor->GetSelectedPoint() != id)
+    {
+    cout << "Error! the point dragged was not selected" << endl;
+    res++;
+    }
+
+  for (i = 1; i <= 10; i++)
+    {
+    editor->MovePointCallback(x + 2 * i, y, 0);
+    editor->GetFunctionPointParameter(id, &parameter);
+    if (parameter <= last_parameter)
+      {
+      cout << "Error! the point was not moved on motion event " << i << endl;
+      res++;
+      }
+    last_parameter = parameter;
+    }
+  res += CheckCounts(observer, "motion events", 0, 0);
+  res += editor->CheckPointDrawn("motion events", id, 0);
+
+  app->Script("update idletasks");
+  res += CheckCounts(observer, "idle", 1, 0);
+  res += editor->CheckPointDrawn("idle", id, 1);
+
+  // The end of the interaction catches up with the pending motion events
+
+  for (i = 11; i <= 15; i++)
+    {
+    editor->MovePointCallback(x + 2 * i, y, 0);
+    }
+  editor->EndInteractionCallback(x + 30, y);
+  res += CheckCounts(observer, "end of interaction", 2, 1);
+  res += editor->CheckPointDrawn("end of interaction", id, 1);
+
+  app->Script("update idletasks");
+  res += CheckCounts(observer, "idle after the interaction", 2, 1);
+
+  // Without coalescing, each motion event is reported right away
+
+  editor->CoalesceInteractiveRedrawsOff();
+  observer->Counts.clear();
+
+  editor->GetPointWindowCoordinates(id, &x, &y);
+  editor->StartInteractionCallback(x, y, 0);
+  for (i = 1; i <= 3; i++)
+    {
+    editor->MovePointCallback(x - 2 * i, y, 0);
+    }
+  res += CheckCounts(observer, "no coalescing", 3, 0);
+  res += editor->CheckPointDrawn("no coalescing", id, 1);
+  editor->EndInteractionCallback(x - 6, y);
+  res += CheckCounts(observer, "no coalescing, end of interaction", 3, 1);
+
+  // Deallocate and exit
+
+  editor->RemoveObserver(observer);
+  observer->Delete();
+  editor->SetPiecewiseFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
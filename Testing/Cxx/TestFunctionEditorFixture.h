@@ -0,0 +1,250 @@
+// The setup shared by the function editor tests: the application and the
+// toplevel the editors are packed in, an editor subclass giving access to
+// what the tests check, and an observer counting the editor events.
+
+#ifndef __TestFunctionEditorFixture_h
+#define __TestFunctionEditorFixture_h
+
+#include "vtkKWApplication.h"
+#include "vtkKWCanvas.h"
+#include "vtkKWPiecewiseFunctionEditor.h"
+#include "vtkKWTopLevel.h"
+
+#include "vtkCommand.h"
+
+#include <vtksys/stl/map>
+#include <vtksys/stl/string>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_CANVAS_WIDTH  300
+#define TEST_CANVAS_HEIGHT 100
+#define TEST_RANGE_MAX     1000.0
+
+// Deterministic pseudo-random sequence in [0, 1]
+
+inline double TestNextRandom(unsigned long *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (double)((*seed >> 16) & 0x7fff) / 32767.0;
+}
+
+// Give access to the canvas, the points coordinates, the level-of-detail
+// and the rubber-band selection
+
+template <class TEditor>
+class TestFunctionEditor : public TEditor
+{
+public:
+  static TestFunctionEditor<TEditor>* New()
+    { return new TestFunctionEditor<TEditor>; }
+
+  const char* GetCanvasName()
+    { return this->Canvas->GetWidgetName(); }
+
+  int GetPointCanvasCoordinates(int id, int *x, int *y)
+    { return this->GetFunctionPointCanvasCoordinates(id, x, y); }
+
+  int NeedLOD()
+    { return this->FunctionPointsNeedLOD(); }
+
+  int GetNumberOfCanvasItems(const char *tag)
+    {
+      return atoi(this->Script("llength [%s find withtag %s]",
+                               this->GetCanvasName(), tag));
+    }
+
+  // The coordinates of a point in the canvas window, as received by the
+  // interaction callbacks
+
+  void GetPointWindowCoordinates(int id, int *x, int *y)
+    {
+      this->GetFunctionPointCanvasCoordinates(id, x, y);
+      *x -= atoi(this->Script("%s canvasx 0", this->GetCanvasName()));
+      *y -= atoi(this->Script("%s canvasy 0", this->GetCanvasName()));
+    }
+
+  // Send a mouse button event to the canvas, through its bindings
+
+  void GenerateButtonEvent(const char *event, int x, int y)
+    {
+      this->Script("event generate %s %s -x %d -y %d",
+                   this->GetCanvasName(), event, x, y);
+    }
+
+  void StartRubberBand(int x, int y)
+    { this->StartSelectionRectangle(x, y); }
+
+  void DragRubberBand(int x1, int y1, int x2, int y2)
+    {
+      this->StartSelectionRectangle(x1, y1);
+      this->UpdateSelectionRectangle((x1 + x2) / 2, (y1 + y2) / 2);
+      this->UpdateSelectionRectangle(x2, y2);
+      this->EndSelectionRectangle();
+    }
+
+  // The function items visible in the canvas (name, coordinates, color
+  // and text), sorted, so that two editors can be compared. Hidden items
+  // are left out: they are only kept around if they were ever visible.
+
+  vtksys_stl::string GetFunctionItems()
+    {
+      const char *canv = this->GetCanvasName();
+      return vtksys_stl::string(
+        this->Script(
+          "set items {} ; "
+          "foreach item [%s find withtag %s] { "
+          "if {[%s itemcget $item -state] != \"hidden\"} { "
+          "set text {} ; catch {set text [%s itemcget $item -text]} ; "
+          "lappend items [list [lindex [%s gettags $item] 0] "
+          "[%s coords $item] [%s itemcget $item -fill] $text] } } ; "
+          "lsort $items",
+          canv, vtkKWParameterValueFunctionEditor::FunctionTag,
+          canv, canv, canv, canv, canv));
+    }
+
+  // Check that a point is drawn where it is (or is not, if 'expected' is 0)
+
+  int CheckPointDrawn(const char *test, int id, int expected)
+    {
+      int x, y;
+      this->GetFunctionPointCanvasCoordinates(id, &x, &y);
+      double bbox[4];
+      if (sscanf(this->Script("%s bbox p%d", this->GetCanvasName(), id),
+                 "%lf %lf %lf %lf", bbox, bbox + 1, bbox + 2, bbox + 3) != 4)
+        {
+        cout << "Error! " << test << ": point " << id << " is not drawn"
+             << endl;
+        return 1;
+        }
+      int drawn =
+        (bbox[0] <= x && x <= bbox[2] && bbox[1] <= y && y <= bbox[3]);
+      if (drawn != expected)
+        {
+        cout << "Error! " << test << ": point " << id << " at (" << x
+             << ", " << y << ") is " << (drawn ? "" : "not ")
+             << "drawn there" << endl;
+        return 1;
+        }
+      return 0;
+    }
+};
+
+typedef TestFunctionEditor<vtkKWPiecewiseFunctionEditor>
+TestPiecewiseFunctionEditor;
+
+// Count the events invoked by an editor
+
+class TestFunctionEditorObserver : public vtkCommand
+{
+public:
+  static TestFunctionEditorObserver* New()
+    { return new TestFunctionEditorObserver; }
+
+  virtual void Execute(vtkObject *, unsigned long event, void *)
+    { this->Counts[event]++; }
+
+  void Observe(vtkKWParameterValueFunctionEditor *editor)
+    {
+      unsigned long event;
+      for (event = vtkKWParameterValueFunctionEditor::FunctionChangedEvent;
+           event <= vtkKWParameterValueFunctionEditor::DoubleClickOnPointEvent;
+           event++)
+        {
+        editor->AddObserver(event, this);
+        }
+    }
+
+  int GetCount(unsigned long event)
+    { return this->Counts[event]; }
+
+  int GetTotalCount()
+    {
+      int total = 0;
+      vtksys_stl::map<unsigned long, int>::iterator it = this->Counts.begin();
+      for (; it != this->Counts.end(); ++it)
+        {
+        total += it->second;
+        }
+      return total;
+    }
+
+  vtksys_stl::map<unsigned long, int> Counts;
+};
+
+// The application, and the toplevel the editors are packed in
+
+class TestFunctionEditorFixture
+{
+public:
+  vtkKWApplication *Application;
+  vtkKWTopLevel *TopLevel;
+
+  TestFunctionEditorFixture()
+    {
+      this->Application = NULL;
+      this->TopLevel = NULL;
+    }
+
+  ~TestFunctionEditorFixture()
+    {
+      if (this->TopLevel)
+        {
+        this->TopLevel->Delete();
+        }
+      if (this->Application)
+        {
+        this->Application->Delete();
+        }
+    }
+
+  // Initialize Tcl, the application 'name' and the toplevel.
+  // Return 1 on success, 0 otherwise.
+
+  int Initialize(int argc, char *argv[], const char *name)
+    {
+      Tcl_Interp *interp = vtkKWApplication::InitializeTcl(argc, argv, &cerr);
+      if (!interp)
+        {
+        cerr << "Error: InitializeTcl failed" << endl ;
+        return 0;
+        }
+
+      this->Application = vtkKWApplication::New();
+      this->Application->SetName(name);
+      this->Application->SetRegistryLevel(0);
+      this->Application->PromptBeforeExitOff();
+
+      this->TopLevel = vtkKWTopLevel::New();
+      this->TopLevel->SetApplication(this->Application);
+      this->TopLevel->Create();
+
+      return 1;
+    }
+
+  // Create an editor in the toplevel, with the test canvas size
+
+  void CreateEditor(vtkKWParameterValueFunctionEditor *editor)
+    {
+      editor->SetParent(this->TopLevel);
+      editor->ExpandCanvasWidthOff();
+      editor->SetCanvasWidth(TEST_CANVAS_WIDTH);
+      editor->SetCanvasHeight(TEST_CANVAS_HEIGHT);
+      editor->Create();
+      this->Application->Script(
+        "pack %s -side top -fill x", editor->GetWidgetName());
+    }
+
+  // Show the whole test range (once the editor function is set)
+
+  void ShowWholeRange(vtkKWParameterValueFunctionEditor *editor)
+    {
+      editor->SetWholeParameterRange(0.0, TEST_RANGE_MAX);
+      editor->SetVisibleParameterRangeToWholeParameterRange();
+      editor->Update();
+      this->Application->Script("update");
+    }
+};
+
+#endif
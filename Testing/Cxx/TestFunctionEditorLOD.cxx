@@ -0,0 +1,125 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkPiecewiseFunction.h"
+
+#define TEST_CLUSTER_SIZE  5
+
+// The canvas x coordinate of a point
+
+static int GetPointCanvasX(TestPiecewiseFunctionEditor *editor, int id)
+{
+  int x = -1, y = -1;
+  editor->GetPointCanvasCoordinates(id, &x, &y);
+  return x;
+}
+
+// Check FunctionPointsNeedLOD and what was drawn for a given threshold
+
+static int CheckLOD(TestPiecewiseFunctionEditor *editor, const char *test,
+                    int threshold, int expected)
+{
+  editor->SetPointLODThreshold(threshold);
+  editor->Update();
+
+  int res = 0;
+  if (editor->NeedLOD() != expected)
+    {
+    cout << "Error! " << test << " (threshold " << threshold
+         << "): FunctionPointsNeedLOD is " << editor->NeedLOD()
+         << ", expected " << expected << endl;
+    res++;
+    }
+
+  // Either a single polyline (nothing is selected), or no polyline and
+  // individual point items
+
+  int nb_points = editor->GetNumberOfCanvasItems(
+    vtkKWParameterValueFunctionEditor::PointTag);
+  int nb_polylines = editor->GetNumberOfCanvasItems(
+    vtkKWParameterValueFunctionEditor::FunctionLODTag);
+  if (expected ?
+      (nb_points || nb_polylines != 1) : (!nb_points || nb_polylines))
+    {
+    cout << "Error! " << test << " (threshold " << threshold
+         << "): " << nb_points << " point item(s) and " << nb_polylines
+         << " polyline(s) drawn" << endl;
+    res++;
+    }
+
+  return res;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(argc, argv, "KWWidgetsTestFunctionEditorLOD"))
+    {
+    return 1;
+    }
+
+  TestPiecewiseFunctionEditor *editor = TestPiecewiseFunctionEditor::New();
+  fixture.CreateEditor(editor);
+
+  // Both end points, and a cluster of points a hundredth apart in the
+  // middle: the cluster falls in a single pixel column unless zoomed in a
+  // lot (a pixel is worth about 3.3 units)
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  func->AddPoint(0.0, 0.0);
+  int i;
+  for (i = 0; i < TEST_CLUSTER_SIZE; i++)
+    {
+    func->AddPoint(
+      0.5 * TEST_RANGE_MAX + 0.01 * (double)i, (double)(i % 2));
+    }
+  func->AddPoint(TEST_RANGE_MAX, 1.0);
+
+  editor->SetPiecewiseFunction(func);
+  fixture.ShowWholeRange(editor);
+
+  int res = 0;
+
+  for (i = 2; i <= TEST_CLUSTER_SIZE; i++)
+    {
+    if (GetPointCanvasX(editor, i) != GetPointCanvasX(editor, 1))
+      {
+      cout << "Error! the cluster does not fall in a single column" << endl;
+      res++;
+      break;
+      }
+    }
+
+  // LOD kicks in strictly above the threshold, and is disabled at 0
+
+  res += CheckLOD(editor, "disabled", 0, 0);
+  res += CheckLOD(editor, "above", TEST_CLUSTER_SIZE - 1, 1);
+  res += CheckLOD(editor, "at", TEST_CLUSTER_SIZE, 0);
+  res += CheckLOD(editor, "below", TEST_CLUSTER_SIZE + 1, 0);
+
+  // A threshold at or above the number of points never needs LOD
+
+  res += CheckLOD(editor, "function size", editor->GetFunctionSize(), 0);
+
+  // Individual points are drawn again once zoomed in enough (the cluster
+  // points are about 3 pixels apart), or when the cluster is not visible
+
+  res += CheckLOD(editor, "whole range", 1, 1);
+
+  editor->SetVisibleParameterRange(
+    0.5 * TEST_RANGE_MAX - 0.5, 0.5 * TEST_RANGE_MAX + 0.5);
+  res += CheckLOD(editor, "zoomed in", 1, 0);
+
+  editor->SetVisibleParameterRange(0.0, 0.25 * TEST_RANGE_MAX);
+  res += CheckLOD(editor, "cluster not visible", 1, 0);
+
+  editor->SetVisibleParameterRangeToWholeParameterRange();
+  res += CheckLOD(editor, "whole range again", 1, 1);
+
+  // Deallocate and exit
+
+  editor->SetPiecewiseFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
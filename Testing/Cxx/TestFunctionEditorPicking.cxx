@@ -0,0 +1,296 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkIntArray.h"
+#include "vtkPiecewiseFunction.h"
+
+#include <vtksys/stl/vector>
+
+#define TEST_NB_POINTS     60
+
+// Squared distance from a point to canvas coordinates
+
+static double GetDistance2(TestPiecewiseFunctionEditor *editor,
+                           int id, int x, int y)
+{
+  int p_x, p_y;
+  editor->GetPointCanvasCoordinates(id, &p_x, &p_y);
+  double dx = (double)(p_x - x), dy = (double)(p_y - y);
+  return dx * dx + dy * dy;
+}
+
+// The points inside a canvas rectangle, the hard way
+
+static void FindPointsInRectangle(TestPiecewiseFunctionEditor *editor,
+                                  int x1, int y1, int x2, int y2,
+                                  vtksys_stl::vector<int> &ids)
+{
+  ids.clear();
+  int size = editor->GetFunctionSize();
+  for (int id = 0; id < size; id++)
+    {
+    int p_x, p_y;
+    editor->GetPointCanvasCoordinates(id, &p_x, &p_y);
+    if (p_x >= (x1 < x2 ? x1 : x2) && p_x <= (x1 < x2 ? x2 : x1) &&
+        p_y >= (y1 < y2 ? y1 : y2) && p_y <= (y1 < y2 ? y2 : y1))
+      {
+      ids.push_back(id);
+      }
+    }
+}
+
+// Compare FindPointClosestToCanvasCoordinates to an exhaustive search, on
+// a grid covering the canvas and beyond (ties can go either way)
+
+static int CheckClosest(TestPiecewiseFunctionEditor *editor,
+                        const char *test)
+{
+  int size = editor->GetFunctionSize();
+  for (int x = -50; x <= TEST_CANVAS_WIDTH + 50; x += 7)
+    {
+    for (int y = -20; y <= TEST_CANVAS_HEIGHT + 20; y += 5)
+      {
+      double best_dist2 = GetDistance2(editor, 0, x, y);
+      for (int id = 1; id < size; id++)
+        {
+        double dist2 = GetDistance2(editor, id, x, y);
+        if (dist2 < best_dist2)
+          {
+          best_dist2 = dist2;
+          }
+        }
+      int found = -1;
+      if (!editor->FindPointClosestToCanvasCoordinates(x, y, &found) ||
+          found < 0 || found >= size ||
+          GetDistance2(editor, found, x, y) != best_dist2)
+        {
+        cout << "Error! " << test << ": closest point to (" << x << ", "
+             << y << ") is " << found << ", at distance^2 "
+             << (found >= 0 ? GetDistance2(editor, found, x, y) : -1.0)
+             << ", expected distance^2 " << best_dist2 << endl;
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+// Compare FindPointsInCanvasRectangle to an exhaustive search, for random
+// rectangles given by any two opposite corners
+
+static int CheckRectangles(TestPiecewiseFunctionEditor *editor,
+                           const char *test)
+{
+  unsigned long seed = 4242;
+  vtkIntArray *found = vtkIntArray::New();
+  vtksys_stl::vector<int> expected;
+  int res = 0;
+  for (int r = 0; r < 50 && !res; r++)
+    {
+    int x1 = (int)(TestNextRandom(&seed) * (TEST_CANVAS_WIDTH + 40)) - 20;
+    int y1 = (int)(TestNextRandom(&seed) * (TEST_CANVAS_HEIGHT + 40)) - 20;
+    int x2 = (int)(TestNextRandom(&seed) * (TEST_CANVAS_WIDTH + 40)) - 20;
+    int y2 = (int)(TestNextRandom(&seed) * (TEST_CANVAS_HEIGHT + 40)) - 20;
+    FindPointsInRectangle(editor, x1, y1, x2, y2, expected);
+    int nb_found = editor->FindPointsInCanvasRectangle(x1, y1, x2, y2, found);
+    int ok = (nb_found == (int)expected.size() &&
+              found->GetNumberOfTuples() == (vtkIdType)expected.size());
+    for (int i = 0; ok && i < nb_found; i++)
+      {
+      ok = (found->GetValue(i) == expected[i]);
+      }
+    if (!ok)
+      {
+      cout << "Error! " << test << ": " << nb_found << " point(s) found in ("
+           << x1 << ", " << y1 << ")-(" << x2 << ", " << y2 << "), expected "
+           << expected.size() << endl;
+      res++;
+      }
+    }
+  found->Delete();
+  return res;
+}
+
+// Check that exactly the points 'expected' are selected, the first one
+// being SelectedPoint
+
+static int CheckSelection(TestPiecewiseFunctionEditor *editor,
+                          const char *test,
+                          const vtksys_stl::vector<int> &expected)
+{
+  int nb_selected = editor->GetNumberOfSelectedPoints();
+  int ok = (nb_selected == (int)expected.size());
+  if (ok && nb_selected)
+    {
+    ok = (editor->GetSelectedPoint() == expected[0] &&
+          editor->GetNthSelectedPoint(0) == expected[0]);
+    }
+  for (int i = 1; ok && i < nb_selected; i++)
+    {
+    ok = (editor->GetNthSelectedPoint(i) == expected[i]);
+    }
+  int size = editor->GetFunctionSize(), nb_flagged = 0;
+  for (int id = 0; id < size; id++)
+    {
+    nb_flagged += editor->IsPointSelected(id) ? 1 : 0;
+    }
+  if (!ok || nb_flagged != nb_selected)
+    {
+    cout << "Error! " << test << ": " << nb_selected << " point(s) selected ("
+         << nb_flagged << " flagged), expected " << expected.size() << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(argc, argv, "KWWidgetsTestFunctionEditorPicking"))
+    {
+    return 1;
+    }
+
+  TestPiecewiseFunctionEditor *editor = TestPiecewiseFunctionEditor::New();
+  fixture.CreateEditor(editor);
+
+  // Random values, some points closer than a pixel apart
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  unsigned long seed = 1234;
+  int i;
+  for (i = 0; i < TEST_NB_POINTS; i++)
+    {
+    double x = TEST_RANGE_MAX * (double)i / (double)(TEST_NB_POINTS - 1);
+    if (i % 10 == 5)
+      {
+      x = TEST_RANGE_MAX * (double)(i - 1) / (double)(TEST_NB_POINTS - 1)
+        + 0.5;
+      }
+    func->AddPoint(x, TestNextRandom(&seed));
+    }
+
+  editor->SetPiecewiseFunction(func);
+  fixture.ShowWholeRange(editor);
+
+  int res = 0;
+
+  // Queries on the whole range
+
+  res += CheckClosest(editor, "closest");
+  res += CheckRectangles(editor, "rectangle");
+
+  // After moving points (the index is updated in place)
+
+  double parameter;
+  for (i = 1; i < TEST_NB_POINTS - 1; i += 3)
+    {
+    double prev, next;
+    editor->GetFunctionPointParameter(i - 1, &prev);
+    editor->GetFunctionPointParameter(i + 1, &next);
+    editor->MovePointToParameter(i, prev + 0.25 * (next - prev));
+    }
+  res += CheckClosest(editor, "closest (moved)");
+  res += CheckRectangles(editor, "rectangle (moved)");
+
+  // After zooming in (the index is rebuilt)
+
+  editor->SetVisibleParameterRange(0.3 * TEST_RANGE_MAX, 0.6 * TEST_RANGE_MAX);
+  editor->Update();
+  res += CheckClosest(editor, "closest (zoomed)");
+  res += CheckRectangles(editor, "rectangle (zoomed)");
+
+  // Rubber-band selection: the points inside the rectangle dragged,
+  // whatever the direction of the drag, SelectedPoint being the first one
+
+  editor->SetVisibleParameterRangeToWholeParameterRange();
+  editor->Update();
+
+  vtksys_stl::vector<int> expected;
+  int x1 = TEST_CANVAS_WIDTH / 4, y1 = 0;
+  int x2 = (3 * TEST_CANVAS_WIDTH) / 4, y2 = TEST_CANVAS_HEIGHT;
+  FindPointsInRectangle(editor, x1, y1, x2, y2, expected);
+  if (expected.size() < 2)
+    {
+    cout << "Error! rubber-band: only " << expected.size()
+         << " point(s) in the rectangle" << endl;
+    res++;
+    }
+
+  editor->DragRubberBand(x2, y2, x1, y1);
+  res += CheckSelection(editor, "rubber-band", expected);
+
+  editor->ClearSelection();
+  editor->DragRubberBand(x1, y1, x2, y2);
+  res += CheckSelection(editor, "rubber-band (reversed)", expected);
+
+  if (editor->SelectPointsInCanvasRectangle(x1, y1, x2, y2) !=
+      (int)expected.size())
+    {
+    cout << "Error! SelectPointsInCanvasRectangle did not return the number "
+         << "of points selected" << endl;
+    res++;
+    }
+  res += CheckSelection(editor, "SelectPointsInCanvasRectangle", expected);
+
+  // Selecting a single point reduces the selection to it
+
+  int single = expected.back();
+  editor->SelectPoint(single);
+  expected.clear();
+  expected.push_back(single);
+  res += CheckSelection(editor, "single point", expected);
+
+  // An empty rectangle clears the selection
+
+  expected.clear();
+  editor->DragRubberBand(-20, -20, -10, -10);
+  res += CheckSelection(editor, "empty rectangle", expected);
+
+  // Control + right button does not start a rubber-band selection (only the
+  // left button motion and release end one)
+
+  editor->GenerateButtonEvent("<Control-ButtonPress-3>", 5, 5);
+  editor->GenerateButtonEvent("<Control-ButtonRelease-3>", 5, 5);
+  if (editor->GetNumberOfCanvasItems(
+        vtkKWParameterValueFunctionEditor::SelectionRectangleTag))
+    {
+    cout << "Error! Control + right button started a rubber-band selection"
+         << endl;
+    res++;
+    }
+
+  // A rubber-band selection left behind does not turn the next drag of a
+  // point into a rubber-band selection
+
+  editor->StartRubberBand(5, 5);
+
+  int id = editor->GetFunctionSize() / 2, x, y;
+  double before;
+  editor->GetFunctionPointParameter(id, &before);
+  editor->GetPointWindowCoordinates(id, &x, &y);
+  editor->StartInteractionCallback(x, y, 0);
+  editor->MovePointCallback(x + 2, y, 0);
+  editor->EndInteractionCallback(x + 2, y);
+  editor->GetFunctionPointParameter(id, &parameter);
+
+  expected.clear();
+  expected.push_back(id);
+  if (parameter == before ||
+      editor->GetNumberOfCanvasItems(
+        vtkKWParameterValueFunctionEditor::SelectionRectangleTag))
+    {
+    cout << "Error! dragging a point after a rubber-band selection was left "
+         << "behind did not move it" << endl;
+    res++;
+    }
+  res += CheckSelection(editor, "drag after a rubber-band selection",
+                        expected);
+
+  // Deallocate and exit
+
+  editor->SetPiecewiseFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
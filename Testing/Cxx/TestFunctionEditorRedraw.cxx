@@ -0,0 +1,128 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkPiecewiseFunction.h"
+
+#define TEST_NB_POINTS     20
+
+// Create an editor showing 'func' over the test range
+
+static TestPiecewiseFunctionEditor* CreateEditor(
+  TestFunctionEditorFixture *fixture, vtkPiecewiseFunction *func)
+{
+  TestPiecewiseFunctionEditor *editor = TestPiecewiseFunctionEditor::New();
+  editor->PointIndexVisibilityOn();
+  fixture->CreateEditor(editor);
+  editor->SetPiecewiseFunction(func);
+  fixture->ShowWholeRange(editor);
+  return editor;
+}
+
+// Compare the items of an editor redrawn incrementally to the ones of an
+// editor drawing the same function from scratch
+
+static int CheckItems(TestFunctionEditorFixture *fixture,
+                      TestPiecewiseFunctionEditor *editor,
+                      const char *test)
+{
+  vtkKWApplication *app = fixture->Application;
+  app->Script("update");
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  func->DeepCopy(editor->GetPiecewiseFunction());
+  TestPiecewiseFunctionEditor *reference = CreateEditor(fixture, func);
+  reference->SetVisibleParameterRange(editor->GetVisibleParameterRange());
+  reference->Update();
+  app->Script("update");
+
+  vtksys_stl::string items(editor->GetFunctionItems());
+  vtksys_stl::string expected(reference->GetFunctionItems());
+
+  reference->SetPiecewiseFunction(NULL);
+  reference->Delete();
+  func->Delete();
+
+  if (items != expected)
+    {
+    cout << "Error! " << test << ": the items redrawn are:" << endl
+         << items << endl << "expected:" << endl << expected << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(argc, argv, "KWWidgetsTestFunctionEditorRedraw"))
+    {
+    return 1;
+    }
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  unsigned long seed = 2468;
+  int i;
+  for (i = 0; i < TEST_NB_POINTS; i++)
+    {
+    func->AddPoint(
+      TEST_RANGE_MAX * (double)i / (double)(TEST_NB_POINTS - 1),
+      TestNextRandom(&seed));
+    }
+
+  TestPiecewiseFunctionEditor *editor = CreateEditor(&fixture, func);
+
+  int res = 0;
+
+  // Only the items that changed are sent to the canvas, what is drawn
+  // should still be what a complete redraw draws
+
+  res += CheckItems(&fixture, editor, "initial");
+
+  double prev, next;
+  for (i = 2; i < TEST_NB_POINTS - 1; i += 4)
+    {
+    editor->GetFunctionPointParameter(i - 1, &prev);
+    editor->GetFunctionPointParameter(i + 1, &next);
+    editor->MovePointToParameter(i, prev + 0.7 * (next - prev));
+    }
+  res += CheckItems(&fixture, editor, "points moved");
+
+  int id;
+  editor->AddPointAtParameter(0.33 * TEST_RANGE_MAX, &id);
+  editor->AddPointAtParameter(0.66 * TEST_RANGE_MAX, &id);
+  editor->ClearSelection();
+  res += CheckItems(&fixture, editor, "points added");
+
+  editor->RemovePoint(TEST_NB_POINTS / 2);
+  editor->RemovePoint(3);
+  editor->ClearSelection();
+  res += CheckItems(&fixture, editor, "points removed");
+
+  // Points moving in and out of the visible range
+
+  editor->SetVisibleParameterRange(0.2 * TEST_RANGE_MAX, 0.5 * TEST_RANGE_MAX);
+  editor->Update();
+  res += CheckItems(&fixture, editor, "zoomed in");
+
+  editor->SetVisibleParameterRange(0.4 * TEST_RANGE_MAX, 0.7 * TEST_RANGE_MAX);
+  editor->Update();
+  res += CheckItems(&fixture, editor, "panned");
+
+  editor->SetVisibleParameterRangeToWholeParameterRange();
+  editor->Update();
+  res += CheckItems(&fixture, editor, "zoomed out");
+
+  // The function modified behind the editor's back
+
+  func->AddPoint(0.5 * TEST_RANGE_MAX + 1.0, 0.5);
+  func->RemovePoint(TEST_RANGE_MAX * 5.0 / (double)(TEST_NB_POINTS - 1));
+  editor->Update();
+  res += CheckItems(&fixture, editor, "function modified");
+
+  // Deallocate and exit
+
+  editor->SetPiecewiseFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+#include "TestFunctionEditorFixture.h"
+
+#include "vtkKWObject.h"
+#include "vtkPiecewiseFunction.h"
+
+#define TEST_NB_POINTS     5
+
+// Check the number of times an event was invoked
+
+static int CheckCount(TestFunctionEditorObserver *observer,
+                      const char *test, const char *event_name,
+                      unsigned long event, int expected)
+{
+  if (observer->GetCount(event) != expected)
+    {
+    cout << "Error! " << test << ": " << event_name << " invoked "
+         << observer->GetCount(event) << " time(s), expected " << expected
+         << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  TestFunctionEditorFixture fixture;
+  if (!fixture.Initialize(
+        argc, argv, "KWWidgetsTestFunctionEditorTransactions"))
+    {
+    return 1;
+    }
+  vtkKWApplication *app = fixture.Application;
+
+  TestPiecewiseFunctionEditor *editor = TestPiecewiseFunctionEditor::New();
+  fixture.CreateEditor(editor);
+
+  vtkPiecewiseFunction *func = vtkPiecewiseFunction::New();
+  int i;
+  for (i = 0; i < TEST_NB_POINTS; i++)
+    {
+    func->AddPoint(
+      TEST_RANGE_MAX * (double)i / (double)(TEST_NB_POINTS - 1),
+      (double)(i % 2));
+    }
+
+  editor->SetPiecewiseFunction(func);
+  fixture.ShowWholeRange(editor);
+
+  // Both the events and the commands are watched (the point commands get
+  // arguments, only their events are)
+
+  TestFunctionEditorObserver *observer = TestFunctionEditorObserver::New();
+  observer->Observe(editor);
+
+  vtkKWObject *function_target = vtkKWObject::New();
+  function_target->SetApplication(app);
+  editor->SetFunctionChangedCommand(function_target, "Modified");
+
+  vtkKWObject *selection_target = vtkKWObject::New();
+  selection_target->SetApplication(app);
+  editor->SetSelectionChangedCommand(selection_target, "Modified");
+
+  unsigned long function_time = function_target->GetMTime();
+  unsigned long selection_time = selection_target->GetMTime();
+
+  int res = 0;
+
+  // Nothing is invoked (nor redrawn) during a transaction, nested or not,
+  // but the points are moved, added and removed right away
+
+  editor->BeginEditTransaction();
+  editor->BeginEditTransaction();
+
+  double parameter, expected_parameter;
+  expected_parameter = 0.3 * TEST_RANGE_MAX;
+  if (!editor->MovePointToParameter(1, 0.4 * TEST_RANGE_MAX) ||
+      !editor->MovePointToParameter(1, expected_parameter) ||
+      !editor->GetFunctionPointParameter(1, &parameter) ||
+      parameter != expected_parameter)
+    {
+    cout << "Error! MovePointToParameter failed in a transaction" << endl;
+    res++;
+    }
+  res += editor->CheckPointDrawn("moved (in transaction)", 1, 0);
+
+  int id = -1;
+  if (!editor->AddPointAtParameter(0.6 * TEST_RANGE_MAX, &id) ||
+      editor->GetFunctionSize() != TEST_NB_POINTS + 1)
+    {
+    cout << "Error! AddPointAtParameter failed in a transaction" << endl;
+    res++;
+    }
+  if (!editor->RemovePoint(id) ||
+      editor->GetFunctionSize() != TEST_NB_POINTS)
+    {
+    cout << "Error! RemovePoint failed in a transaction" << endl;
+    res++;
+    }
+  editor->SelectPoint(2);
+
+  editor->EndEditTransaction();
+  if (!editor->IsInEditTransaction())
+    {
+    cout << "Error! the inner EndEditTransaction ended the transaction"
+         << endl;
+    res++;
+    }
+
+  if (observer->GetTotalCount() ||
+      function_target->GetMTime() != function_time ||
+      selection_target->GetMTime() != selection_time)
+    {
+    cout << "Error! " << observer->GetTotalCount()
+         << " event(s) or commands invoked during the transaction" << endl;
+    res++;
+    }
+
+  // The outermost EndEditTransaction redraws, and invokes the
+  // SelectionChanged and FunctionChanged commands and events once
+
+  editor->EndEditTransaction();
+  if (editor->IsInEditTransaction())
+    {
+    cout << "Error! the outer EndEditTransaction did not end the transaction"
+         << endl;
+    res++;
+    }
+  res += editor->CheckPointDrawn("moved", 1, 1);
+
+  const char *test = "end of transaction";
+  res += CheckCount(observer, test, "FunctionChangedEvent",
+                    vtkKWParameterValueFunctionEditor::FunctionChangedEvent,
+                    1);
+  res += CheckCount(observer, test, "SelectionChangedEvent",
+                    vtkKWParameterValueFunctionEditor::SelectionChangedEvent,
+                    1);
+  res += CheckCount(observer, test, "PointChangedEvent",
+                    vtkKWParameterValueFunctionEditor::PointChangedEvent, 0);
+  res += CheckCount(observer, test, "PointAddedEvent",
+                    vtkKWParameterValueFunctionEditor::PointAddedEvent, 0);
+  res += CheckCount(observer, test, "PointRemovedEvent",
+                    vtkKWParameterValueFunctionEditor::PointRemovedEvent, 0);
+  if (function_target->GetMTime() == function_time ||
+      selection_target->GetMTime() == selection_time)
+    {
+    cout << "Error! " << test << ": the FunctionChanged and SelectionChanged"
+         << " commands were not invoked" << endl;
+    res++;
+    }
+
+  // A transaction that does not change anything does not invoke anything
+
+  observer->Counts.clear();
+  editor->BeginEditTransaction();
+  editor->EndEditTransaction();
+  if (observer->GetTotalCount())
+    {
+    cout << "Error! " << observer->GetTotalCount()
+         << " event(s) invoked by an empty transaction" << endl;
+    res++;
+    }
+
+  // Outside of a transaction, each edit invokes its own events
+
+  observer->Counts.clear();
+  editor->MovePointToParameter(1, 0.2 * TEST_RANGE_MAX);
+  editor->MovePointToParameter(1, 0.1 * TEST_RANGE_MAX);
+  test = "no transaction";
+  res += CheckCount(observer, test, "FunctionChangedEvent",
+                    vtkKWParameterValueFunctionEditor::FunctionChangedEvent,
+                    2);
+  res += CheckCount(observer, test, "PointChangedEvent",
+                    vtkKWParameterValueFunctionEditor::PointChangedEvent, 2);
+  res += editor->CheckPointDrawn("moved (no transaction)", 1, 1);
+
+  // Deallocate and exit
+
+  editor->RemoveObserver(observer);
+  observer->Delete();
+  editor->SetFunctionChangedCommand(NULL, NULL);
+  editor->SetSelectionChangedCommand(NULL, NULL);
+  function_target->Delete();
+  selection_target->Delete();
+
+  editor->SetPiecewiseFunction(NULL);
+  func->Delete();
+  editor->Delete();
+
+  return res ? 1 : 0;
+}
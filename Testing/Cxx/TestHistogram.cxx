@@ -0,0 +1,595 @@
+#include "vtkKWHistogram.h"
+#include "vtkKWHistogram2D.h"
+#include "vtkKWHistogramSet.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedShortArray.h"
+
+#include <vtksys/SystemTools.hxx>
+#include <vtksys/ios/sstream>
+#include <vtksys/stl/string>
+
+#include <math.h>
+#include <string.h>
+
+// Fill 'array' with a deterministic pseudo-random sequence
+
+static void FillArray(vtkDataArray *array, 
+                      vtkIdType nb_tuples, int nb_components, double scale)
+{
+  array->SetNumberOfComponents(nb_components);
+  array->SetNumberOfTuples(nb_tuples);
+
+  unsigned long seed = 12345;
+  for (vtkIdType i = 0; i < nb_tuples; i++)
+    {
+    for (int c = 0; c < nb_components; c++)
+      {
+      seed = seed * 1103515245 + 12345;
+      array->SetComponent(
+        i, c, (double)((seed >> 16) & 0x7fff) / 32767.0 * scale);
+      }
+    }
+}
+
+// Compare the bins of two histograms, they should be strictly identical
+
+static int CompareHistograms(vtkKWHistogram *hist1, 
+                             vtkKWHistogram *hist2, 
+                             const char *label)
+{
+  vtkIdType nb_of_bins = hist1->GetNumberOfBins();
+  if (nb_of_bins != hist2->GetNumberOfBins() ||
+      hist1->GetRange()[0] != hist2->GetRange()[0] ||
+      hist1->GetRange()[1] != hist2->GetRange()[1])
+    {
+    cout << "Error! " << label << ": histograms differ in bins or range!"
+         << endl;
+    return 1;
+    }
+
+  double *bins1 = hist1->GetBins()->GetPointer(0);
+  double *bins2 = hist2->GetBins()->GetPointer(0);
+  for (vtkIdType i = 0; i < nb_of_bins; i++)
+    {
+    if (bins1[i] != bins2[i])
+      {
+      cout << "Error! " << label << ": bin " << i << " differs ("
+           << bins1[i] << " != " << bins2[i] << ")!" << endl;
+      return 1;
+      }
+    }
+
+  return 0;
+}
+
+// Value at a given accumulated occurence, by scanning the bins (reference
+// for the accumulated occurences table)
+
+static double ScanValueAtAccumulatedOccurence(vtkKWHistogram *hist, 
+                                              double acc, 
+                                              vtkIdType excluded_bin)
+{
+  double *bins = hist->GetBins()->GetPointer(0);
+  vtkIdType nb_of_bins = hist->GetNumberOfBins();
+  double *range = hist->GetRange();
+  double bin_width = (range[1] - range[0]) / (double)nb_of_bins;
+
+  double total = 0.0;
+  for (vtkIdType i = 0; i < nb_of_bins; i++)
+    {
+    if (i == excluded_bin)
+      {
+      continue;
+      }
+    double previous_total = total;
+    total += bins[i];
+    if (total >= acc)
+      {
+      double partial = bins[i] ? (acc - previous_total) / bins[i] : 0.0;
+      return range[0] + bin_width * ((double)i + partial);
+      }
+    }
+
+  return range[1];
+}
+
+int main(int argc, char *argv[])
+{
+  int res = 0;
+
+  // Directory of the histograms cache (removed before and after the test)
+
+  const char *cache_dir = argc > 1 ? argv[1] : "TestHistogramCache";
+
+  vtkKWHistogram *serial = vtkKWHistogram::New();
+  serial->SetNumberOfThreads(1);
+
+  vtkKWHistogram *threaded = vtkKWHistogram::New();
+  threaded->SetNumberOfThreads(4);
+
+  // Integer binning (one bin per value)
+
+  vtkUnsignedShortArray *ushort_array = vtkUnsignedShortArray::New();
+  FillArray(ushort_array, 500000, 2, 4095.0);
+
+  serial->BuildHistogram(ushort_array, 1);
+  threaded->BuildHistogram(ushort_array, 1);
+  res += CompareHistograms(serial, threaded, "unsigned short (build)");
+
+  serial->AccumulateHistogram(ushort_array, 1);
+  threaded->AccumulateHistogram(ushort_array, 1);
+  res += CompareHistograms(serial, threaded, "unsigned short (accumulate)");
+
+  if (serial->GetTotalOccurence() != 2.0 * 500000)
+    {
+    cout << "Error! Total occurence does not match the number of tuples!"
+         << endl;
+    res = 1;
+    }
+
+  // Single pass build, exact for 16 bits scalars and small integer ranges
+
+  vtkKWHistogram *single_pass = vtkKWHistogram::New();
+  single_pass->SinglePassBuildOn();
+
+  serial->BuildHistogram(ushort_array, 0);
+  single_pass->BuildHistogram(ushort_array, 0);
+  res += CompareHistograms(serial, single_pass, "unsigned short (single pass)");
+
+  vtkIntArray *int_array = vtkIntArray::New();
+  FillArray(int_array, 300000, 1, 300.0);
+
+  serial->BuildHistogram(int_array, 0);
+  single_pass->BuildHistogram(int_array, 0);
+  res += CompareHistograms(serial, single_pass, "int (single pass)");
+
+  int_array->Delete();
+  single_pass->Delete();
+
+  // Quantiles: the accumulated occurence at the value found for a given
+  // accumulated occurence should match
+
+  serial->BuildHistogram(ushort_array, 0);
+  double total = serial->GetTotalOccurence();
+  for (int q = 1; q < 10; q++)
+    {
+    double acc = total * (double)q / 10.0;
+    double value = serial->GetValueAtAccumulatedOccurence(acc);
+    double acc2 = serial->GetAccumulatedOccurenceAtValue(value);
+    if (fabs(acc2 - acc) > 1e-6 * total)
+      {
+      cout << "Error! Accumulated occurence " << acc << " gives value " 
+           << value << " which gives accumulated occurence " << acc2 
+           << endl;
+      res = 1;
+      }
+    }
+
+  // Several percentiles at once, with or without an excluded value, should
+  // match the values found one at a time, and by scanning the bins
+
+  vtkDoubleArray *percentiles = vtkDoubleArray::New();
+  vtkDoubleArray *percentile_values = vtkDoubleArray::New();
+  double percentiles_list[] = { 0.0, 0.02, 0.25, 0.5, 0.75, 0.98, 1.0 };
+  int nb_of_percentiles = sizeof(percentiles_list) / sizeof(double);
+  for (int p = 0; p < nb_of_percentiles; p++)
+    {
+    percentiles->InsertNextValue(percentiles_list[p]);
+    }
+  double exclude_value = 
+    floor(serial->GetValueAtAccumulatedOccurence(total * 0.5)) + 0.5;
+  for (int exclude = 0; exclude < 2; exclude++)
+    {
+    double *exclude_ptr = exclude ? &exclude_value : NULL;
+    double excluded_total = total;
+    vtkIdType excluded_bin = -1;
+    if (exclude)
+      {
+      excluded_total -= serial->GetOccurenceAtValue(exclude_value);
+      excluded_bin = (vtkIdType)(exclude_value - serial->GetRange()[0]);
+      }
+    serial->GetValuesAtPercentiles(
+      percentiles, percentile_values, exclude_ptr);
+    if (percentile_values->GetNumberOfTuples() != nb_of_percentiles)
+      {
+      cout << "Error! Wrong number of values at percentiles!" << endl;
+      res = 1;
+      continue;
+      }
+    for (int p = 0; p < nb_of_percentiles; p++)
+      {
+      double acc = percentiles_list[p] * excluded_total;
+      double value = percentile_values->GetValue(p);
+      double single = serial->GetValueAtAccumulatedOccurence(acc, exclude_ptr);
+      double scan = ScanValueAtAccumulatedOccurence(serial, acc, excluded_bin);
+      if (value != single || fabs(value - scan) > 1e-9)
+        {
+        cout << "Error! Value at percentile " << percentiles_list[p]
+             << (exclude ? " (excluding a bin)" : "") << " is " << value
+             << ", single query gives " << single << ", scan gives " << scan
+             << endl;
+        res = 1;
+        }
+      }
+    }
+  percentiles->Delete();
+  percentile_values->Delete();
+
+  ushort_array->Delete();
+
+  // Floating point binning
+
+  vtkFloatArray *float_array = vtkFloatArray::New();
+  FillArray(float_array, 500000, 1, 1.0);
+
+  serial->BuildHistogram(float_array, 0);
+  threaded->BuildHistogram(float_array, 0);
+  res += CompareHistograms(serial, threaded, "float");
+
+  float_array->Delete();
+
+  // Incremental update of an edited region of an image: subtracting the
+  // region before editing it and accumulating it afterwards should give the
+  // same bins, statistics and image as building the histogram again
+
+  vtkUnsignedShortArray *image_array = vtkUnsignedShortArray::New();
+  FillArray(image_array, 64 * 64 * 8, 1, 4000.0);
+  image_array->SetValue(0, 0);
+  image_array->SetValue(64 * 64 * 8 - 1, 4095);
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(64, 64, 8);
+  image->GetPointData()->SetScalars(image_array);
+
+  vtkKWHistogram::ImageDescriptor hist_desc;
+  hist_desc.SetRange(0.0, 4096.0);
+  hist_desc.SetDimensions(257, 50);
+  hist_desc.DrawBackground = 0;
+
+  serial->BuildHistogram(image_array, 0);
+  serial->GetMaximumOccurence();
+  serial->GetValueAtAccumulatedOccurence(1000.0);
+  serial->GetImage(&hist_desc);
+
+  int edit_extents[2][6] = 
+    { { 10, 12, 5, 6, 2, 2 }, { 10, 30, 5, 20, 2, 4 } };
+  for (int edit = 0; edit < 2; edit++)
+    {
+    int *edit_extent = edit_extents[edit];
+    serial->SubtractHistogram(image, 0, edit_extent);
+    for (int z = edit_extent[4]; z <= edit_extent[5]; z++)
+      {
+      for (int y = edit_extent[2]; y <= edit_extent[3]; y++)
+        {
+        for (int x = edit_extent[0]; x <= edit_extent[1]; x++)
+          {
+          vtkIdType id = x + 64 * (y + 64 * z);
+          image_array->SetValue(
+            id, edit ? 1234 : (image_array->GetValue(id) / 2 + 100));
+          }
+        }
+      }
+    image_array->Modified();
+    serial->AccumulateHistogram(image, 0, edit_extent);
+
+    threaded->BuildHistogram(image_array, 0);
+    res += CompareHistograms(serial, threaded, "image (incremental)");
+
+    vtkImageData *image1 = serial->GetImage(&hist_desc);
+    double max1 = hist_desc.LastMaximumOccurence;
+    vtkImageData *image2 = threaded->GetImage(&hist_desc);
+    double max2 = hist_desc.LastMaximumOccurence;
+    if (serial->GetMaximumOccurence() != threaded->GetMaximumOccurence() ||
+        serial->GetMinimumOccurence() != threaded->GetMinimumOccurence() ||
+        serial->GetTotalOccurence() != threaded->GetTotalOccurence() ||
+        serial->GetAccumulatedOccurenceAtValue(2000.0) != 
+        threaded->GetAccumulatedOccurenceAtValue(2000.0) ||
+        max1 != max2 ||
+        memcmp(image1->GetScalarPointer(), image2->GetScalarPointer(),
+               257 * 50 * 4))
+      {
+      cout << "Error! Incremental update does not match (edit " 
+           << edit << ")!" << endl;
+      res = 1;
+      }
+    }
+
+  // Panning by a whole number of pixels and recoloring reuse the previous
+  // image, the result should match an image computed from scratch
+
+  double pan_color[3] = { 1.0, 0.0, 0.0 };
+  for (int pan = 0; pan < 3; pan++)
+    {
+    if (pan == 2)
+      {
+      hist_desc.SetColor(pan_color);
+      }
+    else
+      {
+      hist_desc.SetRange(hist_desc.Range[0] + (pan ? -48.0 : 80.0),
+                         hist_desc.Range[1] + (pan ? -48.0 : 80.0));
+      }
+    vtkImageData *image1 = serial->GetImage(&hist_desc);
+    vtkKWHistogram *reference = vtkKWHistogram::New();
+    reference->BuildHistogram(image_array, 0);
+    vtkImageData *image2 = reference->GetImage(&hist_desc);
+    if (memcmp(image1->GetScalarPointer(), image2->GetScalarPointer(),
+               257 * 50 * 4))
+      {
+      cout << "Error! Panned or recolored image does not match!" << endl;
+      res = 1;
+      }
+    reference->Delete();
+    }
+
+  // Accumulating the image streamed in pieces, in the Range of the whole
+  // image, should match building the histogram in one shot
+
+  serial->BuildHistogram(image_array, 0);
+  vtkKWHistogram *streamed = vtkKWHistogram::New();
+  streamed->SetRange(serial->GetRange());
+  streamed->EmptyHistogram();
+  if (!streamed->AccumulateHistogramFromStreamedImage(
+        image->GetProducerPort(), 0, 5))
+    {
+    cout << "Error! Streamed accumulation failed!" << endl;
+    res = 1;
+    }
+  res += CompareHistograms(serial, streamed, "image (streamed)");
+  if (streamed->GetTotalOccurence() != 64 * 64 * 8)
+    {
+    cout << "Error! Streamed accumulation missed some pieces!" << endl;
+    res = 1;
+    }
+  streamed->Delete();
+
+  image->Delete();
+  image_array->Delete();
+
+  // Batch build of all the components at once (skipping the third one), 
+  // should match building each component on its own
+
+  vtkKWHistogramSet *hist_set = vtkKWHistogramSet::New();
+  hist_set->SetNumberOfThreads(4);
+
+  vtkFloatArray *multi_array = vtkFloatArray::New();
+  multi_array->SetName("multi");
+  FillArray(multi_array, 300000, 6, 100.0);
+
+  hist_set->AddHistograms(multi_array, NULL, 1 << 2);
+  if (hist_set->GetNumberOfHistograms() != 5)
+    {
+    cout << "Error! Batch build did not skip the masked component!" << endl;
+    res = 1;
+    }
+
+  char hist_name[1024];
+  for (int comp = 0; comp < 6; comp++)
+    {
+    vtkKWHistogramSet::ComputeHistogramName("multi", comp, NULL, hist_name);
+    vtkKWHistogram *batch = hist_set->GetHistogramWithName(hist_name);
+    if (!batch != (comp == 2))
+      {
+      cout << "Error! Batch build gave the wrong histogram for component "
+           << comp << endl;
+      res = 1;
+      }
+    else if (batch)
+      {
+      serial->BuildHistogram(multi_array, comp);
+      res += CompareHistograms(serial, batch, "float (batch)");
+      }
+    }
+
+  // Histograms cached on disk: a second set should load the same
+  // histograms from the cache instead of building them
+
+  vtksys::SystemTools::RemoveADirectory(cache_dir);
+
+  vtkKWHistogramSet *cached_set = vtkKWHistogramSet::New();
+  cached_set->SetCacheDirectory(cache_dir);
+  cached_set->AddHistograms(multi_array);
+
+  vtksys_stl::string cache_file(cache_dir);
+  cache_file += "/";
+  cache_file += cached_set->GetArrayFingerprint(multi_array);
+  cache_file += ".kwh";
+  if (!vtksys::SystemTools::FileExists(cache_file.c_str()) ||
+      vtksys::SystemTools::FileExists((cache_file + ".tmp").c_str()))
+    {
+    cout << "Error! Cache file was not written and renamed!" << endl;
+    res = 1;
+    }
+
+  vtkKWHistogramSet *loaded_set = vtkKWHistogramSet::New();
+  loaded_set->SetCacheDirectory(cache_dir);
+  loaded_set->AddHistograms(multi_array);
+
+  if (loaded_set->GetNumberOfHistograms() != 6)
+    {
+    cout << "Error! Cached histograms were not all loaded!" << endl;
+    res = 1;
+    }
+  for (int comp = 0; comp < loaded_set->GetNumberOfHistograms(); comp++)
+    {
+    vtkKWHistogram *loaded = loaded_set->GetNthHistogram(comp);
+    serial->BuildHistogram(multi_array, comp);
+    res += CompareHistograms(serial, loaded, "float (cache)");
+    if (loaded->GetTotalOccurence() != serial->GetTotalOccurence() ||
+        loaded->GetMaximumOccurence() != serial->GetMaximumOccurence())
+      {
+      cout << "Error! Cached histogram statistics do not match!" << endl;
+      res = 1;
+      }
+    }
+
+  // Histograms built with another MaximumNumberOfBins should be rebuilt,
+  // not loaded from the cache
+
+  vtkKWHistogramSet *rebuilt_set = vtkKWHistogramSet::New();
+  rebuilt_set->SetCacheDirectory(cache_dir);
+  vtkKWHistogramSet::ComputeHistogramName("multi", 0, NULL, hist_name);
+  vtkKWHistogram *rebuilt = rebuilt_set->AllocateAndAddHistogram(hist_name);
+  rebuilt->SetMaximumNumberOfBins(100);
+  rebuilt_set->AddHistograms(multi_array);
+
+  vtkIdType max_nb_of_bins = serial->GetMaximumNumberOfBins();
+  serial->SetMaximumNumberOfBins(100);
+  serial->BuildHistogram(multi_array, 0);
+  res += CompareHistograms(serial, rebuilt, "float (cache, 100 bins)");
+  serial->SetMaximumNumberOfBins(max_nb_of_bins);
+
+  // A sampled fingerprint misses an edit in between two samples, a
+  // fingerprint of all the values does not
+
+  char fingerprint1[64], fingerprint2[64];
+  char full_fingerprint1[64], full_fingerprint2[64];
+  vtkKWHistogramSet::ComputeArrayFingerprint(multi_array, fingerprint1);
+  vtkKWHistogramSet::ComputeArrayFingerprint(
+    multi_array, full_fingerprint1, 1);
+  float edited_value = multi_array->GetValue(6);
+  multi_array->SetValue(6, edited_value + 1.0f);
+  vtkKWHistogramSet::ComputeArrayFingerprint(multi_array, fingerprint2);
+  vtkKWHistogramSet::ComputeArrayFingerprint(
+    multi_array, full_fingerprint2, 1);
+  multi_array->SetValue(6, edited_value);
+  if (strcmp(fingerprint1, fingerprint2) ||
+      !strcmp(full_fingerprint1, full_fingerprint2) ||
+      !strcmp(fingerprint1, full_fingerprint1))
+    {
+    cout << "Error! Array fingerprints do not match the edits!" << endl;
+    res = 1;
+    }
+
+  // A corrupted stream announcing more bins than the MaximumNumberOfBins,
+  // or than the stream holds, should be rejected (before allocating them)
+
+  serial->BuildHistogram(multi_array, 0);
+  vtksys_ios::ostringstream hist_stream;
+  serial->SaveToStream(hist_stream);
+  vtkKWHistogram *corrupted = vtkKWHistogram::New();
+  corrupted->SetMaximumNumberOfBins(1 << 30);
+  vtkTypeInt64 corrupted_nb_of_bins[2] = 
+    { (vtkTypeInt64)1 << 40, serial->GetNumberOfBins() + 1 };
+  for (int corruption = 0; corruption < 2; corruption++)
+    {
+    vtksys_stl::string buffer = hist_stream.str();
+    memcpy(&buffer[sizeof(vtkTypeUInt32) + 2 * sizeof(double)],
+           &corrupted_nb_of_bins[corruption], sizeof(vtkTypeInt64));
+    vtksys_ios::istringstream corrupted_stream(buffer);
+    if (corrupted->LoadFromStream(corrupted_stream) ||
+        corrupted->GetNumberOfBins())
+      {
+      cout << "Error! Corrupted histogram stream was loaded!" << endl;
+      res = 1;
+      }
+    }
+  corrupted->Delete();
+
+  cached_set->Delete();
+  loaded_set->Delete();
+  rebuilt_set->Delete();
+
+  vtksys::SystemTools::RemoveADirectory(cache_dir);
+
+  // Joint histogram of two components, registered in the set: the bins
+  // should not depend on the number of threads
+
+  vtkKWHistogram2D *joint_serial = vtkKWHistogram2D::New();
+  joint_serial->SetNumberOfThreads(1);
+  joint_serial->BuildHistogram(multi_array, 0, multi_array, 1);
+
+  vtkKWHistogramSet::ComputeHistogram2DName(
+    "multi", 0, "multi", 1, NULL, hist_name);
+  vtkKWHistogram2D *joint = hist_set->AllocateAndAddHistogram2D(hist_name);
+  joint->SetNumberOfThreads(4);
+  joint->BuildHistogram(multi_array, 0, multi_array, 1);
+
+  if (hist_set->GetHistogram2DWithName(hist_name) != joint ||
+      joint->GetNumberOfXBins() != joint_serial->GetNumberOfXBins() ||
+      joint->GetNumberOfYBins() != joint_serial->GetNumberOfYBins() ||
+      joint->GetTotalOccurence() != 300000.0)
+    {
+    cout << "Error! 2D histogram does not match!" << endl;
+    res = 1;
+    }
+  else
+    {
+    double *bins1 = joint->GetBins()->GetPointer(0);
+    double *bins2 = joint_serial->GetBins()->GetPointer(0);
+    vtkIdType nb_of_bins = 
+      joint->GetNumberOfXBins() * joint->GetNumberOfYBins();
+    for (vtkIdType i = 0; i < nb_of_bins; i++)
+      {
+      if (bins1[i] != bins2[i])
+        {
+        cout << "Error! 2D histogram bin " << i << " differs!" << endl;
+        res = 1;
+        break;
+        }
+      }
+    }
+
+  vtkKWHistogram2D::ImageDescriptor desc;
+  desc.SetXRange(joint->GetXRange()[0], joint->GetXRange()[1]);
+  desc.SetYRange(joint->GetYRange()[0], joint->GetYRange()[1]);
+  desc.SetDimensions(100, 50);
+  vtkImageData *joint_image = joint->GetImage(&desc);
+  if (!joint_image || 
+      joint_image->GetDimensions()[0] != 100 ||
+      joint_image->GetDimensions()[1] != 50 ||
+      desc.LastMaximumOccurence != joint->GetMaximumOccurence())
+    {
+    cout << "Error! 2D histogram image is invalid!" << endl;
+    res = 1;
+    }
+
+  // An empty 2D histogram reports no occurence. Accumulating in ranges set
+  // beforehand keeps those ranges, so that two halves of the scalars
+  // accumulate to the same bins as the whole scalars.
+
+  joint_serial->EmptyHistogram();
+  if (joint_serial->GetMinimumOccurence() != 0.0 ||
+      joint_serial->GetMaximumOccurence() != 0.0)
+    {
+    cout << "Error! Empty 2D histogram reports occurences!" << endl;
+    res = 1;
+    }
+
+  vtkFloatArray *half_array = vtkFloatArray::New();
+  half_array->SetNumberOfComponents(6);
+  half_array->SetNumberOfTuples(150000);
+  joint_serial->SetXRange(joint->GetXRange());
+  joint_serial->SetYRange(joint->GetYRange());
+  for (int half = 0; half < 2; half++)
+    {
+    memcpy(half_array->GetPointer(0),
+           multi_array->GetPointer(half * 150000 * 6),
+           150000 * 6 * sizeof(float));
+    joint_serial->AccumulateHistogram(half_array, 0, half_array, 1);
+    }
+  if (joint_serial->GetXRange()[0] != joint->GetXRange()[0] ||
+      joint_serial->GetYRange()[1] != joint->GetYRange()[1] ||
+      joint_serial->GetTotalOccurence() != 300000.0)
+    {
+    cout << "Error! 2D histogram accumulated in set ranges is invalid!"
+         << endl;
+    res = 1;
+    }
+  half_array->Delete();
+
+  joint_serial->Delete();
+
+  multi_array->Delete();
+  hist_set->Delete();
+
+  serial->Delete();
+  threaded->Delete();
+
+  return res ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+#include "vtkKWApplication.h"
+#include "vtkKWObject.h"
+#include "vtkKWTkUtilities.h"
+#include "vtkKWTopLevel.h"
+#include "vtkOutputWindow.h"
+#include "vtkTcl.h"
+
+#include <vtksys/ios/sstream>
+#include <vtksys/stl/string>
+
+// Collect the errors instead of displaying them
+
+class TestScriptBatchOutputWindow : public vtkOutputWindow
+{
+public:
+  static TestScriptBatchOutputWindow* New()
+    { return new TestScriptBatchOutputWindow; }
+  virtual void DisplayText(const char *text)
+    { this->Text += text; }
+  vtksys_stl::string Text;
+};
+
+// A frame created with the options 'Options' (they may be invalid)
+
+class TestScriptBatchWidget : public vtkKWWidget
+{
+public:
+  static TestScriptBatchWidget* New()
+    { return new TestScriptBatchWidget; }
+  const char *Options;
+protected:
+  TestScriptBatchWidget()
+    { this->Options = NULL; }
+  virtual void CreateWidget()
+    { vtkKWWidget::CreateSpecificTkWidget(this, "frame", this->Options); }
+};
+
+// Check that a global variable matches the expected value (NULL if the
+// variable should not exist)
+
+static int CheckVar(Tcl_Interp *interp, const char *test,
+                    const char *name, const char *expected)
+{
+  const char *value = Tcl_GetVar(interp, name, TCL_GLOBAL_ONLY);
+  if ((!value && expected) || (value && !expected) ||
+      (value && expected && strcmp(value, expected)))
+    {
+    cout << "Error! " << test << ": " << name << " is ["
+         << (value ? value : "(unset)") << "], expected ["
+         << (expected ? expected : "(unset)") << "]" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+// Check that an error containing 'message' was reported on 'obj'
+
+static int CheckError(TestScriptBatchOutputWindow *output,
+                      const char *test, vtkObject *obj, const char *message)
+{
+  vtksys_ios::ostringstream location;
+  location << obj->GetClassName() << " (" << obj << ")";
+  vtksys_stl::string::size_type pos = output->Text.find(location.str());
+  if (pos == vtksys_stl::string::npos ||
+      output->Text.find(message, pos) == vtksys_stl::string::npos)
+    {
+    cout << "Error! " << test << ": [" << message << "] was not reported on "
+         << location.str() << ", got:" << endl << output->Text << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize Tcl
+
+  Tcl_Interp *interp = vtkKWApplication::InitializeTcl(argc, argv, &cerr);
+  if (!interp)
+    {
+    cerr << "Error: InitializeTcl failed" << endl ;
+    return 1;
+    }
+
+  vtkKWApplication *app = vtkKWApplication::New();
+  app->SetName("KWWidgetsTestScriptBatch");
+  app->SetRegistryLevel(0);
+  app->PromptBeforeExitOff();
+
+  TestScriptBatchOutputWindow *output = TestScriptBatchOutputWindow::New();
+  vtkOutputWindow::SetInstance(output);
+
+  vtkKWObject *obj1 = vtkKWObject::New();
+  obj1->SetApplication(app);
+
+  vtkKWObject *obj2 = vtkKWObject::New();
+  obj2->SetApplication(app);
+
+  int res = 0;
+
+  // Queued scripts are evaluated in order, when the batch ends, verbatim
+
+  app->BeginScriptBatch();
+  obj1->QueueScript("set ::order {}");
+  obj1->QueueScript("lappend ::order 1");
+  obj2->QueueScript("lappend ::order 2");
+  obj1->QueueScript("set ::verbatim {a {b} $c [d]}");
+  res += CheckVar(interp, "order (queued)", "::order", NULL);
+  app->EndScriptBatch();
+  res += CheckVar(interp, "order", "::order", "1 2");
+  res += CheckVar(interp, "verbatim", "::verbatim", "a {b} $c [d]");
+
+  // Calls that return a result flush the batch first
+
+  app->BeginScriptBatch();
+  obj1->QueueScript("set ::value 1");
+  const char *result = obj1->Script("set ::value");
+  if (!result || strcmp(result, "1"))
+    {
+    cout << "Error! Script did not flush the batch, got ["
+         << (result ? result : "(null)") << "]" << endl;
+    res++;
+    }
+  obj1->QueueScript("set ::value 2");
+  vtkKWTkCommandArguments args;
+  args.AddString("::value");
+  result = vtkKWTkUtilities::EvaluateCommand(app, obj1, "set", NULL, &args);
+  if (!result || strcmp(result, "2"))
+    {
+    cout << "Error! EvaluateCommand did not flush the batch, got ["
+         << (result ? result : "(null)") << "]" << endl;
+    res++;
+    }
+  app->EndScriptBatch();
+
+  // Nested batches are only evaluated when the outermost one ends
+
+  app->BeginScriptBatch();
+  app->BeginScriptBatch();
+  obj1->QueueScript("set ::nested 1");
+  app->EndScriptBatch();
+  res += CheckVar(interp, "nested (inner end)", "::nested", NULL);
+  if (app->GetScriptBatchDepth() != 1)
+    {
+    cout << "Error! batch depth is " << app->GetScriptBatchDepth()
+         << ", expected 1" << endl;
+    res++;
+    }
+  app->EndScriptBatch();
+  res += CheckVar(interp, "nested", "::nested", "1");
+
+  // Errors are reported on the object that queued the script, and do not
+  // stop the rest of the batch. One of the scripts flushes a batch of its
+  // own while the first one is being evaluated: both errors are reported.
+
+  vtksys_ios::ostringstream inner;
+  inner << app->GetTclName() << " BeginScriptBatch; "
+        << app->GetTclName() << " AddScriptToBatch "
+        << obj2->GetTclName() << " {error inner_error}; "
+        << app->GetTclName() << " EndScriptBatch";
+
+  output->Text = "";
+  app->BeginScriptBatch();
+  obj1->QueueScript("error outer_error");
+  obj1->QueueScript("%s", inner.str().c_str());
+  obj1->QueueScript("set ::after_errors 1");
+  app->EndScriptBatch();
+  res += CheckError(output, "outer error", obj1, "outer_error");
+  res += CheckError(output, "inner error", obj2, "inner_error");
+  res += CheckVar(interp, "after errors", "::after_errors", "1");
+
+  // A widget whose creation was queued is not considered created anymore
+  // if its creation fails
+
+  vtkKWTopLevel *toplevel = vtkKWTopLevel::New();
+  toplevel->SetApplication(app);
+  toplevel->Create();
+
+  TestScriptBatchWidget *good = TestScriptBatchWidget::New();
+  good->SetParent(toplevel);
+
+  TestScriptBatchWidget *bad = TestScriptBatchWidget::New();
+  bad->SetParent(toplevel);
+  bad->Options = "-no_such_option 1";
+
+  output->Text = "";
+  app->BeginScriptBatch();
+  good->Create();
+  bad->Create();
+  app->EndScriptBatch();
+  if (!good->IsCreated() || !good->IsAlive())
+    {
+    cout << "Error! the widget created in a batch is not created" << endl;
+    res++;
+    }
+  if (bad->IsCreated())
+    {
+    cout << "Error! the widget that failed to be created in a batch is "
+         << "still created" << endl;
+    res++;
+    }
+  res += CheckError(output, "widget creation", bad, "no_such_option");
+
+  // Deallocate and exit
+
+  good->Delete();
+  bad->Delete();
+  toplevel->Delete();
+
+  obj1->Delete();
+  obj2->Delete();
+  app->Delete();
+
+  vtkOutputWindow::SetInstance(NULL);
+  output->Delete();
+
+  return res ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+#include "vtkKWApplication.h"
+#include "vtkKWFrame.h"
+#include "vtkKWTclProfiler.h"
+#include "vtkKWTopLevel.h"
+
+#include <vtksys/stl/string>
+
+// Return 1 if the event of the widget has no bindings left
+
+static int HasNoBindings(vtkKWApplication *app, vtkKWWidget *widget,
+                         const char *event)
+{
+  vtksys_stl::string bindings(
+    app->Script("string trim [bind %s %s]", widget->GetWidgetName(), event));
+  return bindings.empty();
+}
+
+// Add a binding with the profiler 'enabled_at_add', remove it with the
+// profiler 'enabled_at_remove', and check that nothing is left behind
+
+static int TestBinding(vtkKWApplication *app,
+                       vtkKWWidget *widget,
+                       vtkObject *object,
+                       int enabled_at_add,
+                       int enabled_at_remove)
+{
+  const char *event = "<<TclProfilerTest>>";
+  vtkKWTclProfiler *profiler = app->GetTclProfiler();
+
+  profiler->SetEnabled(enabled_at_add);
+  widget->AddBinding(event, object, "Modified");
+  if (HasNoBindings(app, widget, event))
+    {
+    cout << "AddBinding (profiler " << enabled_at_add << ") failed" << endl;
+    return 1;
+    }
+
+  profiler->SetEnabled(enabled_at_remove);
+  widget->RemoveBinding(event, object, "Modified");
+  if (!HasNoBindings(app, widget, event))
+    {
+    cout << "RemoveBinding (profiler " << enabled_at_add << " then "
+         << enabled_at_remove << ") left: "
+         << app->Script("bind %s %s", widget->GetWidgetName(), event)
+         << endl;
+    return 1;
+    }
+
+  profiler->SetEnabled(0);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize Tcl
+
+  Tcl_Interp *interp = vtkKWApplication::InitializeTcl(argc, argv, &cerr);
+  if (!interp)
+    {
+    cerr << "Error: InitializeTcl failed" << endl ;
+    return 1;
+    }
+
+  vtkKWApplication *app = vtkKWApplication::New();
+  app->SetName("KWWidgetsTestTclProfiler");
+  app->SetRegistryLevel(0);
+  app->PromptBeforeExitOff();
+
+  vtkKWTopLevel *toplevel = vtkKWTopLevel::New();
+  toplevel->SetApplication(app);
+  toplevel->Create();
+
+  vtkKWFrame *frame = vtkKWFrame::New();
+  frame->SetParent(toplevel);
+  frame->Create();
+
+  vtkKWFrame *target = vtkKWFrame::New();
+  target->SetParent(toplevel);
+  target->Create();
+
+  int res = 0;
+
+  // The callbacks are the same whether the profiler is enabled or not
+
+  res += TestBinding(app, frame, target, 1, 0);
+  res += TestBinding(app, frame, target, 0, 1);
+  res += TestBinding(app, frame, target, 1, 1);
+  res += TestBinding(app, frame, target, 0, 0);
+
+  // The methods invoked by the callbacks created while the profiler is
+  // enabled are profiled, until it is disabled
+
+  const char *event = "<<TclProfilerTest>>";
+  vtkKWTclProfiler *profiler = app->GetTclProfiler();
+  profiler->Reset();
+  profiler->EnabledOn();
+  frame->AddBinding(event, target, "Modified");
+  app->Script("eval [bind %s %s]", frame->GetWidgetName(), event);
+
+  int i, found = 0;
+  for (i = 0; i < profiler->GetNumberOfCallSites(); i++)
+    {
+    if (!strcmp(profiler->GetNthCallSiteClassName(i),
+                target->GetClassName()) &&
+        !strcmp(profiler->GetNthCallSiteName(i), "Modified"))
+      {
+      found = 1;
+      }
+    }
+  if (!found)
+    {
+    cout << "Callback method was not profiled" << endl;
+    res++;
+    }
+
+  profiler->EnabledOff();
+  app->Script("eval [bind %s %s]", frame->GetWidgetName(), event);
+  frame->RemoveBinding(event, target, "Modified");
+
+  // So are the methods invoked by the callbacks created before the
+  // profiler was enabled
+
+  frame->AddBinding(event, target, "Modified");
+  profiler->Reset();
+  profiler->EnabledOn();
+  app->Script("eval [bind %s %s]", frame->GetWidgetName(), event);
+
+  found = 0;
+  for (i = 0; i < profiler->GetNumberOfCallSites(); i++)
+    {
+    if (!strcmp(profiler->GetNthCallSiteClassName(i),
+                target->GetClassName()) &&
+        !strcmp(profiler->GetNthCallSiteName(i), "Modified"))
+      {
+      found = 1;
+      }
+    }
+  if (!found)
+    {
+    cout << "Callback method created before enabling was not profiled"
+         << endl;
+    res++;
+    }
+
+  profiler->EnabledOff();
+  frame->RemoveBinding(event, target, "Modified");
+
+  // Deallocate and exit
+
+  target->Delete();
+  frame->Delete();
+  toplevel->Delete();
+  app->Delete();
+
+  return res;
+}
@@ -47,12 +47,14 @@
 #include "vtkKWSeparator.h"
 #include "vtkKWSplashScreen.h"
 #include "vtkKWTclInteractor.h"
+#include "vtkKWTclProfiler.h"
 #include "vtkKWText.h"
 #include "vtkKWTextWithScrollbars.h"
 #include "vtkKWTheme.h"
 #include "vtkKWTkUtilities.h"
 #include "vtkKWTkcon.h"
 #include "vtkKWToolbar.h"
+#include "vtkKWWidget.h"
 #include "vtkKWWindowBase.h"
 
 #include <stdarg.h>
@@ -235,8 +237,30 @@ public:
 
   vtkOutputWindow *PreviousOutputWindow;
   vtkKWOutputWindow *LogOutputWindow;
+
+  // Script batch
+
+  class ScriptBatchEntry
+  {
+  public:
+    vtkObject *Object;
+    vtksys_stl::string Script;
+    int CreatesWidget;
+  };
+
+  typedef vtksys_stl::vector<ScriptBatchEntry> ScriptBatchContainer;
+  typedef vtksys_stl::vector<ScriptBatchEntry>::iterator ScriptBatchContainerIterator;
+
+  ScriptBatchContainer ScriptBatch;
+  int ScriptBatchDepth;
+  int ScriptBatchFlushLevel;
 };
 
+// Name of the interpreter's associated data pointing to the application
+// that has scripts waiting in a batch (see vtkKWTkUtilities)
+
+#define VTK_KW_SCRIPT_BATCH_ASSOC_DATA "vtkKWApplicationScriptBatch"
+
 vtkStandardNewMacro(vtkKWOutputWindow);
 
 //----------------------------------------------------------------------------
@@ -276,6 +300,7 @@ vtkKWApplication::vtkKWApplication()
   this->OptionDataBase            = NULL;
   this->RegistryLevel             = 10;
   this->BalloonHelpManager        = NULL;
+  this->TclProfiler               = NULL;
   this->CharacterEncoding         = VTK_ENCODING_UNKNOWN;
   this->AboutDialog               = NULL;
   this->AboutDialogImage          = NULL;
@@ -311,6 +336,8 @@ vtkKWApplication::vtkKWApplication()
   // Instantiate the PIMPL Encapsulation for STL containers
 
   this->Internals = new vtkKWApplicationInternals;
+  this->Internals->ScriptBatchDepth = 0;
+  this->Internals->ScriptBatchFlushLevel = 0;
 
   // Output win
 
@@ -372,6 +399,25 @@ vtkKWApplication::~vtkKWApplication()
 {
   this->PrepareForDelete();
 
+  // Discard the scripts that may still be waiting in a batch
+
+  if (this->Internals && this->Internals->ScriptBatch.size())
+    {
+    Tcl_DeleteAssocData(
+      this->GetMainInterp(), VTK_KW_SCRIPT_BATCH_ASSOC_DATA);
+    vtkKWApplicationInternals::ScriptBatchContainerIterator it = 
+      this->Internals->ScriptBatch.begin();
+    vtkKWApplicationInternals::ScriptBatchContainerIterator end = 
+      this->Internals->ScriptBatch.end();
+    for (; it != end; ++it)
+      {
+      if ((*it).Object)
+        {
+        (*it).Object->UnRegister(this);
+        }
+      }
+    }
+
   delete this->Internals;
   this->Internals = NULL;
 
@@ -460,6 +506,12 @@ void vtkKWApplication::PrepareForDelete()
     this->BalloonHelpManager = NULL;
     }
 
+  if (this->TclProfiler)
+    {
+    this->TclProfiler->Delete();
+    this->TclProfiler = NULL;
+    }
+
   if (this->GetMainInterp())
     {
     vtkKWTkUtilities::CancelAllTimerHandlers(this->GetMainInterp());
@@ -1679,8 +1731,8 @@ void vtkKWApplication::ConfigureAboutDialog()
         this->AboutDialogImage->Create();
         }
       this->AboutDialogImage->SetConfigurationOption("-image", img_name);
-      this->Script("pack %s -side top", 
-                   this->AboutDialogImage->GetWidgetName());
+      this->QueueScript("pack %s -side top", 
+                        this->AboutDialogImage->GetWidgetName());
       int w = vtkKWTkUtilities::GetPhotoWidth(this->GetMainInterp(), img_name);
       int h = vtkKWTkUtilities::GetPhotoHeight(this->GetMainInterp(), img_name);
       this->AboutDialog->GetTopFrame()->SetWidth(w);
@@ -1689,7 +1741,7 @@ void vtkKWApplication::ConfigureAboutDialog()
         {
         this->AboutDialog->SetTextWidth(w);
         }
-      this->Script(
+      this->QueueScript(
         "pack %s -side bottom",  // -expand 1 -fill both
         this->AboutDialog->GetMessageDialogFrame()->GetWidgetName());
       }
@@ -1716,8 +1768,8 @@ void vtkKWApplication::ConfigureAboutDialog()
     vtkKWFrame *parent = vtkKWFrame::SafeDownCast(text->GetParent());
     parent->GetBackgroundColor(&r, &g, &b);
     text->SetBackgroundColor(r, g, b);
-    this->Script("pack %s -side top -padx 2 -expand 1 -fill both",
-                 this->AboutRuntimeInfo->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 2 -expand 1 -fill both",
+                      this->AboutRuntimeInfo->GetWidgetName());
     }
 
   char buffer[500];
@@ -1908,6 +1960,17 @@ vtkKWBalloonHelpManager *vtkKWApplication::GetBalloonHelpManager()
   return this->BalloonHelpManager;
 }
 
+//----------------------------------------------------------------------------
+vtkKWTclProfiler *vtkKWApplication::GetTclProfiler()
+{
+  if (!this->TclProfiler && !this->InExit)
+    {
+    this->TclProfiler = vtkKWTclProfiler::New();
+    this->TclProfiler->SetApplication(this);
+    }
+  return this->TclProfiler;
+}
+
 //----------------------------------------------------------------------------
 vtkKWRegistryHelper *vtkKWApplication::GetRegistryHelper()
 {
@@ -2705,8 +2768,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
   sep->Create();
   sep->Delete();
 
-  this->Script("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
-               sep->GetWidgetName());
+  this->QueueScript("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
+                    sep->GetWidgetName());
 
   int label_width = 14;
 
@@ -2721,8 +2784,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     to_entry->GetWidget()->ReadOnlyOn();
     to_entry->Delete();
 
-    this->Script("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
-                 to_entry->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
+                      to_entry->GetWidgetName());
     }
 
   if (subject)
@@ -2736,8 +2799,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     subject_entry->GetWidget()->ReadOnlyOn();
     subject_entry->Delete();
 
-    this->Script("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
-                 subject_entry->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 2 -pady 2 -expand 1 -fill x",
+                      subject_entry->GetWidgetName());
     }
 
   if (attachment_filename)
@@ -2747,8 +2810,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     attachment_frame->Create();
     attachment_frame->Delete();
 
-    this->Script("pack %s -side top -padx 0 -pady 0 -expand 1 -fill x",
-                 attachment_frame->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 0 -pady 0 -expand 1 -fill x",
+                      attachment_frame->GetWidgetName());
 
     vtkKWEntryWithLabel *attachment_entry = vtkKWEntryWithLabel::New();
     attachment_entry->SetParent(attachment_frame);
@@ -2761,8 +2824,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     attachment_entry->GetWidget()->ReadOnlyOn();
     attachment_entry->Delete();
   
-    this->Script("pack %s -side left -padx 2 -pady 2 -expand 1 -fill x",
-                 attachment_entry->GetWidgetName());
+    this->QueueScript("pack %s -side left -padx 2 -pady 2 -expand 1 -fill x",
+                      attachment_entry->GetWidgetName());
 
     vtkKWPushButton *attachment_locate_button = vtkKWPushButton::New();
     attachment_locate_button->SetParent(attachment_frame);
@@ -2776,8 +2839,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     attachment_locate_button->SetCommand(this, command.c_str());
     attachment_locate_button->Delete();
   
-    this->Script("pack %s -side left -padx 2 -pady 2 -expand 0 -fill none",
-                 attachment_locate_button->GetWidgetName());
+    this->QueueScript("pack %s -side left -padx 2 -pady 2 -expand 0 -fill none",
+                      attachment_locate_button->GetWidgetName());
     }
 
   if (message)
@@ -2795,8 +2858,8 @@ void vtkKWApplication::CreateEmailMessageDialog(
     text_widget->SetText(message ? message : "");
     message_text->Delete();
 
-    this->Script("pack %s -side top -padx 2 -pady 2 -expand 1 -fill both",
-                 message_text->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 2 -pady 2 -expand 1 -fill both",
+                      message_text->GetWidgetName());
     }
 
 }
@@ -3051,6 +3114,212 @@ int vtkKWApplication::EvaluateBooleanExpression(const char* format, ...)
   return (result && !strcmp(result, "1")) ? 1 : 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkKWApplication::BeginScriptBatch()
+{
+  if (this->Internals)
+    {
+    this->Internals->ScriptBatchDepth++;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWApplication::EndScriptBatch()
+{
+  if (!this->Internals || this->Internals->ScriptBatchDepth <= 0)
+    {
+    return;
+    }
+
+  if (--this->Internals->ScriptBatchDepth == 0)
+    {
+    this->FlushScriptBatch();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkKWApplication::GetScriptBatchDepth()
+{
+  return this->Internals ? this->Internals->ScriptBatchDepth : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWApplication::AddScriptToBatch(vtkObject *obj, const char *script)
+{
+  if (!this->Internals || this->Internals->ScriptBatchDepth <= 0 || !script)
+    {
+    return 0;
+    }
+
+  // Let vtkKWTkUtilities know that this batch has to be flushed before
+  // evaluating anything else
+
+  if (!this->Internals->ScriptBatch.size())
+    {
+    Tcl_SetAssocData(
+      this->GetMainInterp(), VTK_KW_SCRIPT_BATCH_ASSOC_DATA, NULL, this);
+    }
+
+  vtkKWApplicationInternals::ScriptBatchEntry entry;
+  entry.Object = obj;
+  entry.Script = script;
+  entry.CreatesWidget = 0;
+  this->Internals->ScriptBatch.push_back(entry);
+  if (obj)
+    {
+    obj->Register(this);
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWApplication::AddWidgetCreationToBatch(vtkKWWidget *widget, 
+                                               const char *script)
+{
+  if (!widget || !this->AddScriptToBatch(widget, script))
+    {
+    return 0;
+    }
+
+  this->Internals->ScriptBatch.back().CreatesWidget = 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWApplication::FlushPendingScriptBatch(Tcl_Interp *interp)
+{
+  vtkKWApplication *app = interp ? static_cast<vtkKWApplication*>(
+    Tcl_GetAssocData(interp, VTK_KW_SCRIPT_BATCH_ASSOC_DATA, NULL)) : NULL;
+  if (app)
+    {
+    app->FlushScriptBatch();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWApplication::FlushScriptBatch()
+{
+  if (!this->Internals || !this->Internals->ScriptBatch.size())
+    {
+    return;
+    }
+
+  // Take the scripts out of the queue first, they may trigger callbacks
+  // that evaluate (or queue) scripts themselves
+
+  Tcl_Interp *interp = this->GetMainInterp();
+  Tcl_DeleteAssocData(interp, VTK_KW_SCRIPT_BATCH_ASSOC_DATA);
+
+  vtkKWApplicationInternals::ScriptBatchContainer batch;
+  batch.swap(this->Internals->ScriptBatch);
+
+  // Evaluate all the scripts at once, each one being caught separately. 
+  // The scripts are quoted as list elements, so that each one is passed 
+  // verbatim to 'catch'. The errors are collected in a list returned as
+  // the result. A queued script may trigger a callback that flushes a
+  // batch too, hence a different variable at each flush level.
+
+  int flush_level = this->Internals->ScriptBatchFlushLevel++;
+  char errors_var[64], error_var[64];
+  sprintf(errors_var, "::vtkKWScriptBatchErrors%d", flush_level);
+  sprintf(error_var, "::vtkKWScriptBatchError%d", flush_level);
+
+  vtksys_ios::ostringstream tk_cmd;
+  tk_cmd << "set " << errors_var << " {}" << endl;
+
+  int nb_scripts = (int)batch.size(), i;
+  vtksys_stl::vector<char> element;
+  for (i = 0; i < nb_scripts; i++)
+    {
+    const char *script = batch[i].Script.c_str();
+    int flags;
+    element.resize(Tcl_ScanElement(script, &flags) + 1);
+    element.resize(Tcl_ConvertElement(script, &element[0], flags));
+    element.push_back('\0');
+    tk_cmd << "if {[catch " << &element[0] << " " << error_var << "]} "
+           << "{lappend " << errors_var << " " << i 
+           << " $" << error_var << " $::errorInfo}" << endl;
+    }
+  tk_cmd << "set " << errors_var << endl;
+
+  vtkKWTclProfiler *profiler = vtkKWTclProfiler::GetEnabledProfiler(interp);
+  double start = profiler ? profiler->BeginEvaluation() : 0.0;
+
+  int res = Tcl_GlobalEval(interp, tk_cmd.str().c_str());
+
+  if (profiler && profiler == vtkKWTclProfiler::GetEnabledProfiler(interp))
+    {
+    profiler->EndEvaluation(
+      start, this->GetClassName(), "(script batch)", tk_cmd.str().c_str());
+    }
+
+  Tcl_Obj *errors = NULL;
+  if (res != TCL_OK)
+    {
+    vtkErrorMacro("Failed to evaluate script batch: " 
+                  << Tcl_GetStringResult(interp));
+    }
+  else
+    {
+    errors = Tcl_GetObjResult(interp);
+    Tcl_IncrRefCount(errors);
+    }
+
+  Tcl_UnsetVar(interp, errors_var, TCL_GLOBAL_ONLY);
+  Tcl_UnsetVar(interp, error_var, TCL_GLOBAL_ONLY);
+  this->Internals->ScriptBatchFlushLevel--;
+
+  // Report the errors on the objects that queued the scripts
+
+  int nb_errors_elems = 0;
+  Tcl_Obj **errors_elems = NULL;
+  if (errors && 
+      Tcl_ListObjGetElements(
+        interp, errors, &nb_errors_elems, &errors_elems) == TCL_OK)
+    {
+    for (i = 0; i + 2 < nb_errors_elems; i += 3)
+      {
+      int index = -1;
+      if (Tcl_GetIntFromObj(interp, errors_elems[i], &index) != TCL_OK ||
+          index < 0 || index >= nb_scripts)
+        {
+        continue;
+        }
+      vtkObject *obj = batch[index].Object ? batch[index].Object : this;
+      vtkErrorWithObjectMacro(
+        obj, "\n    Script: \n" << batch[index].Script.c_str()
+        << "\n    Returned Error: \n"
+        << Tcl_GetString(errors_elems[i + 1]) << "\nStack trace: \n"
+        << Tcl_GetString(errors_elems[i + 2]) << endl);
+
+      // The widget was assumed to be created when its creation was queued
+
+      if (batch[index].CreatesWidget)
+        {
+        vtkKWWidget *widget = vtkKWWidget::SafeDownCast(batch[index].Object);
+        if (widget)
+          {
+          widget->TkWidgetCreationFailed();
+          }
+        }
+      }
+    }
+
+  if (errors)
+    {
+    Tcl_DecrRefCount(errors);
+    }
+
+  for (i = 0; i < nb_scripts; i++)
+    {
+    if (batch[i].Object)
+      {
+      batch[i].Object->UnRegister(this);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkKWApplication::PutEnv(const char* value)
 { 
@@ -3266,6 +3535,14 @@ void vtkKWApplication::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "BalloonHelpManager: (none)" << endl;
     }
+  if (this->TclProfiler)
+    {
+    os << indent << "TclProfiler: " << this->TclProfiler << endl;
+    }
+  else
+    {
+    os << indent << "TclProfiler: (none)" << endl;
+    }
   os << indent << "SupportSplashScreen: " << (this->SupportSplashScreen ? "on":"off") << endl;
   os << indent << "SplashScreenVisibility: " << (this->SplashScreenVisibility ? "on":"off") << endl;
   os << indent << "PromptBeforeExit: " << (this->GetPromptBeforeExit() ? "on":"off") << endl;
@@ -35,6 +35,7 @@ class vtkKWOptionDataBase;
 class vtkKWRegistryHelper;
 class vtkKWSplashScreen;
 class vtkKWTclInteractor;
+class vtkKWTclProfiler;
 class vtkKWTextWithScrollbars;
 class vtkKWTheme;
 class vtkKWTopLevel;
@@ -418,6 +419,11 @@ public:
   // Return the Balloon Help helper object. 
   virtual vtkKWBalloonHelpManager *GetBalloonHelpManager();
 
+  // Description:
+  // Return the Tcl profiler, which can be enabled to record the Tcl
+  // evaluations issued by the application and its widgets.
+  virtual vtkKWTclProfiler *GetTclProfiler();
+
   // Description:
   // Return the appplication-wide color picker dialog. Redefine this method
   // in your application sub-class to provide a customized color picker.
@@ -429,6 +435,46 @@ public:
   virtual const char* Script(const char* format, ...);
   int EvaluateBooleanExpression(const char* format, ...);
   //ETX
+
+  // Description:
+  // Begin/End a batch of scripts.
+  // Between these calls, the scripts that do not need a result (see
+  // vtkKWObject::QueueScript) are queued instead of being evaluated one at
+  // a time. The queue is flushed, i.e. evaluated at once, when the
+  // outermost batch ends, or before any other script is evaluated through
+  // vtkKWTkUtilities (for example by vtkKWObject::Script), so that the
+  // scripts are still evaluated in order. Each queued script is caught
+  // separately: an error does not prevent the next ones from being
+  // evaluated, and it is reported on the object that queued the script.
+  // As a result, methods that queue a script can not report its errors
+  // (say, vtkKWCoreWidget::SetConfigurationOption returns 1 in a batch).
+  // Widget creation (see vtkKWWidget::CreateSpecificTkWidget), bindings,
+  // configuration options and pack/grid commands are queued this way.
+  // Note that Tcl/Tk C API calls made directly on the interpreter (outside
+  // of vtkKWTkUtilities) do not flush the queue. Batches can be nested.
+  virtual void BeginScriptBatch();
+  virtual void EndScriptBatch();
+  virtual int GetScriptBatchDepth();
+  virtual void FlushScriptBatch();
+
+  // Description:
+  // Add a script to the current batch, on behalf of object 'obj' (which is
+  // Register()'ed until the script is evaluated).
+  // AddWidgetCreationToBatch queues the command creating the Tk widget of
+  // 'widget' (see vtkKWWidget::CreateSpecificTkWidget): if it fails, the
+  // widget is notified that it was not created after all.
+  // Return 1 if the script was queued, 0 if no batch is in progress.
+  virtual int AddScriptToBatch(vtkObject *obj, const char *script);
+  virtual int AddWidgetCreationToBatch(
+    vtkKWWidget *widget, const char *script);
+
+  // Description:
+  // Flush the script batch of the application that has scripts waiting on
+  // the interpreter 'interp', if any. This is called by vtkKWTkUtilities
+  // before evaluating a script.
+  //BTX
+  static void FlushPendingScriptBatch(Tcl_Interp *interp);
+  //ETX
   
   // Description:
   // Get the interpreter being used by this application
@@ -712,6 +758,7 @@ private:
   vtkKWOptionDataBase *OptionDataBase;
   vtkKWSplashScreen *SplashScreen;
   vtkKWBalloonHelpManager *BalloonHelpManager;
+  vtkKWTclProfiler *TclProfiler;
 
   // Description:
   // Application name and version
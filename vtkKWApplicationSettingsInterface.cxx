@@ -609,7 +609,7 @@ void vtkKWApplicationSettingsInterface::Update()
     {
     if (!uim_nb || !uim_nb->GetEnableDragAndDrop())
       {
-      this->Script(
+      this->QueueScript(
         "pack forget %s", this->InterfaceCustomizationFrame->GetWidgetName());
       if (this->ResetDragAndDropButton)
         {
@@ -618,7 +618,7 @@ void vtkKWApplicationSettingsInterface::Update()
       }
     else
       {
-      this->Script(
+      this->QueueScript(
         "pack %s -side top -anchor nw -fill x -padx 2 -pady 2 -in %s ",
         this->InterfaceCustomizationFrame->GetWidgetName(),
         this->GetPageWidget(this->GetName())->GetWidgetName());
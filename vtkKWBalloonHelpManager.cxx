@@ -100,7 +100,7 @@ void vtkKWBalloonHelpManager::CreateBalloon()
       this->Label->SetForegroundColor(0.0, 0.0, 0.0);
       this->Label->SetJustificationToLeft();
       this->Label->SetWrapLength("2i");
-      app->Script("pack %s", this->Label->GetWidgetName());
+      app->QueueScript("pack %s", this->Label->GetWidgetName());
       }
     }
 }
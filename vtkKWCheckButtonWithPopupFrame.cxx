@@ -76,15 +76,15 @@ void vtkKWCheckButtonWithPopupFrame::CreateWidget()
 
   if (this->PopupMode)
     {
-    this->Script("pack %s -side left -anchor w",
-                 this->CheckButton->GetWidgetName());
-    this->Script("pack %s -side left -anchor w -fill x -expand t -padx 2",
-                 this->PopupButton->GetWidgetName());
+    this->QueueScript("pack %s -side left -anchor w",
+                      this->CheckButton->GetWidgetName());
+    this->QueueScript("pack %s -side left -anchor w -fill x -expand t -padx 2",
+                      this->PopupButton->GetWidgetName());
     }
   else
     {
-    this->Script("pack %s -side top -padx 2 -anchor nw",
-                 this->CheckButton->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 2 -anchor nw",
+                      this->CheckButton->GetWidgetName());
     }
 
   // --------------------------------------------------------------
@@ -95,7 +95,7 @@ void vtkKWColorPickerDialog::CreateWidget()
   this->AddCallbackCommandObserver(
     this->ColorPickerWidget, vtkKWColorPickerWidget::CompactModeChangedEvent);
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -anchor center -fill both -expand true -padx 2 -pady 2",
     this->ColorPickerWidget->GetWidgetName());
 
@@ -112,8 +112,8 @@ void vtkKWColorPickerDialog::CreateWidget()
   this->OKButton->SetCommand(this, "OK");
   this->OKButton->SetConfigurationOptionAsInt("-takefocus", 0);
 
-  this->Script("pack %s -side right -anchor e -padx 2 -pady 2 -expand n",
-               this->OKButton->GetWidgetName());
+  this->QueueScript("pack %s -side right -anchor e -padx 2 -pady 2 -expand n",
+                    this->OKButton->GetWidgetName());
 
   // Cancel button
 
@@ -128,8 +128,8 @@ void vtkKWColorPickerDialog::CreateWidget()
   this->CancelButton->SetCommand(this, "Cancel");
   this->CancelButton->SetConfigurationOptionAsInt("-takefocus", 0);
 
-  this->Script("pack %s -side right -anchor e -pady 2 -padx 2 -expand n",
-               this->CancelButton->GetWidgetName());
+  this->QueueScript("pack %s -side right -anchor e -pady 2 -padx 2 -expand n",
+                    this->CancelButton->GetWidgetName());
 
   this->AddBinding("<Return>", this, "OK");
   this->AddBinding("<Escape>", this, "Cancel");
@@ -850,7 +850,7 @@ void vtkKWColorPickerWidget::CreateColorSwatchesWidget()
   this->ColorSwatchesWidget->GetSwatchesColorPresetSelector()->SetListHeight(
     this->FavoritesColorPresetSelector->GetListHeight());
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side left -anchor nw -expand y -fill both -padx 2 -pady 2",
     this->ColorSwatchesWidget->GetWidgetName());
 }
@@ -886,8 +886,8 @@ void vtkKWColorPickerWidget::CreateFavoritesColorPresetSelector()
   this->FavoritesColorPresetSelector->SetListWidth(15);
   this->FavoritesColorPresetSelector->SetListHeight(4);
 
-  this->Script("pack %s -side left -anchor nw -expand y -fill both",
-               this->FavoritesColorPresetSelector->GetWidgetName());
+  this->QueueScript("pack %s -side left -anchor nw -expand y -fill both",
+                    this->FavoritesColorPresetSelector->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
@@ -919,8 +919,8 @@ void vtkKWColorPickerWidget::CreateHistoryColorPresetSelector()
   this->HistoryColorPresetSelector->SetListHeight(
     this->FavoritesColorPresetSelector->GetListHeight());
 
-  this->Script("pack %s -side left -anchor nw -expand y -fill both",
-               this->HistoryColorPresetSelector->GetWidgetName());
+  this->QueueScript("pack %s -side left -anchor nw -expand y -fill both",
+                    this->HistoryColorPresetSelector->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
@@ -43,7 +43,7 @@ public:
   double PreviousFixedAxisValue; // track the color that was rendered
   int PreviousFixedAxis;         // in the canvas to avoid re-rendering
 
-  unsigned char *ImageBuffer;    // permanent buffer for speed
+  vtkKWTkPhotoSurface ImageSurface; // permanent buffer for speed
 };
 
 //----------------------------------------------------------------------------
@@ -52,7 +52,6 @@ vtkKWColorSpectrumWidget::vtkKWColorSpectrumWidget()
   this->Internals = new vtkKWColorSpectrumWidgetInternals;
   this->Internals->PreviousFixedAxisValue = -1; /* unitialized */
   this->Internals->PreviousFixedAxis = -1;
-  this->Internals->ImageBuffer = NULL;
 
   this->ColorCanvas       = NULL;
   this->FixedAxisRadioButtonSet = NULL;
@@ -77,8 +76,6 @@ vtkKWColorSpectrumWidget::vtkKWColorSpectrumWidget()
 //----------------------------------------------------------------------------
 vtkKWColorSpectrumWidget::~vtkKWColorSpectrumWidget()
 {
-  delete [] this->Internals->ImageBuffer;
-
   delete this->Internals;
   this->Internals = NULL;
 
@@ -229,9 +226,6 @@ void vtkKWColorSpectrumWidget::CreateWidget()
 //----------------------------------------------------------------------------
 void vtkKWColorSpectrumWidget::AdjustToCanvasSize()
 {
-  delete [] this->Internals->ImageBuffer;
-  this->Internals->ImageBuffer = NULL;
-
   this->ColorCanvas->SetHeight(this->CanvasSize);
   this->ColorCanvas->SetWidth(this->CanvasSize);
 
@@ -544,9 +538,10 @@ void vtkKWColorSpectrumWidget::UpdateColorCanvas()
     }
 
   int size = this->CanvasSize;
-  if (!this->Internals->ImageBuffer)
+  vtkKWTkPhotoSurface *surface = &this->Internals->ImageSurface;
+  if (!surface->SetSize(size, size, 3))
     {
-    this->Internals->ImageBuffer = new unsigned char[size * size * 3];
+    return;
     }
   
   double h, s, v;
@@ -569,7 +564,7 @@ void vtkKWColorSpectrumWidget::UpdateColorCanvas()
   const double twothird = 2.0 / 3.0;
   const double fivesixth = 5.0 / 6.0;
 
-  unsigned char *img_ptr = this->Internals->ImageBuffer;
+  unsigned char *img_ptr = surface->GetPixels();
 
   int i, j;
 
@@ -803,11 +798,8 @@ void vtkKWColorSpectrumWidget::UpdateColorCanvas()
   img_name << this->ColorCanvas->GetWidgetName() 
            << "." << VTK_KW_COLOR_SPECTRUM_WIDGET_IMAGE_TAG;
 
-  vtkKWTkUtilities::UpdatePhoto(this->GetApplication(),
-                                img_name.str().c_str(),
-                                this->Internals->ImageBuffer,
-                                size, size, 3,
-                                size * size * 3);
+  surface->MarkAsModified();
+  surface->UpdatePhoto(this->GetApplication(), img_name.str().c_str());
 }
 
 //----------------------------------------------------------------------------
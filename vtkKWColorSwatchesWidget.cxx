@@ -307,8 +307,8 @@ void vtkKWColorSwatchesWidget::CreateWidget()
   this->Internals->ContainerFrame->SetParent(this);
   this->Internals->ContainerFrame->Create();
 
-  this->Script("pack %s -side top -anchor nw -expand n -fill none",
-               this->Internals->ContainerFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -expand n -fill none",
+                    this->Internals->ContainerFrame->GetWidgetName());
 
   // Collection combobox
 
@@ -321,8 +321,8 @@ void vtkKWColorSwatchesWidget::CreateWidget()
   this->Internals->CollectionComboBox->SetCommand(
     this, "CollectionSelectedCallback");
 
-  this->Script("pack %s -side left -anchor nw -expand n -fill none",
-               this->Internals->CollectionComboBox->GetWidgetName());
+  this->QueueScript("pack %s -side left -anchor nw -expand n -fill none",
+                    this->Internals->CollectionComboBox->GetWidgetName());
 
   // Representation mode
 
@@ -351,7 +351,7 @@ void vtkKWColorSwatchesWidget::CreateWidget()
   this->Internals->SwatchesRepresentationRadioButtonSet->GetWidget(
     this->SwatchesRepresentation)->SetSelectedState(1);
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side left -anchor nw -expand n -fill none -padx 2",
     this->Internals->SwatchesRepresentationRadioButtonSet->GetWidgetName());
 
@@ -404,21 +404,21 @@ void vtkKWColorSwatchesWidget::Pack()
   if (this->SwatchesRepresentation == 
       vtkKWColorSwatchesWidget::RepresentationFrames)
     {
-    this->Script(
+    this->QueueScript(
       "pack %s -side top -anchor nw -expand n -fill none -padx 0 -after %s", 
       this->Internals->SwatchesFrameSet->GetWidgetName(), 
       this->Internals->ContainerFrame->GetWidgetName());
-    this->Script(
+    this->QueueScript(
       "pack forget %s", 
       this->Internals->SwatchesColorPresetSelector->GetWidgetName());
     }
   else
     {
-    this->Script(
+    this->QueueScript(
       "pack %s -side top -anchor nw -expand y -fill both -padx 0 -after %s", 
       this->Internals->SwatchesColorPresetSelector->GetWidgetName(), 
       this->Internals->ContainerFrame->GetWidgetName());
-    this->Script(
+    this->QueueScript(
       "pack forget %s", 
       this->Internals->SwatchesFrameSet->GetWidgetName());
     }
@@ -649,6 +649,7 @@ void vtkKWColorSwatchesWidget::PopulateSwatchesAsFrames()
              << " configure -bd 1 -relief solid -width " << this->SwatchSize 
              << " -height " << this->SwatchSize << " -bg #" << swatch.HexRGB 
              << endl; 
+      frame->InvalidateConfigurationOptionCache();
       sprintf(command, "SwatchSelectedCallback %f %f %f", 
               swatch.RGB[0], swatch.RGB[1], swatch.RGB[2]);
       frame->SetBinding("<Any-ButtonPress>", this, command);
@@ -35,6 +35,7 @@
 
 #include <vtksys/ios/sstream>
 #include <vtksys/stl/string>
+#include <vtksys/stl/vector>
 
 vtkStandardNewMacro(vtkKWColorTransferFunctionEditor);
 vtkCxxRevisionMacro(vtkKWColorTransferFunctionEditor, "$Revision: 1.61 $");
@@ -45,6 +46,59 @@ vtkCxxRevisionMacro(vtkKWColorTransferFunctionEditor, "$Revision: 1.61 $");
 
 #define VTK_KW_CTFE_COLOR_RAMP_HEIGHT_MIN 2
 
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+#define VTK_KW_CTFE_NODE_SIZE 6
+#else
+#define VTK_KW_CTFE_NODE_SIZE 4
+#endif
+
+//----------------------------------------------------------------------------
+class vtkKWColorTransferFunctionEditorInternals
+{
+public:
+
+  // The color ramp image, as last sent to Tk, the layout it was computed
+  // for, and the nodes of the function it was computed from (see
+  // UpdateColorRampColumns).
+
+  vtkKWTkPhotoSurface RampSurface;
+  int RampWidth;
+  int RampHeight;
+  int RampOffsetX;
+  int RampOutlineStyle;
+  double RampRange[2];
+  unsigned char RampMarginColor[3];
+  int RampColorSpace;
+  int RampClamping;
+  vtksys_stl::vector<double> RampNodes;
+
+  static void GetNodes(
+    vtkColorTransferFunction *func, vtksys_stl::vector<double> &nodes);
+};
+
+//----------------------------------------------------------------------------
+// Copy the nodes of a function (parameter, color, and midpoint/sharpness if
+// supported), VTK_KW_CTFE_NODE_SIZE values per node.
+void vtkKWColorTransferFunctionEditorInternals::GetNodes(
+  vtkColorTransferFunction *func, vtksys_stl::vector<double> &nodes)
+{
+  int size = func->GetSize();
+  nodes.resize(size * VTK_KW_CTFE_NODE_SIZE);
+  if (!size)
+    {
+    return;
+    }
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+  for (int i = 0; i < size; i++)
+    {
+    func->GetNodeValue(i, &nodes[i * VTK_KW_CTFE_NODE_SIZE]);
+    }
+#else
+  double *data = func->GetDataPointer();
+  vtksys_stl::copy(data, data + size * VTK_KW_CTFE_NODE_SIZE, nodes.begin());
+#endif
+}
+
 //----------------------------------------------------------------------------
 vtkKWColorTransferFunctionEditor::vtkKWColorTransferFunctionEditor()
 {
@@ -64,6 +118,8 @@ vtkKWColorTransferFunctionEditor::vtkKWColorTransferFunctionEditor()
   this->ColorSpaceOptionMenu           = vtkKWMenuButton::New();
   this->ColorRamp                      = vtkKWLabel::New();
 
+  this->Internals = new vtkKWColorTransferFunctionEditorInternals;
+
   int i;
   for (i = 0; i < VTK_KW_CTFE_NB_ENTRIES; i++)
     {
@@ -109,6 +165,8 @@ vtkKWColorTransferFunctionEditor::~vtkKWColorTransferFunctionEditor()
     this->ColorRampTransferFunction->Delete();
     this->ColorRampTransferFunction = NULL;
     }
+
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -120,6 +178,8 @@ void vtkKWColorTransferFunctionEditor::SetColorTransferFunction(
     return;
     }
 
+  this->ResetEditTransactionFunctionTime();
+
   if (this->ColorTransferFunction)
     {
     this->ColorTransferFunction->UnRegister(this);
@@ -1422,138 +1482,177 @@ void vtkKWColorTransferFunctionEditor::RedrawColorRamp()
     // be done properly with -padx on the label 
 
     int table_width = img_width;
+    unsigned char margin_rgb[3] = { 0, 0, 0 };
     if (!in_canvas)
       {
       img_width += margins[0];
       img_offset_x = margins[0];
+      double bg_r, bg_g, bg_b;
+      this->ColorRamp->GetBackgroundColor(&bg_r, &bg_g, &bg_b);
+      margin_rgb[0] = (unsigned char)(bg_r * 255.0);
+      margin_rgb[1] = (unsigned char)(bg_g * 255.0);
+      margin_rgb[2] = (unsigned char)(bg_b * 255.0);
       }
 
-    unsigned char *img_buffer = new unsigned char [img_width * img_height * 3];
-
-    // Get the LUT for the parameter range and copy it in the first row
-
-    double *table = new double[table_width * 3];
-    func->GetTable(p_v_range_ext[0], p_v_range_ext[1], table_width, table);
-
-    double *table_ptr = table;
-    img_ptr = img_buffer + img_offset_x * 3;
-    for (i = 0; i < table_width * 3; i++)
-      {
-      *img_ptr++ = (unsigned char)(255.0 * *table_ptr++);
-      }
-
-    // If ramp below the canvas as a label, fill the margin with
-    // background color on the first row
+    // Most of the time (say, a point is being dragged), only a few columns
+    // have changed, update them only
 
-    if (!in_canvas)
+    if (!this->UpdateColorRampColumns(
+          func, p_v_range_ext, img_width, img_height, img_offset_x, 
+          margin_rgb))
       {
-      double bg_r, bg_g, bg_b;
-      this->ColorRamp->GetBackgroundColor(&bg_r, &bg_g, &bg_b);
-      unsigned char rgb[3];
-      rgb[0] = (unsigned char)(bg_r * 255.0);
-      rgb[1] = (unsigned char)(bg_g * 255.0);
-      rgb[2] = (unsigned char)(bg_b * 255.0);
-      img_ptr = img_buffer;
-      for (i = 0; i < img_offset_x; i++)
+      vtkKWTkPhotoSurface *surface = &this->Internals->RampSurface;
+      if (!surface->SetSize(img_width, img_height, 3))
         {
-        *img_ptr++ = rgb[0];
-        *img_ptr++ = rgb[1];
-        *img_ptr++ = rgb[2];
+        return;
         }
-      }
+      unsigned char *img_buffer = surface->GetPixels();
 
-    // Insert the outline border on that first row if needed
+      // Get the LUT for the parameter range and copy it in the first row
 
-    unsigned char bg_rgb[3], ds_rgb[3], ls_rgb[3], hl_rgb[3];
+      double *table = new double[table_width * 3];
+      func->GetTable(p_v_range_ext[0], p_v_range_ext[1], table_width, table);
 
-    if (this->ColorRampOutlineStyle == 
-        vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid)
-      {
+      double *table_ptr = table;
       img_ptr = img_buffer + img_offset_x * 3;
-      *img_ptr++ = 0; *img_ptr++ = 0; *img_ptr++ = 0;
-      img_ptr = img_buffer + (img_width - 1) * 3;
-      *img_ptr++ = 0; *img_ptr++ = 0; *img_ptr++ = 0;
-      }
-    else if (this->ColorRampOutlineStyle == 
-             vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken)
-      {
-      /* 
-         DDDDDDDDDDDDDDDDH <- B
-         DLLLLLLLLLLLLLLBH <- C
-         DL.............BH
-         DL.............BH <- A
-         DBBBBBBBBBBBBBBBH <- D 
-         HHHHHHHHHHHHHHHHH <- E
-      */
-      // Sunken Outline: Part A
-      this->GetColorRampOutlineSunkenColors(bg_rgb, ds_rgb, ls_rgb, hl_rgb);
-      img_ptr = img_buffer + img_offset_x * 3;
-      *img_ptr++ = ds_rgb[0]; *img_ptr++ = ds_rgb[1]; *img_ptr++ = ds_rgb[2];
-      *img_ptr++ = ls_rgb[0]; *img_ptr++ = ls_rgb[1]; *img_ptr++ = ls_rgb[2];
-      img_ptr = img_buffer + (img_width - 2) * 3;
-      *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
-      *img_ptr++ = hl_rgb[0]; *img_ptr++ = hl_rgb[1]; *img_ptr++ = hl_rgb[2];
-      }
+      for (i = 0; i < table_width * 3; i++)
+        {
+        *img_ptr++ = (unsigned char)(255.0 * *table_ptr++);
+        }
 
-    // Replicate the first row to all other rows
+      // If ramp below the canvas as a label, fill the margin with
+      // background color on the first row
 
-    img_ptr = img_buffer + img_width * 3;
-    for (i = 1; i < img_height; i++)
-      {
-      memcpy(img_ptr, img_buffer, img_width * 3);
-      img_ptr += img_width * 3;
-      }
+      if (!in_canvas)
+        {
+        img_ptr = img_buffer;
+        for (i = 0; i < img_offset_x; i++)
+          {
+          *img_ptr++ = margin_rgb[0];
+          *img_ptr++ = margin_rgb[1];
+          *img_ptr++ = margin_rgb[2];
+          }
+        }
 
-    // Complete the outline top/bottom
+      // Insert the outline border on that first row if needed
 
-    if (this->ColorRampOutlineStyle == 
-        vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid)
-      {
-      memset(img_buffer + img_offset_x * 3, 0, table_width * 3);
-      memset(img_buffer + (img_width * (img_height - 1) + img_offset_x) * 3, 
-             0, table_width * 3);
-      }
-    else if (this->ColorRampOutlineStyle == 
-             vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken)
-      {
-      // Sunken Outline: Part B
-      img_ptr = img_buffer + img_offset_x * 3;
-      for (i = 0; i < table_width - 1; i++)
+      unsigned char bg_rgb[3], ds_rgb[3], ls_rgb[3], hl_rgb[3];
+
+      if (this->ColorRampOutlineStyle == 
+          vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid)
         {
-        *img_ptr++ = ds_rgb[0]; *img_ptr++ = ds_rgb[1]; *img_ptr++ = ds_rgb[2];
+        img_ptr = img_buffer + img_offset_x * 3;
+        *img_ptr++ = 0; *img_ptr++ = 0; *img_ptr++ = 0;
+        img_ptr = img_buffer + (img_width - 1) * 3;
+        *img_ptr++ = 0; *img_ptr++ = 0; *img_ptr++ = 0;
         }
-      *img_ptr++ = hl_rgb[0]; *img_ptr++ = hl_rgb[1]; *img_ptr++ = hl_rgb[2];
-
-      // Sunken Outline: Part C
-      img_ptr = img_buffer + (img_width + img_offset_x + 1) * 3;
-      for (i = 0; i < table_width - 3; i++)
+      else if (this->ColorRampOutlineStyle == 
+               vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken)
         {
+        /* 
+           DDDDDDDDDDDDDDDDH <- B
+           DLLLLLLLLLLLLLLBH <- C
+           DL.............BH
+           DL.............BH <- A
+           DBBBBBBBBBBBBBBBH <- D 
+           HHHHHHHHHHHHHHHHH <- E
+        */
+        // Sunken Outline: Part A
+        this->GetColorRampOutlineSunkenColors(bg_rgb, ds_rgb, ls_rgb, hl_rgb);
+        img_ptr = img_buffer + img_offset_x * 3;
+        *img_ptr++ = ds_rgb[0]; *img_ptr++ = ds_rgb[1]; *img_ptr++ = ds_rgb[2];
         *img_ptr++ = ls_rgb[0]; *img_ptr++ = ls_rgb[1]; *img_ptr++ = ls_rgb[2];
+        img_ptr = img_buffer + (img_width - 2) * 3;
+        *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
+        *img_ptr++ = hl_rgb[0]; *img_ptr++ = hl_rgb[1]; *img_ptr++ = hl_rgb[2];
         }
-      *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
 
-      // Sunken Outline: Part D
-      img_ptr = img_buffer + (img_width * (img_height - 2) + img_offset_x+1)*3;
-      for (i = 0; i < table_width - 2; i++)
+      // Replicate the first row to all other rows
+
+      img_ptr = img_buffer + img_width * 3;
+      for (i = 1; i < img_height; i++)
         {
-        *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
+        memcpy(img_ptr, img_buffer, img_width * 3);
+        img_ptr += img_width * 3;
         }
 
-      // Sunken Outline: Part E
-      img_ptr = img_buffer + (img_width * (img_height - 1) + img_offset_x) * 3;
-      for (i = 0; i < table_width; i++)
+      // Complete the outline top/bottom
+
+      if (this->ColorRampOutlineStyle == 
+          vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid)
         {
+        memset(img_buffer + img_offset_x * 3, 0, table_width * 3);
+        memset(img_buffer + (img_width * (img_height - 1) + img_offset_x) * 3, 
+               0, table_width * 3);
+        }
+      else if (this->ColorRampOutlineStyle == 
+               vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken)
+        {
+        // Sunken Outline: Part B
+        img_ptr = img_buffer + img_offset_x * 3;
+        for (i = 0; i < table_width - 1; i++)
+          {
+          *img_ptr++ = ds_rgb[0]; *img_ptr++ = ds_rgb[1]; *img_ptr++ = ds_rgb[2];
+          }
         *img_ptr++ = hl_rgb[0]; *img_ptr++ = hl_rgb[1]; *img_ptr++ = hl_rgb[2];
+
+        // Sunken Outline: Part C
+        img_ptr = img_buffer + (img_width + img_offset_x + 1) * 3;
+        for (i = 0; i < table_width - 3; i++)
+          {
+          *img_ptr++ = ls_rgb[0]; *img_ptr++ = ls_rgb[1]; *img_ptr++ = ls_rgb[2];
+          }
+        *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
+
+        // Sunken Outline: Part D
+        img_ptr = img_buffer + (img_width * (img_height - 2) + img_offset_x+1)*3;
+        for (i = 0; i < table_width - 2; i++)
+          {
+          *img_ptr++ = bg_rgb[0]; *img_ptr++ = bg_rgb[1]; *img_ptr++ = bg_rgb[2];
+          }
+
+        // Sunken Outline: Part E
+        img_ptr = img_buffer + (img_width * (img_height - 1) + img_offset_x) * 3;
+        for (i = 0; i < table_width; i++)
+          {
+          *img_ptr++ = hl_rgb[0]; *img_ptr++ = hl_rgb[1]; *img_ptr++ = hl_rgb[2];
+          }
         }
-      }
 
-    // Update the image
+      // Update the image (the photo is shared by the label and the canvas)
+
+      delete [] table;
 
-    this->ColorRamp->SetImageToPixels(
-      img_buffer, img_width, img_height, 3);
+      surface->MarkAsModified();
+      vtksys_stl::string image_name(this->ColorRamp->GetWidgetName());
+      image_name += ".image";
+      if (surface->UpdatePhoto(this->GetApplication(), image_name.c_str()))
+        {
+        const char *image = this->ColorRamp->GetConfigurationOption("-image");
+        if (!image || strcmp(image, image_name.c_str()))
+          {
+          this->ColorRamp->SetConfigurationOption(
+            "-image", image_name.c_str());
+          }
+        }
 
-    delete [] img_buffer;
-    delete [] table;
+      // Keep track of what the image was computed for
+
+      vtkKWColorTransferFunctionEditorInternals *internals = this->Internals;
+      internals->RampWidth = img_width;
+      internals->RampHeight = img_height;
+      internals->RampOffsetX = img_offset_x;
+      internals->RampOutlineStyle = this->ColorRampOutlineStyle;
+      internals->RampRange[0] = p_v_range_ext[0];
+      internals->RampRange[1] = p_v_range_ext[1];
+      internals->RampMarginColor[0] = margin_rgb[0];
+      internals->RampMarginColor[1] = margin_rgb[1];
+      internals->RampMarginColor[2] = margin_rgb[2];
+      internals->RampColorSpace = func->GetColorSpace();
+      internals->RampClamping = func->GetClamping();
+      vtkKWColorTransferFunctionEditorInternals::GetNodes(
+        func, internals->RampNodes);
+      }
     }
 
   // If the ramp has to be in the canvas, draw it now or remove it
@@ -1615,6 +1714,170 @@ void vtkKWColorTransferFunctionEditor::RedrawColorRamp()
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkKWColorTransferFunctionEditor::UpdateColorRampColumns(
+  vtkColorTransferFunction *func, 
+  double p_v_range_ext[2], 
+  int img_width, int img_height, int img_offset_x, 
+  unsigned char margin_rgb[3])
+{
+  vtkKWColorTransferFunctionEditorInternals *internals = this->Internals;
+
+  // Can we reuse the previous image at all ?
+
+  if (!func ||
+      !internals->RampSurface.GetPixels() ||
+      internals->RampWidth != img_width ||
+      internals->RampHeight != img_height ||
+      internals->RampOffsetX != img_offset_x ||
+      internals->RampOutlineStyle != this->ColorRampOutlineStyle ||
+      internals->RampRange[0] != p_v_range_ext[0] ||
+      internals->RampRange[1] != p_v_range_ext[1] ||
+      internals->RampMarginColor[0] != margin_rgb[0] ||
+      internals->RampMarginColor[1] != margin_rgb[1] ||
+      internals->RampMarginColor[2] != margin_rgb[2] ||
+      internals->RampColorSpace != func->GetColorSpace() ||
+      internals->RampClamping != func->GetClamping())
+    {
+    return 0;
+    }
+
+  // Find the range of nodes that changed. If none did, something else
+  // we do not track changed (say, HSV wrapping): redraw it all.
+
+  vtksys_stl::vector<double> nodes;
+  vtkKWColorTransferFunctionEditorInternals::GetNodes(func, nodes);
+  if (nodes.size() != internals->RampNodes.size())
+    {
+    return 0;
+    }
+
+  int nb_nodes = (int)nodes.size() / VTK_KW_CTFE_NODE_SIZE;
+  int first = -1, last = -1, i, j;
+  for (i = 0; i < nb_nodes; i++)
+    {
+    for (j = 0; j < VTK_KW_CTFE_NODE_SIZE; j++)
+      {
+      if (nodes[i * VTK_KW_CTFE_NODE_SIZE + j] != 
+          internals->RampNodes[i * VTK_KW_CTFE_NODE_SIZE + j])
+        {
+        if (first < 0)
+          {
+          first = i;
+          }
+        last = i;
+        break;
+        }
+      }
+    }
+  if (first < 0)
+    {
+    return 0;
+    }
+
+  // A node only affects the colors up to its neighbors (and everything
+  // before/after it if it is the first/last one, given the clamping).
+  // Those neighbors did not change, their position is the same in both the
+  // old and new set of nodes.
+
+  int table_width = img_width - img_offset_x;
+  int col_min = 0, col_max = table_width - 1;
+  double step = table_width > 1 
+    ? (p_v_range_ext[1] - p_v_range_ext[0]) / (double)(table_width - 1) : 0.0;
+  if (step > 0.0)
+    {
+    if (first > 0)
+      {
+      double x = nodes[(first - 1) * VTK_KW_CTFE_NODE_SIZE];
+      col_min = (int)floor((x - p_v_range_ext[0]) / step);
+      }
+    if (last < nb_nodes - 1)
+      {
+      double x = nodes[(last + 1) * VTK_KW_CTFE_NODE_SIZE];
+      col_max = (int)ceil((x - p_v_range_ext[0]) / step);
+      }
+    }
+
+  // Leave the outline alone
+
+  int border = 0;
+  if (this->ColorRampOutlineStyle == 
+      vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSolid)
+    {
+    border = 1;
+    }
+  else if (this->ColorRampOutlineStyle == 
+           vtkKWColorTransferFunctionEditor::ColorRampOutlineStyleSunken)
+    {
+    border = 2;
+    }
+
+  if (col_min < border)
+    {
+    col_min = border;
+    }
+  if (col_max > table_width - 1 - border)
+    {
+    col_max = table_width - 1 - border;
+    }
+  int row_min = border;
+  int row_max = img_height - 1 - border;
+
+  if (col_min > col_max || row_min > row_max)
+    {
+    internals->RampNodes.swap(nodes);
+    return 1;
+    }
+
+  // Re-evaluate those columns and copy them in the interior rows.
+  // Each column is evaluated at the very parameter GetTable samples it at
+  // over the whole range in RedrawColorRamp (GetTable over the sub-range
+  // would be off by a rounding error, and so would the pixels sometimes).
+
+  int nb_cols = col_max - col_min + 1;
+  int nb_rows = row_max - row_min + 1;
+
+  vtkKWTkPhotoSurface *surface = &internals->RampSurface;
+  unsigned char *img_buffer = surface->GetPixels();
+  unsigned char *row_ptr = 
+    img_buffer + (row_min * img_width + img_offset_x + col_min) * 3;
+  unsigned char *img_ptr = row_ptr;
+  double rgb[3];
+  for (i = col_min; i <= col_max; i++)
+    {
+    double parameter = (table_width > 1)
+      ? p_v_range_ext[0] + ((double)i / (double)(table_width - 1)) * 
+        (p_v_range_ext[1] - p_v_range_ext[0])
+      : 0.5 * (p_v_range_ext[0] + p_v_range_ext[1]);
+    func->GetColor(parameter, rgb);
+    *img_ptr++ = (unsigned char)(255.0 * rgb[0]);
+    *img_ptr++ = (unsigned char)(255.0 * rgb[1]);
+    *img_ptr++ = (unsigned char)(255.0 * rgb[2]);
+    }
+
+  img_ptr = row_ptr + img_width * 3;
+  for (i = 1; i < nb_rows; i++)
+    {
+    memcpy(img_ptr, row_ptr, nb_cols * 3);
+    img_ptr += img_width * 3;
+    }
+
+  // Send only that region to the photo shared by the label and the canvas
+
+  const char *photo_name = this->ColorRamp->GetConfigurationOption("-image");
+  surface->MarkRegionAsModified(
+    img_offset_x + col_min, row_min, nb_cols, nb_rows);
+  if (!photo_name || !*photo_name ||
+      !surface->UpdatePhoto(this->GetApplication(), photo_name))
+    {
+    return 0;
+    }
+
+  internals->RampNodes.swap(nodes);
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkKWColorTransferFunctionEditor::RedrawHistogram()
 {
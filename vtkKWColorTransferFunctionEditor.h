@@ -33,6 +33,7 @@
 class vtkColorTransferFunction;
 class vtkKWEntryWithLabel;
 class vtkKWMenuButton;
+class vtkKWColorTransferFunctionEditorInternals;
 
 class KWWidgets_EXPORT vtkKWColorTransferFunctionEditor : public vtkKWParameterValueHermiteFunctionEditor
 {
@@ -208,6 +209,11 @@ protected:
   int ColorRampOutlineStyle;
   unsigned long LastRedrawColorRampTime;
 
+  // PIMPL Encapsulation for STL containers
+  //BTX
+  vtkKWColorTransferFunctionEditorInternals *Internals;
+  //ETX
+
   // GUI
 
   vtkKWMenuButton   *ColorSpaceOptionMenu;
@@ -237,6 +243,17 @@ protected:
   // Redraw the color ramp
   virtual void RedrawColorRamp();
   virtual int IsColorRampUpToDate();
+
+  // Description:
+  // Update the color ramp image in place, only re-evaluating and sending to
+  // Tk the columns affected by the function nodes that changed since it
+  // was last drawn. The image layout is described by the parameters, as
+  // computed in RedrawColorRamp. Return 0 if the ramp has to be redrawn
+  // entirely instead (the layout changed, for example).
+  virtual int UpdateColorRampColumns(
+    vtkColorTransferFunction *func, double p_v_range_ext[2], 
+    int img_width, int img_height, int img_offset_x, 
+    unsigned char margin_rgb[3]);
   virtual void GetColorRampOutlineSunkenColors(
     unsigned char bg_rgb[3], unsigned char ds_rgb[3], unsigned char ls_rgb[3],
     unsigned char hl_rgb[3]);
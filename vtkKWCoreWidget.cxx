@@ -20,6 +20,8 @@
 #include "vtkKWOptions.h"
 
 #include <vtksys/SystemTools.hxx>
+#include <vtksys/stl/string>
+#include <vtksys/stl/map>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro( vtkKWCoreWidget );
@@ -41,13 +43,102 @@ public:
   // options on a widget can only be achieved given a specific state.
 
   int CachedStateOption; 
+
+  // Along the same lines, cache the value of the other configuration 
+  // options, as well as their availability and their value as a color.
+  // The cache is discarded when its generation does not match 
+  // vtkKWCoreWidgetOptionCacheGeneration anymore.
+
+  typedef vtksys_stl::map<vtksys_stl::string, vtksys_stl::string> 
+  OptionValuesContainerType;
+  OptionValuesContainerType OptionValues;
+
+  typedef vtksys_stl::map<vtksys_stl::string, int> 
+  OptionAvailabilityContainerType;
+  OptionAvailabilityContainerType OptionAvailability;
+
+  struct OptionColorType
+  {
+    double RGB[3];
+  };
+  typedef vtksys_stl::map<vtksys_stl::string, OptionColorType> 
+  OptionColorsContainerType;
+  OptionColorsContainerType OptionColors;
+
+  unsigned long OptionCacheGeneration;
+
+  void ClearOptionCache(int availability_too);
+  void UpdateOptionCache();
 };
 
+//----------------------------------------------------------------------------
+// Bumped by InvalidateAllConfigurationOptionCaches()
+
+static unsigned long vtkKWCoreWidgetOptionCacheGeneration = 0;
+
+//----------------------------------------------------------------------------
+void vtkKWCoreWidgetInternals::ClearOptionCache(int availability_too)
+{
+  this->OptionValues.clear();
+  this->OptionColors.clear();
+  if (availability_too)
+    {
+    this->OptionAvailability.clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWCoreWidgetInternals::UpdateOptionCache()
+{
+  if (this->OptionCacheGeneration != vtkKWCoreWidgetOptionCacheGeneration)
+    {
+    this->ClearOptionCache(0);
+    this->OptionCacheGeneration = vtkKWCoreWidgetOptionCacheGeneration;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Options that Tk is likely to change on its own (class bindings, linked
+// variables, etc.), or that are set directly from Tcl, and should
+// therefore never be cached.
+
+static int vtkKWCoreWidgetIsVolatileOption(const char *option)
+{
+  static const char *volatile_options[] = 
+    {
+      "-state", 
+      "-relief", 
+      "-overrelief", 
+      "-text", 
+      "-textvariable", 
+      "-variable", 
+      "-value", 
+      "-values", 
+      "-from", 
+      "-to", 
+      "-cursor", 
+      "-constrainedwidth", 
+      "-constrainedheight", 
+      NULL
+    };
+
+  for (const char **ptr = volatile_options; *ptr; ++ptr)
+    {
+    if (!strcmp(option, *ptr))
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 vtkKWCoreWidget::vtkKWCoreWidget()
 {
   this->Internals = new vtkKWCoreWidgetInternals;
   this->Internals->CachedStateOption = vtkKWOptions::StateUnknown;
+  this->Internals->OptionCacheGeneration = 
+    vtkKWCoreWidgetOptionCacheGeneration;
 }
 
 //----------------------------------------------------------------------------
@@ -73,6 +164,18 @@ void vtkKWCoreWidget::CreateWidget()
   this->Superclass::CreateWidget();
 }
 
+//----------------------------------------------------------------------------
+void vtkKWCoreWidget::InvalidateConfigurationOptionCache()
+{
+  this->Internals->ClearOptionCache(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches()
+{
+  ++vtkKWCoreWidgetOptionCacheGeneration;
+}
+
 //----------------------------------------------------------------------------
 int vtkKWCoreWidget::SetConfigurationOption(
   const char *option, const char *value)
@@ -89,25 +192,51 @@ int vtkKWCoreWidget::SetConfigurationOption(
     return 0;
     }
 
-  const char *res = 
-    this->Script("%s configure %s {%s}", 
-                 this->GetWidgetName(), option, value ? value : "");
+  // Tk options have synonyms (-bg and -background, for example), so
+  // let's drop all the values we know of, and only keep the new one
+  // once it has been set successfully.
+
+  this->Internals->UpdateOptionCache();
+  this->Internals->ClearOptionCache(0);
+
+  // In a script batch, queue the command (quoted as a list, so that the
+  // value is still passed verbatim). Errors will be reported by the batch.
+
+  vtkKWApplication *app = this->GetApplication();
+  if (app->GetScriptBatchDepth() > 0)
+    {
+    const char *argv[4];
+    argv[0] = this->GetWidgetName();
+    argv[1] = "configure";
+    argv[2] = option;
+    argv[3] = value ? value : "";
+    char *cmd = Tcl_Merge(4, argv);
+    app->AddScriptToBatch(this, cmd);
+    Tcl_Free(cmd);
+    return 1;
+    }
+
+  vtkKWTkCommandArguments args;
+  args.AddString(option);
+  args.AddString(value);
+
+  const char *res = vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, this->GetWidgetName(), "configure", &args);
 
   // 'configure' is not supposed to return anything, so let's assume
-  // any output is an error
+  // any output is an error (already reported on this widget)
 
   if (res && *res)
     {
-    vtksys_stl::string err_msg(res);
-    vtksys_stl::string tcl_name(this->GetTclName());
-    vtksys_stl::string widget_name(this->GetWidgetName());
-    vtksys_stl::string type(this->GetType());
-    vtkErrorMacro(
-      "Error configuring " << tcl_name.c_str() << " (" << type.c_str() << ": " 
-      << widget_name.c_str() << ") with option: [" << option 
-      << "] and value [" << value << "] => " << err_msg.c_str());
     return 0;
     }
+
+  if (!vtkKWCoreWidgetIsVolatileOption(option))
+    {
+    this->Internals->OptionValues[option] = value ? value : "";
+    this->Internals->OptionAvailability[option] = 1;
+    }
+
   return 1;
 }
 
@@ -120,10 +249,22 @@ int vtkKWCoreWidget::HasConfigurationOption(const char *option)
     return 0;
     }
 
-  return (this->GetApplication() && 
-          !this->GetApplication()->EvaluateBooleanExpression(
-            "catch {%s cget %s}",
-            this->GetWidgetName(), option));
+  if (!option || !this->GetApplication())
+    {
+    return 0;
+    }
+
+  vtkKWCoreWidgetInternals::OptionAvailabilityContainerType::iterator it = 
+    this->Internals->OptionAvailability.find(option);
+  if (it != this->Internals->OptionAvailability.end())
+    {
+    return it->second;
+    }
+
+  int has_option = !this->GetApplication()->EvaluateBooleanExpression(
+    "catch {%s cget %s}", this->GetWidgetName(), option);
+  this->Internals->OptionAvailability[option] = has_option;
+  return has_option;
 }
 
 //----------------------------------------------------------------------------
@@ -134,7 +275,25 @@ const char* vtkKWCoreWidget::GetConfigurationOption(const char *option)
     return NULL;
     }
 
-  return this->Script("%s cget %s", this->GetWidgetName(), option);
+  if (vtkKWCoreWidgetIsVolatileOption(option))
+    {
+    return this->Script("%s cget %s", this->GetWidgetName(), option);
+    }
+
+  this->Internals->UpdateOptionCache();
+
+  vtkKWCoreWidgetInternals::OptionValuesContainerType::iterator it = 
+    this->Internals->OptionValues.find(option);
+  if (it == this->Internals->OptionValues.end())
+    {
+    const char *res = 
+      this->Script("%s cget %s", this->GetWidgetName(), option);
+    it = this->Internals->OptionValues.insert(
+      vtkKWCoreWidgetInternals::OptionValuesContainerType::value_type(
+        option, res ? res : "")).first;
+    }
+
+  return it->second.c_str();
 }
 
 //----------------------------------------------------------------------------
@@ -154,7 +313,7 @@ int vtkKWCoreWidget::GetConfigurationOptionAsInt(const char *option)
     return 0;
     }
 
-  return atoi(this->Script("%s cget %s", this->GetWidgetName(), option));
+  return atoi(this->GetConfigurationOption(option));
 }
 
 //----------------------------------------------------------------------------
@@ -174,14 +333,49 @@ double vtkKWCoreWidget::GetConfigurationOptionAsDouble(const char *option)
     return 0.0;
     }
 
-  return atof(this->Script("%s cget %s", this->GetWidgetName(), option));
+  return atof(this->GetConfigurationOption(option));
 }
 
 //----------------------------------------------------------------------------
 void vtkKWCoreWidget::GetConfigurationOptionAsColor(
   const char *option, double *r, double *g, double *b)
 {
-  vtkKWTkUtilities::GetOptionColor(this, option, r, g, b);
+  if (!option || !r || !g || !b || !this->IsCreated() || 
+      vtkKWCoreWidgetIsVolatileOption(option) ||
+      !this->HasConfigurationOption(option))
+    {
+    vtkKWTkUtilities::GetOptionColor(this, option, r, g, b);
+    return;
+    }
+
+  this->Internals->UpdateOptionCache();
+
+  vtkKWCoreWidgetInternals::OptionColorsContainerType::iterator it = 
+    this->Internals->OptionColors.find(option);
+  if (it == this->Internals->OptionColors.end())
+    {
+    // Some color options can be empty (-disabledforeground, for example),
+    // in which case r, g, b are left untouched
+
+    const char *value = this->GetConfigurationOption(option);
+    if (!value || !*value)
+      {
+      return;
+      }
+    vtkKWCoreWidgetInternals::OptionColorType color;
+    color.RGB[0] = *r;
+    color.RGB[1] = *g;
+    color.RGB[2] = *b;
+    vtkKWTkUtilities::GetRGBColor(
+      this, value, color.RGB, color.RGB + 1, color.RGB + 2);
+    it = this->Internals->OptionColors.insert(
+      vtkKWCoreWidgetInternals::OptionColorsContainerType::value_type(
+        option, color)).first;
+    }
+
+  *r = it->second.RGB[0];
+  *g = it->second.RGB[1];
+  *b = it->second.RGB[2];
 }
 
 //----------------------------------------------------------------------------
@@ -203,6 +397,9 @@ double* vtkKWCoreWidget::GetConfigurationOptionAsColor(const char *option)
 void vtkKWCoreWidget::SetConfigurationOptionAsColor(
   const char *option, double r, double g, double b)
 {
+  // Tk quantizes the color, let the next Get query the actual value
+  // (vtkKWTkUtilities::SetOptionColor invalidates the cache)
+
   vtkKWTkUtilities::SetOptionColor(this, option, r, g, b);
 }
 
@@ -348,6 +545,8 @@ void vtkKWCoreWidget::SetTextOption(const char *option, const char *value)
     return;
     }
 
+  this->InvalidateConfigurationOptionCache();
+
   const char *val = this->ConvertInternalStringToTclString(
     value, vtkKWCoreWidget::ConvertStringEscapeInterpretable);
   this->Script("%s configure %s \"%s\"", 
@@ -63,6 +63,9 @@ public:
   // Note that SetConfigurationOption will enclose the value inside
   // curly braces {} as a convenience.
   // SetConfigurationOption returns 1 on success, 0 otherwise.
+  // Within a script batch (see vtkKWApplication::BeginScriptBatch), the
+  // option is queued instead of being set right away: 1 is returned, and
+  // an error will only be reported when the batch is flushed.
   virtual int SetConfigurationOption(const char* option, const char *value);
   virtual int HasConfigurationOption(const char* option);
   virtual const char* GetConfigurationOption(const char* option);
@@ -81,6 +84,22 @@ public:
     const char* option, double *r, double *g, double *b);
   virtual double* GetDefaultConfigurationOptionAsColor(const char* option);
 
+  // Description:
+  // The values returned by HasConfigurationOption and the
+  // GetConfigurationOption... methods are cached on the C++ side, so that
+  // querying an option (say, the background color) does not go through
+  // the Tcl interpreter each time. The cache is updated by the
+  // SetConfigurationOption... methods; options that Tk may change on its
+  // own (-state, -relief, -text, -variable, etc.) are never cached.
+  // InvalidateConfigurationOptionCache() should be called if a Tk option
+  // of this widget was set directly from Tcl (i.e. without using the
+  // SetConfigurationOption... methods).
+  // InvalidateAllConfigurationOptionCaches() invalidates the cache of all
+  // widgets at once; this is done automatically when the option database
+  // is modified, or when a theme is installed/uninstalled.
+  virtual void InvalidateConfigurationOptionCache();
+  static void InvalidateAllConfigurationOptionCaches();
+
 protected:
   vtkKWCoreWidget();
   ~vtkKWCoreWidget();
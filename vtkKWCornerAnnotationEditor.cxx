@@ -204,8 +204,8 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
   this->CornerFrame->SetParent(this->Frame->GetFrame());
   this->CornerFrame->Create();
 
-  this->Script("pack %s -side top -padx 2 -expand t -fill x -anchor nw",
-               this->CornerFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -padx 2 -expand t -fill x -anchor nw",
+                    this->CornerFrame->GetWidgetName());
 
   char buffer[50];
   int i;
@@ -247,19 +247,19 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
     k_("Set the upper right corner annotation. The text will automatically "
        "scale to fit within the allocated space"));
 
-  this->Script("grid %s %s -row 0 -sticky news -padx 2 -pady 0 -ipady 0",
-               this->CornerText[2]->GetWidgetName(), 
-               this->CornerText[3]->GetWidgetName());
+  this->QueueScript("grid %s %s -row 0 -sticky news -padx 2 -pady 0 -ipady 0",
+                    this->CornerText[2]->GetWidgetName(), 
+                    this->CornerText[3]->GetWidgetName());
 
-  this->Script("grid %s %s -row 1 -sticky news -padx 2 -pady 0 -ipady 0",
-               this->CornerText[0]->GetWidgetName(), 
-               this->CornerText[1]->GetWidgetName());
+  this->QueueScript("grid %s %s -row 1 -sticky news -padx 2 -pady 0 -ipady 0",
+                    this->CornerText[0]->GetWidgetName(), 
+                    this->CornerText[1]->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 0 -weight 1",
-               this->CornerFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 0 -weight 1",
+                    this->CornerFrame->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 1 -weight 1",
-               this->CornerFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 1 -weight 1",
+                    this->CornerFrame->GetWidgetName());
 
   // --------------------------------------------------------------
   // Properties frame
@@ -267,8 +267,8 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
   this->PropertiesFrame->SetParent(this->Frame->GetFrame());
   this->PropertiesFrame->Create();
 
-  this->Script("pack %s -side top -padx 2 -expand t -fill both -anchor nw",
-               this->PropertiesFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -padx 2 -expand t -fill both -anchor nw",
+                    this->PropertiesFrame->GetWidgetName());
 
   // --------------------------------------------------------------
   // Maximum line height
@@ -297,9 +297,9 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
   this->MaximumLineHeightScale->SetEntryCommand(
     this, "MaximumLineHeightEndCallback");
 
-  this->Script("pack %s -padx 2 -pady 2 -side %s -anchor w -fill y", 
-               this->MaximumLineHeightScale->GetWidgetName(),
-               (popup_text_property ? "left" : "top"));
+  this->QueueScript("pack %s -padx 2 -pady 2 -side %s -anchor w -fill y", 
+                    this->MaximumLineHeightScale->GetWidgetName(),
+                    (popup_text_property ? "left" : "top"));
   
   // --------------------------------------------------------------
   // Text property : popup button if needed
@@ -322,8 +322,8 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
     popupframe->SetBorderWidth(2);
     popupframe->SetReliefToGroove();
 
-    this->Script("pack %s -padx 2 -pady 2 -side left -anchor w", 
-                 this->TextPropertyPopupButton->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side left -anchor w", 
+                      this->TextPropertyPopupButton->GetWidgetName());
 
     this->TextPropertyWidget->SetParent(
       this->TextPropertyPopupButton->GetWidget()->GetPopupFrame());
@@ -344,9 +344,9 @@ void vtkKWCornerAnnotationEditor::CreateWidget()
     ks_("Corner Annotation Editor|Text properties:"));
   this->TextPropertyWidget->SetChangedCommand(this, "TextPropertyCallback");
 
-  this->Script("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
-               this->TextPropertyWidget->GetWidgetName(),
-               this->TextPropertyWidget->GetLongFormat() ? 0 : 2);
+  this->QueueScript("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
+                    this->TextPropertyWidget->GetWidgetName(),
+                    this->TextPropertyWidget->GetLongFormat() ? 0 : 2);
 
   // --------------------------------------------------------------
   // Update the GUI according to the Ivar value (i.e. the corner prop, etc.)
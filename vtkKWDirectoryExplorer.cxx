@@ -243,8 +243,8 @@ void vtkKWDirectoryExplorer::CreateWidget()
   this->Toolbar->SetToolbarAspectToFlat();
   this->Toolbar->SetWidgetsAspectToFlat();
 
-  this->Script("pack %s -side top -anchor nw", 
-               this->Toolbar->GetWidgetName());           
+  this->QueueScript("pack %s -side top -anchor nw", 
+                    this->Toolbar->GetWidgetName());           
    
   // Directory Tree
 
@@ -276,7 +276,7 @@ void vtkKWDirectoryExplorer::CreateWidget()
   dirtree->SetRightClickOnNodeCommand(this, "RightClickCallback %X %Y");
   dirtree->SetBinding("<F2>", this, "RenameCallback");
     
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -fill both -expand true -padx 1 -pady 1",
     this->DirectoryTree->GetWidgetName());
 
@@ -220,8 +220,8 @@ void vtkKWFavoriteDirectoriesFrame::CreateWidget()
   this->Toolbar->SetToolbarAspectToFlat();
   this->Toolbar->SetWidgetsAspectToFlat();
 
-  this->Script("pack %s -side top -anchor nw -fill x",
-               this->Toolbar->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -fill x",
+                    this->Toolbar->GetWidgetName());
   
   // Favorite button frame to hold favorite directory buttons.
 
@@ -232,8 +232,8 @@ void vtkKWFavoriteDirectoriesFrame::CreateWidget()
   this->ContainerFrame->SetBorderWidth(1);
   this->ContainerFrame->SetReliefToSunken();
 
-  this->Script("pack %s -side top -fill both -expand true",
-               this->ContainerFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand true",
+                    this->ContainerFrame->GetWidgetName());
 
   // Initialize
 
@@ -573,14 +573,14 @@ void vtkKWFavoriteDirectoriesFrame::AddFavoriteDirectoryToFrame(
                     
   if (nb_children > 0)
     {
-    this->Script("pack %s -side top -fill x -pady 2 -before %s", 
-                 dirbutton->GetWidgetName(), 
-                 this->ContainerFrame->GetFrame()->GetNthChild(nb_children-1)->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -pady 2 -before %s", 
+                      dirbutton->GetWidgetName(), 
+                      this->ContainerFrame->GetFrame()->GetNthChild(nb_children-1)->GetWidgetName());
     }
   else
     {
-    this->Script("pack %s -side top -fill x -pady 2", 
-                 dirbutton->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -pady 2", 
+                      dirbutton->GetWidgetName());
     }
 
   dirbutton->Delete();
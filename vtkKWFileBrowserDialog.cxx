@@ -186,15 +186,15 @@ void vtkKWFileBrowserDialog::CreateWidget()
   this->FileBrowserWidget->SetParent(this);
   this->FileBrowserWidget->Create();
 
-  this->Script("pack %s -side top -fill both -expand true",
-               this->FileBrowserWidget->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand true",
+                    this->FileBrowserWidget->GetWidgetName());
 
   // Bottom frame
 
   this->BottomFrame->SetParent(this);
   this->BottomFrame->Create();
-  this->Script("pack %s -side top -fill x", 
-               this->BottomFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill x", 
+                    this->BottomFrame->GetWidgetName());
 
   this->FileNameLabel->SetParent(this->BottomFrame);
   this->FileNameLabel->Create();
@@ -281,38 +281,38 @@ void vtkKWFileBrowserDialog::Update()
 
   if (!this->ChooseDirectory)
     {
-    this->Script("grid %s -column 0 -row 0 -sticky nw -padx 2 -pady 5", 
-                 this->FileNameLabel->GetWidgetName());
-    this->Script("grid %s -column 0 -row 1 -sticky nw -padx 2 -pady 5", 
-                 this->FileTypesLabel->GetWidgetName());
-    this->Script("grid %s -column 1 -row 0 -sticky ew -padx 2 -pady 2", 
-                 this->FileNameText->GetWidgetName());
-    this->Script("grid %s -column 1 -row 1 -sticky ew -padx 2 -pady 2", 
-                 this->FileTypesBox->GetWidgetName());
-    this->Script("grid %s -column 2 -row 0 -sticky ne -padx 2 -pady 2", 
-                 this->OKButton->GetWidgetName());
-    this->Script("grid %s -column 2 -row 1 -sticky ne -padx 2 -pady 2", 
-                 this->CancelButton->GetWidgetName());
-
-    this->Script("grid columnconfigure %s 1 -weight 1", 
+    this->QueueScript("grid %s -column 0 -row 0 -sticky nw -padx 2 -pady 5", 
+                      this->FileNameLabel->GetWidgetName());
+    this->QueueScript("grid %s -column 0 -row 1 -sticky nw -padx 2 -pady 5", 
+                      this->FileTypesLabel->GetWidgetName());
+    this->QueueScript("grid %s -column 1 -row 0 -sticky ew -padx 2 -pady 2", 
+                      this->FileNameText->GetWidgetName());
+    this->QueueScript("grid %s -column 1 -row 1 -sticky ew -padx 2 -pady 2", 
+                      this->FileTypesBox->GetWidgetName());
+    this->QueueScript("grid %s -column 2 -row 0 -sticky ne -padx 2 -pady 2", 
+                      this->OKButton->GetWidgetName());
+    this->QueueScript("grid %s -column 2 -row 1 -sticky ne -padx 2 -pady 2", 
+                      this->CancelButton->GetWidgetName());
+
+    this->QueueScript("grid columnconfigure %s 1 -weight 1", 
       this->BottomFrame->GetWidgetName());
     }
   else
     {
-    this->Script("grid remove %s", this->FileNameLabel->GetWidgetName());
-    this->Script("grid remove %s", this->FileTypesLabel->GetWidgetName());
-    this->Script("grid remove %s", this->FileNameText->GetWidgetName());
-    this->Script("grid remove %s", this->FileTypesBox->GetWidgetName());
-    this->Script("grid remove %s", this->OKButton->GetWidgetName());
-    this->Script("grid remove %s", this->CancelButton->GetWidgetName());
+    this->QueueScript("grid remove %s", this->FileNameLabel->GetWidgetName());
+    this->QueueScript("grid remove %s", this->FileTypesLabel->GetWidgetName());
+    this->QueueScript("grid remove %s", this->FileNameText->GetWidgetName());
+    this->QueueScript("grid remove %s", this->FileTypesBox->GetWidgetName());
+    this->QueueScript("grid remove %s", this->OKButton->GetWidgetName());
+    this->QueueScript("grid remove %s", this->CancelButton->GetWidgetName());
 
-    this->Script("grid columnconfigure %s 1 -weight 0", 
+    this->QueueScript("grid columnconfigure %s 1 -weight 0", 
       this->BottomFrame->GetWidgetName());
 
-    this->Script("grid %s -column 0 -row 0 -sticky nw -padx 2 -pady 2", 
-                 this->OKButton->GetWidgetName());
-    this->Script("grid %s -column 1 -row 0 -sticky nw -padx 2 -pady 2", 
-                 this->CancelButton->GetWidgetName());
+    this->QueueScript("grid %s -column 0 -row 0 -sticky nw -padx 2 -pady 2", 
+                      this->OKButton->GetWidgetName());
+    this->QueueScript("grid %s -column 1 -row 0 -sticky nw -padx 2 -pady 2", 
+                      this->CancelButton->GetWidgetName());
     }
 
   this->CreatePreviewFrame();
@@ -333,13 +333,13 @@ void vtkKWFileBrowserDialog::CreatePreviewFrame()
     }
   if (this->PreviewFrameVisibility)
     {
-    this->Script("pack %s -side top -fill both -expand y -padx 2 -pady 2",
-                 this->PreviewFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill both -expand y -padx 2 -pady 2",
+                      this->PreviewFrame->GetWidgetName());
     }
   else
     {
-    this->Script("pack forget %s",
-                 this->PreviewFrame->GetWidgetName());
+    this->QueueScript("pack forget %s",
+                      this->PreviewFrame->GetWidgetName());
     }
 }
 
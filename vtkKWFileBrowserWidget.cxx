@@ -136,8 +136,8 @@ void vtkKWFileBrowserWidget::CreateWidget()
   this->MainFrame->SetSeparatorVisibility(1);
   this->MainFrame->SetHeight(345);
 
-  this->Script("pack %s -fill both -expand true",
-               this->MainFrame->GetWidgetName());
+  this->QueueScript("pack %s -fill both -expand true",
+                    this->MainFrame->GetWidgetName());
 
   this->CreateDirectoryExplorer();
   this->CreateFileListTable(); 
@@ -156,8 +156,8 @@ void vtkKWFileBrowserWidget::Pack()
     this->DirFileFrame->SetFrame1Visibility(this->DirectoryExplorerVisibility);
     this->DirFileFrame->SetFrame2Visibility(this->FileListTableVisibility);
     
-    this->Script("pack %s -side top -fill both -expand true",
-                 this->DirFileFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill both -expand true",
+                      this->DirFileFrame->GetWidgetName());
     }
   else
     {
@@ -221,7 +221,7 @@ void vtkKWFileBrowserWidget::CreateDirectoryExplorer()
     this->UpdateDirectorySelectionColor();
     this->PropagateMultipleSelection();
 
-    this->Script(
+    this->QueueScript(
       "pack %s -side top -fill both -expand true -padx 1 -pady 1",
       this->DirectoryExplorer->GetWidgetName());
     }
@@ -261,7 +261,7 @@ void vtkKWFileBrowserWidget::CreateFileListTable()
     this->UpdateFileSelectionColor();
     this->PropagateMultipleSelection();
 
-    this->Script(
+    this->QueueScript(
       "pack %s -side top -fill both -expand true -padx 1 -pady 1",
       this->FileListTable->GetWidgetName());
     }
@@ -282,8 +282,8 @@ void vtkKWFileBrowserWidget::CreateFavoriteDirectoriesFrame()
         this, "FavoriteDirectorySelectedCallback");
       }
 
-    this->Script("pack %s -fill x -expand true",
-                 this->FavoriteDirectoriesFrame->GetWidgetName());
+    this->QueueScript("pack %s -fill x -expand true",
+                      this->FavoriteDirectoriesFrame->GetWidgetName());
     }
 }
 
@@ -274,7 +274,7 @@ void vtkKWFileListTable::CreateWidget()
   filelist->SetBinding("<F2>", this, "RenameFileCallback");
   filelist->SetBinding("<FocusIn>", this, "FocusInCallback");
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -fill both -expand true -padx 1 -pady 1",
     this->FileList->GetWidgetName());
 }
@@ -173,18 +173,18 @@ void vtkKWFrameWithLabel::CreateWidget()
   this->Icon->SetBalloonHelpString(
     ks_("Frame With Label|Shrink or expand the frame"));
   
-  this->Script(
+  this->QueueScript(
     "pack %s -fill x -expand n -anchor nw -side top", this->ExternalMarginFrame->GetWidgetName());
-  this->Script(
+  this->QueueScript(
     "pack %s -fill both -expand y -anchor nw -side top", this->CollapsibleFrame->GetWidgetName());
-  this->Script(
+  this->QueueScript(
     "pack %s -fill x -expand n -side top", this->InternalMarginFrame->GetWidgetName());
 
-  this->Script(
+  this->QueueScript(
     "pack %s -padx 2 -pady 2 -fill both -expand yes -side top",
-               this->Frame->GetWidgetName());
+                    this->Frame->GetWidgetName());
 
-  this->Script(
+  this->QueueScript(
     "pack %s -anchor nw -side left -fill both -expand y -padx 2 -pady 0",
     this->Label->GetWidgetName());
 
@@ -431,11 +431,11 @@ void vtkKWFrameWithLabel::ExpandFrame()
 {
   if (this->Frame && this->Frame->IsCreated())
     {
-    this->Script("pack %s -fill both -expand yes -padx 2 -pady 2",
-                 this->Frame->GetWidgetName());
+    this->QueueScript("pack %s -fill both -expand yes -padx 2 -pady 2",
+                      this->Frame->GetWidgetName());
     if (this->ChangePackingOnCollapse && this->IsPacked())
       {
-      this->Script("pack configure %s -expand y", this->GetWidgetName());
+      this->QueueScript("pack configure %s -expand y", this->GetWidgetName());
       }
     }
   if (this->IconData && this->Icon)
@@ -450,12 +450,12 @@ void vtkKWFrameWithLabel::CollapseFrame()
 {
   if (this->Frame && this->Frame->IsCreated())
     {
-    this->Script("pack forget %s", this->Frame->GetWidgetName());
+    this->QueueScript("pack forget %s", this->Frame->GetWidgetName());
     this->SetWidth(this->GetWidth());
     this->SetHeight(this->GetHeight());
     if (this->ChangePackingOnCollapse && this->IsPacked())
       {
-      this->Script("pack configure %s -expand n", this->GetWidgetName());
+      this->QueueScript("pack configure %s -expand n", this->GetWidgetName());
       }
     }
   if (this->IconData && this->Icon)
@@ -171,6 +171,7 @@ void vtkKWFrameWithScrollbar::ConfigureWidget()
   this->Script("%s configure -constrainedwidth %d -constrainedheight %d",
                this->ScrollableFrame->GetWidgetName(), 
                constrained_width, constrained_height);
+  this->ScrollableFrame->InvalidateConfigurationOptionCache();
 }
 
 //----------------------------------------------------------------------------
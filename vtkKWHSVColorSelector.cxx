@@ -63,6 +63,11 @@ vtkKWHSVColorSelector::vtkKWHSVColorSelector()
   this->ValueBoxCanvas           = vtkKWCanvas::New();
   this->HueSatLabel              = vtkKWLabel::New();
   this->ValueLabel               = vtkKWLabel::New();
+
+  this->HueSatWheelSurface         = new vtkKWTkPhotoSurface;
+  this->HueSatWheelDisabledSurface = new vtkKWTkPhotoSurface;
+  this->ValueBoxSurface            = new vtkKWTkPhotoSurface;
+  this->ValueBoxDisabledSurface    = new vtkKWTkPhotoSurface;
 }
 
 //----------------------------------------------------------------------------
@@ -107,6 +112,11 @@ vtkKWHSVColorSelector::~vtkKWHSVColorSelector()
     this->ValueLabel->Delete();
     this->ValueLabel = NULL;
     }
+
+  delete this->HueSatWheelSurface;
+  delete this->HueSatWheelDisabledSurface;
+  delete this->ValueBoxSurface;
+  delete this->ValueBoxDisabledSurface;
 }
 
 //----------------------------------------------------------------------------
@@ -650,11 +660,14 @@ void vtkKWHSVColorSelector::UpdateHueSatWheelImage()
 
   int diameter = 2 * this->HueSatWheelRadius;
 
-  unsigned char *buffer = new unsigned char [diameter * diameter * 4];
-  unsigned char *ptr = buffer;
+  if (!this->HueSatWheelSurface->SetSize(diameter, diameter, 4) ||
+      !this->HueSatWheelDisabledSurface->SetSize(diameter, diameter, 4))
+    {
+    return;
+    }
 
-  unsigned char *buffer_d = new unsigned char [diameter * diameter * 4];
-  unsigned char *ptr_d = buffer_d;
+  unsigned char *ptr = this->HueSatWheelSurface->GetPixels();
+  unsigned char *ptr_d = this->HueSatWheelDisabledSurface->GetPixels();
 
   double hue, sat, r, g, b;
 
@@ -700,13 +713,9 @@ void vtkKWHSVColorSelector::UpdateHueSatWheelImage()
   img_name << this->HueSatWheelCanvas->GetWidgetName() 
            << "." << VTK_KW_HSV_SEL_IMAGE_TAG;
 
-  vtkKWTkUtilities::UpdatePhoto(this->GetApplication(),
-                                img_name.str().c_str(),
-                                buffer,
-                                diameter, diameter, 4,
-                                diameter * diameter * 4);
-
-  delete [] buffer;
+  this->HueSatWheelSurface->MarkAsModified();
+  this->HueSatWheelSurface->UpdatePhoto(
+    this->GetApplication(), img_name.str().c_str());
 
   // Update the image (disabled state)
 
@@ -714,13 +723,9 @@ void vtkKWHSVColorSelector::UpdateHueSatWheelImage()
   img_name_d << this->HueSatWheelCanvas->GetWidgetName() 
              << "." << VTK_KW_HSV_SEL_IMAGE_TAG << "_disabled";
 
-  vtkKWTkUtilities::UpdatePhoto(this->GetApplication(),
-                                img_name_d.str().c_str(),
-                                buffer_d,
-                                diameter, diameter, 4,
-                                diameter * diameter * 4);
-
-  delete [] buffer_d;
+  this->HueSatWheelDisabledSurface->MarkAsModified();
+  this->HueSatWheelDisabledSurface->UpdatePhoto(
+    this->GetApplication(), img_name_d.str().c_str());
 }
 
 //----------------------------------------------------------------------------
@@ -879,11 +884,14 @@ void vtkKWHSVColorSelector::UpdateValueBoxImage()
   int height = 2 * this->HueSatWheelRadius;
   int width = this->ValueBoxWidth;
 
-  unsigned char *buffer = new unsigned char [width * height * 3];
-  unsigned char *ptr = buffer;
+  if (!this->ValueBoxSurface->SetSize(width, height, 3) ||
+      !this->ValueBoxDisabledSurface->SetSize(width, height, 4))
+    {
+    return;
+    }
 
-  unsigned char *buffer_d = new unsigned char [width * height * 4];
-  unsigned char *ptr_d = buffer_d;
+  unsigned char *ptr = this->ValueBoxSurface->GetPixels();
+  unsigned char *ptr_d = this->ValueBoxDisabledSurface->GetPixels();
 
   double value, r, g, b;
 
@@ -915,13 +923,9 @@ void vtkKWHSVColorSelector::UpdateValueBoxImage()
   img_name << this->ValueBoxCanvas->GetWidgetName() 
            << "." << VTK_KW_HSV_SEL_IMAGE_TAG;
 
-  vtkKWTkUtilities::UpdatePhoto(this->GetApplication(),
-                                img_name.str().c_str(),
-                                buffer,
-                                width, height, 3,
-                                width * height * 3);
-
-  delete [] buffer;
+  this->ValueBoxSurface->MarkAsModified();
+  this->ValueBoxSurface->UpdatePhoto(
+    this->GetApplication(), img_name.str().c_str());
 
   // Update disabled image
 
@@ -929,13 +933,9 @@ void vtkKWHSVColorSelector::UpdateValueBoxImage()
   img_name_d << this->ValueBoxCanvas->GetWidgetName() 
              << "." << VTK_KW_HSV_SEL_IMAGE_TAG << "_disabled";
 
-  vtkKWTkUtilities::UpdatePhoto(this->GetApplication(),
-                                img_name_d.str().c_str(),
-                                buffer_d,
-                                width, height, 4,
-                                width * height * 4);
-
-  delete [] buffer_d;
+  this->ValueBoxDisabledSurface->MarkAsModified();
+  this->ValueBoxDisabledSurface->UpdatePhoto(
+    this->GetApplication(), img_name_d.str().c_str());
 }
 
 //----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 
 class vtkKWCanvas;
 class vtkKWLabel;
+class vtkKWTkPhotoSurface;
 
 class KWWidgets_EXPORT vtkKWHSVColorSelector : public vtkKWCompositeWidget
 {
@@ -178,6 +179,14 @@ protected:
   vtkKWLabel  *HueSatLabel;
   vtkKWLabel  *ValueLabel;
 
+  // Images (and their disabled counterparts), reused from one update
+  // to the next
+
+  vtkKWTkPhotoSurface *HueSatWheelSurface;
+  vtkKWTkPhotoSurface *HueSatWheelDisabledSurface;
+  vtkKWTkPhotoSurface *ValueBoxSurface;
+  vtkKWTkPhotoSurface *ValueBoxDisabledSurface;
+
   // Description:
   // Bind/Unbind all components.
   virtual void Bind();
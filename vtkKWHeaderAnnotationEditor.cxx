@@ -146,8 +146,8 @@ void vtkKWHeaderAnnotationEditor::CreateWidget()
   this->TextFrame->SetParent(frame);
   this->TextFrame->Create();
 
-  this->Script("pack %s -side top -fill both -expand y", 
-               this->TextFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand y", 
+                    this->TextFrame->GetWidgetName());
   
   // --------------------------------------------------------------
   // Header text
@@ -163,9 +163,9 @@ void vtkKWHeaderAnnotationEditor::CreateWidget()
     k_("Set the header annotation. The text will automatically scale "
        "to fit within the allocated space"));
 
-  this->Script("pack %s -padx 2 -pady 2 -side %s -anchor nw -expand y -fill x",
-               this->TextEntry->GetWidgetName(),
-               (popup_text_property ? "left" : "top"));
+  this->QueueScript("pack %s -padx 2 -pady 2 -side %s -anchor nw -expand y -fill x",
+                    this->TextEntry->GetWidgetName(),
+                    (popup_text_property ? "left" : "top"));
   
   // --------------------------------------------------------------
   // Text property : popup button if needed
@@ -188,8 +188,8 @@ void vtkKWHeaderAnnotationEditor::CreateWidget()
     popupframe->SetBorderWidth(2);
     popupframe->SetReliefToGroove();
 
-    this->Script("pack %s -padx 2 -pady 2 -side left -anchor w", 
-                 this->TextPropertyPopupButton->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side left -anchor w", 
+                      this->TextPropertyPopupButton->GetWidgetName());
 
     this->TextPropertyWidget->SetParent(
       this->TextPropertyPopupButton->GetWidget()->GetPopupFrame());
@@ -210,9 +210,9 @@ void vtkKWHeaderAnnotationEditor::CreateWidget()
     ks_("Header Annotation Editor|Header properties:"));
   this->TextPropertyWidget->SetChangedCommand(this, "TextPropertyCallback");
 
-  this->Script("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
-               this->TextPropertyWidget->GetWidgetName(),
-               this->TextPropertyWidget->GetLongFormat() ? 0 : 2);
+  this->QueueScript("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
+                    this->TextPropertyWidget->GetWidgetName(),
+                    this->TextPropertyWidget->GetLongFormat() ? 0 : 2);
 
   // --------------------------------------------------------------
   // Update the GUI according to the Ivar value (i.e. the corner prop, etc.)
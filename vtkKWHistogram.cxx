@@ -14,15 +14,23 @@
 
 #include "vtkKWHistogram.h"
 
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
 #include "vtkColorTransferFunction.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
+#include "vtkExtentTranslator.h"
 #include "vtkImageData.h"
 #include "vtkMath.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkDoubleArray.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/stl/vector>
 
 #include <float.h>
 
@@ -53,7 +61,28 @@ vtkKWHistogram::vtkKWHistogram()
   this->LogMode                  = 1;
 
   this->LastStatisticsBuildTime  = 0;
+  this->MinimumOccurenceBin      = -1;
+  this->MaximumOccurenceBin      = -1;
   this->MaximumNumberOfBins      = 10000;
+
+  this->ImageModifiedBins[0]     = 0;
+  this->ImageModifiedBins[1]     = -1;
+  this->ImageModifiedBinsTime    = 0;
+  this->ImageResampledBins       = NULL;
+  this->ImageTransferFunctionColors = NULL;
+
+  this->AccumulatedBins              = vtkDoubleArray::New();
+  this->LastAccumulatedBinsBuildTime = 0;
+
+  this->Threader                 = vtkMultiThreader::New();
+  this->NumberOfThreads          = this->Threader->GetNumberOfThreads();
+  this->SinglePassBuild          = 0;
+
+  this->ScalarsRangeCacheArray     = NULL;
+  this->ScalarsRangeCacheComponent = 0;
+  this->ScalarsRangeCacheTime      = 0;
+  this->ScalarsRangeCache[0]       = 0.0;
+  this->ScalarsRangeCache[1]       = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -65,6 +94,12 @@ vtkKWHistogram::~vtkKWHistogram()
     this->Bins = NULL;
     }
 
+  if (this->AccumulatedBins)
+    {
+    this->AccumulatedBins->Delete();
+    this->AccumulatedBins = NULL;
+    }
+
   if (this->Image)
     {
     this->Image->Delete();
@@ -77,11 +112,29 @@ vtkKWHistogram::~vtkKWHistogram()
     this->ImageCoordinates = NULL;
     }
 
+  if (this->ImageResampledBins)
+    {
+    this->ImageResampledBins->Delete();
+    this->ImageResampledBins = NULL;
+    }
+
+  if (this->ImageTransferFunctionColors)
+    {
+    this->ImageTransferFunctionColors->Delete();
+    this->ImageTransferFunctionColors = NULL;
+    }
+
   if (this->LastImageDescriptor)
     {
     delete this->LastImageDescriptor;
     this->LastImageDescriptor = NULL;
     }
+
+  if (this->Threader)
+    {
+    this->Threader->Delete();
+    this->Threader = NULL;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -94,29 +147,42 @@ vtkIdType vtkKWHistogram::GetNumberOfBins()
   
   return 0;
 }
-
 //----------------------------------------------------------------------------
 
+// The binning engine.
+// The tuples to bin are split between NumberOfThreads threads, each of them
+// filling its own private copy of the bins; the private bins are then
+// merged into the histogram bins. Since each bin only stores an integer
+// number of occurences, the merge is exact and the result is identical to
+// the one obtained by a single thread.
+// The kernels are templated over the native scalar type, values are only
+// converted to double when a bin index can not be computed from an integer
+// difference.
+
+// Do not bother spawning threads for less than that many tuples per thread
+
+#define VTK_KW_HIST_MIN_TUPLES_PER_THREAD 65536
+
+// Number of chunks the tuples are split into, so that progress events can be
+// sent in between
+
+#define VTK_KW_HIST_NB_PROGRESS_CHUNKS 5
+
 // Special version for unsigned long: since we can not promote to any
 // signed bigger type, use double for safety (I have no data to verify)
 
-void vtkKWHistogramBuildInt(
-  unsigned long *data, vtkIdType nb_tuples, int nb_of_components, vtkKWHistogram *self)
+void vtkKWHistogramBinInt(
+  unsigned long *data, vtkIdType nb_tuples, int nb_of_components, 
+  double range0, double weight, double *bins_ptr)
 {
-  if (!data || !nb_tuples || nb_of_components < 1 || !self)
-    {
-    return;
-    }
-
   typedef double cast_type;
 
-  double *bins_ptr = self->GetBins()->GetPointer(0);
-  cast_type shift = (cast_type)self->GetRange()[0];
+  cast_type shift = (cast_type)range0;
 
   unsigned long *data_end = data + nb_tuples * nb_of_components;
   while (data < data_end)
     {
-    bins_ptr[(int)(cast_type(*data) - shift)]++;
+    bins_ptr[(vtkIdType)(cast_type(*data) - shift)] += weight;
     data += nb_of_components;
     }
 }
@@ -126,21 +192,16 @@ void vtkKWHistogramBuildInt(
 #if VTK_KW_ASSUME_LOWER_BOUND_IS_IN_TYPE_RANGE
 
 template <class T>
-void vtkKWHistogramBuildInt(
-  T *data, vtkIdType nb_tuples, int nb_of_components, vtkKWHistogram *self)
+void vtkKWHistogramBinInt(
+  T *data, vtkIdType nb_tuples, int nb_of_components, 
+  double range0, double weight, double *bins_ptr)
 {
-  if (!data || !nb_tuples || nb_of_components < 1 || !self)
-    {
-    return;
-    }
-
-  double *bins_ptr = self->GetBins()->GetPointer(0);
-  T shift = (T)self->GetRange()[0];
+  T shift = (T)range0;
 
   T *data_end = data + nb_tuples * nb_of_components;
   while (data < data_end)
     {
-    bins_ptr[*data - shift]++;
+    bins_ptr[(vtkIdType)(*data - shift)] += weight;
     data += nb_of_components;
     }
 }
@@ -148,23 +209,18 @@ void vtkKWHistogramBuildInt(
 #else
 
 template <class T>
-void vtkKWHistogramBuildInt(
-  T *data, vtkIdType nb_tuples, int nb_of_components, vtkKWHistogram *self)
+void vtkKWHistogramBinInt(
+  T *data, vtkIdType nb_tuples, int nb_of_components, 
+  double range0, double weight, double *bins_ptr)
 {
-  if (!data || !nb_tuples || nb_of_components < 1 || !self)
-    {
-    return;
-    }
-  
   typedef long cast_type;
 
-  double *bins_ptr = self->GetBins()->GetPointer(0);
-  cast_type shift = (cast_type)self->GetRange()[0];
+  cast_type shift = (cast_type)range0;
 
   T *data_end = data + nb_tuples * nb_of_components;
   while (data < data_end)
     {
-    bins_ptr[cast_type(*data) - shift]++;
+    bins_ptr[cast_type(*data) - shift] += weight;
     data += nb_of_components;
     }
 }
@@ -172,21 +228,15 @@ void vtkKWHistogramBuildInt(
 #endif
 
 template <class T>
-void vtkKWHistogramBuildFloat(
-  T *data, vtkIdType nb_tuples, int nb_of_components, vtkKWHistogram *self)
+void vtkKWHistogramBinFloat(
+  T *data, vtkIdType nb_tuples, int nb_of_components, 
+  const double range[2], vtkIdType nb_of_bins, double weight, 
+  double *bins_ptr)
 {
-  if (!data || !nb_tuples || nb_of_components < 1 || !self)
-    {
-    return;
-    }
-
-  double range[2];
-  self->GetRange(range);
   double bin_width = 
     (range[1] == range[0] ? 1 : 
-     (double)self->GetNumberOfBins() / (range[1] - range[0]));
+     (double)nb_of_bins / (range[1] - range[0]));
 
-  double *bins_ptr = self->GetBins()->GetPointer(0);
   int index;
 
   T *data_end = data + nb_tuples * nb_of_components;
@@ -197,70 +247,115 @@ void vtkKWHistogramBuildFloat(
 #endif
       {
       index = vtkMath::Floor(((double)*data - range[0]) * bin_width);
-      bins_ptr[index]++;
+      bins_ptr[index] += weight;
       }
     data += nb_of_components;
     }
 }
 
+//----------------------------------------------------------------------------
+class vtkKWHistogramProvisionalBins;
+class vtkKWHistogramBinningInfo
+{
+public:
+  int       DataType;           // native scalar type of the data
+  void      *Data;              // pointer to the first tuple
+  int       NumberOfComponents; // of the data
+  int       Component;          // component to bin
+  vtkIdType StartTuple;         // first tuple to bin in this pass
+  vtkIdType NumberOfTuples;     // number of tuples to bin in this pass
+  double    Range[2];           // histogram range
+  vtkIdType NumberOfBins;       // histogram number of bins
+  int       IntegerBinning;     // one bin per integer value
+  double    Weight;             // added to a bin for each value (or -1)
+  double    **ThreadBins;       // bins for each thread
+  vtkKWHistogramProvisionalBins *ProvisionalBins; // same, single pass
+};
+
+//----------------------------------------------------------------------------
 template <class T>
-void vtkKWHistogramBuildIntOrFloat(
-  T *data, vtkIdType nb_tuples, int nb_of_components, vtkKWHistogram *self)
+void vtkKWHistogramBinTuples(
+  T *data, vtkKWHistogramBinningInfo *info, 
+  vtkIdType start_tuple, vtkIdType nb_tuples, double *bins_ptr)
 {
-  if (!data || !nb_tuples || nb_of_components < 1 || !self)
+  if (!data || nb_tuples <= 0 || !bins_ptr)
     {
     return;
     }
 
-  double range[2];
-  self->GetRange(range);
-  if (self->GetNumberOfBins() == (vtkIdType)(range[1] - range[0]))
+  data += start_tuple * info->NumberOfComponents + info->Component;
+  if (info->IntegerBinning)
     {
-    vtkKWHistogramBuildInt(data, nb_tuples, nb_of_components, self);
+    vtkKWHistogramBinInt(
+      data, nb_tuples, info->NumberOfComponents, info->Range[0], 
+      info->Weight, bins_ptr);
     }
   else
     {
-    vtkKWHistogramBuildFloat(data, nb_tuples, nb_of_components, self);
+    vtkKWHistogramBinFloat(
+      data, nb_tuples, info->NumberOfComponents, 
+      info->Range, info->NumberOfBins, info->Weight, bins_ptr);
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkKWHistogram::EmptyHistogram()
+VTK_THREAD_RETURN_TYPE vtkKWHistogramBinningThreadedExecute(void *arg)
 {
-  if (this->Bins)
+  vtkMultiThreader::ThreadInfo *thread_info = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWHistogramBinningInfo *info = 
+    static_cast<vtkKWHistogramBinningInfo*>(thread_info->UserData);
+
+  // Split the tuples evenly between threads
+
+  vtkIdType nb_threads = thread_info->NumberOfThreads;
+  vtkIdType thread_id = thread_info->ThreadID;
+  vtkIdType start_tuple = 
+    info->StartTuple + (info->NumberOfTuples * thread_id) / nb_threads;
+  vtkIdType end_tuple = 
+    info->StartTuple + (info->NumberOfTuples * (thread_id + 1)) / nb_threads;
+
+  switch (info->DataType)
     {
-    this->Bins->SetNumberOfComponents(1);
-    this->Bins->SetNumberOfTuples(0);
+    vtkTemplateMacro(
+      vtkKWHistogramBinTuples(
+        static_cast<VTK_TT*>(info->Data), info, 
+        start_tuple, end_tuple - start_tuple, 
+        info->ThreadBins[thread_id]));
     }
+
+  return VTK_THREAD_RETURN_VALUE;
 }
 
 //----------------------------------------------------------------------------
-void vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
-  vtkDataArray *scalars, 
-  int comp,
-  double range[2], 
-  vtkIdType *nb_of_bins)
+int vtkKWHistogram::IsSupportedDataType(int data_type)
 {
-  if (!scalars ||
-      comp < 0 || comp >= scalars->GetNumberOfComponents() ||
-      !range || !nb_of_bins)
+  switch (data_type)
     {
-    vtkWarningMacro( "Missing parameters" );
-    return;
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      return 1;
     }
+  return 0;
+}
 
-  // Get the histogram range required for those scalars.
-  // For some big data types (int, long, double), let's use the more
-  // accurate GetScalarRange(..., double) function, which does
-  // not cache the range (it iterates over data each time), but
-  // get the proper result and avoid accessing memory out of the array.
-  // If 'reset_range' is true, the Range ivar is reset to the range
-  // that was just computed. If not (accumulate mode), make sure the
-  // current range fits inside the Range ivar.
-
-  // Given the range, compute the number of bins required.
-
-  double dscalars_range[2];
+//----------------------------------------------------------------------------
+void vtkKWHistogram::ComputeRangeAndNumberOfBins(
+  vtkDataArray *scalars,
+  const double scalars_range[2],
+  vtkIdType max_nb_of_bins,
+  double range[2], 
+  vtkIdType *nb_of_bins)
+{
   double try_nb_of_bins, delta;
 
   switch (scalars->GetDataType())
@@ -273,50 +368,26 @@ void vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
       try_nb_of_bins = (range[1] - range[0]);
       break;
 
-    case VTK_SHORT:
-    case VTK_UNSIGNED_SHORT:
-      scalars->GetRange(dscalars_range, comp);
-      range[0] = dscalars_range[0];
-      range[1] = dscalars_range[1] + 1.0;
-      try_nb_of_bins = (range[1] - range[0]);
-      break;
-
-    case VTK_INT:
-    case VTK_UNSIGNED_INT:
-    case VTK_LONG:
-    case VTK_UNSIGNED_LONG:
-      scalars->GetRange(dscalars_range, comp);
-      range[0] = dscalars_range[0];
-      range[1] = dscalars_range[1] + 1.0;
-      try_nb_of_bins = (range[1] - range[0]);
-      break;
-
     case VTK_FLOAT:
-      scalars->GetRange(dscalars_range, comp);
-      delta = (dscalars_range[1] - dscalars_range[0]) * 0.01;
-      range[0] = dscalars_range[0];
-      range[1] = dscalars_range[1] + delta;
-      try_nb_of_bins = this->MaximumNumberOfBins;
-      break;
-
     case VTK_DOUBLE:
-      scalars->GetRange(dscalars_range, comp);
-      delta = (dscalars_range[1] - dscalars_range[0]) * 0.01;
-      range[0] = dscalars_range[0];
-      range[1] = dscalars_range[1] + delta;
-      try_nb_of_bins = this->MaximumNumberOfBins;
+      delta = (scalars_range[1] - scalars_range[0]) * 0.01;
+      range[0] = scalars_range[0];
+      range[1] = scalars_range[1] + delta;
+      try_nb_of_bins = (double)max_nb_of_bins;
       break;
 
     default:
-      vtkErrorMacro( "Unhandled data type: " << scalars->GetDataType() );
-      return;
+      range[0] = scalars_range[0];
+      range[1] = scalars_range[1] + 1.0;
+      try_nb_of_bins = (range[1] - range[0]);
+      break;
     }
 
   // Check if too large number of bins, or exceeded capacity
 
-  if (try_nb_of_bins > this->MaximumNumberOfBins || try_nb_of_bins < 1)
+  if (try_nb_of_bins > max_nb_of_bins || try_nb_of_bins < 1)
     {
-    *nb_of_bins = this->MaximumNumberOfBins;
+    *nb_of_bins = max_nb_of_bins;
     }
   else
     {
@@ -325,256 +396,1849 @@ void vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
 }
 
 //----------------------------------------------------------------------------
-void vtkKWHistogram::EstimateHistogramRange(
-  vtkDataArray *scalars, 
-  int comp,
-  double range[2])
-{
-  vtkIdType nb_bins;
-  vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
-    scalars, comp, range, &nb_bins);
-}
-
-//----------------------------------------------------------------------------
-void vtkKWHistogram::UpdateHistogram(vtkDataArray *scalars, 
-                                     int comp,
-                                     int reset_range)
+int vtkKWHistogram::BinScalars(vtkDataArray *scalars, 
+                               int comp,
+                               vtkIdType start_tuple,
+                               vtkIdType nb_of_tuples,
+                               double weight,
+                               double progress_start,
+                               double progress_span)
 {
-  if (!scalars)
+  if (!scalars || comp < 0 || comp >= scalars->GetNumberOfComponents())
     {
-    vtkErrorMacro(<< "Can not build histogram from NULL scalars!");
-    return;
+    vtkErrorMacro(<< "Can not bin invalid scalars or component!");
+    return 0;
     }
 
-  if (comp < 0 || comp >= scalars->GetNumberOfComponents())
+  int data_type = scalars->GetDataType();
+  if (!vtkKWHistogram::IsSupportedDataType(data_type))
     {
-    vtkErrorMacro(<< "Can not build histogram from invalid component!");
-    return;
+    vtkErrorMacro(<< "Can not build histogram from unsupported data type!");
+    return 0;
     }
 
-  // Get the histogram range required for those scalars.
-  // Also, given the range, compute the number of bins needed
-  // if 'reset_range' is true, reset the Range ivar, otherwise check
-  // that the current range is within the ivar (accumulate mode)
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
+  if (!nb_of_bins || nb_of_tuples <= 0)
+    {
+    return 1;
+    }
 
-  double range[2];
-  vtkIdType nb_of_bins;
+  vtkKWHistogramBinningInfo info;
+  info.DataType = data_type;
+  info.Data = scalars->GetVoidPointer(0);
+  info.NumberOfComponents = scalars->GetNumberOfComponents();
+  info.Component = comp;
+  info.Range[0] = this->Range[0];
+  info.Range[1] = this->Range[1];
+  info.NumberOfBins = nb_of_bins;
+  info.IntegerBinning = 
+    (data_type != VTK_FLOAT && data_type != VTK_DOUBLE &&
+     nb_of_bins == (vtkIdType)(this->Range[1] - this->Range[0]));
+  info.Weight = weight;
+  info.ProvisionalBins = NULL;
+
+  // Do not use more threads than worth it
+
+  vtkIdType nb_of_threads = nb_of_tuples / VTK_KW_HIST_MIN_TUPLES_PER_THREAD;
+  if (nb_of_threads > this->NumberOfThreads)
+    {
+    nb_of_threads = this->NumberOfThreads;
+    }
+  if (nb_of_threads < 1)
+    {
+    nb_of_threads = 1;
+    }
 
-  this->EstimateHistogramRangeAndNumberOfBins(
-    scalars, comp, range, &nb_of_bins);
+  // A single thread bins directly into the histogram, otherwise each thread
+  // gets its own private bins
 
-  if (reset_range)
+  double *bins_ptr = this->Bins->GetPointer(0);
+  info.ThreadBins = new double* [nb_of_threads];
+  vtkIdType i, bin;
+  if (nb_of_threads == 1)
     {
-    this->Range[0] = range[0];
-    this->Range[1] = range[1];
+    info.ThreadBins[0] = bins_ptr;
     }
   else
     {
-    if (range[0] < this->Range[0] || range[1] > this->Range[1])
+    for (i = 0; i < nb_of_threads; i++)
       {
-      vtkErrorMacro(<< "Scalars range [" 
-                    << range[0] << ".." << range[1] << "] "
-                    << "does not fit in the current Range ["
-                    << this->Range[0] << ".." << this->Range[1] << "]!");
-      return;
+      info.ThreadBins[i] = new double [nb_of_bins];
+      memset(info.ThreadBins[i], 0, nb_of_bins * sizeof(double));
       }
+    this->Threader->SetNumberOfThreads((int)nb_of_threads);
+    this->Threader->SetSingleMethod(
+      vtkKWHistogramBinningThreadedExecute, &info);
     }
 
-  this->InvokeEvent(vtkCommand::StartEvent, NULL);
+  // Loop over the data in chunks and fill in the bins
 
-  // Allocate the bins 
-  // if 'reset_range' is true, reset the number of bins, otherwise reset
-  // it only if it was 0 before (i.e., EmptyHistogram was called).
+  vtkIdType inc_tuple = (vtkIdType)ceil(
+    (double)nb_of_tuples / (double)VTK_KW_HIST_NB_PROGRESS_CHUNKS);
+  vtkIdType end_tuple = start_tuple + nb_of_tuples;
+  double progress;
 
-  this->Bins->SetNumberOfComponents(1);
-  vtkIdType old_nb_of_bins = this->Bins->GetNumberOfTuples();
-  if (reset_range)
-    {
-    this->Bins->SetNumberOfTuples(nb_of_bins);
-    }
-  else
+  info.StartTuple = start_tuple;
+  while (info.StartTuple < end_tuple)
     {
-    if (old_nb_of_bins == 0)
+    // Make sure we are really one after...
+
+    info.NumberOfTuples = inc_tuple;
+    if (info.StartTuple + info.NumberOfTuples >= end_tuple)
       {
-      this->Bins->SetNumberOfTuples(nb_of_bins);
+      info.NumberOfTuples = end_tuple - info.StartTuple;
+      }
+
+    if (nb_of_threads == 1)
+      {
+      vtkMultiThreader::ThreadInfo thread_info;
+      thread_info.ThreadID = 0;
+      thread_info.NumberOfThreads = 1;
+      thread_info.UserData = &info;
+      vtkKWHistogramBinningThreadedExecute(&thread_info);
+      }
+    else
+      {
+      this->Threader->SingleMethodExecute();
+      }
+
+    info.StartTuple += info.NumberOfTuples;
+
+    if (progress_span > 0.0)
+      {
+      progress = progress_start + progress_span * 
+        ((double)(info.StartTuple - start_tuple) / (double)nb_of_tuples);
+      this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
       }
     }
 
-  // Reset the bins to 0
+  // Merge the private bins
 
-  if (nb_of_bins != old_nb_of_bins)
+  if (nb_of_threads > 1)
     {
-    double *bins_ptr = this->Bins->GetPointer(0);
-    double *bins_ptr_end = bins_ptr + nb_of_bins;
-    while (bins_ptr < bins_ptr_end)
+    for (i = 0; i < nb_of_threads; i++)
       {
-      *bins_ptr++ = 0.0;
+      double *thread_bins_ptr = info.ThreadBins[i];
+      for (bin = 0; bin < nb_of_bins; bin++)
+        {
+        bins_ptr[bin] += thread_bins_ptr[bin];
+        }
+      delete [] thread_bins_ptr;
       }
     }
 
-  double progress = 0.2;
-  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+  delete [] info.ThreadBins;
 
-  // Loop over the data and fill in the bins
+  return 1;
+}
 
-  vtkIdType nb_of_components = scalars->GetNumberOfComponents();
-  vtkIdType nb_of_tuples = scalars->GetNumberOfTuples();
+//----------------------------------------------------------------------------
 
-  vtkIdType inc_tuple = (vtkIdType)ceil((double)nb_of_tuples / 5.0);
-  vtkIdType start_tuple = 0;
+// The batch engine.
+// The histograms of several components of the same scalars are filled in a
+// single interleaved pass: the tuples are processed in blocks small enough
+// to stay in the cache, each block being binned for every component before
+// moving to the next one, so that the scalars are read from memory only
+// once. The same binning kernels are used, and so are the resulting bins.
+// The range of all components is computed in a single pass as well.
 
-  while (start_tuple < nb_of_tuples)
-    {
-    // Make sure we are really one after...
+// Number of tuples in each block
 
-    if (start_tuple + inc_tuple >= nb_of_tuples)
-      {
-      inc_tuple = nb_of_tuples - start_tuple;
-      }
+#define VTK_KW_HIST_BATCH_BLOCK_TUPLES 2048
 
-    switch (scalars->GetDataType())
-      {
-      case VTK_CHAR:
-      {
-      typedef char type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
-      }
-      break;
+class vtkKWHistogramBatchInfo
+{
+public:
+  int       DataType;           // native scalar type of the data
+  void      *Data;              // pointer to the first tuple
+  int       NumberOfComponents; // of the data
+  vtkIdType StartTuple;         // first tuple to process in this pass
+  vtkIdType NumberOfTuples;     // number of tuples to process in this pass
+  int       NumberOfHistograms; // number of components to bin
+  vtkKWHistogramBinningInfo *Histograms; // binning of each component
+  double    **ThreadBins;       // bins for each thread and each component
+  double    *ThreadRanges;      // range of all components, for each thread
+};
 
-      case VTK_SIGNED_CHAR:
+//----------------------------------------------------------------------------
+template <class T>
+void vtkKWHistogramComputeComponentsRange(
+  T *data, int nb_of_components, 
+  vtkIdType start_tuple, vtkIdType nb_tuples, double *ranges)
+{
+  // Same comparisons as vtkDataArray::GetRange, so that the ranges are the 
+  // same
+
+  double s;
+  int comp;
+
+  data += start_tuple * nb_of_components;
+  T *data_end = data + nb_tuples * nb_of_components;
+  while (data < data_end)
+    {
+    for (comp = 0; comp < nb_of_components; comp++)
       {
-      typedef signed char type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      s = (double)data[comp];
+      if (s < ranges[2 * comp])
+        {
+        ranges[2 * comp] = s;
+        }
+      if (s > ranges[2 * comp + 1])
+        {
+        ranges[2 * comp + 1] = s;
+        }
       }
-      break;
+    data += nb_of_components;
+    }
+}
 
-      case VTK_UNSIGNED_CHAR:
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKWHistogramBatchRangeThreadedExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *thread_info = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWHistogramBatchInfo *info = 
+    static_cast<vtkKWHistogramBatchInfo*>(thread_info->UserData);
+
+  vtkIdType nb_threads = thread_info->NumberOfThreads;
+  vtkIdType thread_id = thread_info->ThreadID;
+  vtkIdType start_tuple = 
+    info->StartTuple + (info->NumberOfTuples * thread_id) / nb_threads;
+  vtkIdType end_tuple = 
+    info->StartTuple + (info->NumberOfTuples * (thread_id + 1)) / nb_threads;
+
+  switch (info->DataType)
+    {
+    vtkTemplateMacro(
+      vtkKWHistogramComputeComponentsRange(
+        static_cast<VTK_TT*>(info->Data), info->NumberOfComponents,
+        start_tuple, end_tuple - start_tuple, 
+        info->ThreadRanges + thread_id * 2 * info->NumberOfComponents));
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkKWHistogramBinInterleavedTuples(
+  T *data, vtkKWHistogramBatchInfo *info, 
+  vtkIdType start_tuple, vtkIdType nb_tuples, double **bins)
+{
+  vtkIdType end_tuple = start_tuple + nb_tuples;
+  vtkIdType nb_block_tuples;
+  int i;
+
+  while (start_tuple < end_tuple)
+    {
+    nb_block_tuples = end_tuple - start_tuple;
+    if (nb_block_tuples > VTK_KW_HIST_BATCH_BLOCK_TUPLES)
       {
-      typedef unsigned char type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      nb_block_tuples = VTK_KW_HIST_BATCH_BLOCK_TUPLES;
       }
-      break;
-
-      case VTK_SHORT:
+    for (i = 0; i < info->NumberOfHistograms; i++)
       {
-      typedef short type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      vtkKWHistogramBinTuples(
+        data, info->Histograms + i, start_tuple, nb_block_tuples, bins[i]);
       }
-      break;
+    start_tuple += nb_block_tuples;
+    }
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKWHistogramBatchBinningThreadedExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *thread_info = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWHistogramBatchInfo *info = 
+    static_cast<vtkKWHistogramBatchInfo*>(thread_info->UserData);
+
+  vtkIdType nb_threads = thread_info->NumberOfThreads;
+  vtkIdType thread_id = thread_info->ThreadID;
+  vtkIdType start_tuple = 
+    info->StartTuple + (info->NumberOfTuples * thread_id) / nb_threads;
+  vtkIdType end_tuple = 
+    info->StartTuple + (info->NumberOfTuples * (thread_id + 1)) / nb_threads;
+
+  switch (info->DataType)
+    {
+    vtkTemplateMacro(
+      vtkKWHistogramBinInterleavedTuples(
+        static_cast<VTK_TT*>(info->Data), info, 
+        start_tuple, end_tuple - start_tuple, 
+        info->ThreadBins + thread_id * info->NumberOfHistograms));
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Run one of the batch passes over all the tuples, spread over threads, in
+// chunks so that progress events can be sent in between.
+
+void vtkKWHistogramExecuteBatchPass(
+  vtkKWHistogramBatchInfo *info,
+  vtkThreadFunctionType execute,
+  vtkMultiThreader *threader,
+  int nb_of_threads,
+  vtkIdType nb_of_tuples,
+  vtkObject *progress_object,
+  double progress_start,
+  double progress_span)
+{
+  if (nb_of_threads > 1)
+    {
+    threader->SetNumberOfThreads(nb_of_threads);
+    threader->SetSingleMethod(execute, info);
+    }
 
-      case VTK_UNSIGNED_SHORT:
+  vtkIdType inc_tuple = (vtkIdType)ceil(
+    (double)nb_of_tuples / (double)VTK_KW_HIST_NB_PROGRESS_CHUNKS);
+  double progress;
+
+  info->StartTuple = 0;
+  while (info->StartTuple < nb_of_tuples)
+    {
+    info->NumberOfTuples = inc_tuple;
+    if (info->StartTuple + info->NumberOfTuples >= nb_of_tuples)
       {
-      typedef unsigned short type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      info->NumberOfTuples = nb_of_tuples - info->StartTuple;
       }
-      break;
 
-      case VTK_INT:
+    if (nb_of_threads > 1)
       {
-      typedef int type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      threader->SingleMethodExecute();
       }
-      break;
-
-      case VTK_UNSIGNED_INT:
+    else
       {
-      typedef unsigned int type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
+      vtkMultiThreader::ThreadInfo thread_info;
+      thread_info.ThreadID = 0;
+      thread_info.NumberOfThreads = 1;
+      thread_info.UserData = info;
+      (*execute)(&thread_info);
       }
-      break;
 
-      case VTK_LONG:
-      {
-      typedef long type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
-      }
-      break;
+    info->StartTuple += info->NumberOfTuples;
+
+    progress = progress_start + progress_span * 
+      ((double)info->StartTuple / (double)nb_of_tuples);
+    progress_object->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+// The single pass engine.
+// Each thread computes the range of its subset of the scalars and fills a
+// provisional histogram at the same time. The provisional histograms are
+// then re-binned into the final bins, once the range of all the scalars, and
+// therefore the final range and number of bins, are known.
+// For 16 bits scalars, the provisional histogram has one bin per value of
+// the type range, and the re-binning is exact. For larger types, the
+// provisional histogram starts small around the first values; each time a
+// value falls outside of its range, it is shifted if possible, otherwise
+// its bin width is doubled (merging pairs of bins). It always ends up with
+// at least half of its bins over the range of the scalars. Integer
+// scalars are exact as long as their range fits in the provisional bins.
+
+// Number of provisional bins for each final bin, for large types
+
+#define VTK_KW_HIST_PROVISIONAL_BINS_FACTOR 16
+
+// Number of tuples scanned to initialize the provisional histogram
+
+#define VTK_KW_HIST_PROVISIONAL_PREFIX 4096
+
+//----------------------------------------------------------------------------
+class vtkKWHistogramProvisionalBins
+{
+public:
+  double    Origin;        // lower bound of the first bin
+  double    Width;         // width of each bin
+  double    InverseWidth;
+  vtkIdType NumberOfBins;
+  int       Integer;       // are the scalars integer values
+  int       Exact;         // one bin per value in the type range
+  int       Initialized;
+  double    Minimum;       // range of the scalars binned so far
+  double    Maximum;
+  vtksys_stl::vector<double> Bins;
+
+  vtkKWHistogramProvisionalBins()
+    {
+      this->Origin = 0.0;
+      this->Width = 1.0;
+      this->InverseWidth = 1.0;
+      this->NumberOfBins = 0;
+      this->Integer = 0;
+      this->Exact = 0;
+      this->Initialized = 0;
+      this->Minimum = VTK_DOUBLE_MAX;
+      this->Maximum = VTK_DOUBLE_MIN;
+    }
+
+  void Allocate(vtkIdType nb_of_bins)
+    {
+      this->NumberOfBins = nb_of_bins;
+      this->Bins.assign(nb_of_bins, 0.0);
+    }
+
+  void SetWidth(double width)
+    {
+      this->Width = width;
+      this->InverseWidth = 1.0 / width;
+    }
+
+  // Description:
+  // Initialize the bins to cover [min, max]. Integer scalars get a
+  // power of two bin width so that each value stays on a bin boundary.
+  void Initialize(double min, double max)
+    {
+      double span = (double)this->NumberOfBins;
+      if (this->Integer)
+        {
+        this->Origin = floor(min);
+        this->SetWidth(1.0);
+        while (max - this->Origin >= span * this->Width)
+          {
+          this->SetWidth(this->Width * 2.0);
+          }
+        }
+      else
+        {
+        this->Origin = min;
+        if (max > min)
+          {
+          this->SetWidth((max - min) / (span * 0.5));
+          }
+        else
+          {
+          this->SetWidth((min > 0.0 ? min : (min < 0.0 ? -min : 1.0)) / span);
+          }
+        }
+      this->Initialized = 1;
+    }
+
+  // Description:
+  // Make room for 'value' in the bins: shift the bins if the occupied bins
+  // and 'value' can fit, otherwise double the bin width.
+  void Expand(double value)
+    {
+      vtkIdType nb_of_bins = this->NumberOfBins, half = nb_of_bins / 2, i;
+      double *bins = &this->Bins[0];
+      double pos = (value - this->Origin) * this->InverseWidth;
+      while (pos < 0.0 || pos >= (double)nb_of_bins)
+        {
+        // Find the occupied bins, and the bins needed to fit 'value' too
+
+        vtkIdType first = 0, last = nb_of_bins - 1;
+        while (first < nb_of_bins && bins[first] == 0.0)
+          {
+          first++;
+          }
+        while (last >= first && bins[last] == 0.0)
+          {
+          last--;
+          }
+        vtkIdType value_bin = (vtkIdType)floor(pos);
+        if (first > last)
+          {
+          first = last = value_bin;
+          }
+        else if (value_bin < first)
+          {
+          first = value_bin;
+          }
+        else if (value_bin > last)
+          {
+          last = value_bin;
+          }
+
+        // Shift the bins so that the needed ones are centered
+
+        if ((double)last - (double)first < (double)nb_of_bins)
+          {
+          vtkIdType shift = first - (nb_of_bins - (last - first + 1)) / 2;
+          if (shift > 0)
+            {
+            for (i = 0; i < nb_of_bins; i++)
+              {
+              bins[i] = (i + shift < nb_of_bins) ? bins[i + shift] : 0.0;
+              }
+            }
+          else
+            {
+            for (i = nb_of_bins - 1; i >= 0; i--)
+              {
+              bins[i] = (i + shift >= 0) ? bins[i + shift] : 0.0;
+              }
+            }
+          this->Origin += (double)shift * this->Width;
+          }
+
+        // Merge pairs into the upper half, extend the range downward
+
+        else if (pos < 0.0)
+          {
+          for (i = half - 1; i >= 0; i--)
+            {
+            bins[half + i] = bins[2 * i] + bins[2 * i + 1];
+            }
+          for (i = 0; i < half; i++)
+            {
+            bins[i] = 0.0;
+            }
+          this->Origin -= (double)nb_of_bins * this->Width;
+          this->SetWidth(this->Width * 2.0);
+          }
+
+        // Merge pairs into the lower half, extend the range upward
+
+        else
+          {
+          for (i = 0; i < half; i++)
+            {
+            bins[i] = bins[2 * i] + bins[2 * i + 1];
+            }
+          for (i = half; i < nb_of_bins; i++)
+            {
+            bins[i] = 0.0;
+            }
+          this->SetWidth(this->Width * 2.0);
+          }
+
+        pos = (value - this->Origin) * this->InverseWidth;
+        }
+    }
+
+  // Description:
+  // Re-bin into the final bins.
+  void Rebin(const double range[2], vtkIdType nb_of_bins, 
+             int integer_binning, double *bins_ptr)
+    {
+      double bin_width = 
+        (range[1] == range[0] ? 1 : 
+         (double)nb_of_bins / (range[1] - range[0]));
+
+      const double *bins = this->NumberOfBins ? &this->Bins[0] : NULL;
+      for (vtkIdType i = 0; i < this->NumberOfBins; i++)
+        {
+        if (bins[i] == 0.0)
+          {
+          continue;
+          }
+
+        // Integer bins are represented by the smallest value they hold,
+        // other bins by their center
+
+        double value = this->Integer 
+          ? ceil(this->Origin + this->Width * (double)i)
+          : this->Origin + this->Width * ((double)i + 0.5);
+        if (value < this->Minimum)
+          {
+          value = this->Minimum;
+          }
+        else if (value > this->Maximum)
+          {
+          value = this->Maximum;
+          }
+
+        vtkIdType index = integer_binning 
+          ? (vtkIdType)(value - range[0])
+          : (vtkIdType)vtkMath::Floor((value - range[0]) * bin_width);
+        if (index < 0)
+          {
+          index = 0;
+          }
+        else if (index >= nb_of_bins)
+          {
+          index = nb_of_bins - 1;
+          }
+        bins_ptr[index] += bins[i];
+        }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkKWHistogramFillProvisionalBins(
+  T *data, vtkIdType nb_tuples, int nb_of_components, 
+  vtkKWHistogramProvisionalBins *prov)
+{
+  if (nb_tuples <= 0)
+    {
+    return;
+    }
+
+  T *data_end = data + nb_tuples * nb_of_components;
+
+  // One bin per value, no need to check for the bins range
+
+  if (prov->Exact)
+    {
+    double *bins_ptr = &prov->Bins[0];
+    T shift = (T)prov->Origin;
+    T min = *data, max = *data;
+    while (data < data_end)
+      {
+      if (*data < min)
+        {
+        min = *data;
+        }
+      else if (*data > max)
+        {
+        max = *data;
+        }
+      bins_ptr[(vtkIdType)(*data - shift)]++;
+      data += nb_of_components;
+      }
+    if ((double)min < prov->Minimum)
+      {
+      prov->Minimum = (double)min;
+      }
+    if ((double)max > prov->Maximum)
+      {
+      prov->Maximum = (double)max;
+      }
+    return;
+    }
+
+  // Initialize the bins from the range of the first few tuples
+  // (NaN and infinite values are ignored)
+
+  double value;
+  double min = prov->Minimum, max = prov->Maximum;
+  if (!prov->Initialized)
+    {
+    vtkIdType nb_prefix_tuples = nb_tuples < VTK_KW_HIST_PROVISIONAL_PREFIX 
+      ? nb_tuples : VTK_KW_HIST_PROVISIONAL_PREFIX;
+    T *ptr = data, *ptr_end = data + nb_prefix_tuples * nb_of_components;
+    for (; ptr < ptr_end; ptr += nb_of_components)
+      {
+      value = (double)*ptr;
+      if (value - value == 0.0)
+        {
+        if (value < min)
+          {
+          min = value;
+          }
+        if (value > max)
+          {
+          max = value;
+          }
+        }
+      }
+    if (min <= max)
+      {
+      prov->Initialize(min, max);
+      }
+    }
+
+  double pos;
+  while (data < data_end)
+    {
+    value = (double)*data;
+    if (value - value == 0.0)
+      {
+      if (!prov->Initialized)
+        {
+        prov->Initialize(value, value);
+        }
+      if (value < min)
+        {
+        min = value;
+        }
+      if (value > max)
+        {
+        max = value;
+        }
+      pos = (value - prov->Origin) * prov->InverseWidth;
+      if (pos < 0.0 || pos >= (double)prov->NumberOfBins)
+        {
+        prov->Expand(value);
+        pos = (value - prov->Origin) * prov->InverseWidth;
+        }
+      prov->Bins[(vtkIdType)pos]++;
+      }
+    data += nb_of_components;
+    }
+
+  prov->Minimum = min;
+  prov->Maximum = max;
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKWHistogramProvisionalBinningThreadedExecute(
+  void *arg)
+{
+  vtkMultiThreader::ThreadInfo *thread_info = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWHistogramBinningInfo *info = 
+    static_cast<vtkKWHistogramBinningInfo*>(thread_info->UserData);
+
+  // Split the tuples evenly between threads
+
+  vtkIdType nb_threads = thread_info->NumberOfThreads;
+  vtkIdType thread_id = thread_info->ThreadID;
+  vtkIdType start_tuple = 
+    info->StartTuple + (info->NumberOfTuples * thread_id) / nb_threads;
+  vtkIdType end_tuple = 
+    info->StartTuple + (info->NumberOfTuples * (thread_id + 1)) / nb_threads;
+
+  switch (info->DataType)
+    {
+    vtkTemplateMacro(
+      vtkKWHistogramFillProvisionalBins(
+        static_cast<VTK_TT*>(info->Data) + 
+        start_tuple * info->NumberOfComponents + info->Component,
+        end_tuple - start_tuple, 
+        info->NumberOfComponents,
+        info->ProvisionalBins + thread_id));
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::BuildHistogramInSinglePass(vtkDataArray *scalars, 
+                                               int comp,
+                                               double progress_start,
+                                               double progress_span)
+{
+  if (!scalars || comp < 0 || comp >= scalars->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<< "Can not bin invalid scalars or component!");
+    return 0;
+    }
+
+  int data_type = scalars->GetDataType();
+  if (!vtkKWHistogram::IsSupportedDataType(data_type))
+    {
+    vtkErrorMacro(<< "Can not build histogram from unsupported data type!");
+    return 0;
+    }
+
+  vtkIdType nb_of_tuples = scalars->GetNumberOfTuples();
+
+  vtkKWHistogramBinningInfo info;
+  info.DataType = data_type;
+  info.Data = scalars->GetVoidPointer(0);
+  info.NumberOfComponents = scalars->GetNumberOfComponents();
+  info.Component = comp;
+  info.ThreadBins = NULL;
+
+  // Do not use more threads than worth it
+
+  vtkIdType nb_of_threads = nb_of_tuples / VTK_KW_HIST_MIN_TUPLES_PER_THREAD;
+  if (nb_of_threads > this->NumberOfThreads)
+    {
+    nb_of_threads = this->NumberOfThreads;
+    }
+  if (nb_of_threads < 1)
+    {
+    nb_of_threads = 1;
+    }
+
+  // Allocate the provisional bins
+
+  int exact = 0, integer = 1;
+  switch (data_type)
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+      exact = 1;
+      break;
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      integer = 0;
+      break;
+    }
+
+  vtkIdType i;
+  info.ProvisionalBins = new vtkKWHistogramProvisionalBins [nb_of_threads];
+  for (i = 0; i < nb_of_threads; i++)
+    {
+    vtkKWHistogramProvisionalBins *prov = info.ProvisionalBins + i;
+    prov->Integer = integer;
+    prov->Exact = exact;
+    if (exact)
+      {
+      prov->Allocate((vtkIdType)
+        (scalars->GetDataTypeMax() - scalars->GetDataTypeMin() + 1.0));
+      prov->Origin = scalars->GetDataTypeMin();
+      prov->Initialized = 1;
+      }
+    else
+      {
+      prov->Allocate(
+        2 * ((this->MaximumNumberOfBins * 
+              VTK_KW_HIST_PROVISIONAL_BINS_FACTOR + 1) / 2));
+      }
+    }
+
+  if (nb_of_threads > 1)
+    {
+    this->Threader->SetNumberOfThreads((int)nb_of_threads);
+    this->Threader->SetSingleMethod(
+      vtkKWHistogramProvisionalBinningThreadedExecute, &info);
+    }
+
+  // Loop over the data in chunks and fill in the provisional bins
+
+  vtkIdType inc_tuple = (vtkIdType)ceil(
+    (double)nb_of_tuples / (double)VTK_KW_HIST_NB_PROGRESS_CHUNKS);
+  double progress;
+
+  info.StartTuple = 0;
+  while (info.StartTuple < nb_of_tuples)
+    {
+    info.NumberOfTuples = inc_tuple;
+    if (info.StartTuple + info.NumberOfTuples >= nb_of_tuples)
+      {
+      info.NumberOfTuples = nb_of_tuples - info.StartTuple;
+      }
+
+    if (nb_of_threads == 1)
+      {
+      vtkMultiThreader::ThreadInfo thread_info;
+      thread_info.ThreadID = 0;
+      thread_info.NumberOfThreads = 1;
+      thread_info.UserData = &info;
+      vtkKWHistogramProvisionalBinningThreadedExecute(&thread_info);
+      }
+    else
+      {
+      this->Threader->SingleMethodExecute();
+      }
+
+    info.StartTuple += info.NumberOfTuples;
+
+    progress = progress_start + progress_span * 
+      ((double)info.StartTuple / (double)nb_of_tuples);
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    }
+
+  // Now that the range of the scalars is known, compute the final range
+  // and number of bins, and remember that range for the next time
+
+  double scalars_range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (i = 0; i < nb_of_threads; i++)
+    {
+    vtkKWHistogramProvisionalBins *prov = info.ProvisionalBins + i;
+    if (prov->Minimum < scalars_range[0])
+      {
+      scalars_range[0] = prov->Minimum;
+      }
+    if (prov->Maximum > scalars_range[1])
+      {
+      scalars_range[1] = prov->Maximum;
+      }
+    }
+  if (scalars_range[0] > scalars_range[1])
+    {
+    scalars_range[0] = scalars_range[1] = 0.0;
+    }
+  else
+    {
+    this->SetScalarsRangeCache(scalars, comp, scalars_range);
+    }
+
+  vtkIdType nb_of_bins;
+  vtkKWHistogram::ComputeRangeAndNumberOfBins(
+    scalars, scalars_range, this->MaximumNumberOfBins, 
+    this->Range, &nb_of_bins);
+
+  this->Bins->SetNumberOfComponents(1);
+  this->Bins->SetNumberOfTuples(nb_of_bins);
+  double *bins_ptr = this->Bins->GetPointer(0);
+  memset(bins_ptr, 0, nb_of_bins * sizeof(double));
+
+  // Re-bin the provisional bins
+
+  int integer_binning = 
+    (integer && nb_of_bins == (vtkIdType)(this->Range[1] - this->Range[0]));
+  for (i = 0; i < nb_of_threads; i++)
+    {
+    info.ProvisionalBins[i].Rebin(
+      this->Range, nb_of_bins, integer_binning, bins_ptr);
+    }
+
+  delete [] info.ProvisionalBins;
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::EmptyHistogram()
+{
+  if (this->Bins)
+    {
+    this->Bins->SetNumberOfComponents(1);
+    this->Bins->SetNumberOfTuples(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::GetScalarsRange(
+  vtkDataArray *scalars, int comp, double range[2], int compute)
+{
+  // Reuse the range computed the last time for these scalars if they
+  // have not been modified since then
+
+  if (scalars == this->ScalarsRangeCacheArray &&
+      comp == this->ScalarsRangeCacheComponent &&
+      scalars->GetMTime() <= this->ScalarsRangeCacheTime)
+    {
+    range[0] = this->ScalarsRangeCache[0];
+    range[1] = this->ScalarsRangeCache[1];
+    return 1;
+    }
+
+  if (!compute)
+    {
+    return 0;
+    }
+
+  // For some big data types (int, long, double), let's use the more
+  // accurate GetScalarRange(..., double) function, which does
+  // not cache the range (it iterates over data each time), but
+  // get the proper result and avoid accessing memory out of the array.
+
+  scalars->GetRange(range, comp);
+  this->SetScalarsRangeCache(scalars, comp, range);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::SetScalarsRangeCache(
+  vtkDataArray *scalars, int comp, const double range[2])
+{
+  this->ScalarsRangeCacheArray = scalars;
+  this->ScalarsRangeCacheComponent = comp;
+  this->ScalarsRangeCacheTime = scalars->GetMTime();
+  this->ScalarsRangeCache[0] = range[0];
+  this->ScalarsRangeCache[1] = range[1];
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
+  vtkDataArray *scalars, 
+  int comp,
+  double range[2], 
+  vtkIdType *nb_of_bins)
+{
+  if (!scalars ||
+      comp < 0 || comp >= scalars->GetNumberOfComponents() ||
+      !range || !nb_of_bins)
+    {
+    vtkWarningMacro( "Missing parameters" );
+    return;
+    }
+
+  if (!vtkKWHistogram::IsSupportedDataType(scalars->GetDataType()))
+    {
+    vtkErrorMacro( "Unhandled data type: " << scalars->GetDataType() );
+    return;
+    }
+
+  // Get the histogram range required for those scalars (the 8 bits types
+  // use the whole type range and do not need to be scanned).
+  // Given the range, compute the number of bins required.
+
+  double scalars_range[2] = { 0.0, 0.0 };
+  switch (scalars->GetDataType())
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      break;
+
+    default:
+      this->GetScalarsRange(scalars, comp, scalars_range, 1);
+      break;
+    }
+
+  vtkKWHistogram::ComputeRangeAndNumberOfBins(
+    scalars, scalars_range, this->MaximumNumberOfBins, range, nb_of_bins);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::EstimateHistogramRange(
+  vtkDataArray *scalars, 
+  int comp,
+  double range[2])
+{
+  vtkIdType nb_bins;
+  vtkKWHistogram::EstimateHistogramRangeAndNumberOfBins(
+    scalars, comp, range, &nb_bins);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::UpdateHistogram(vtkDataArray *scalars, 
+                                     int comp,
+                                     int reset_range)
+{
+  if (!scalars)
+    {
+    vtkErrorMacro(<< "Can not build histogram from NULL scalars!");
+    return;
+    }
+
+  if (comp < 0 || comp >= scalars->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<< "Can not build histogram from invalid component!");
+    return;
+    }
+
+  // Estimate the range and fill the bins in a single pass if requested,
+  // unless the 8 bits types (whose range is known) or a known range 
+  // make the regular path a single pass already.
+
+  double range[2];
+  int single_pass = reset_range && this->SinglePassBuild;
+  if (single_pass)
+    {
+    switch (scalars->GetDataType())
+      {
+      case VTK_CHAR:
+      case VTK_SIGNED_CHAR:
+      case VTK_UNSIGNED_CHAR:
+        single_pass = 0;
+        break;
+
+      default:
+        single_pass = !this->GetScalarsRange(scalars, comp, range, 0);
+        break;
+      }
+    }
+
+  if (single_pass)
+    {
+    this->InvokeEvent(vtkCommand::StartEvent, NULL);
+
+    if (!this->BuildHistogramInSinglePass(scalars, comp, 0.0, 1.0))
+      {
+      return;
+      }
+    }
+  else
+    {
+    // Get the histogram range required for those scalars.
+    // Also, given the range, compute the number of bins needed
+    // if 'reset_range' is true, reset the Range ivar, otherwise check
+    // that the current range is within the ivar (accumulate mode)
+
+    vtkIdType nb_of_bins;
+
+    this->EstimateHistogramRangeAndNumberOfBins(
+      scalars, comp, range, &nb_of_bins);
+
+    if (reset_range)
+      {
+      this->Range[0] = range[0];
+      this->Range[1] = range[1];
+      }
+    else
+      {
+      if (range[0] < this->Range[0] || range[1] > this->Range[1])
+        {
+        vtkErrorMacro(<< "Scalars range [" 
+                      << range[0] << ".." << range[1] << "] "
+                      << "does not fit in the current Range ["
+                      << this->Range[0] << ".." << this->Range[1] << "]!");
+        return;
+        }
+      }
+
+    this->InvokeEvent(vtkCommand::StartEvent, NULL);
+
+    // Allocate the bins and reset them to 0
+    // if 'reset_range' is true, reset the number of bins, otherwise reset
+    // it only if it was 0 before (i.e., EmptyHistogram was called).
+
+    this->Bins->SetNumberOfComponents(1);
+    if (reset_range || this->Bins->GetNumberOfTuples() == 0)
+      {
+      this->Bins->SetNumberOfTuples(nb_of_bins);
+      double *bins_ptr = this->Bins->GetPointer(0);
+      double *bins_ptr_end = bins_ptr + nb_of_bins;
+      while (bins_ptr < bins_ptr_end)
+        {
+        *bins_ptr++ = 0.0;
+        }
+      }
+
+    double progress = 0.2;
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+
+    // Loop over the data and fill in the bins
+
+    if (!this->BinScalars(
+          scalars, comp, 0, scalars->GetNumberOfTuples(), 1.0, 0.2, 0.8))
+      {
+      return;
+      }
+    }
+
+  double progress = 1.0;
+  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+
+  this->Bins->Modified();
+  this->Modified();
+    
+  this->InvokeEvent(vtkCommand::EndEvent, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::BuildHistogram(vtkDataArray *scalars, int comp)
+{
+  this->UpdateHistogram(scalars, comp, 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::AccumulateHistogram(vtkDataArray *scalars, int comp)
+{
+  this->UpdateHistogram(scalars, comp, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::BuildHistograms(vtkDataArray *scalars, 
+                                    vtkKWHistogram **histograms,
+                                    int nb_of_threads)
+{
+  if (!scalars || !histograms)
+    {
+    vtkGenericWarningMacro(<< "Can not build histograms from NULL scalars!");
+    return 0;
+    }
+
+  // Collect the histograms to build. The first one is used to send the 
+  // progress events and to spawn the threads.
+
+  int nb_of_components = scalars->GetNumberOfComponents();
+  int nb_of_histograms = 0;
+  vtkKWHistogram *first = NULL;
+  int comp, i;
+  for (comp = 0; comp < nb_of_components; comp++)
+    {
+    if (histograms[comp])
+      {
+      if (!first)
+        {
+        first = histograms[comp];
+        }
+      nb_of_histograms++;
+      }
+    }
+
+  if (!nb_of_histograms)
+    {
+    return 1;
+    }
+
+  // Nothing to share between components for empty or unsupported scalars, 
+  // let BuildHistogram handle them one component at a time
+
+  vtkIdType nb_of_tuples = scalars->GetNumberOfTuples();
+  int data_type = scalars->GetDataType();
+  if (nb_of_tuples <= 0 || !vtkKWHistogram::IsSupportedDataType(data_type))
+    {
+    for (comp = 0; comp < nb_of_components; comp++)
+      {
+      if (histograms[comp])
+        {
+        histograms[comp]->BuildHistogram(scalars, comp);
+        }
+      }
+    return 1;
+    }
+
+  for (comp = 0; comp < nb_of_components; comp++)
+    {
+    if (histograms[comp])
+      {
+      histograms[comp]->InvokeEvent(vtkCommand::StartEvent, NULL);
+      }
+    }
+
+  // Do not use more threads than worth it
+
+  vtkIdType max_nb_of_threads = 
+    nb_of_tuples / VTK_KW_HIST_MIN_TUPLES_PER_THREAD;
+  if (nb_of_threads > max_nb_of_threads)
+    {
+    nb_of_threads = (int)max_nb_of_threads;
+    }
+  if (nb_of_threads < 1)
+    {
+    nb_of_threads = 1;
+    }
+
+  vtkKWHistogramBatchInfo info;
+  info.DataType = data_type;
+  info.Data = scalars->GetVoidPointer(0);
+  info.NumberOfComponents = nb_of_components;
+  info.NumberOfHistograms = nb_of_histograms;
+  info.Histograms = new vtkKWHistogramBinningInfo [nb_of_histograms];
+  info.ThreadBins = NULL;
+  info.ThreadRanges = NULL;
+
+  // Get the range of the components, scanning the scalars once for all
+  // the components whose range is not known yet (the 8 bits types use the
+  // whole type range and do not need to be scanned)
+
+  double *ranges = new double [2 * nb_of_components];
+  int compute_ranges = 0;
+  for (comp = 0; comp < nb_of_components; comp++)
+    {
+    ranges[2 * comp] = 0.0;
+    ranges[2 * comp + 1] = 0.0;
+    if (histograms[comp] && 
+        !histograms[comp]->GetScalarsRange(scalars, comp, ranges + 2*comp, 0))
+      {
+      compute_ranges = 1;
+      }
+    }
+
+  switch (data_type)
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      compute_ranges = 0;
+      break;
+    }
+
+  if (compute_ranges)
+    {
+    int nb_of_range_values = nb_of_threads * 2 * nb_of_components;
+    info.ThreadRanges = new double [nb_of_range_values];
+    for (i = 0; i < nb_of_range_values; i += 2)
+      {
+      info.ThreadRanges[i] = VTK_DOUBLE_MAX;
+      info.ThreadRanges[i + 1] = VTK_DOUBLE_MIN;
+      }
+
+    vtkKWHistogramExecuteBatchPass(
+      &info, vtkKWHistogramBatchRangeThreadedExecute, 
+      first->Threader, nb_of_threads, nb_of_tuples, first, 0.0, 0.2);
+
+    for (comp = 0; comp < nb_of_components; comp++)
+      {
+      if (!histograms[comp] || 
+          histograms[comp]->GetScalarsRange(scalars, comp, ranges+2*comp, 0))
+        {
+        continue;
+        }
+      double *range = ranges + 2 * comp;
+      range[0] = VTK_DOUBLE_MAX;
+      range[1] = VTK_DOUBLE_MIN;
+      for (i = 0; i < nb_of_threads; i++)
+        {
+        double *thread_range = 
+          info.ThreadRanges + (i * nb_of_components + comp) * 2;
+        if (thread_range[0] < range[0])
+          {
+          range[0] = thread_range[0];
+          }
+        if (thread_range[1] > range[1])
+          {
+          range[1] = thread_range[1];
+          }
+        }
+      histograms[comp]->SetScalarsRangeCache(scalars, comp, range);
+      }
+
+    delete [] info.ThreadRanges;
+    }
+
+  // Given the range, reset the Range ivar and allocate the bins of each 
+  // histogram, as BuildHistogram would
+
+  int bins_allocated = (nb_of_threads > 1);
+  info.ThreadBins = new double* [nb_of_threads * nb_of_histograms];
+
+  for (comp = 0, i = 0; comp < nb_of_components; comp++)
+    {
+    vtkKWHistogram *self = histograms[comp];
+    if (!self)
+      {
+      continue;
+      }
+
+    vtkIdType nb_of_bins;
+    vtkKWHistogram::ComputeRangeAndNumberOfBins(
+      scalars, ranges + 2 * comp, self->MaximumNumberOfBins, 
+      self->Range, &nb_of_bins);
+
+    self->Bins->SetNumberOfComponents(1);
+    self->Bins->SetNumberOfTuples(nb_of_bins);
+    double *bins_ptr = self->Bins->GetPointer(0);
+    memset(bins_ptr, 0, nb_of_bins * sizeof(double));
+
+    vtkKWHistogramBinningInfo *hist_info = info.Histograms + i;
+    hist_info->DataType = data_type;
+    hist_info->Data = info.Data;
+    hist_info->NumberOfComponents = nb_of_components;
+    hist_info->Component = comp;
+    hist_info->Range[0] = self->Range[0];
+    hist_info->Range[1] = self->Range[1];
+    hist_info->NumberOfBins = nb_of_bins;
+    hist_info->IntegerBinning = 
+      (data_type != VTK_FLOAT && data_type != VTK_DOUBLE &&
+       nb_of_bins == (vtkIdType)(self->Range[1] - self->Range[0]));
+    hist_info->Weight = 1.0;
+    hist_info->ThreadBins = NULL;
+    hist_info->ProvisionalBins = NULL;
+
+    // A single thread bins directly into the histograms, otherwise each 
+    // thread gets its own private bins
+
+    int thread_id;
+    for (thread_id = 0; thread_id < nb_of_threads; thread_id++)
+      {
+      double *thread_bins_ptr = bins_ptr;
+      if (bins_allocated)
+        {
+        thread_bins_ptr = new double [nb_of_bins];
+        memset(thread_bins_ptr, 0, nb_of_bins * sizeof(double));
+        }
+      info.ThreadBins[thread_id * nb_of_histograms + i] = thread_bins_ptr;
+      }
+
+    i++;
+    }
+
+  // Fill the bins of all the components in a single pass
+
+  vtkKWHistogramExecuteBatchPass(
+    &info, vtkKWHistogramBatchBinningThreadedExecute, 
+    first->Threader, nb_of_threads, nb_of_tuples, first, 
+    compute_ranges ? 0.2 : 0.0, compute_ranges ? 0.8 : 1.0);
+
+  // Merge the private bins
+
+  if (bins_allocated)
+    {
+    for (i = 0; i < nb_of_histograms; i++)
+      {
+      vtkIdType nb_of_bins = info.Histograms[i].NumberOfBins;
+      double *bins_ptr = 
+        histograms[info.Histograms[i].Component]->Bins->GetPointer(0);
+      int thread_id;
+      for (thread_id = 0; thread_id < nb_of_threads; thread_id++)
+        {
+        double *thread_bins_ptr = 
+          info.ThreadBins[thread_id * nb_of_histograms + i];
+        vtkIdType bin;
+        for (bin = 0; bin < nb_of_bins; bin++)
+          {
+          bins_ptr[bin] += thread_bins_ptr[bin];
+          }
+        delete [] thread_bins_ptr;
+        }
+      }
+    }
+
+  delete [] info.ThreadBins;
+  delete [] info.Histograms;
+  delete [] ranges;
+
+  for (comp = 0; comp < nb_of_components; comp++)
+    {
+    if (histograms[comp])
+      {
+      histograms[comp]->Bins->Modified();
+      histograms[comp]->Modified();
+      histograms[comp]->InvokeEvent(vtkCommand::EndEvent, NULL);
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkKWHistogram::GetHistogramPieceExtent(vtkImageData *image, 
+                                                  int comp,
+                                                  int extent[6],
+                                                  int piece_extent[6],
+                                                  double piece_range[2])
+{
+  vtkDataArray *scalars = 
+    image ? image->GetPointData()->GetScalars() : NULL;
+  if (!scalars)
+    {
+    vtkErrorMacro(<< "Can not accumulate histogram from NULL scalars!");
+    return -1;
+    }
+
+  if (comp < 0 || comp >= scalars->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<< "Can not accumulate histogram from invalid component!");
+    return -1;
+    }
+
+  int data_type = scalars->GetDataType();
+  if (!vtkKWHistogram::IsSupportedDataType(data_type))
+    {
+    vtkErrorMacro(<< "Can not build histogram from unsupported data type!");
+    return -1;
+    }
+
+  // Clip the extent to the image extent
+
+  int *data_extent = image->GetExtent();
+  int i;
+  for (i = 0; i < 3; i++)
+    {
+    piece_extent[2 * i] = (extent && extent[2 * i] > data_extent[2 * i]) 
+      ? extent[2 * i] : data_extent[2 * i];
+    piece_extent[2 * i + 1] = 
+      (extent && extent[2 * i + 1] < data_extent[2 * i + 1]) 
+      ? extent[2 * i + 1] : data_extent[2 * i + 1];
+    if (piece_extent[2 * i] > piece_extent[2 * i + 1])
+      {
+      return 0;
+      }
+    }
+
+  vtkIdType row_length = piece_extent[1] - piece_extent[0] + 1;
+  vtkIdType nb_of_tuples = row_length *
+    (piece_extent[3] - piece_extent[2] + 1) *
+    (piece_extent[5] - piece_extent[4] + 1);
+
+  // Get the range of the values inside the extent: the range of the whole
+  // scalars may be known already, otherwise scan the rows of the extent
+  // only, so that the cost is proportional to the extent
+
+  if (nb_of_tuples == scalars->GetNumberOfTuples())
+    {
+    this->GetScalarsRange(scalars, comp, piece_range, 1);
+    }
+  else
+    {
+    int nb_of_components = scalars->GetNumberOfComponents();
+    double *ranges = new double [2 * nb_of_components];
+    for (i = 0; i < nb_of_components; i++)
+      {
+      ranges[2 * i] = VTK_DOUBLE_MAX;
+      ranges[2 * i + 1] = VTK_DOUBLE_MIN;
+      }
+    vtkIdType inc_y = data_extent[1] - data_extent[0] + 1;
+    vtkIdType inc_z = inc_y * (data_extent[3] - data_extent[2] + 1);
+    int y, z;
+    for (z = piece_extent[4]; z <= piece_extent[5]; z++)
+      {
+      for (y = piece_extent[2]; y <= piece_extent[3]; y++)
+        {
+        vtkIdType start_tuple = (z - data_extent[4]) * inc_z + 
+          (y - data_extent[2]) * inc_y + (piece_extent[0] - data_extent[0]);
+        switch (data_type)
+          {
+          vtkTemplateMacro(
+            vtkKWHistogramComputeComponentsRange(
+              static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), 
+              nb_of_components, start_tuple, row_length, ranges));
+          }
+        }
+      }
+    piece_range[0] = ranges[2 * comp];
+    piece_range[1] = ranges[2 * comp + 1];
+    delete [] ranges;
+    }
+
+  // Make sure the piece fits in the Range (upper bound is exclusive)
+
+  if (piece_range[0] < this->Range[0] || piece_range[1] >= this->Range[1])
+    {
+    vtkErrorMacro(<< "Scalars range [" 
+                  << piece_range[0] << ".." << piece_range[1] << "] "
+                  << "does not fit in the current Range ["
+                  << this->Range[0] << ".." << this->Range[1] << "[!");
+    return -1;
+    }
+
+  return nb_of_tuples;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::BinHistogramPiece(vtkImageData *image, 
+                                      int comp,
+                                      int piece_extent[6],
+                                      double weight,
+                                      double progress_start,
+                                      double progress_span)
+{
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+
+  int *data_extent = image->GetExtent();
+  vtkIdType inc_y = data_extent[1] - data_extent[0] + 1;
+  vtkIdType inc_z = inc_y * (data_extent[3] - data_extent[2] + 1);
+  vtkIdType row_length = piece_extent[1] - piece_extent[0] + 1;
+  int nb_of_slices = piece_extent[5] - piece_extent[4] + 1;
+
+  // Whole slices are contiguous, bin them in one go
+
+  if (piece_extent[0] == data_extent[0] && 
+      piece_extent[1] == data_extent[1] &&
+      piece_extent[2] == data_extent[2] && 
+      piece_extent[3] == data_extent[3])
+    {
+    return this->BinScalars(
+      scalars, comp, 
+      (piece_extent[4] - data_extent[4]) * inc_z, nb_of_slices * inc_z,
+      weight, progress_start, progress_span);
+    }
+
+  // Otherwise bin each row, and report progress for each slice
+
+  double progress;
+  int y, z;
+  for (z = piece_extent[4]; z <= piece_extent[5]; z++)
+    {
+    for (y = piece_extent[2]; y <= piece_extent[3]; y++)
+      {
+      vtkIdType start_tuple = (z - data_extent[4]) * inc_z + 
+        (y - data_extent[2]) * inc_y + (piece_extent[0] - data_extent[0]);
+      if (!this->BinScalars(
+            scalars, comp, start_tuple, row_length, weight, 0, 0))
+        {
+        return 0;
+        }
+      }
+    if (progress_span > 0.0)
+      {
+      progress = progress_start + progress_span * 
+        ((double)(z - piece_extent[4] + 1) / (double)nb_of_slices);
+      this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::AccumulateHistogramPiece(vtkImageData *image, 
+                                             int comp,
+                                             int extent[6],
+                                             double progress_start,
+                                             double progress_span)
+{
+  int piece_extent[6];
+  double piece_range[2];
+  vtkIdType nb_of_tuples = this->GetHistogramPieceExtent(
+    image, comp, extent, piece_extent, piece_range);
+  if (nb_of_tuples <= 0)
+    {
+    return nb_of_tuples == 0;
+    }
+
+  // The bins are fixed: allocate them for the current Range if the
+  // histogram is empty, the same way BuildHistogram would for scalars
+  // spanning that Range.
+
+  if (!this->GetNumberOfBins())
+    {
+    int data_type = image->GetPointData()->GetScalars()->GetDataType();
+    vtkIdType nb_of_bins = this->MaximumNumberOfBins;
+    if (data_type != VTK_FLOAT && data_type != VTK_DOUBLE)
+      {
+      double try_nb_of_bins = ceil(this->Range[1] - this->Range[0]);
+      if (try_nb_of_bins >= 1 && try_nb_of_bins <= nb_of_bins)
+        {
+        nb_of_bins = (vtkIdType)try_nb_of_bins;
+        }
+      }
+    this->Bins->SetNumberOfComponents(1);
+    this->Bins->SetNumberOfTuples(nb_of_bins);
+    memset(this->Bins->GetPointer(0), 0, nb_of_bins * sizeof(double));
+    }
+
+  return this->BinHistogramPiece(
+    image, comp, piece_extent, 1.0, progress_start, progress_span);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::AccumulateHistogram(vtkImageData *image, int comp)
+{
+  this->AccumulateHistogram(image, comp, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::AccumulateHistogram(vtkImageData *image, 
+                                         int comp, 
+                                         int extent[6])
+{
+  this->InvokeEvent(vtkCommand::StartEvent, NULL);
+
+  this->UpdateHistogramPiece(image, comp, extent, 1.0);
+
+  this->InvokeEvent(vtkCommand::EndEvent, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::SubtractHistogram(vtkImageData *image, 
+                                       int comp, 
+                                       int extent[6])
+{
+  this->InvokeEvent(vtkCommand::StartEvent, NULL);
+
+  this->UpdateHistogramPiece(image, comp, extent, -1.0);
+
+  this->InvokeEvent(vtkCommand::EndEvent, NULL);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::UpdateHistogramPiece(vtkImageData *image, 
+                                         int comp, 
+                                         int extent[6],
+                                         double weight)
+{
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
+
+  // Nothing to update incrementally in an empty histogram
+
+  if (!nb_of_bins)
+    {
+    if (weight < 0.0)
+      {
+      vtkErrorMacro(<< "Can not subtract from an empty histogram!");
+      return 0;
+      }
+    if (!this->AccumulateHistogramPiece(image, comp, extent, 0.0, 1.0))
+      {
+      return 0;
+      }
+    this->Bins->Modified();
+    this->Modified();
+    return 1;
+    }
+
+  int piece_extent[6];
+  double piece_range[2];
+  vtkIdType nb_of_tuples = this->GetHistogramPieceExtent(
+    image, comp, extent, piece_extent, piece_range);
+  if (nb_of_tuples <= 0)
+    {
+    return nb_of_tuples == 0;
+    }
+
+  // Find the range of bins the piece can hit. Be conservative by one bin
+  // on each side, the kernels may not round the same way.
+
+  double bin_scale = (this->Range[1] == this->Range[0] ? 1.0 :
+    (double)nb_of_bins / (this->Range[1] - this->Range[0]));
+  vtkIdType lo = 
+    (vtkIdType)floor((piece_range[0] - this->Range[0]) * bin_scale) - 1;
+  vtkIdType hi = 
+    (vtkIdType)floor((piece_range[1] - this->Range[0]) * bin_scale) + 1;
+  if (lo < 0)
+    {
+    lo = 0;
+    }
+  if (hi > nb_of_bins - 1)
+    {
+    hi = nb_of_bins - 1;
+    }
+
+  // Which of the structures derived from the bins are up to date, and can
+  // therefore be updated from the modified bins only
+
+  unsigned long bins_time = this->Bins->GetMTime();
+  int stats_valid = (this->LastStatisticsBuildTime >= bins_time);
+  int acc_valid = (this->LastAccumulatedBinsBuildTime >= bins_time);
+  int image_up_to_date = (this->LastImageBuildTime >= bins_time);
+  int image_partial = (this->LastImageBuildTime && 
+                       this->ImageModifiedBinsTime >= bins_time);
+
+  double *bins_ptr = this->Bins->GetPointer(0);
+  double sum_before = 0.0;
+  vtkIdType i;
+  for (i = lo; i <= hi; i++)
+    {
+    sum_before += bins_ptr[i];
+    }
+
+  if (!this->BinHistogramPiece(image, comp, piece_extent, weight, 0.0, 1.0))
+    {
+    this->Bins->Modified();
+    this->Modified();
+    return 0;
+    }
+
+  this->Bins->Modified();
+  unsigned long new_bins_time = this->Bins->GetMTime();
+
+  // Statistics: the total is updated from the modified bins; the extrema
+  // too, unless the previous extremum was in the modified bins and is not
+  // matched anymore, in which case they have to be recomputed.
+
+  if (stats_valid)
+    {
+    double sum_after = 0.0;
+    double min = VTK_DOUBLE_MAX, max = VTK_DOUBLE_MIN;
+    vtkIdType min_bin = -1, max_bin = -1;
+    for (i = lo; i <= hi; i++)
+      {
+      sum_after += bins_ptr[i];
+      if (bins_ptr[i] < min)
+        {
+        min = bins_ptr[i];
+        min_bin = i;
+        }
+      if (bins_ptr[i] > max)
+        {
+        max = bins_ptr[i];
+        max_bin = i;
+        }
+      }
+    this->TotalOccurence += sum_after - sum_before;
+
+    if (max >= this->MaximumOccurence)
+      {
+      if (max > this->MaximumOccurence || 
+          (this->MaximumOccurenceBin >= lo && this->MaximumOccurenceBin <= hi))
+        {
+        this->MaximumOccurence = max;
+        this->MaximumOccurenceBin = max_bin;
+        }
+      }
+    else if (this->MaximumOccurenceBin >= lo && 
+             this->MaximumOccurenceBin <= hi)
+      {
+      stats_valid = 0;
+      }
+
+    if (min <= this->MinimumOccurence)
+      {
+      if (min < this->MinimumOccurence || 
+          (this->MinimumOccurenceBin >= lo && this->MinimumOccurenceBin <= hi))
+        {
+        this->MinimumOccurence = min;
+        this->MinimumOccurenceBin = min_bin;
+        }
+      }
+    else if (this->MinimumOccurenceBin >= lo && 
+             this->MinimumOccurenceBin <= hi)
+      {
+      stats_valid = 0;
+      }
+
+    if (stats_valid)
+      {
+      this->LastStatisticsBuildTime = new_bins_time;
+      }
+    }
+
+  // Accumulated occurences: only those from the first modified bin onward
+  // change. Same order of summation as ComputeAccumulatedBins.
+
+  if (acc_valid)
+    {
+    double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+    double total = lo ? acc_ptr[lo - 1] : 0.0;
+    for (i = lo; i < nb_of_bins; i++)
+      {
+      total += bins_ptr[i];
+      acc_ptr[i] = total;
+      }
+    this->LastAccumulatedBinsBuildTime = new_bins_time;
+    }
+
+  // Image: keep track of the bins modified since it was computed
+
+  if (image_up_to_date)
+    {
+    this->ImageModifiedBins[0] = lo;
+    this->ImageModifiedBins[1] = hi;
+    this->ImageModifiedBinsTime = new_bins_time;
+    }
+  else if (image_partial)
+    {
+    if (lo < this->ImageModifiedBins[0])
+      {
+      this->ImageModifiedBins[0] = lo;
+      }
+    if (hi > this->ImageModifiedBins[1])
+      {
+      this->ImageModifiedBins[1] = hi;
+      }
+    this->ImageModifiedBinsTime = new_bins_time;
+    }
+
+  this->Modified();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::AccumulateHistogramFromStreamedImage(
+  vtkAlgorithmOutput *input, int comp, int nb_of_pieces)
+{
+  vtkAlgorithm *producer = input ? input->GetProducer() : NULL;
+  vtkStreamingDemandDrivenPipeline *exec = producer 
+    ? vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      producer->GetExecutive()) : NULL;
+  if (!exec)
+    {
+    vtkErrorMacro(<< "Can not stream histogram from an invalid input!");
+    return 0;
+    }
+
+  if (nb_of_pieces < 1)
+    {
+    nb_of_pieces = 1;
+    }
+
+  int port = input->GetIndex();
+  exec->UpdateInformation();
+
+  int whole_extent[6];
+  vtkStreamingDemandDrivenPipeline::GetWholeExtent(
+    exec->GetOutputInformation(port), whole_extent);
+
+  // Split the whole extent in slabs, so that each piece is contiguous
 
-      case VTK_UNSIGNED_LONG:
-      {
-      typedef unsigned long type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildIntOrFloat(
-        data, inc_tuple, nb_of_components, this);
-      }
-      break;
+  vtkExtentTranslator *translator = vtkExtentTranslator::New();
+  translator->SetWholeExtent(whole_extent);
+  translator->SetNumberOfPieces(nb_of_pieces);
+  translator->SetGhostLevel(0);
+  translator->SetSplitModeToZSlab();
 
-      case VTK_FLOAT:
-      {
-      typedef float type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildFloat(
-        data, inc_tuple, nb_of_components, this);
-      }
-      break;
+  this->InvokeEvent(vtkCommand::StartEvent, NULL);
 
-      case VTK_DOUBLE:
+  int res = 1, extent[6];
+  for (int piece = 0; piece < nb_of_pieces && res; piece++)
+    {
+    translator->SetPiece(piece);
+    if (!translator->PieceToExtent())
       {
-      typedef double type;
-      type *data = static_cast<type *>
-        (scalars->GetVoidPointer(start_tuple * nb_of_components)) + comp;
-      vtkKWHistogramBuildFloat(
-        data, inc_tuple, nb_of_components, this);
+      continue;
       }
-      break;
+    translator->GetExtent(extent);
 
-      default:
-        vtkErrorMacro(
-          << "Can not build histogram from unsupported data type!");
-        return;
-      }
+    // Update the input for that piece only, and accumulate it
 
-    progress = 0.2 + ((double)start_tuple / (double)nb_of_tuples) * 0.8;
-    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    exec->SetUpdateExtent(port, extent);
+    exec->Update(port);
 
-    start_tuple += inc_tuple;
+    res = this->AccumulateHistogramPiece(
+      vtkImageData::SafeDownCast(producer->GetOutputDataObject(port)), 
+      comp, extent, 
+      (double)piece / (double)nb_of_pieces, 1.0 / (double)nb_of_pieces);
     }
 
-  progress = 1.0;
-  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+  translator->Delete();
 
   this->Bins->Modified();
   this->Modified();
-    
-  this->InvokeEvent(vtkCommand::EndEvent, NULL);
-}
 
-//----------------------------------------------------------------------------
-void vtkKWHistogram::BuildHistogram(vtkDataArray *scalars, int comp)
-{
-  this->UpdateHistogram(scalars, comp, 1);
-}
+  this->InvokeEvent(vtkCommand::EndEvent, NULL);
 
-//----------------------------------------------------------------------------
-void vtkKWHistogram::AccumulateHistogram(vtkDataArray *scalars, int comp)
-{
-  this->UpdateHistogram(scalars, comp, 0);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -804,6 +2468,77 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
     return 1;
     }
 
+  if (!this->ImageResampledBins)
+    {
+    this->ImageResampledBins = vtkDoubleArray::New();
+    }
+  if (!this->ImageTransferFunctionColors)
+    {
+    this->ImageTransferFunctionColors = vtkDoubleArray::New();
+    }
+
+  // Find out how much of the previous image can be reused:
+  // - if the descriptor only differs by its colors (or the transfer
+  //   function was modified), the resampled occurences are still valid and
+  //   the columns are only recolored,
+  // - if the bins were updated incrementally (see SubtractHistogram), only
+  //   the columns covering the modified bins are resampled,
+  // - if the range was only shifted by a whole number of pixels (pan), the
+  //   previous image is shifted and only the exposed columns are resampled.
+  // In each case, all the columns are redrawn if the maximum occurence, 
+  // and therefore the vertical scale, changed.
+
+  unsigned long bins_time = this->Bins->GetMTime();
+  int tfunc_up_to_date = 
+    (!desc->ColorTransferFunction || 
+     this->LastTransferFunctionTime >= 
+     desc->ColorTransferFunction->GetMTime());
+
+  int reuse_samples = 0, recolor = 0, dirty_bins = 0, shift = 0;
+
+  if (this->LastImageBuildTime &&
+      this->ImageResampledBins->GetNumberOfTuples() == (vtkIdType)desc->Width &&
+      this->ImageCoordinates->GetNumberOfTuples() == (vtkIdType)desc->Width)
+    {
+    vtkKWHistogram::ImageDescriptor geometry;
+    geometry.Copy(desc);
+    geometry.SetColor(this->LastImageDescriptor->Color);
+    geometry.SetBackgroundColor(this->LastImageDescriptor->BackgroundColor);
+    geometry.SetOutOfRangeColor(this->LastImageDescriptor->OutOfRangeColor);
+    geometry.SetGridColor(this->LastImageDescriptor->GridColor);
+
+    if (this->LastImageBuildTime < bins_time)
+      {
+      dirty_bins = (this->ImageModifiedBinsTime >= bins_time);
+      }
+
+    if ((dirty_bins || this->LastImageBuildTime >= bins_time) &&
+        this->LastImageDescriptor->IsEqualTo(&geometry))
+      {
+      reuse_samples = 1;
+      recolor = 
+        !this->LastImageDescriptor->IsEqualTo(desc) || !tfunc_up_to_date;
+      }
+    else if (this->LastImageBuildTime >= bins_time && 
+             tfunc_up_to_date && !desc->DrawGrid && desc->Width > 1)
+      {
+      geometry.Copy(desc);
+      geometry.SetRange(this->LastImageDescriptor->Range);
+      double pixels = (desc->Range[0] - this->LastImageDescriptor->Range[0]) 
+        * (double)(desc->Width - 1) / (desc->Range[1] - desc->Range[0]);
+      double rounded_pixels = floor(pixels + 0.5);
+      if (this->LastImageDescriptor->IsEqualTo(&geometry) &&
+          fabs(pixels - rounded_pixels) < 1e-6 &&
+          fabs(rounded_pixels) < (double)desc->Width &&
+          (desc->Range[1] - desc->Range[0]) == 
+          (this->LastImageDescriptor->Range[1] - 
+           this->LastImageDescriptor->Range[0]))
+        {
+        shift = (int)rounded_pixels;
+        }
+      }
+    }
+
   // We need width x height RGBA (unsigned char)
 
   int draw_image = desc->DrawForeground || desc->DrawGrid;
@@ -811,18 +2546,38 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
   int nb_of_components = 3 + (desc->DrawBackground ? 0 : 1);
   unsigned char *image_ptr = NULL;
 
+  int image_reallocated = 0;
   if (draw_image)
     {
-    this->Image->SetDimensions(desc->Width, desc->Height, 1);
-    this->Image->SetWholeExtent(this->Image->GetExtent());
-    this->Image->SetUpdateExtent(this->Image->GetExtent());
-    this->Image->SetScalarTypeToUnsignedChar();
-    this->Image->SetNumberOfScalarComponents(nb_of_components);
-    this->Image->AllocateScalars();
+    vtkDataArray *image_scalars = this->Image->GetPointData()->GetScalars();
+    int *image_dims = this->Image->GetDimensions();
+    if (!image_scalars ||
+        image_scalars->GetDataType() != VTK_UNSIGNED_CHAR ||
+        image_scalars->GetNumberOfComponents() != nb_of_components ||
+        image_dims[0] != (int)desc->Width || 
+        image_dims[1] != (int)desc->Height ||
+        image_dims[2] != 1)
+      {
+      this->Image->SetDimensions(desc->Width, desc->Height, 1);
+      this->Image->SetWholeExtent(this->Image->GetExtent());
+      this->Image->SetUpdateExtent(this->Image->GetExtent());
+      this->Image->SetScalarTypeToUnsignedChar();
+      this->Image->SetNumberOfScalarComponents(nb_of_components);
+      this->Image->AllocateScalars();
+      image_reallocated = 1;
+      }
     image_ptr = 
       static_cast<unsigned char*>(this->Image->GetScalarPointer());
     }
 
+  // The previous image can only be reused if it was drawn
+
+  if (image_reallocated)
+    {
+    reuse_samples = recolor = 0;
+    shift = 0;
+    }
+
   unsigned char *column_ptr = NULL;
 
   // Colors
@@ -848,23 +2603,69 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
   double *tfunccolors = NULL;
   if (desc->ColorTransferFunction)
     {
-    tfunccolors = new double[3 * desc->Width];
+    this->ImageTransferFunctionColors->SetNumberOfComponents(3);
+    this->ImageTransferFunctionColors->SetNumberOfTuples(desc->Width);
+    tfunccolors = this->ImageTransferFunctionColors->GetPointer(0);
     desc->ColorTransferFunction->GetTable(
       desc->Range[0], desc->Range[1], desc->Width, tfunccolors);
     }
 
+  int row_length = desc->Width * nb_of_components;
+
   // Quickly set the whole image to be transparent if no background color
-  // is going to be used
+  // is going to be used, and no column is reused
 
-  if (draw_image && !desc->DrawBackground)
+  int redraw_all = !(reuse_samples && !recolor) && !shift;
+  if (draw_image && !desc->DrawBackground && redraw_all)
     {
     memset(image_ptr, 0, desc->Width * desc->Height * nb_of_components);
     }
 
+  if (!reuse_samples && !shift)
+    {
+    this->ImageCoordinates->SetNumberOfComponents(1);
+    this->ImageCoordinates->SetNumberOfTuples(desc->Width);
+    this->ImageResampledBins->SetNumberOfComponents(1);
+    this->ImageResampledBins->SetNumberOfTuples(desc->Width);
+    }
+  int *image_coords = this->ImageCoordinates->GetPointer(0);
+  double *resampled_histogram = this->ImageResampledBins->GetPointer(0);
+
+  // Pan: shift the columns that are still visible. The columns 
+  // [exposed_first, exposed_last] are the ones that were not visible.
+
+  unsigned int x, y, ylimit;
+  unsigned int exposed_first = 0, exposed_last = desc->Width - 1;
+  if (shift)
+    {
+    unsigned int nb_kept = desc->Width - (shift > 0 ? shift : -shift);
+    unsigned int from = shift > 0 ? shift : 0;
+    unsigned int to = shift > 0 ? 0 : -shift;
+    memmove(resampled_histogram + to, resampled_histogram + from, 
+            nb_kept * sizeof(double));
+    memmove(image_coords + to, image_coords + from, nb_kept * sizeof(int));
+    if (draw_image)
+      {
+      unsigned char *row_ptr = image_ptr;
+      for (y = 0; y < desc->Height; y++)
+        {
+        memmove(row_ptr + to * nb_of_components, 
+                row_ptr + from * nb_of_components,
+                nb_kept * nb_of_components);
+        row_ptr += row_length;
+        }
+      }
+    exposed_first = shift > 0 ? nb_kept : 0;
+    exposed_last = shift > 0 ? desc->Width - 1 : -shift - 1;
+    }
+
   // Fill the image
 
   double *bins_ptr = this->Bins->GetPointer(0);
 
+  this->ComputeAccumulatedBins();
+  double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+
   double value, next_value;
   double occurrence;
 
@@ -884,27 +2685,46 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
 
   double x_scale = hist_subrange / (double)(desc->Width - 1);
 
-  vtkIdType bin, next_bin, iter_bin;
-
-  int row_length = desc->Width * nb_of_components;
+  vtkIdType bin, next_bin;
 
   double bin_real;
   double next_bin_real;
   double max_occurrence = 0.0;
 
-  this->ImageCoordinates->SetNumberOfComponents(1);
-  this->ImageCoordinates->SetNumberOfTuples(desc->Width);
-  int *image_coords = this->ImageCoordinates->GetPointer(0);
+  // Range of columns to draw
 
-  double *resampled_histogram = new double[desc->Width];
+  unsigned int x_first = desc->Width, x_last = 0;
 
-  unsigned int x, y, ylimit;
-  for (x = 0; x < desc->Width; x++)
+  for (x = exposed_first; x <= exposed_last; x++)
     {
     // Get the value and occurrence for this x (column)
 
     value = desc->Range[0] + x_scale * (double)x;
 
+    // Only resample the columns covering the modified bins, if any
+
+    if (reuse_samples)
+      {
+      if (!dirty_bins || resampled_histogram[x] < 0)
+        {
+        continue;
+        }
+      bin = (vtkIdType)floor((value - this->Range[0]) / bin_width);
+      next_bin = (vtkIdType)floor(
+        (desc->Range[0] + x_scale * (double)(x + 1) - this->Range[0]) 
+        / bin_width);
+      if (next_bin < this->ImageModifiedBins[0] || 
+          bin > this->ImageModifiedBins[1])
+        {
+        continue;
+        }
+      }
+    if (x < x_first)
+      {
+      x_first = x;
+      }
+    x_last = x;
+
     // "occurrence" cumulates area under the histogram inside a particular
     // range.
 
@@ -925,11 +2745,13 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
         {
         next_bin = this->GetNumberOfBins();
         }
-      iter_bin = bin;
-      while (++iter_bin < next_bin)
+      // Cumulate the values from the bins strictly between bin and next_bin
+      // using the accumulated occurences, so that the cost of each column
+      // does not depend on how many bins it covers
+
+      if (next_bin - 1 > bin)
         {
-        // We should cumulate values from the bins
-        occurrence += bins_ptr[iter_bin];
+        occurrence += acc_ptr[next_bin - 1] - acc_ptr[bin];
         }
 
       // Compute the partial contribution from the first bin and last bin
@@ -960,10 +2782,6 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
       // single bin on the histogram visible on the interface.
 
       resampled_histogram[x] = x_scale ? (occurrence / x_scale) : 0;
-      if( resampled_histogram[x] > max_occurrence )
-        {
-        max_occurrence = resampled_histogram[x];
-        }
       }
 
     // Out of range, set the occurence to -1, so that it can be
@@ -975,6 +2793,14 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
       }
     }
 
+  for (x = 0; x < desc->Width; x++)
+    {
+    if (resampled_histogram[x] > max_occurrence)
+      {
+      max_occurrence = resampled_histogram[x];
+      }
+    }
+
   if (desc->DefaultMaximumOccurence > 0.0 &&
       desc->DefaultMaximumOccurence > max_occurrence)
     {
@@ -982,6 +2808,16 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
     }
   desc->LastMaximumOccurence = max_occurrence;
 
+  // All the columns are scaled by the maximum occurence: if it changed,
+  // all of them have to be redrawn
+
+  if (redraw_all || 
+      max_occurrence != this->LastImageDescriptor->LastMaximumOccurence)
+    {
+    x_first = 0;
+    x_last = desc->Width - 1;
+    }
+
 #if VTK_KW_HIST_TESTING
   cout << this << " : vtkKWHistogram::GetImage: " 
        << "(" << desc->Range[0] << ".." << desc->Range[1] << ") from "
@@ -991,7 +2827,7 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
        << endl;
 #endif
 
-  for (x = 0; x < desc->Width; x++)
+  for (x = x_first; x <= x_last && x < desc->Width; x++)
     {
     // If the occurence is < 0, it is a flag that in fact we were
     // out of range for that pixel column
@@ -999,6 +2835,19 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
     int out_of_range = (resampled_histogram[x] < 0);
     occurrence = resampled_histogram[x] < 0 ? 0 : resampled_histogram[x];
 
+    // The column is not cleared with the rest of the image when it is
+    // redrawn on its own
+
+    if (!redraw_all && draw_image && !desc->DrawBackground)
+      {
+      column_ptr = image_ptr + x * nb_of_components;
+      for (y = 0; y < desc->Height; y++)
+        {
+        memset(column_ptr, 0, nb_of_components);
+        column_ptr += row_length;
+        }
+      }
+
     // No occurrence and no background to next column since we
     // already assigned all pixels to be fully transparent
     
@@ -1186,14 +3035,8 @@ int vtkKWHistogram::RefreshImage(ImageDescriptor *desc)
 
     }
 
-  delete [] resampled_histogram;
-  
-  if (tfunccolors)
-    {
-    delete [] tfunccolors;
-    }
-
   this->LastImageDescriptor->Copy(desc);
+  this->LastImageDescriptor->LastMaximumOccurence = max_occurrence;
   this->LastImageBuildTime = this->Bins->GetMTime();
   this->LastTransferFunctionTime = 
     (desc->ColorTransferFunction ? desc->ColorTransferFunction->GetMTime() :0);
@@ -1237,6 +3080,7 @@ void vtkKWHistogram::SetLogMode(int arg)
   // The next time the image is queried, it will be refreshed
 
   this->LastImageBuildTime = 0;
+  this->ImageModifiedBinsTime = 0;
 
   this->Modified();
 }
@@ -1253,26 +3097,38 @@ void vtkKWHistogram::ComputeStatistics()
   double max = VTK_DOUBLE_MIN;
   double total = 0.0;
 
+  vtkIdType min_bin = -1;
+  vtkIdType max_bin = -1;
+
   double *bins_ptr = this->Bins->GetPointer(0);
-  double *bins_ptr_end = bins_ptr + this->GetNumberOfBins();
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
 
-  while (bins_ptr < bins_ptr_end)
+  vtkIdType i;
+  for (i = 0; i < nb_of_bins; i++)
     {
-    if (*bins_ptr < min)
+    if (bins_ptr[i] < min)
       {
-      min = *bins_ptr;
+      min = bins_ptr[i];
+      min_bin = i;
       }
-    if (*bins_ptr > max)
+    if (bins_ptr[i] > max)
       {
-      max = *bins_ptr;
+      max = bins_ptr[i];
+      max_bin = i;
       }
-    total += *bins_ptr;
-    bins_ptr++;
+    total += bins_ptr[i];
     }
 
-  this->MinimumOccurence = min;
-  this->MaximumOccurence = max;
-  this->TotalOccurence   = total;
+  if (!nb_of_bins)
+    {
+    min = max = 0.0;
+    }
+
+  this->MinimumOccurence    = min;
+  this->MaximumOccurence    = max;
+  this->TotalOccurence      = total;
+  this->MinimumOccurenceBin = min_bin;
+  this->MaximumOccurenceBin = max_bin;
 
   this->LastStatisticsBuildTime = this->Bins->GetMTime();
 }
@@ -1317,63 +3173,330 @@ double vtkKWHistogram::GetOccurenceAtValue(double value)
   return *bins_ptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkKWHistogram::ComputeAccumulatedBins()
+{
+  if (this->LastAccumulatedBinsBuildTime >= this->Bins->GetMTime())
+    {
+    return;
+    }
+
+  // Same order of summation as a sequential scan of the bins, so that the
+  // accumulated occurences are the same
+
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
+  this->AccumulatedBins->SetNumberOfComponents(1);
+  this->AccumulatedBins->SetNumberOfTuples(nb_of_bins);
+
+  double *bins_ptr = this->Bins->GetPointer(0);
+  double *bins_ptr_end = bins_ptr + nb_of_bins;
+  double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+
+  double total = 0.0;
+  while (bins_ptr < bins_ptr_end)
+    {
+    total += *bins_ptr++;
+    *acc_ptr++ = total;
+    }
+
+  this->LastAccumulatedBinsBuildTime = this->Bins->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkKWHistogram::GetExcludedBin(double *exclude_value)
+{
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
+  if (!exclude_value || 
+      *exclude_value < this->Range[0] || *exclude_value >= this->Range[1] ||
+      !nb_of_bins)
+    {
+    return -1;
+    }
+
+  vtkIdType bin = (vtkIdType)floor(
+    (*exclude_value - this->Range[0]) * (double)nb_of_bins / 
+    (this->Range[1] - this->Range[0]));
+  return bin < nb_of_bins ? bin : nb_of_bins - 1;
+}
+
 //----------------------------------------------------------------------------
 double vtkKWHistogram::GetValueAtAccumulatedOccurence(
   double acc, double *exclude_value)
 {
-  double total = 0.0;
+  double value;
+  this->GetValuesAtAccumulatedOccurences(1, &acc, &value, exclude_value);
+  return value;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::GetValuesAtAccumulatedOccurences(
+  int nb_of_accs, const double *accs, double *values, double *exclude_value)
+{
+  if (nb_of_accs <= 0 || !accs || !values)
+    {
+    return;
+    }
+
+  this->ComputeAccumulatedBins();
 
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
   double bin_width = 
     (this->Range[1] == this->Range[0] ? 0 : 
-     (this->Range[1] - this->Range[0]) / (double)this->GetNumberOfBins());
+     (this->Range[1] - this->Range[0]) / (double)nb_of_bins);
 
-  double *bins_ptr = this->Bins->GetPointer(0);
-  double *bins_ptr_end = bins_ptr + this->GetNumberOfBins();
+  const double *bins_ptr = this->Bins->GetPointer(0);
+  const double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+
+  // The occurences of the excluded bin are removed from the accumulated
+  // occurences of that bin and the following ones
+
+  vtkIdType excluded_bin = this->GetExcludedBin(exclude_value);
+  double excluded_occ = excluded_bin >= 0 ? bins_ptr[excluded_bin] : 0.0;
 
-  if (exclude_value)
+  for (int i = 0; i < nb_of_accs; i++)
     {
-    double low = this->Range[0];
-    while (bins_ptr < bins_ptr_end)
+    double acc = accs[i];
+
+    // Binary search for the first bin where the accumulated occurence
+    // reaches 'acc'
+
+    vtkIdType low = 0, high = nb_of_bins;
+    while (low < high)
       {
-      if (*exclude_value < low || *exclude_value >= low + bin_width)
+      vtkIdType mid = low + (high - low) / 2;
+      double total = acc_ptr[mid] - (mid >= excluded_bin ? excluded_occ : 0);
+      if (total >= acc)
         {
-        total += *bins_ptr;
-        if (total >= acc)
-          {
-          break;
-          }
+        high = mid;
+        }
+      else
+        {
+        low = mid + 1;
         }
-      bins_ptr++;
-      low += bin_width;
       }
+    if (low == excluded_bin)
+      {
+      low++;
+      }
+
+    // If we never reached acc, return the upper bound
+
+    if (low >= nb_of_bins)
+      {
+      values[i] = this->Range[1];
+      continue;
+      }
+
+    // Otherwise interpolate
+
+    double total = acc_ptr[low] - (low >= excluded_bin ? excluded_occ : 0);
+    double previous_total = total - bins_ptr[low];
+    double delta_acc = (total - previous_total);
+    double partial_v = (delta_acc ? (acc - previous_total) / delta_acc : 0);
+    values[i] = this->Range[0] + bin_width * ((double)low + partial_v);
     }
-  else
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram::GetValuesAtPercentiles(vtkDoubleArray *percentiles, 
+                                            vtkDoubleArray *values,
+                                            double *exclude_value)
+{
+  if (!percentiles || !values)
+    {
+    return;
+    }
+
+  vtkIdType nb_of_percentiles = percentiles->GetNumberOfTuples();
+  values->SetNumberOfComponents(1);
+  values->SetNumberOfTuples(nb_of_percentiles);
+  if (!nb_of_percentiles)
+    {
+    return;
+    }
+
+  // Convert the percentiles to accumulated occurences, relative to the
+  // total occurence minus the excluded bin
+
+  double total = this->GetTotalOccurence();
+  vtkIdType excluded_bin = this->GetExcludedBin(exclude_value);
+  if (excluded_bin >= 0)
+    {
+    total -= this->Bins->GetValue(excluded_bin);
+    }
+
+  double *accs = new double [nb_of_percentiles];
+  for (vtkIdType i = 0; i < nb_of_percentiles; i++)
+    {
+    accs[i] = percentiles->GetValue(i) * total;
+    }
+
+  this->GetValuesAtAccumulatedOccurences(
+    (int)nb_of_percentiles, accs, values->GetPointer(0), exclude_value);
+
+  delete [] accs;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWHistogram::GetAccumulatedOccurenceAtValue(
+  double value, double *exclude_value)
+{
+  vtkIdType nb_of_bins = this->GetNumberOfBins();
+  if (!nb_of_bins || value <= this->Range[0])
+    {
+    return 0.0;
+    }
+
+  this->ComputeAccumulatedBins();
+
+  const double *bins_ptr = this->Bins->GetPointer(0);
+  const double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+
+  vtkIdType excluded_bin = this->GetExcludedBin(exclude_value);
+  double excluded_occ = excluded_bin >= 0 ? bins_ptr[excluded_bin] : 0.0;
+
+  if (value >= this->Range[1])
+    {
+    return acc_ptr[nb_of_bins - 1] - excluded_occ;
+    }
+
+  // Accumulated occurence up to the bin holding the value, plus the part
+  // of that bin below the value
+
+  double bin_real = (value - this->Range[0]) * (double)nb_of_bins / 
+    (this->Range[1] - this->Range[0]);
+  vtkIdType bin = (vtkIdType)floor(bin_real);
+  if (bin >= nb_of_bins)
+    {
+    bin = nb_of_bins - 1;
+    }
+
+  double acc = (bin > 0 ? acc_ptr[bin - 1] : 0.0) - 
+    (bin > excluded_bin && excluded_bin >= 0 ? excluded_occ : 0.0);
+  if (bin != excluded_bin)
+    {
+    acc += bins_ptr[bin] * (bin_real - (double)bin);
+    }
+  return acc;
+}
+
+//----------------------------------------------------------------------------
+// Tag written first by SaveToStream, read back with the same byte order
+// only
+
+#define VTK_KW_HIST_STREAM_MAGIC 0x4b574831 // 'KWH1'
+
+int vtkKWHistogram::SaveToStream(ostream &os)
+{
+  this->ComputeStatistics();
+
+  vtkTypeUInt32 magic = VTK_KW_HIST_STREAM_MAGIC;
+  vtkTypeInt64 nb_of_bins = this->GetNumberOfBins();
+  vtkTypeInt64 extrema_bins[2];
+  extrema_bins[0] = this->MinimumOccurenceBin;
+  extrema_bins[1] = this->MaximumOccurenceBin;
+  double stats[3];
+  stats[0] = this->MinimumOccurence;
+  stats[1] = this->MaximumOccurence;
+  stats[2] = this->TotalOccurence;
+
+  os.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+  os.write(reinterpret_cast<const char*>(this->Range), sizeof(this->Range));
+  os.write(reinterpret_cast<const char*>(&nb_of_bins), sizeof(nb_of_bins));
+  os.write(reinterpret_cast<const char*>(stats), sizeof(stats));
+  os.write(reinterpret_cast<const char*>(extrema_bins), 
+           sizeof(extrema_bins));
+  if (nb_of_bins)
+    {
+    os.write(reinterpret_cast<const char*>(this->Bins->GetPointer(0)), 
+             nb_of_bins * sizeof(double));
+    }
+
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram::LoadFromStream(istream &is)
+{
+  vtkTypeUInt32 magic = 0;
+  double range[2];
+  vtkTypeInt64 nb_of_bins = 0;
+  vtkTypeInt64 extrema_bins[2];
+  double stats[3];
+
+  is.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  is.read(reinterpret_cast<char*>(range), sizeof(range));
+  is.read(reinterpret_cast<char*>(&nb_of_bins), sizeof(nb_of_bins));
+  is.read(reinterpret_cast<char*>(stats), sizeof(stats));
+  is.read(reinterpret_cast<char*>(extrema_bins), sizeof(extrema_bins));
+  if (!is.good() || magic != VTK_KW_HIST_STREAM_MAGIC || 
+      nb_of_bins < 0 || nb_of_bins > this->MaximumNumberOfBins ||
+      range[1] < range[0])
+    {
+    vtkErrorMacro(<< "Can not load histogram from invalid stream!");
+    return 0;
+    }
+
+  // Do not allocate more bins than the stream holds (if it can tell), so 
+  // that a corrupted or truncated stream is rejected before allocating
+
+  istream::pos_type pos = is.tellg();
+  if (pos != istream::pos_type(-1))
     {
-    while (bins_ptr < bins_ptr_end)
+    is.seekg(0, ios::end);
+    istream::pos_type end = is.tellg();
+    is.seekg(pos);
+    if (end != istream::pos_type(-1) && 
+        (vtkTypeInt64)(end - pos) < nb_of_bins * (vtkTypeInt64)sizeof(double))
       {
-      total += *bins_ptr;
-      if (total >= acc)
-        {
-        break;
-        }
-      bins_ptr++;
+      vtkErrorMacro(<< "Can not load histogram bins from truncated stream!");
+      return 0;
       }
     }
-  
-  // If we never reached acc, return the upper bound
 
-  if (bins_ptr == bins_ptr_end)
+  // Read the bins in a separate array first, so that the histogram is not
+  // modified if the stream is truncated
+
+  vtkDoubleArray *bins = vtkDoubleArray::New();
+  bins->SetNumberOfComponents(1);
+  bins->SetNumberOfTuples((vtkIdType)nb_of_bins);
+  if (nb_of_bins)
+    {
+    is.read(reinterpret_cast<char*>(bins->GetPointer(0)), 
+            nb_of_bins * sizeof(double));
+    }
+  if (!is.good())
+    {
+    vtkErrorMacro(<< "Can not load histogram bins from truncated stream!");
+    bins->Delete();
+    return 0;
+    }
+
+  this->Range[0] = range[0];
+  this->Range[1] = range[1];
+
+  this->Bins->SetNumberOfComponents(1);
+  this->Bins->SetNumberOfTuples((vtkIdType)nb_of_bins);
+  if (nb_of_bins)
     {
-    return this->Range[1];
+    memcpy(this->Bins->GetPointer(0), bins->GetPointer(0), 
+           nb_of_bins * sizeof(double));
     }
+  bins->Delete();
+  this->Bins->Modified();
+
+  // The statistics were saved with the bins, no need to scan them
 
-  // Otherwise interpolate
+  this->MinimumOccurence    = stats[0];
+  this->MaximumOccurence    = stats[1];
+  this->TotalOccurence      = stats[2];
+  this->MinimumOccurenceBin = (vtkIdType)extrema_bins[0];
+  this->MaximumOccurenceBin = (vtkIdType)extrema_bins[1];
+  this->LastStatisticsBuildTime = this->Bins->GetMTime();
+
+  this->Modified();
 
-  vtkIdType index = bins_ptr - this->Bins->GetPointer(0);
-  double previous_total = total - *bins_ptr;
-  double delta_acc = (total - previous_total);
-  double partial_v = (delta_acc ? (acc - previous_total) / delta_acc : 0);
-  return this->Range[0] + bin_width * ((double)index + partial_v);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -1385,6 +3508,9 @@ void vtkKWHistogram::PrintSelf(ostream& os, vtkIndent indent)
      << this->Range[0] << ", " << this->Range[1] << endl;
   os << indent << "LogMode: " << (this->LogMode ? "On" : "Off") << endl;
   os << indent << "MaximumNumberOfBins: " << this->MaximumNumberOfBins << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "SinglePassBuild: " 
+     << (this->SinglePassBuild ? "On" : "Off") << endl;
   os << indent << "DataSet: ";
   if (this->Bins)
     {
@@ -19,7 +19,9 @@
 
 #include "vtkObject.h"
 #include "vtkKWWidgets.h" // Needed for export symbols directives
+#include "vtkMultiThreader.h" // Needed for VTK_MAX_THREADS
 
+class vtkAlgorithmOutput;
 class vtkColorTransferFunction;
 class vtkDataArray;
 class vtkImageData;
@@ -50,10 +52,36 @@ public:
 
   // Description:
   // Set/Get the maximum number of bins that should be used when
-  // creating the histogram
+  // creating the histogram. The images are resampled from the accumulated
+  // occurences, so a large number of bins (say, 65536 for 16-bit data)
+  // does not slow down GetImage when zooming or panning.
   vtkSetMacro(MaximumNumberOfBins, vtkIdType);
   vtkGetMacro(MaximumNumberOfBins, vtkIdType);
 
+  // Description:
+  // Set/Get the maximum number of threads used to fill the bins when
+  // building or accumulating the histogram. Each thread bins a subset of
+  // the scalars in its own private bins, which are merged at the end; the
+  // result does not depend on the number of threads.
+  // Defaults to the number of processors available.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Set/Get if BuildHistogram should estimate the range and fill the bins
+  // in a single pass over the scalars, instead of scanning them once to
+  // find their range and once more to fill the bins (default is Off).
+  // In that mode, a provisional fine-grained histogram is filled while the
+  // range is computed, then re-binned into the final bins. The result is
+  // identical for 8 and 16 bits integer scalars, and for integer scalars
+  // whose range is small enough; other values are binned at the
+  // provisional resolution first, which can move a value to a neighbour
+  // bin. No pass is saved if the range of the scalars is already known,
+  // in which case the regular (exact) path is used.
+  vtkSetMacro(SinglePassBuild, int);
+  vtkGetMacro(SinglePassBuild, int);
+  vtkBooleanMacro(SinglePassBuild, int);
+
   // Description:
   // Get min, max, total occurence
   virtual double GetMinimumOccurence();
@@ -71,11 +99,54 @@ public:
   virtual double GetValueAtAccumulatedOccurence(
     double acc, double *exclude_value = 0);
 
+  // Description:
+  // Get the values at several accumulated occurences at once, see
+  // GetValueAtAccumulatedOccurence. 'values' should be large enough
+  // to store 'nb_of_accs' values.
+  // The accumulated occurences are kept in a table that is rebuilt only
+  // when the bins are modified, each value is found by a binary search.
+  virtual void GetValuesAtAccumulatedOccurences(
+    int nb_of_accs, const double *accs, double *values, 
+    double *exclude_value = 0);
+
+  // Description:
+  // Get the values at several percentiles at once. Each percentile is
+  // expressed as a fraction (in [0, 1]) of the total occurence (minus the
+  // occurence of the bin holding *exclude_value, if specified).
+  // 'values' is resized to the number of 'percentiles'.
+  virtual void GetValuesAtPercentiles(
+    vtkDoubleArray *percentiles, vtkDoubleArray *values,
+    double *exclude_value = 0);
+
+  // Description:
+  // Get the accumulated occurence at a given value in the histogram, i.e.
+  // the number of occurences below that value (inverse of
+  // GetValueAtAccumulatedOccurence). 'exclude_value' is not NULL, it is a
+  // pointer to a value which bin will be ignored from the computation.
+  virtual double GetAccumulatedOccurenceAtValue(
+    double value, double *exclude_value = 0);
+
   // Description:
   // Build/update the histogram from scalars (given a component)
   // The Range and number of bins are modified automatically
   virtual void BuildHistogram(vtkDataArray *scalars, int component);
 
+  //BTX
+  // Description:
+  // Build the histograms of several components of the same scalars at once.
+  // 'histograms' holds one entry per component of the scalars: the n-th
+  // histogram is built from the n-th component, as BuildHistogram would
+  // (NULL entries are skipped). Instead of scanning the scalars twice per
+  // component, the range of all the components is computed in one pass
+  // (unless already known), then all the bins are filled in a single
+  // interleaved pass, spread over up to 'nb_of_threads' threads. The bins
+  // are exact (SinglePassBuild is ignored). Progress events are invoked
+  // on the first histogram only.
+  // Return 1 on success, 0 otherwise.
+  static int BuildHistograms(
+    vtkDataArray *scalars, vtkKWHistogram **histograms, int nb_of_threads);
+  //ETX
+
   // Description:
   // Set the histogram range.
   // Note that Range[1] is exclusive.
@@ -112,6 +183,55 @@ public:
   //        of bins is changed).
   virtual void AccumulateHistogram(vtkDataArray *scalars, int component);
 
+  // Description:
+  // Accumulate the histogram from the scalars of an image (given a
+  // component), restricted to a given extent if specified. This can be used
+  // to build an histogram from successive pieces of a volume too large to
+  // fit in memory, as produced by a streaming reader. The bins are fixed:
+  // as for the method above, the Range has to be set appropriately first,
+  // each piece has to lie within that Range; if the histogram is empty
+  // (see EmptyHistogram), the bins are allocated for that Range given the
+  // scalar type of the piece.
+  virtual void AccumulateHistogram(vtkImageData *image, int component);
+  virtual void AccumulateHistogram(
+    vtkImageData *image, int component, int extent[6]);
+
+  // Description:
+  // Subtract the scalars of an image (given a component), restricted to a
+  // given extent, from the histogram. This can be used to keep the
+  // histogram up to date when a region of the image is edited: subtract
+  // the extent before modifying the scalars, then accumulate it again
+  // (see AccumulateHistogram above) once they have been modified. The
+  // statistics, the accumulated occurences and the image of the histogram
+  // are then updated in a time proportional to the size of the extent and
+  // of the range of the bins it hit, instead of being recomputed from
+  // scratch. The scalars of the extent have to lie within the Range.
+  virtual void SubtractHistogram(
+    vtkImageData *image, int component, int extent[6]);
+
+  // Description:
+  // Accumulate the histogram from the output of an image pipeline (given a
+  // component), by streaming its whole extent in 'nb_of_pieces' pieces.
+  // Only one piece is requested from the pipeline at a time, which bounds
+  // the memory footprint. The bins are fixed, see AccumulateHistogram.
+  // A progress event is sent for each piece.
+  // Return 1 on success, 0 otherwise.
+  virtual int AccumulateHistogramFromStreamedImage(
+    vtkAlgorithmOutput *input, int component, int nb_of_pieces);
+
+  // Description:
+  // Save/load the Range, bins and statistics of the histogram to/from a
+  // binary stream (opened in binary mode), so that it can be restored
+  // without going through the scalars again. The data is written in the
+  // native byte order, a stream saved on a machine with a different byte
+  // order is rejected by LoadFromStream, as well as a stream holding more
+  // bins than MaximumNumberOfBins.
+  // Return 1 on success, 0 otherwise (the histogram is left unchanged).
+  //BTX
+  virtual int SaveToStream(ostream &os);
+  virtual int LoadFromStream(istream &is);
+  //ETX
+
   // Description:
   // Empty this histogram (0 bins). The next time the number of bins is
   // changed (BuildHistogram or AccumulateHistogram), each bin is set to 0.
@@ -139,12 +259,61 @@ protected:
   int           LogMode;
   vtkIdType     MaximumNumberOfBins;
 
+  vtkMultiThreader *Threader;
+  int               NumberOfThreads;
+  int               SinglePassBuild;
+
+  // Description:
+  // Get the range of the scalars (given a component). The range computed
+  // the last time is reused if the scalars have not been modified since;
+  // otherwise it is computed if 'compute' is true.
+  // Return 1 if the range was found, 0 otherwise.
+  virtual int GetScalarsRange(
+    vtkDataArray *scalars, int component, double range[2], int compute);
+  virtual void SetScalarsRangeCache(
+    vtkDataArray *scalars, int component, const double range[2]);
+  vtkDataArray  *ScalarsRangeCacheArray; // not referenced, only compared
+  int           ScalarsRangeCacheComponent;
+  unsigned long ScalarsRangeCacheTime;
+  double        ScalarsRangeCache[2];
+
   virtual void ComputeStatistics();
   unsigned long LastStatisticsBuildTime;
 
   double MinimumOccurence;
   double MaximumOccurence;
   double TotalOccurence;
+  vtkIdType MinimumOccurenceBin;
+  vtkIdType MaximumOccurenceBin;
+
+  // Description:
+  // Accumulated occurences (i.e. the n-th element is the sum of the
+  // first n+1 bins), rebuilt lazily when the bins are modified. Used to
+  // answer quantile queries and to resample the bins in RefreshImage.
+  virtual void ComputeAccumulatedBins();
+  vtkDoubleArray *AccumulatedBins;
+  unsigned long  LastAccumulatedBinsBuildTime;
+
+  // Description:
+  // Return 1 if histograms can be built from scalars of type 'data_type'.
+  // Given the range of the scalars (given a component), compute the
+  // histogram range and the number of bins required (at most
+  // 'max_nb_of_bins'). The range of 8 bits scalars is not used, the whole
+  // type range is. Also used by vtkKWHistogram2D along each axis.
+  //BTX
+  static int IsSupportedDataType(int data_type);
+  static void ComputeRangeAndNumberOfBins(
+    vtkDataArray *scalars,
+    const double scalars_range[2],
+    vtkIdType max_nb_of_bins,
+    double range[2], 
+    vtkIdType *nb_of_bins);
+  friend class vtkKWHistogram2D;
+  //ETX
+
+  // Description:
+  // Get the bin holding *exclude_value, or -1 if none.
+  virtual vtkIdType GetExcludedBin(double *exclude_value);
 
   // Description:
   // Update the histogram from scalars (given a component)
@@ -159,6 +328,81 @@ protected:
     vtkDataArray *scalars, int component, 
     double range[2], vtkIdType *nb_of_bins);
 
+  // Description:
+  // Bin 'nb_of_tuples' tuples of 'scalars' (given a component), starting
+  // at tuple 'start_tuple', into the current bins. Neither the Range nor
+  // the number of bins are modified, the scalars have to fit in the Range.
+  // Each value adds 'weight' to its bin (1 to accumulate, -1 to subtract).
+  // The work is split between NumberOfThreads threads. Progress events
+  // are sent from 'progress_start' to 'progress_start' + 'progress_span'
+  // (none if 'progress_span' is 0).
+  // Return 1 on success, 0 otherwise.
+  virtual int BinScalars(
+    vtkDataArray *scalars, int component, 
+    vtkIdType start_tuple, vtkIdType nb_of_tuples, double weight,
+    double progress_start, double progress_span);
+
+  // Description:
+  // Clip an extent (whole extent if NULL) to the extent of an image, and
+  // get the range of its scalars (given a component) into 'piece_range'.
+  // The scalars have to fit in the Range.
+  // Return the number of tuples in the clipped extent, -1 on error.
+  virtual vtkIdType GetHistogramPieceExtent(
+    vtkImageData *image, int component, int extent[6],
+    int piece_extent[6], double piece_range[2]);
+
+  // Description:
+  // Bin the scalars of an image (given a component) restricted to a
+  // clipped extent (see GetHistogramPieceExtent), with a given weight (see
+  // BinScalars). See above for progress events.
+  // Return 1 on success, 0 otherwise.
+  virtual int BinHistogramPiece(
+    vtkImageData *image, int component, int piece_extent[6], double weight,
+    double progress_start, double progress_span);
+
+  // Description:
+  // Accumulate the scalars of an image (given a component) restricted to a
+  // given extent (if not NULL) into the fixed bins. No Start or End events
+  // are sent, see above for progress events.
+  // Return 1 on success, 0 otherwise.
+  virtual int AccumulateHistogramPiece(
+    vtkImageData *image, int component, int extent[6],
+    double progress_start, double progress_span);
+
+  // Description:
+  // Add (weight = 1) or subtract (weight = -1) the scalars of an image
+  // (given a component) restricted to a given extent, and update the
+  // statistics, accumulated occurences and image of the histogram given the
+  // range of bins that were modified, if they were up to date.
+  // Return 1 on success, 0 otherwise.
+  virtual int UpdateHistogramPiece(
+    vtkImageData *image, int component, int extent[6], double weight);
+
+  // Description:
+  // Range of bins modified since the image was last computed, and the bins
+  // time at which that range was last extended. If the image descriptor
+  // does not change, RefreshImage only resamples and redraws the columns
+  // covering these bins. The resampled occurence of each column is kept in
+  // ImageResampledBins.
+  vtkIdType      ImageModifiedBins[2];
+  unsigned long  ImageModifiedBinsTime;
+  vtkDoubleArray *ImageResampledBins;
+
+  // Description:
+  // Colors of the transfer function for each column of the image, kept
+  // between calls to RefreshImage to avoid reallocating them.
+  vtkDoubleArray *ImageTransferFunctionColors;
+
+  // Description:
+  // Compute the Range and number of bins, and fill the bins, from scalars
+  // (given a component) in a single pass (see SinglePassBuild).
+  // Progress events are sent from 'progress_start' to
+  // 'progress_start' + 'progress_span'.
+  // Return 1 on success, 0 otherwise.
+  virtual int BuildHistogramInSinglePass(
+    vtkDataArray *scalars, int component, 
+    double progress_start, double progress_span);
+
 public:
   // Description:
   // Get an image of the histogram. The image parameters are described 
@@ -167,6 +411,10 @@ public:
   // If DrawBackground is false, the background pixels are set to be 
   // transparent and the resulting image is created in RGBA space instead
   // of RGB.
+  // The previous image is reused whenever possible: changing the colors
+  // only redraws the columns without resampling the bins, and shifting the
+  // Range by a whole number of pixels (without grid) only computes the
+  // columns that were not visible.
   //BTX
   // @cond nested_class
   class KWWidgets_EXPORT ImageDescriptor
@@ -0,0 +1,1070 @@
+/*=========================================================================
+
+  Module:    $RCSfile: vtkKWHistogram2D.cxx,v $
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkKWHistogram2D.h"
+
+#include "vtkColorTransferFunction.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkKWHistogram.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+
+#include <math.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkKWHistogram2D);
+vtkCxxRevisionMacro(vtkKWHistogram2D, "$Revision: 1.1 $");
+
+//----------------------------------------------------------------------------
+vtkKWHistogram2D::vtkKWHistogram2D()
+{
+  this->XRange[0]                = 0;
+  this->XRange[1]                = 1.0;
+  this->YRange[0]                = 0;
+  this->YRange[1]                = 1.0;
+
+  this->Bins                     = vtkDoubleArray::New();
+  this->EmptyHistogram();
+
+  this->MaximumNumberOfBins[0]   = 256;
+  this->MaximumNumberOfBins[1]   = 256;
+
+  this->Image                    = NULL;
+  this->LastImageDescriptor      = NULL;
+  this->LastImageBuildTime       = 0;
+  this->LastTransferFunctionTime = 0;
+  this->LogMode                  = 1;
+
+  this->Threader                 = vtkMultiThreader::New();
+  this->NumberOfThreads          = this->Threader->GetNumberOfThreads();
+
+  this->LastStatisticsBuildTime  = 0;
+  this->MinimumOccurence         = 0.0;
+  this->MaximumOccurence         = 0.0;
+  this->TotalOccurence           = 0.0;
+
+  this->AccumulatedBins              = vtkDoubleArray::New();
+  this->LastAccumulatedBinsBuildTime = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkKWHistogram2D::~vtkKWHistogram2D()
+{
+  if (this->Bins)
+    {
+    this->Bins->Delete();
+    this->Bins = NULL;
+    }
+
+  if (this->AccumulatedBins)
+    {
+    this->AccumulatedBins->Delete();
+    this->AccumulatedBins = NULL;
+    }
+
+  if (this->Image)
+    {
+    this->Image->Delete();
+    this->Image = NULL;
+    }
+
+  if (this->LastImageDescriptor)
+    {
+    delete this->LastImageDescriptor;
+    this->LastImageDescriptor = NULL;
+    }
+
+  if (this->Threader)
+    {
+    this->Threader->Delete();
+    this->Threader = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::EmptyHistogram()
+{
+  this->NumberOfXBins = 0;
+  this->NumberOfYBins = 0;
+  if (this->Bins)
+    {
+    this->Bins->SetNumberOfComponents(1);
+    this->Bins->SetNumberOfTuples(0);
+    this->Bins->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+
+// The binning engine.
+// The tuples are split evenly between threads, each thread filling its own
+// private bins, merged at the end. Each thread converts the two components
+// to double one block of tuples at a time, then bins the pairs of values, so
+// that the two scalars do not have to be dispatched over each pair of types.
+
+// Do not bother spawning threads for less than that many tuples per thread
+
+#define VTK_KW_HIST2D_MIN_TUPLES_PER_THREAD 65536
+
+// Number of chunks the tuples are split into, so that progress events can be
+// sent in between
+
+#define VTK_KW_HIST2D_NB_PROGRESS_CHUNKS 5
+
+// Number of tuples converted at once
+
+#define VTK_KW_HIST2D_BLOCK_TUPLES 1024
+
+//----------------------------------------------------------------------------
+class vtkKWHistogram2DBinningInfo
+{
+public:
+  vtkDataArray *Scalars[2];     // X and Y scalars
+  int          Components[2];   // component to bin in each
+  vtkIdType    StartTuple;      // first tuple to bin in this pass
+  vtkIdType    NumberOfTuples;  // number of tuples to bin in this pass
+  double       Ranges[2][2];    // histogram X and Y ranges
+  vtkIdType    NumberOfBins[2]; // histogram number of bins along X and Y
+  double       **ThreadBins;    // bins for each thread
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkKWHistogram2DGetComponent(
+  T *data, int nb_of_components,
+  vtkIdType start_tuple, vtkIdType nb_tuples, double *values)
+{
+  data += start_tuple * nb_of_components;
+  double *values_end = values + nb_tuples;
+  while (values < values_end)
+    {
+    *values++ = (double)*data;
+    data += nb_of_components;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2DBinTuples(
+  vtkKWHistogram2DBinningInfo *info,
+  vtkIdType start_tuple, vtkIdType nb_tuples, double *bins_ptr)
+{
+  double values[2][VTK_KW_HIST2D_BLOCK_TUPLES];
+
+  // All data types are binned by scaling the values to the number of bins
+  // (vtkKWHistogram only does so for floating point scalars). For integer
+  // scalars whose range fits in the maximum number of bins, the scale is 1
+  // and each integer value gets its own bin; otherwise several consecutive
+  // values share a bin.
+
+  double scale[2];
+  int axis;
+  for (axis = 0; axis < 2; axis++)
+    {
+    scale[axis] =
+      (info->Ranges[axis][1] == info->Ranges[axis][0] ? 1 :
+       (double)info->NumberOfBins[axis] /
+       (info->Ranges[axis][1] - info->Ranges[axis][0]));
+    }
+
+  double nb_of_x_bins = (double)info->NumberOfBins[0];
+  double nb_of_y_bins = (double)info->NumberOfBins[1];
+  double x, y;
+  vtkIdType i, nb_block_tuples;
+
+  vtkIdType end_tuple = start_tuple + nb_tuples;
+  while (start_tuple < end_tuple)
+    {
+    nb_block_tuples = end_tuple - start_tuple;
+    if (nb_block_tuples > VTK_KW_HIST2D_BLOCK_TUPLES)
+      {
+      nb_block_tuples = VTK_KW_HIST2D_BLOCK_TUPLES;
+      }
+
+    for (axis = 0; axis < 2; axis++)
+      {
+      vtkDataArray *scalars = info->Scalars[axis];
+      switch (scalars->GetDataType())
+        {
+        vtkTemplateMacro(
+          vtkKWHistogram2DGetComponent(
+            static_cast<VTK_TT*>(scalars->GetVoidPointer(0)) +
+            info->Components[axis],
+            scalars->GetNumberOfComponents(),
+            start_tuple, nb_block_tuples, values[axis]));
+        }
+      }
+
+    // Values outside the ranges (or NaN) are not binned
+
+    for (i = 0; i < nb_block_tuples; i++)
+      {
+      x = (values[0][i] - info->Ranges[0][0]) * scale[0];
+      y = (values[1][i] - info->Ranges[1][0]) * scale[1];
+      if (x >= 0.0 && x < nb_of_x_bins && y >= 0.0 && y < nb_of_y_bins)
+        {
+        bins_ptr[(vtkIdType)y * info->NumberOfBins[0] + (vtkIdType)x]++;
+        }
+      }
+
+    start_tuple += nb_block_tuples;
+    }
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkKWHistogram2DBinningThreadedExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *thread_info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWHistogram2DBinningInfo *info =
+    static_cast<vtkKWHistogram2DBinningInfo*>(thread_info->UserData);
+
+  // Split the tuples evenly between threads
+
+  vtkIdType nb_threads = thread_info->NumberOfThreads;
+  vtkIdType thread_id = thread_info->ThreadID;
+  vtkIdType start_tuple =
+    info->StartTuple + (info->NumberOfTuples * thread_id) / nb_threads;
+  vtkIdType end_tuple =
+    info->StartTuple + (info->NumberOfTuples * (thread_id + 1)) / nb_threads;
+
+  vtkKWHistogram2DBinTuples(
+    info, start_tuple, end_tuple - start_tuple, info->ThreadBins[thread_id]);
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Compute the histogram range and the number of bins required along one
+// axis (the 8 bits types use the whole type range and do not need to be
+// scanned).
+
+static void vtkKWHistogram2DComputeRangeAndNumberOfBins(
+  vtkDataArray *scalars,
+  int comp,
+  vtkIdType max_nb_of_bins,
+  double range[2],
+  vtkIdType *nb_of_bins)
+{
+  double scalars_range[2] = { 0.0, 0.0 };
+  switch (scalars->GetDataType())
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      break;
+
+    default:
+      scalars->GetRange(scalars_range, comp);
+      break;
+    }
+
+  vtkKWHistogram::ComputeRangeAndNumberOfBins(
+    scalars, scalars_range, max_nb_of_bins, range, nb_of_bins);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::UpdateHistogram(vtkDataArray *xscalars,
+                                       int xcomp,
+                                       vtkDataArray *yscalars,
+                                       int ycomp,
+                                       int reset_range)
+{
+  if (!xscalars || !yscalars)
+    {
+    vtkErrorMacro(<< "Can not build histogram from NULL scalars!");
+    return;
+    }
+
+  if (xcomp < 0 || xcomp >= xscalars->GetNumberOfComponents() ||
+      ycomp < 0 || ycomp >= yscalars->GetNumberOfComponents())
+    {
+    vtkErrorMacro(<< "Can not build histogram from invalid component!");
+    return;
+    }
+
+  vtkIdType nb_of_tuples = xscalars->GetNumberOfTuples();
+  if (yscalars->GetNumberOfTuples() != nb_of_tuples)
+    {
+    vtkErrorMacro(<< "Can not build histogram from scalars with a "
+                  << "different number of tuples!");
+    return;
+    }
+
+  if (!vtkKWHistogram::IsSupportedDataType(xscalars->GetDataType()) ||
+      !vtkKWHistogram::IsSupportedDataType(yscalars->GetDataType()))
+    {
+    vtkErrorMacro(<< "Can not build histogram from unsupported data type!");
+    return;
+    }
+
+  // Get the histogram ranges required for those scalars, and the number of
+  // bins needed. If 'reset_range' is true, reset the ranges, otherwise
+  // check that the scalars fit (accumulate mode). The number of bins is
+  // reset only if 'reset_range' is true or the histogram is empty.
+
+  double xrange[2], yrange[2];
+  vtkIdType nb_of_x_bins, nb_of_y_bins;
+
+  vtkKWHistogram2DComputeRangeAndNumberOfBins(
+    xscalars, xcomp, this->MaximumNumberOfBins[0], xrange, &nb_of_x_bins);
+  vtkKWHistogram2DComputeRangeAndNumberOfBins(
+    yscalars, ycomp, this->MaximumNumberOfBins[1], yrange, &nb_of_y_bins);
+
+  int allocate_bins = reset_range || this->Bins->GetNumberOfTuples() == 0;
+  if (reset_range)
+    {
+    this->XRange[0] = xrange[0];
+    this->XRange[1] = xrange[1];
+    this->YRange[0] = yrange[0];
+    this->YRange[1] = yrange[1];
+    }
+  else
+    {
+    if (xrange[0] < this->XRange[0] || xrange[1] > this->XRange[1] ||
+        yrange[0] < this->YRange[0] || yrange[1] > this->YRange[1])
+      {
+      vtkErrorMacro(<< "Scalars ranges ["
+                    << xrange[0] << ".." << xrange[1] << "] x ["
+                    << yrange[0] << ".." << yrange[1] << "] "
+                    << "do not fit in the current ranges ["
+                    << this->XRange[0] << ".." << this->XRange[1] << "] x ["
+                    << this->YRange[0] << ".." << this->YRange[1] << "]!");
+      return;
+      }
+    }
+
+  this->InvokeEvent(vtkCommand::StartEvent, NULL);
+
+  // Allocate the bins and reset them to 0
+
+  this->Bins->SetNumberOfComponents(1);
+  if (allocate_bins)
+    {
+    this->NumberOfXBins = nb_of_x_bins;
+    this->NumberOfYBins = nb_of_y_bins;
+    this->Bins->SetNumberOfTuples(nb_of_x_bins * nb_of_y_bins);
+    memset(this->Bins->GetPointer(0), 0,
+           nb_of_x_bins * nb_of_y_bins * sizeof(double));
+    }
+
+  double progress = 0.2;
+  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+
+  vtkKWHistogram2DBinningInfo info;
+  info.Scalars[0] = xscalars;
+  info.Scalars[1] = yscalars;
+  info.Components[0] = xcomp;
+  info.Components[1] = ycomp;
+  info.Ranges[0][0] = this->XRange[0];
+  info.Ranges[0][1] = this->XRange[1];
+  info.Ranges[1][0] = this->YRange[0];
+  info.Ranges[1][1] = this->YRange[1];
+  info.NumberOfBins[0] = this->NumberOfXBins;
+  info.NumberOfBins[1] = this->NumberOfYBins;
+
+  // Do not use more threads than worth it
+
+  vtkIdType nb_of_threads =
+    nb_of_tuples / VTK_KW_HIST2D_MIN_TUPLES_PER_THREAD;
+  if (nb_of_threads > this->NumberOfThreads)
+    {
+    nb_of_threads = this->NumberOfThreads;
+    }
+  if (nb_of_threads < 1)
+    {
+    nb_of_threads = 1;
+    }
+
+  // A single thread bins directly into the histogram, otherwise each thread
+  // gets its own private bins
+
+  vtkIdType nb_of_bins = this->NumberOfXBins * this->NumberOfYBins;
+  double *bins_ptr = this->Bins->GetPointer(0);
+  info.ThreadBins = new double* [nb_of_threads];
+  vtkIdType i, bin;
+  if (nb_of_threads == 1)
+    {
+    info.ThreadBins[0] = bins_ptr;
+    }
+  else
+    {
+    for (i = 0; i < nb_of_threads; i++)
+      {
+      info.ThreadBins[i] = new double [nb_of_bins];
+      memset(info.ThreadBins[i], 0, nb_of_bins * sizeof(double));
+      }
+    this->Threader->SetNumberOfThreads((int)nb_of_threads);
+    this->Threader->SetSingleMethod(
+      vtkKWHistogram2DBinningThreadedExecute, &info);
+    }
+
+  // Loop over the data in chunks and fill in the bins
+
+  vtkIdType inc_tuple = (vtkIdType)ceil(
+    (double)nb_of_tuples / (double)VTK_KW_HIST2D_NB_PROGRESS_CHUNKS);
+
+  info.StartTuple = 0;
+  while (info.StartTuple < nb_of_tuples)
+    {
+    info.NumberOfTuples = inc_tuple;
+    if (info.StartTuple + info.NumberOfTuples >= nb_of_tuples)
+      {
+      info.NumberOfTuples = nb_of_tuples - info.StartTuple;
+      }
+
+    if (nb_of_threads == 1)
+      {
+      vtkMultiThreader::ThreadInfo thread_info;
+      thread_info.ThreadID = 0;
+      thread_info.NumberOfThreads = 1;
+      thread_info.UserData = &info;
+      vtkKWHistogram2DBinningThreadedExecute(&thread_info);
+      }
+    else
+      {
+      this->Threader->SingleMethodExecute();
+      }
+
+    info.StartTuple += info.NumberOfTuples;
+
+    progress = 0.2 + 0.8 *
+      ((double)info.StartTuple / (double)nb_of_tuples);
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    }
+
+  // Merge the private bins
+
+  if (nb_of_threads > 1)
+    {
+    for (i = 0; i < nb_of_threads; i++)
+      {
+      double *thread_bins_ptr = info.ThreadBins[i];
+      for (bin = 0; bin < nb_of_bins; bin++)
+        {
+        bins_ptr[bin] += thread_bins_ptr[bin];
+        }
+      delete [] thread_bins_ptr;
+      }
+    }
+
+  delete [] info.ThreadBins;
+
+  progress = 1.0;
+  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+
+  this->Bins->Modified();
+  this->Modified();
+
+  this->InvokeEvent(vtkCommand::EndEvent, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::BuildHistogram(vtkDataArray *xscalars, int xcomp,
+                                      vtkDataArray *yscalars, int ycomp)
+{
+  this->UpdateHistogram(xscalars, xcomp, yscalars, ycomp, 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::AccumulateHistogram(vtkDataArray *xscalars, int xcomp,
+                                           vtkDataArray *yscalars, int ycomp)
+{
+  this->UpdateHistogram(xscalars, xcomp, yscalars, ycomp, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ComputeStatistics()
+{
+  if (this->LastStatisticsBuildTime >= this->Bins->GetMTime())
+    {
+    return;
+    }
+
+  double min = VTK_DOUBLE_MAX;
+  double max = VTK_DOUBLE_MIN;
+  double total = 0.0;
+
+  double *bins_ptr = this->Bins->GetPointer(0);
+  double *bins_ptr_end = bins_ptr + this->Bins->GetNumberOfTuples();
+
+  while (bins_ptr < bins_ptr_end)
+    {
+    if (*bins_ptr < min)
+      {
+      min = *bins_ptr;
+      }
+    if (*bins_ptr > max)
+      {
+      max = *bins_ptr;
+      }
+    total += *bins_ptr;
+    bins_ptr++;
+    }
+
+  // An empty histogram reports 0 occurence
+
+  if (bins_ptr == bins_ptr_end)
+    {
+    min = max = 0.0;
+    }
+
+  this->MinimumOccurence = min;
+  this->MaximumOccurence = max;
+  this->TotalOccurence   = total;
+
+  this->LastStatisticsBuildTime = this->Bins->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+double vtkKWHistogram2D::GetMinimumOccurence()
+{
+  this->ComputeStatistics();
+  return this->MinimumOccurence;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWHistogram2D::GetMaximumOccurence()
+{
+  this->ComputeStatistics();
+  return this->MaximumOccurence;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWHistogram2D::GetTotalOccurence()
+{
+  this->ComputeStatistics();
+  return this->TotalOccurence;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWHistogram2D::GetOccurenceAtValues(double x, double y)
+{
+  if (x < this->XRange[0] || x >= this->XRange[1] ||
+      y < this->YRange[0] || y >= this->YRange[1] ||
+      !this->Bins->GetNumberOfTuples())
+    {
+    return 0;
+    }
+
+  double x_bin_width =
+    (this->XRange[1] == this->XRange[0] ? 1 :
+     (this->XRange[1] - this->XRange[0]) / (double)this->NumberOfXBins);
+  double y_bin_width =
+    (this->YRange[1] == this->YRange[0] ? 1 :
+     (this->YRange[1] - this->YRange[0]) / (double)this->NumberOfYBins);
+
+  vtkIdType i = (vtkIdType)((x - this->XRange[0]) / x_bin_width);
+  vtkIdType j = (vtkIdType)((y - this->YRange[0]) / y_bin_width);
+  if (i >= this->NumberOfXBins || j >= this->NumberOfYBins)
+    {
+    return 0;
+    }
+
+  return *(this->Bins->GetPointer(0) + j * this->NumberOfXBins + i);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ComputeAccumulatedBins()
+{
+  if (this->LastAccumulatedBinsBuildTime >= this->Bins->GetMTime())
+    {
+    return;
+    }
+
+  vtkIdType nb_of_x_bins = this->NumberOfXBins;
+  vtkIdType nb_of_y_bins = this->NumberOfYBins;
+  vtkIdType row_length = nb_of_x_bins + 1;
+
+  this->AccumulatedBins->SetNumberOfComponents(1);
+  this->AccumulatedBins->SetNumberOfTuples(row_length * (nb_of_y_bins + 1));
+
+  double *bins_ptr = this->Bins->GetPointer(0);
+  double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+
+  // First row (and first column of each row) is all zeros, so that
+  // the sum over any rectangle of bins is a difference of 4 elements
+
+  memset(acc_ptr, 0, row_length * sizeof(double));
+
+  vtkIdType i, j;
+  double row_total;
+  for (j = 0; j < nb_of_y_bins; j++)
+    {
+    double *prev_row_ptr = acc_ptr;
+    acc_ptr += row_length;
+    acc_ptr[0] = 0.0;
+    row_total = 0.0;
+    for (i = 0; i < nb_of_x_bins; i++)
+      {
+      row_total += *bins_ptr++;
+      acc_ptr[i + 1] = prev_row_ptr[i + 1] + row_total;
+      }
+    }
+
+  this->LastAccumulatedBinsBuildTime = this->Bins->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+vtkKWHistogram2D::ImageDescriptor::ImageDescriptor()
+{
+  this->Width                   = 0;
+  this->Height                  = 0;
+  this->DrawBackground          = 1;
+  this->ColorTransferFunction   = NULL;
+  this->DefaultMaximumOccurence = 0.0;
+  this->LastMaximumOccurence    = 0.0;
+
+  this->XRange[0]               = 0.0;
+  this->XRange[1]               = 0.0;
+  this->YRange[0]               = 0.0;
+  this->YRange[1]               = 0.0;
+
+  this->Color[0]                = 0.63;
+  this->Color[1]                = 0.63;
+  this->Color[2]                = 0.63;
+
+  this->BackgroundColor[0]      = 0.83;
+  this->BackgroundColor[1]      = 0.83;
+  this->BackgroundColor[2]      = 0.83;
+
+  this->OutOfRangeColor[0]      = 0.83;
+  this->OutOfRangeColor[1]      = 0.83;
+  this->OutOfRangeColor[2]      = 0.83;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram2D::ImageDescriptor::IsEqualTo(const ImageDescriptor *desc)
+{
+  return (
+    desc &&
+    this->XRange[0]             == desc->XRange[0] &&
+    this->XRange[1]             == desc->XRange[1] &&
+    this->YRange[0]             == desc->YRange[0] &&
+    this->YRange[1]             == desc->YRange[1] &&
+    this->Width                 == desc->Width &&
+    this->Height                == desc->Height &&
+    this->DrawBackground        == desc->DrawBackground &&
+    this->Color[0]              == desc->Color[0] &&
+    this->Color[1]              == desc->Color[1] &&
+    this->Color[2]              == desc->Color[2] &&
+    this->BackgroundColor[0]    == desc->BackgroundColor[0] &&
+    this->BackgroundColor[1]    == desc->BackgroundColor[1] &&
+    this->BackgroundColor[2]    == desc->BackgroundColor[2] &&
+    this->OutOfRangeColor[0]    == desc->OutOfRangeColor[0] &&
+    this->OutOfRangeColor[1]    == desc->OutOfRangeColor[1] &&
+    this->OutOfRangeColor[2]    == desc->OutOfRangeColor[2] &&
+    this->ColorTransferFunction == desc->ColorTransferFunction &&
+    this->DefaultMaximumOccurence == desc->DefaultMaximumOccurence
+    );
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::Copy(const ImageDescriptor *desc)
+{
+  if (!desc)
+    {
+    return;
+    }
+
+  this->XRange[0]               = desc->XRange[0];
+  this->XRange[1]               = desc->XRange[1];
+  this->YRange[0]               = desc->YRange[0];
+  this->YRange[1]               = desc->YRange[1];
+  this->Width                   = desc->Width;
+  this->Height                  = desc->Height;
+  this->DrawBackground          = desc->DrawBackground;
+  this->Color[0]                = desc->Color[0];
+  this->Color[1]                = desc->Color[1];
+  this->Color[2]                = desc->Color[2];
+  this->BackgroundColor[0]      = desc->BackgroundColor[0];
+  this->BackgroundColor[1]      = desc->BackgroundColor[1];
+  this->BackgroundColor[2]      = desc->BackgroundColor[2];
+  this->OutOfRangeColor[0]      = desc->OutOfRangeColor[0];
+  this->OutOfRangeColor[1]      = desc->OutOfRangeColor[1];
+  this->OutOfRangeColor[2]      = desc->OutOfRangeColor[2];
+  this->ColorTransferFunction   = desc->ColorTransferFunction;
+  this->DefaultMaximumOccurence = desc->DefaultMaximumOccurence;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram2D::ImageDescriptor::IsValid() const
+{
+  return (
+    this->XRange[0] != this->XRange[1] &&
+    this->YRange[0] != this->YRange[1] &&
+    this->Width &&
+    this->Height &&
+    (this->Color[0] >= 0.0 && this->Color[0] <= 1.0) &&
+    (this->Color[1] >= 0.0 && this->Color[1] <= 1.0) &&
+    (this->Color[2] >= 0.0 && this->Color[2] <= 1.0) &&
+    (this->BackgroundColor[0] >= 0.0 && this->BackgroundColor[0] <= 1.0) &&
+    (this->BackgroundColor[1] >= 0.0 && this->BackgroundColor[1] <= 1.0) &&
+    (this->BackgroundColor[2] >= 0.0 && this->BackgroundColor[2] <= 1.0) &&
+    (this->OutOfRangeColor[0] >= 0.0 && this->OutOfRangeColor[0] <= 1.0) &&
+    (this->OutOfRangeColor[1] >= 0.0 && this->OutOfRangeColor[1] <= 1.0) &&
+    (this->OutOfRangeColor[2] >= 0.0 && this->OutOfRangeColor[2] <= 1.0)
+    );
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetXRange(double range0,
+                                                  double range1)
+{
+  this->XRange[0] = range0;
+  this->XRange[1] = range1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetYRange(double range0,
+                                                  double range1)
+{
+  this->YRange[0] = range0;
+  this->YRange[1] = range1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetDimensions(unsigned int width,
+                                                      unsigned int height)
+{
+  this->Width = width;
+  this->Height = height;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetColor(double color[3])
+{
+  this->Color[0] = color[0];
+  this->Color[1] = color[1];
+  this->Color[2] = color[2];
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetBackgroundColor(double color[3])
+{
+  this->BackgroundColor[0] = color[0];
+  this->BackgroundColor[1] = color[1];
+  this->BackgroundColor[2] = color[2];
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::ImageDescriptor::SetOutOfRangeColor(double color[3])
+{
+  this->OutOfRangeColor[0] = color[0];
+  this->OutOfRangeColor[1] = color[1];
+  this->OutOfRangeColor[2] = color[2];
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram2D::IsImageUpToDate(const ImageDescriptor *desc)
+{
+  // Create new image if it does not exist (same with descriptor)
+
+  if (!this->Image)
+    {
+    this->Image = vtkImageData::New();
+    }
+
+  if (!this->LastImageDescriptor)
+    {
+    this->LastImageDescriptor = new vtkKWHistogram2D::ImageDescriptor;
+    }
+
+  return (this->LastImageBuildTime >= this->Bins->GetMTime() &&
+          (!desc ||
+           (this->LastImageDescriptor->IsEqualTo(desc) &&
+            (!desc->ColorTransferFunction ||
+             this->LastTransferFunctionTime >=
+             desc->ColorTransferFunction->GetMTime()))));
+}
+
+//----------------------------------------------------------------------------
+// Compute the range of bins [bin, next_bin[ covered by each pixel along one
+// axis of the image, or -1 if the pixel is out of the histogram range.
+
+static void vtkKWHistogram2DComputePixelBins(
+  const double desc_range[2], unsigned int nb_of_pixels,
+  const double range[2], vtkIdType nb_of_bins, vtkIdType *pixel_bins)
+{
+  double bin_width =
+    (range[1] == range[0] ? 1 : (range[1] - range[0]) / (double)nb_of_bins);
+  double scale = (desc_range[1] - desc_range[0]) / (double)nb_of_pixels;
+
+  double value, next_value;
+  vtkIdType bin, next_bin;
+  unsigned int p;
+  for (p = 0; p < nb_of_pixels; p++, pixel_bins += 2)
+    {
+    value = desc_range[0] + scale * (double)p;
+    next_value = value + scale;
+    if (next_value <= range[0] || value >= range[1])
+      {
+      pixel_bins[0] = pixel_bins[1] = -1;
+      continue;
+      }
+    bin = (vtkIdType)floor((value - range[0]) / bin_width);
+    next_bin = (vtkIdType)ceil((next_value - range[0]) / bin_width);
+    if (bin < 0)
+      {
+      bin = 0;
+      }
+    if (next_bin > nb_of_bins)
+      {
+      next_bin = nb_of_bins;
+      }
+    if (next_bin <= bin)
+      {
+      next_bin = bin + 1;
+      }
+    pixel_bins[0] = bin;
+    pixel_bins[1] = next_bin;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogram2D::RefreshImage(ImageDescriptor *desc)
+{
+  // Check histogram
+
+  if (!this->Bins->GetNumberOfTuples())
+    {
+    vtkErrorMacro(<< "Can not compute histogram image from empty histogram!");
+    return 0;
+    }
+
+  // Check descriptor
+
+  if (!desc || !desc->IsValid())
+    {
+    vtkErrorMacro(
+      << "Can not compute histogram image with invalid descriptor!");
+    return 0;
+    }
+
+  // Do we really need to recreate ?
+
+  if (this->IsImageUpToDate(desc))
+    {
+    return 1;
+    }
+
+  // We need width x height RGB or RGBA (unsigned char)
+
+  int nb_of_components = 3 + (desc->DrawBackground ? 0 : 1);
+
+  this->Image->SetDimensions(desc->Width, desc->Height, 1);
+  this->Image->SetWholeExtent(this->Image->GetExtent());
+  this->Image->SetUpdateExtent(this->Image->GetExtent());
+  this->Image->SetScalarTypeToUnsignedChar();
+  this->Image->SetNumberOfScalarComponents(nb_of_components);
+  this->Image->AllocateScalars();
+  unsigned char *image_ptr =
+    static_cast<unsigned char*>(this->Image->GetScalarPointer());
+
+  // Colors (the color of each column is either the same, or picked from
+  // the transfer function)
+
+  unsigned char bgcolor[3], oorcolor[3];
+
+  bgcolor[0] = (unsigned char)(255.0 * desc->BackgroundColor[0]);
+  bgcolor[1] = (unsigned char)(255.0 * desc->BackgroundColor[1]);
+  bgcolor[2] = (unsigned char)(255.0 * desc->BackgroundColor[2]);
+
+  oorcolor[0] = (unsigned char)(255.0 * desc->OutOfRangeColor[0]);
+  oorcolor[1] = (unsigned char)(255.0 * desc->OutOfRangeColor[1]);
+  oorcolor[2] = (unsigned char)(255.0 * desc->OutOfRangeColor[2]);
+
+  double *colors = new double[3 * desc->Width];
+  unsigned int x, y;
+  if (desc->ColorTransferFunction)
+    {
+    desc->ColorTransferFunction->GetTable(
+      desc->XRange[0], desc->XRange[1], desc->Width, colors);
+    }
+  else
+    {
+    for (x = 0; x < desc->Width; x++)
+      {
+      colors[3 * x]     = desc->Color[0];
+      colors[3 * x + 1] = desc->Color[1];
+      colors[3 * x + 2] = desc->Color[2];
+      }
+    }
+
+  // Bins covered by each column and row
+
+  vtkIdType *column_bins = new vtkIdType[2 * desc->Width];
+  vtkKWHistogram2DComputePixelBins(
+    desc->XRange, desc->Width, this->XRange, this->NumberOfXBins,
+    column_bins);
+
+  vtkIdType *row_bins = new vtkIdType[2 * desc->Height];
+  vtkKWHistogram2DComputePixelBins(
+    desc->YRange, desc->Height, this->YRange, this->NumberOfYBins,
+    row_bins);
+
+  // Scale so that the bin with the maximum occurence gets the full color
+
+  double max_occurrence = this->GetMaximumOccurence();
+  if (desc->DefaultMaximumOccurence > 0.0 &&
+      desc->DefaultMaximumOccurence > max_occurrence)
+    {
+    max_occurrence = desc->DefaultMaximumOccurence;
+    }
+  desc->LastMaximumOccurence = max_occurrence;
+
+  double scale = 0.0;
+  if (max_occurrence > 0.0)
+    {
+    scale = this->LogMode
+      ? 1.0 / log(1.0 + max_occurrence) : 1.0 / max_occurrence;
+    }
+
+  // Fill the image. The average occurence over the bins covered by each
+  // pixel is read from the summed area table.
+
+  this->ComputeAccumulatedBins();
+  double *acc_ptr = this->AccumulatedBins->GetPointer(0);
+  vtkIdType acc_row_length = this->NumberOfXBins + 1;
+
+  unsigned char *pixel_ptr = image_ptr;
+  double occurrence, t;
+  for (y = 0; y < desc->Height; y++)
+    {
+    vtkIdType *row_bin = row_bins + 2 * y;
+    double *acc_row_ptr = acc_ptr + row_bin[0] * acc_row_length;
+    double *acc_next_row_ptr = acc_ptr + row_bin[1] * acc_row_length;
+    double row_nb_of_bins = (double)(row_bin[1] - row_bin[0]);
+
+    for (x = 0; x < desc->Width; x++, pixel_ptr += nb_of_components)
+      {
+      vtkIdType *column_bin = column_bins + 2 * x;
+
+      // Out of range
+
+      if (row_bin[0] < 0 || column_bin[0] < 0)
+        {
+        if (desc->DrawBackground)
+          {
+          pixel_ptr[0] = oorcolor[0];
+          pixel_ptr[1] = oorcolor[1];
+          pixel_ptr[2] = oorcolor[2];
+          }
+        else
+          {
+          pixel_ptr[0] = pixel_ptr[1] = pixel_ptr[2] = pixel_ptr[3] = 0;
+          }
+        continue;
+        }
+
+      occurrence =
+        (acc_next_row_ptr[column_bin[1]] - acc_next_row_ptr[column_bin[0]] -
+         acc_row_ptr[column_bin[1]] + acc_row_ptr[column_bin[0]]) /
+        (row_nb_of_bins * (double)(column_bin[1] - column_bin[0]));
+
+      t = (this->LogMode ? log(1.0 + occurrence) : occurrence) * scale;
+      if (t > 1.0)
+        {
+        t = 1.0;
+        }
+
+      double *color = colors + 3 * x;
+      if (desc->DrawBackground)
+        {
+        pixel_ptr[0] = (unsigned char)(
+          bgcolor[0] + (255.0 * color[0] - bgcolor[0]) * t);
+        pixel_ptr[1] = (unsigned char)(
+          bgcolor[1] + (255.0 * color[1] - bgcolor[1]) * t);
+        pixel_ptr[2] = (unsigned char)(
+          bgcolor[2] + (255.0 * color[2] - bgcolor[2]) * t);
+        }
+      else
+        {
+        pixel_ptr[0] = (unsigned char)(255.0 * color[0]);
+        pixel_ptr[1] = (unsigned char)(255.0 * color[1]);
+        pixel_ptr[2] = (unsigned char)(255.0 * color[2]);
+        pixel_ptr[3] = (unsigned char)(255.0 * t);
+        }
+      }
+    }
+
+  delete [] colors;
+  delete [] column_bins;
+  delete [] row_bins;
+
+  this->LastImageDescriptor->Copy(desc);
+  this->LastImageBuildTime = this->Bins->GetMTime();
+  this->LastTransferFunctionTime =
+    (desc->ColorTransferFunction ? desc->ColorTransferFunction->GetMTime() :0);
+
+  this->Image->Modified();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* vtkKWHistogram2D::GetImage(ImageDescriptor *desc)
+{
+  if (this->RefreshImage(desc))
+    {
+    return this->Image;
+    }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::SetLogMode(int arg)
+{
+  if (this->LogMode == arg)
+    {
+    return;
+    }
+
+  this->LogMode = arg;
+
+  // The next time the image is queried, it will be refreshed
+
+  this->LastImageBuildTime = 0;
+
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWHistogram2D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "XRange: "
+     << this->XRange[0] << ", " << this->XRange[1] << endl;
+  os << indent << "YRange: "
+     << this->YRange[0] << ", " << this->YRange[1] << endl;
+  os << indent << "NumberOfXBins: " << this->NumberOfXBins << endl;
+  os << indent << "NumberOfYBins: " << this->NumberOfYBins << endl;
+  os << indent << "MaximumNumberOfBins: "
+     << this->MaximumNumberOfBins[0] << ", "
+     << this->MaximumNumberOfBins[1] << endl;
+  os << indent << "LogMode: " << (this->LogMode ? "On" : "Off") << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "Bins: ";
+  if (this->Bins)
+    {
+    os << endl;
+    this->Bins->PrintSelf(os, indent.GetNextIndent());
+    }
+  else
+    {
+    os << "None" << endl;
+    }
+}
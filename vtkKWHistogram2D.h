@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Module:    $RCSfile: vtkKWHistogram2D.h,v $
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkKWHistogram2D - a joint (2D) histogram
+// .SECTION Description
+// A joint histogram of two scalars sampled at the same points, say
+// intensity vs. gradient magnitude, or one component vs. another.
+// Each axis follows the vtkKWHistogram conventions (Range[1] is exclusive,
+// one bin per value for integer scalars whose range is small enough).
+// The bins are stored in a single array, X varying fastest.
+// .SECTION See Also
+// vtkKWHistogram vtkKWHistogramSet
+
+#ifndef __vtkKWHistogram2D_h
+#define __vtkKWHistogram2D_h
+
+#include "vtkObject.h"
+#include "vtkKWWidgets.h" // Needed for export symbols directives
+#include "vtkMultiThreader.h" // Needed for VTK_MAX_THREADS
+
+class vtkColorTransferFunction;
+class vtkDataArray;
+class vtkDoubleArray;
+class vtkImageData;
+
+class KWWidgets_EXPORT vtkKWHistogram2D : public vtkObject
+{
+public:
+  static vtkKWHistogram2D* New();
+  vtkTypeRevisionMacro(vtkKWHistogram2D,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the histogram range along X and Y.
+  // Note that Range[1] is exclusive.
+  // The ranges are updated automatically by the BuildHistogram method to
+  // match the range of the vtkDataArray's passed as parameters.
+  // Nevertheless, you might want to set the ranges manually before calling
+  // the AccumulateHistogram method on an empty histogram (see
+  // EmptyHistogram), so that later scalars fit in the ranges too.
+  vtkSetVector2Macro(XRange, double);
+  vtkGetVector2Macro(XRange, double);
+  vtkSetVector2Macro(YRange, double);
+  vtkGetVector2Macro(YRange, double);
+
+  // Description:
+  // Direct access to the bins. The bin (i, j) is at index
+  // i + j * NumberOfXBins.
+  vtkGetObjectMacro(Bins, vtkDoubleArray);
+
+  // Description:
+  // Get the number of bins along X and Y
+  vtkGetMacro(NumberOfXBins, vtkIdType);
+  vtkGetMacro(NumberOfYBins, vtkIdType);
+
+  // Description:
+  // Set/Get the maximum number of bins that should be used along X and Y
+  // when creating the histogram (default is 256 x 256).
+  vtkSetVector2Macro(MaximumNumberOfBins, vtkIdType);
+  vtkGetVector2Macro(MaximumNumberOfBins, vtkIdType);
+
+  // Description:
+  // Set/Get the maximum number of threads used to fill the bins. Each
+  // thread bins a subset of the tuples in its own private bins, which are
+  // merged at the end; the result does not depend on the number of threads.
+  // Defaults to the number of processors available.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Get the minimum, maximum and total occurence in the histogram
+  // (all 0 for an empty histogram).
+  virtual double GetMinimumOccurence();
+  virtual double GetMaximumOccurence();
+  virtual double GetTotalOccurence();
+
+  // Description:
+  // Get the occurence in the bin holding the pair (x, y)
+  virtual double GetOccurenceAtValues(double x, double y);
+
+  // Description:
+  // Build/update the histogram from two scalars arrays (given a component
+  // in each). The n-th tuple of 'xscalars' is paired with the n-th tuple
+  // of 'yscalars', both arrays should therefore have the same number of
+  // tuples. They can be the same array, to cross two of its components.
+  // The ranges and number of bins are modified automatically.
+  virtual void BuildHistogram(vtkDataArray *xscalars, int xcomponent,
+                              vtkDataArray *yscalars, int ycomponent);
+
+  // Description:
+  // Accumulate the histogram from two scalars arrays, see BuildHistogram.
+  // The ranges are *not* modified automatically, you have to set them
+  // appropriately before calling this method, using either:
+  //   - SetXRange and SetYRange followed by a call to EmptyHistogram
+  //     (the number of bins is then computed from the first scalars),
+  //   - or a call to BuildHistogram first, with the appropriate scalars.
+  // The scalars have to fit in the ranges.
+  virtual void AccumulateHistogram(vtkDataArray *xscalars, int xcomponent,
+                                   vtkDataArray *yscalars, int ycomponent);
+
+  // Description:
+  // Empty this histogram (0 bins).
+  virtual void EmptyHistogram();
+
+  // Description:
+  // Compute the image of the histogram in log space (default).
+  virtual void SetLogMode(int);
+  vtkBooleanMacro(LogMode, int);
+  vtkGetMacro(LogMode, int);
+
+  // Description:
+  // Get an image of the histogram. The image parameters are described
+  // through an instance of the ImageDescriptor below. The histogram can be
+  // drawn for given data ranges along X and Y. Each pixel blends the Color
+  // (or the color of the ColorTransferFunction at its X value) with the
+  // BackgroundColor, according to the occurence in the bins it covers.
+  // If DrawBackground is false, the background pixels are set to be
+  // transparent and the resulting image is created in RGBA space instead
+  // of RGB. The first row of the image is the bottom one (YRange[0]): pass
+  // vtkKWTkUtilities::UpdatePhotoOptionFlipVertical when feeding it to
+  // vtkKWTkUtilities::UpdatePhoto.
+  //BTX
+  // @cond nested_class
+  class KWWidgets_EXPORT ImageDescriptor
+  {
+  public:
+    ImageDescriptor();
+
+    int  IsValid() const;
+    int  IsEqualTo(const ImageDescriptor *desc);
+    void Copy(const ImageDescriptor *desc);
+
+    int          DrawBackground;
+
+    double       XRange[2];
+    void SetXRange(double range0, double range1);
+    double       YRange[2];
+    void SetYRange(double range0, double range1);
+
+    unsigned int Width;
+    unsigned int Height;
+    void SetDimensions(unsigned int width, unsigned int height);
+
+    double       Color[3];
+    void SetColor(double color[3]);
+
+    double       BackgroundColor[3];
+    void SetBackgroundColor(double color[3]);
+
+    double       OutOfRangeColor[3];
+    void SetOutOfRangeColor(double color[3]);
+
+    vtkColorTransferFunction *ColorTransferFunction;
+
+    // Each pixel is drawn given the average occurence in the bins it
+    // covers, scaled so that the bin with the maximum occurence is drawn
+    // with the full Color. The LastMaximumOccurence ivar is updated with
+    // this maximum occurence each time the image is computed.
+    // If the DefaultMaximumOccurence is set to something other than 0.0
+    // (and is >= to the current maximum occurence), it is used to scale the
+    // histogram instead, so that several histograms can be scaled the same
+    // way.
+
+    double       DefaultMaximumOccurence;
+    double       LastMaximumOccurence;
+  };
+  // @endcond
+  virtual int IsImageUpToDate(const ImageDescriptor *desc = 0);
+  virtual vtkImageData* GetImage(ImageDescriptor *desc);
+  //ETX
+
+protected:
+  vtkKWHistogram2D();
+  ~vtkKWHistogram2D();
+
+  double XRange[2];
+  double YRange[2];
+
+  vtkDoubleArray *Bins;
+  vtkIdType      NumberOfXBins;
+  vtkIdType      NumberOfYBins;
+  vtkIdType      MaximumNumberOfBins[2];
+
+  vtkImageData  *Image;
+  unsigned long LastImageBuildTime;
+  unsigned long LastTransferFunctionTime;
+  int           LogMode;
+
+  vtkMultiThreader *Threader;
+  int               NumberOfThreads;
+
+  virtual void ComputeStatistics();
+  unsigned long LastStatisticsBuildTime;
+
+  double MinimumOccurence;
+  double MaximumOccurence;
+  double TotalOccurence;
+
+  // Description:
+  // Summed area table of the bins (the element (i, j) is the sum of the
+  // bins below i and j, with a row and column of zeros first), rebuilt
+  // lazily when the bins are modified. Used to resample the bins in
+  // RefreshImage in a time that does not depend on the number of bins.
+  virtual void ComputeAccumulatedBins();
+  vtkDoubleArray *AccumulatedBins;
+  unsigned long  LastAccumulatedBinsBuildTime;
+
+  // Description:
+  // Update the histogram from scalars (given a component in each)
+  // Either reset the ranges (BuildHistogram) or not (AccumulateHistogram)
+  virtual void UpdateHistogram(vtkDataArray *xscalars, int xcomponent,
+                               vtkDataArray *yscalars, int ycomponent,
+                               int reset_range);
+
+  //BTX
+  vtkKWHistogram2D::ImageDescriptor *LastImageDescriptor;
+  //ETX
+
+  virtual int RefreshImage(ImageDescriptor *desc);
+
+private:
+  vtkKWHistogram2D(const vtkKWHistogram2D&); // Not implemented
+  void operator=(const vtkKWHistogram2D&); // Not implemented
+};
+
+#endif
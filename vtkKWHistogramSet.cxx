@@ -17,8 +17,10 @@
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
 #include "vtkKWHistogram.h"
+#include "vtkKWHistogram2D.h"
 #include "vtkObjectFactory.h"
 
+#include <vtksys/SystemTools.hxx>
 #include <vtksys/stl/list>
 #include <vtksys/stl/string>
 
@@ -43,6 +45,27 @@ public:
   typedef vtksys_stl::list<HistogramSlot>::iterator HistogramsContainerIterator;
 
   HistogramsContainer Histograms;
+
+  class Histogram2DSlot
+  {
+  public:
+
+    vtksys_stl::string Name;
+    vtkKWHistogram2D *Histogram;
+  };
+
+  typedef vtksys_stl::list<Histogram2DSlot> Histograms2DContainer;
+  typedef vtksys_stl::list<Histogram2DSlot>::iterator 
+    Histograms2DContainerIterator;
+
+  Histograms2DContainer Histograms2D;
+
+  // Last fingerprint computed by GetArrayFingerprint
+
+  vtkDataArray       *FingerprintArray; // not referenced, only compared
+  unsigned long      FingerprintTime;
+  int                FingerprintAllValues;
+  vtksys_stl::string Fingerprint;
 };
 
 //----------------------------------------------------------------------------
@@ -88,6 +111,15 @@ void vtkKWHistogramCallback::Execute(
 vtkKWHistogramSet::vtkKWHistogramSet()
 {
   this->Internals = new vtkKWHistogramSetInternals;
+  this->Internals->FingerprintArray = NULL;
+  this->Internals->FingerprintTime = 0;
+  this->Internals->FingerprintAllValues = 0;
+
+  this->NumberOfThreads = 
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  this->CacheDirectory = NULL;
+  this->FingerprintAllValues = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -102,6 +134,8 @@ vtkKWHistogramSet::~vtkKWHistogramSet()
     delete this->Internals;
     this->Internals = NULL;
     }
+
+  this->SetCacheDirectory(NULL);
 }
 
 //----------------------------------------------------------------------------
@@ -248,6 +282,19 @@ void vtkKWHistogramSet::RemoveAllHistograms()
         }
       }
     this->Internals->Histograms.clear();
+
+    vtkKWHistogramSetInternals::Histograms2DContainerIterator it2d = 
+      this->Internals->Histograms2D.begin();
+    vtkKWHistogramSetInternals::Histograms2DContainerIterator end2d = 
+      this->Internals->Histograms2D.end();
+    for (; it2d != end2d; ++it2d)
+      {
+      if (it2d->Histogram)
+        {
+        it2d->Histogram->UnRegister(this);
+        }
+      }
+    this->Internals->Histograms2D.clear();
     }
 }
 
@@ -284,6 +331,139 @@ int vtkKWHistogramSet::RemoveHistogramWithName(const char *name)
   return this->RemoveHistogram(this->GetHistogramWithName(name));
 }
 
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::GetNumberOfHistograms2D()
+{
+  return this->Internals ? (int)this->Internals->Histograms2D.size() : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkKWHistogram2D* vtkKWHistogramSet::GetHistogram2DWithName(const char *name)
+{
+  if (name && *name && this->Internals)
+    {
+    vtkKWHistogramSetInternals::Histograms2DContainerIterator it = 
+      this->Internals->Histograms2D.begin();
+    vtkKWHistogramSetInternals::Histograms2DContainerIterator end = 
+      this->Internals->Histograms2D.end();
+    for (; it != end; ++it)
+      {
+      if (!strcmp(it->Name.c_str(), name))
+        {
+        return it->Histogram;
+        }
+      }
+    }
+
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::HasHistogram2DWithName(const char *name)
+{
+  return this->GetHistogram2DWithName(name) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::AddHistogram2D(vtkKWHistogram2D *hist, 
+                                      const char *name)
+{
+  if (!hist)
+    {
+    vtkErrorMacro("Can not add a NULL 2D histogram.");
+    return 0;
+    }
+
+  if (!name || !*name)
+    {
+    vtkErrorMacro("Can not add a 2D histogram with a NULL or empty name.");
+    return 0;
+    }
+
+  // Check if we have a 2D histogram with that name already
+
+  if (this->HasHistogram2DWithName(name))
+    {
+    vtkErrorMacro("A 2D histogram with that name (" << name << ") already "
+                  "exists in the histogram set.");
+    return 0;
+    }
+
+  // Add the histogram slot to the manager
+
+  vtkKWHistogramSetInternals::Histogram2DSlot histogram_slot;
+  histogram_slot.Histogram = hist;
+  histogram_slot.Histogram->Register(this);
+  histogram_slot.Name = name;
+  this->Internals->Histograms2D.push_back(histogram_slot);
+  
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkKWHistogram2D* vtkKWHistogramSet::AllocateAndAddHistogram2D(
+  const char *name)
+{
+  vtkKWHistogram2D *hist = vtkKWHistogram2D::New();
+  int res = this->AddHistogram2D(hist, name);
+  hist->Delete();
+  return res ? hist : NULL;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::RemoveHistogram2D(vtkKWHistogram2D *hist)
+{
+  if (!hist)
+    {
+    vtkErrorMacro("Can not remove a NULL 2D histogram.");
+    return 0;
+    }
+
+  vtkKWHistogramSetInternals::Histograms2DContainerIterator it = 
+    this->Internals->Histograms2D.begin();
+  vtkKWHistogramSetInternals::Histograms2DContainerIterator end = 
+    this->Internals->Histograms2D.end();
+  for (; it != end; ++it)
+    {
+    if (it->Histogram == hist)
+      {
+      it->Histogram->UnRegister(this);
+      this->Internals->Histograms2D.erase(it);
+      return 1;
+      }
+    }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::RemoveHistogram2DWithName(const char *name)
+{
+  return this->RemoveHistogram2D(this->GetHistogram2DWithName(name));
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::ComputeHistogram2DName(const char *x_array_name, 
+                                              int x_component,
+                                              const char *y_array_name, 
+                                              int y_component,
+                                              const char *tag,
+                                              char *buffer)
+{
+  if (!buffer)
+    {
+    return 0;
+    }
+
+  sprintf(buffer, 
+          "%s%d_%s%d%s", 
+          (x_array_name ? x_array_name : ""), x_component, 
+          (y_array_name ? y_array_name : ""), y_component, 
+          (tag ? tag : ""));
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkKWHistogramSet::ComputeHistogramName(const char *array_name, 
                                             int component,
@@ -302,6 +482,358 @@ int vtkKWHistogramSet::ComputeHistogramName(const char *array_name,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Histograms file: a tag, the fingerprint of the data, the number of 
+// histograms, then the name, the build parameters (MaximumNumberOfBins) 
+// and contents of each histogram (see vtkKWHistogram::SaveToStream), in 
+// the native byte order.
+
+#define VTK_KW_HISTSET_FILE_MAGIC 0x4b575332 // 'KWS2'
+
+// Number of tuples sampled by ComputeArrayFingerprint
+
+#define VTK_KW_HISTSET_FINGERPRINT_SAMPLES 16384
+
+static void vtkKWHistogramSetWriteString(ostream &os, const char *str)
+{
+  vtkTypeUInt32 length = (vtkTypeUInt32)strlen(str);
+  os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  os.write(str, length);
+}
+
+static int vtkKWHistogramSetReadString(istream &is, vtksys_stl::string &str)
+{
+  vtkTypeUInt32 length = 0;
+  is.read(reinterpret_cast<char*>(&length), sizeof(length));
+  if (!is.good() || length > 65536)
+    {
+    return 0;
+    }
+  str.resize(length);
+  if (length)
+    {
+    is.read(&str[0], length);
+    }
+  return is.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+// The histograms are written to a temporary file first, which is then
+// renamed, so that a crash while writing can not leave a partial file
+// behind that would be loaded later on.
+
+static int vtkKWHistogramSetWriteHistogramsToStream(
+  ostream &os, 
+  const char *fingerprint,
+  vtkKWHistogramSetInternals::HistogramsContainer &histograms)
+{
+  vtkTypeUInt32 magic = VTK_KW_HISTSET_FILE_MAGIC;
+  vtkTypeUInt32 nb_of_histograms = (vtkTypeUInt32)histograms.size();
+  os.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+  vtkKWHistogramSetWriteString(os, fingerprint ? fingerprint : "");
+  os.write(reinterpret_cast<const char*>(&nb_of_histograms), 
+           sizeof(nb_of_histograms));
+
+  vtkKWHistogramSetInternals::HistogramsContainerIterator it = 
+    histograms.begin();
+  vtkKWHistogramSetInternals::HistogramsContainerIterator end = 
+    histograms.end();
+  for (; it != end; ++it)
+    {
+    vtkKWHistogramSetWriteString(os, it->Name.c_str());
+    vtkTypeInt64 max_nb_of_bins = it->Histogram->GetMaximumNumberOfBins();
+    os.write(reinterpret_cast<const char*>(&max_nb_of_bins), 
+             sizeof(max_nb_of_bins));
+    if (!it->Histogram->SaveToStream(os))
+      {
+      return 0;
+      }
+    }
+
+  return os.good() ? 1 : 0;
+}
+
+static int vtkKWHistogramSetWriteHistograms(
+  const char *filename, 
+  const char *fingerprint,
+  vtkKWHistogramSetInternals::HistogramsContainer &histograms)
+{
+  vtksys_stl::string tmp_filename(filename);
+  tmp_filename += ".tmp";
+
+  ofstream os(tmp_filename.c_str(), ios::out | ios::trunc | ios::binary);
+  if (!os)
+    {
+    return 0;
+    }
+  int res = vtkKWHistogramSetWriteHistogramsToStream(
+    os, fingerprint, histograms);
+  os.close();
+  res = res && os.good();
+
+  // rename() does not replace an existing file on Win32
+
+  if (res)
+    {
+    vtksys::SystemTools::RemoveFile(filename);
+    res = (rename(tmp_filename.c_str(), filename) == 0);
+    }
+  if (!res)
+    {
+    vtksys::SystemTools::RemoveFile(tmp_filename.c_str());
+    }
+
+  return res;
+}
+
+//----------------------------------------------------------------------------
+// Read the histograms saved in a file with a given fingerprint (if any).
+// Each histogram is loaded in the histogram of the same name in
+// 'histograms' if 'load_existing' is true, or skipped; if 
+// 'match_parameters' is true, it is also skipped unless that histogram
+// has the MaximumNumberOfBins it was built with. Histograms that are not
+// found by name are added to 'histograms' (as new instances the caller is
+// responsible for) if 'add_missing' is true, or skipped.
+// Return the number of histograms loaded, -1 on error or if the file does
+// not match the fingerprint.
+
+static int vtkKWHistogramSetReadHistograms(
+  const char *filename, 
+  const char *fingerprint,
+  vtkKWHistogramSetInternals::HistogramsContainer &histograms,
+  int load_existing,
+  int add_missing,
+  int match_parameters)
+{
+  ifstream is(filename, ios::in | ios::binary);
+  if (!is)
+    {
+    return -1;
+    }
+
+  vtkTypeUInt32 magic = 0;
+  vtkTypeUInt32 nb_of_histograms = 0;
+  vtksys_stl::string file_fingerprint;
+  is.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  if (!is.good() || magic != VTK_KW_HISTSET_FILE_MAGIC ||
+      !vtkKWHistogramSetReadString(is, file_fingerprint) ||
+      (fingerprint && file_fingerprint != fingerprint))
+    {
+    return -1;
+    }
+  is.read(reinterpret_cast<char*>(&nb_of_histograms), 
+          sizeof(nb_of_histograms));
+  if (!is.good())
+    {
+    return -1;
+    }
+
+  int nb_loaded = 0;
+  vtkKWHistogram *skipped = vtkKWHistogram::New();
+  vtkKWHistogramSetInternals::HistogramSlot slot;
+  vtkTypeUInt32 i;
+  for (i = 0; i < nb_of_histograms; i++)
+    {
+    vtkTypeInt64 max_nb_of_bins = 0;
+    if (!vtkKWHistogramSetReadString(is, slot.Name) ||
+        !is.read(reinterpret_cast<char*>(&max_nb_of_bins), 
+                 sizeof(max_nb_of_bins)) ||
+        max_nb_of_bins < 1)
+      {
+      nb_loaded = -1;
+      break;
+      }
+    vtkKWHistogram *hist = NULL;
+    vtkKWHistogramSetInternals::HistogramsContainerIterator it = 
+      histograms.begin();
+    vtkKWHistogramSetInternals::HistogramsContainerIterator end = 
+      histograms.end();
+    for (; it != end && !hist; ++it)
+      {
+      if (it->Name == slot.Name)
+        {
+        hist = (load_existing && 
+                (!match_parameters || 
+                 it->Histogram->GetMaximumNumberOfBins() == 
+                 (vtkIdType)max_nb_of_bins)) ? it->Histogram : skipped;
+        }
+      }
+    if (!hist && add_missing)
+      {
+      slot.Histogram = hist = vtkKWHistogram::New();
+      histograms.push_back(slot);
+      }
+    if (!hist)
+      {
+      hist = skipped;
+      }
+    // The bins are checked against the MaximumNumberOfBins they were
+    // built with (restored if the histogram can not be loaded)
+
+    vtkIdType prev_max_nb_of_bins = hist->GetMaximumNumberOfBins();
+    hist->SetMaximumNumberOfBins((vtkIdType)max_nb_of_bins);
+    if (!hist->LoadFromStream(is))
+      {
+      hist->SetMaximumNumberOfBins(prev_max_nb_of_bins);
+      nb_loaded = -1;
+      break;
+      }
+    if (hist != skipped)
+      {
+      nb_loaded++;
+      }
+    }
+
+  skipped->Delete();
+
+  return nb_loaded;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::SaveHistograms(const char *filename, 
+                                      const char *fingerprint)
+{
+  if (!filename || !*filename)
+    {
+    vtkErrorMacro("Can not save histograms to a NULL or empty filename.");
+    return 0;
+    }
+
+  if (!vtkKWHistogramSetWriteHistograms(
+        filename, fingerprint, this->Internals->Histograms))
+    {
+    vtkErrorMacro("Can not save histograms to " << filename);
+    return 0;
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::LoadHistograms(const char *filename, 
+                                      const char *fingerprint)
+{
+  if (!filename || !*filename)
+    {
+    vtkErrorMacro("Can not load histograms from a NULL or empty filename.");
+    return 0;
+    }
+
+  // Load in the existing histograms, add the new ones to the set
+
+  vtkKWHistogramSetInternals::HistogramsContainer histograms = 
+    this->Internals->Histograms;
+  size_t nb_existing = histograms.size();
+
+  int res = vtkKWHistogramSetReadHistograms(
+    filename, fingerprint, histograms, 1, 1, 0);
+
+  vtkKWHistogramSetInternals::HistogramsContainerIterator it = 
+    histograms.begin();
+  vtkKWHistogramSetInternals::HistogramsContainerIterator end = 
+    histograms.end();
+  for (size_t i = 0; it != end; ++it, ++i)
+    {
+    if (i >= nb_existing)
+      {
+      if (res >= 0)
+        {
+        this->AddHistogram(it->Histogram, it->Name.c_str());
+        }
+      it->Histogram->Delete();
+      }
+    }
+
+  return res >= 0 ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWHistogramSet::ComputeArrayFingerprint(vtkDataArray *array, 
+                                               char *buffer,
+                                               int all_values)
+{
+  if (!array || !buffer)
+    {
+    return 0;
+    }
+
+  vtkIdType nb_of_tuples = array->GetNumberOfTuples();
+  int nb_of_components = array->GetNumberOfComponents();
+  int tuple_size = nb_of_components * array->GetDataTypeSize();
+
+  // FNV-1a hash of the bytes of evenly spaced tuples (the last one 
+  // included), or of all of them
+
+  vtkTypeUInt32 checksum = 2166136261U;
+  if (nb_of_tuples > 0 && tuple_size > 0)
+    {
+    const unsigned char *data = 
+      static_cast<const unsigned char*>(array->GetVoidPointer(0));
+    vtkIdType step = 
+      all_values ? 1 : nb_of_tuples / VTK_KW_HISTSET_FINGERPRINT_SAMPLES;
+    if (step < 1)
+      {
+      step = 1;
+      }
+    vtkIdType tuple = 0;
+    while (1)
+      {
+      const unsigned char *ptr = data + tuple * tuple_size;
+      const unsigned char *ptr_end = ptr + tuple_size;
+      while (ptr < ptr_end)
+        {
+        checksum = (checksum ^ *ptr++) * 16777619U;
+        }
+      if (tuple == nb_of_tuples - 1)
+        {
+        break;
+        }
+      tuple += step;
+      if (tuple > nb_of_tuples - 1)
+        {
+        tuple = nb_of_tuples - 1;
+        }
+      }
+    }
+
+  // Both kinds of fingerprints differ, so that a cache file saved with one
+  // is not loaded with the other
+
+  sprintf(buffer, "%d_%d_%lu_%s%08lx", 
+          array->GetDataType(), nb_of_components, 
+          (unsigned long)nb_of_tuples, (all_values ? "a" : ""),
+          (unsigned long)checksum);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWHistogramSet::GetArrayFingerprint(vtkDataArray *array)
+{
+  if (!array)
+    {
+    return NULL;
+    }
+
+  if (this->Internals->FingerprintArray != array ||
+      this->Internals->FingerprintTime < array->GetMTime() ||
+      this->Internals->FingerprintAllValues != this->FingerprintAllValues)
+    {
+    char buffer[64];
+    if (!this->ComputeArrayFingerprint(
+          array, buffer, this->FingerprintAllValues))
+      {
+      return NULL;
+      }
+    this->Internals->Fingerprint = buffer;
+    this->Internals->FingerprintArray = array;
+    this->Internals->FingerprintTime = array->GetMTime();
+    this->Internals->FingerprintAllValues = this->FingerprintAllValues;
+    }
+
+  return this->Internals->Fingerprint.c_str();
+}
+
 //----------------------------------------------------------------------------
 int vtkKWHistogramSet::AddHistograms(vtkDataArray *array, 
                                      const char *tag, 
@@ -313,30 +845,27 @@ int vtkKWHistogramSet::AddHistograms(vtkDataArray *array,
     return 0;
     }
 
-  // Add an histogram for each component
+  // Retrieve or allocate an histogram for each component
 
   int nb_components = array->GetNumberOfComponents();
 
   char *hist_name = new char [1024 + (tag ? strlen(tag) : 0)];
 
-  int nb_histograms = 0;
+  vtkKWHistogram **histograms = new vtkKWHistogram* [nb_components];
+  vtkKWHistogram *first_hist = NULL, *last_hist = NULL;
+
+  vtkKWHistogramSetInternals::HistogramsContainer requested;
+  vtkKWHistogramSetInternals::HistogramSlot requested_slot;
+
   int component;
   for (component = 0; component < nb_components; component++)
     {
-    if (!(skip_components_mask & (1 << component)))
-      {
-      nb_histograms++;
-      }
-    }
+    histograms[component] = NULL;
 
-  int nb_components_processed = 0;
-  for (component = 0; component < nb_components; component++)
-    {
     if (skip_components_mask & (1 << component))
       {
       continue;
       }
-    nb_components_processed++;
 
     if (!this->ComputeHistogramName(
           array->GetName(), component, tag, hist_name))
@@ -357,35 +886,91 @@ int vtkKWHistogramSet::AddHistograms(vtkDataArray *array,
       vtkErrorMacro("Can not retrieve histogram for component " << component);
       continue;
       }
-    
-    // Monitor histogram progress
 
-    vtkKWHistogramCallback *callback = vtkKWHistogramCallback::New();
-    callback->Self = this;
-    callback->StartProgressValue = 
-      (double)(nb_components_processed - 1) / (double)nb_histograms;
-    callback->SpanProgressValue = 1.0 / (double)nb_histograms;
-    
-    if (nb_components_processed == 1)
+    histograms[component] = hist;
+    if (!first_hist)
       {
-      hist->AddObserver(vtkCommand::StartEvent, callback);
+      first_hist = hist;
       }
-    if (nb_components_processed == nb_histograms)
-      {
-      hist->AddObserver(vtkCommand::EndEvent, callback);
-      }
-    hist->AddObserver(vtkCommand::ProgressEvent, callback);
+    last_hist = hist;
+
+    requested_slot.Name = hist_name;
+    requested_slot.Histogram = hist;
+    requested.push_back(requested_slot);
+    }
+
+  // Load the histograms from the cache if they were built from the same
+  // values already
 
-    // Build the histogram *right now* (it's not a pipeline)
+  vtksys_stl::string cache_filename;
+  const char *fingerprint = NULL;
+  int loaded = 0;
 
-    hist->BuildHistogram(array, component);
+  if (first_hist && this->CacheDirectory && *this->CacheDirectory)
+    {
+    fingerprint = this->GetArrayFingerprint(array);
+    cache_filename = this->CacheDirectory;
+    cache_filename += "/";
+    cache_filename += fingerprint;
+    cache_filename += ".kwh";
+    loaded = (vtkKWHistogramSetReadHistograms(
+                cache_filename.c_str(), fingerprint, requested, 1, 0, 1) == 
+              (int)requested.size());
+    }
+
+  if (first_hist && !loaded)
+    {
+    // Monitor histograms progress (the batch sends its progress events
+    // through the first histogram)
+
+    vtkKWHistogramCallback *callback = vtkKWHistogramCallback::New();
+    callback->Self = this;
     
-    // Stop monitoring histogram progress
+    first_hist->AddObserver(vtkCommand::StartEvent, callback);
+    first_hist->AddObserver(vtkCommand::ProgressEvent, callback);
+    last_hist->AddObserver(vtkCommand::EndEvent, callback);
+
+    // Build the histograms *right now* (it's not a pipeline), all the
+    // components at once
+
+    vtkKWHistogram::BuildHistograms(array, histograms, this->NumberOfThreads);
 
-    hist->RemoveObserver(callback);
+    // Stop monitoring histograms progress
+
+    first_hist->RemoveObserver(callback);
+    last_hist->RemoveObserver(callback);
     callback->Delete();
+
+    // Save them in the cache, along with the histograms cached for other
+    // components or tags
+
+    if (fingerprint)
+      {
+      vtkKWHistogramSetInternals::HistogramsContainer cached = requested;
+      vtkKWHistogramSetReadHistograms(
+        cache_filename.c_str(), fingerprint, cached, 0, 1, 0);
+      if (!vtksys::SystemTools::MakeDirectory(this->CacheDirectory) ||
+          !vtkKWHistogramSetWriteHistograms(
+            cache_filename.c_str(), fingerprint, cached))
+        {
+        vtkErrorMacro("Can not save histograms to cache file " 
+                      << cache_filename.c_str());
+        }
+      vtkKWHistogramSetInternals::HistogramsContainerIterator it = 
+        cached.begin();
+      vtkKWHistogramSetInternals::HistogramsContainerIterator end = 
+        cached.end();
+      for (size_t i = 0; it != end; ++it, ++i)
+        {
+        if (i >= requested.size())
+          {
+          it->Histogram->Delete();
+          }
+        }
+      }
     }
 
+  delete [] histograms;
   delete [] hist_name;
 
   return 1;
@@ -395,4 +980,9 @@ int vtkKWHistogramSet::AddHistograms(vtkDataArray *array,
 void vtkKWHistogramSet::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "CacheDirectory: " 
+     << (this->CacheDirectory ? this->CacheDirectory : "(none)") << endl;
+  os << indent << "FingerprintAllValues: " 
+     << (this->FingerprintAllValues ? "On" : "Off") << endl;
 }
@@ -20,9 +20,11 @@
 
 #include "vtkObject.h"
 #include "vtkKWWidgets.h" // Needed for export symbols directives
+#include "vtkMultiThreader.h" // Needed for VTK_MAX_THREADS
 
 class vtkDataArray;
 class vtkKWHistogram;
+class vtkKWHistogram2D;
 class vtkKWHistogramCallback;
 class vtkKWHistogramSetInternals;
 
@@ -59,7 +61,8 @@ public:
   virtual int HasHistogram(vtkKWHistogram *hist);
 
   // Description:
-  // Remove one or all histograms. 
+  // Remove one or all histograms (RemoveAllHistograms removes the 2D 
+  // histograms as well). 
   // Return 1 on success, 0 otherwise.
   virtual int RemoveHistogramWithName(const char *name);
   virtual int RemoveHistogram(vtkKWHistogram *hist);
@@ -84,15 +87,110 @@ public:
   // The 'skip_components_mask' is a binary mask specifying which component
   // should be skipped (i.e., if the n-th bit in that mask is set, then the
   // histogram for that n-th component will not be considered)
+  // All the histograms are built at once, in a single interleaved pass over
+  // the array (see vtkKWHistogram::BuildHistograms), unless they can be
+  // loaded from the CacheDirectory (see below).
   // Return 1 on success, 0 otherwise.
   virtual int AddHistograms(vtkDataArray *array, 
                             const char *tag = NULL, 
                             int skip_components_mask = 0);
 
+  // Description:
+  // Add a joint (2D) histogram to the pool under a given name, or allocate
+  // one, so that it can be shared the same way. The 2D histograms are kept
+  // apart from the histograms above, with their own names.
+  // Return 1 (or a pointer to the new histogram) on success, 0 otherwise.
+  virtual int AddHistogram2D(vtkKWHistogram2D*, const char *name);
+  virtual vtkKWHistogram2D* AllocateAndAddHistogram2D(const char *name);
+
+  // Description:
+  // Get the number of 2D histograms in the pool, retrieve one by name, 
+  // query if the pool has one, or remove one.
+  virtual int GetNumberOfHistograms2D();
+  virtual vtkKWHistogram2D* GetHistogram2DWithName(const char *name);
+  virtual int HasHistogram2DWithName(const char *name);
+  virtual int RemoveHistogram2D(vtkKWHistogram2D *hist);
+  virtual int RemoveHistogram2DWithName(const char *name);
+
+  // Description:
+  // Compute a 2D histogram name given the names of the X and Y arrays
+  // this histogram will be built upon, the components that will be used in
+  // those arrays, and an optional tag (see ComputeHistogramName).
+  // The histogram name is stored in 'buffer', which should be large enough.
+  // Return 1 on success, 0 otherwise.
+  static int ComputeHistogram2DName(
+    const char *x_array_name, int x_comp, 
+    const char *y_array_name, int y_comp, 
+    const char *tag, char *buffer);
+
+  // Description:
+  // Compute a fingerprint of an array, from its size, type and a checksum
+  // of a regular sample of its values (not all of them, so that it is
+  // cheap to compute even for large arrays), or of all its values if
+  // 'all_values' is true. Two arrays holding the same values have the same
+  // fingerprint; an array modified in between two samples keeps its
+  // sampled fingerprint though.
+  // The fingerprint is stored in 'buffer', which should be at least 64
+  // characters long.
+  // Return 1 on success, 0 otherwise.
+  static int ComputeArrayFingerprint(
+    vtkDataArray *array, char *buffer, int all_values = 0);
+
+  // Description:
+  // Set/Get if the fingerprints of the arrays are computed from all their
+  // values instead of a sample of them (see ComputeArrayFingerprint).
+  // Turn it on if the arrays can be edited locally, say, a label map
+  // painted by the user, so that a stale histogram is never loaded from the
+  // CacheDirectory; it costs a pass over the array though.
+  // Default to Off.
+  vtkSetMacro(FingerprintAllValues, int);
+  vtkGetMacro(FingerprintAllValues, int);
+  vtkBooleanMacro(FingerprintAllValues, int);
+
+  // Description:
+  // Get the fingerprint of an array (see ComputeArrayFingerprint and
+  // FingerprintAllValues). The last fingerprint computed is reused as long
+  // as the array is not modified (see vtkObject::GetMTime).
+  virtual const char* GetArrayFingerprint(vtkDataArray *array);
+
+  // Description:
+  // Save all the histograms of the set (name, Range, bins and statistics,
+  // but not the 2D histograms) to a binary file, along with an optional
+  // fingerprint of the data they were built from. Load histograms from
+  // such a file, provided that it was saved with the same fingerprint (if
+  // any): each histogram is loaded in the histogram of the same name in
+  // the set, or a new one is added.
+  // Return 1 on success, 0 otherwise.
+  virtual int SaveHistograms(const char *filename, 
+                             const char *fingerprint = NULL);
+  virtual int LoadHistograms(const char *filename, 
+                             const char *fingerprint = NULL);
+
+  // Description:
+  // Set/Get a directory where AddHistograms caches the histograms it
+  // builds, in a file named after the fingerprint of the array. The next
+  // time AddHistograms is called for an array holding the same values
+  // (say, the same study opened again), the histograms are loaded from
+  // that file instead of being built from the array, provided that they
+  // were built with the same MaximumNumberOfBins.
+  // Default to NULL (no cache).
+  vtkSetStringMacro(CacheDirectory);
+  vtkGetStringMacro(CacheDirectory);
+
+  // Description:
+  // Set/Get the maximum number of threads used by AddHistograms to fill
+  // the bins. Defaults to the number of processors available.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
 protected:
   vtkKWHistogramSet();
   ~vtkKWHistogramSet();
 
+  int NumberOfThreads;
+  char *CacheDirectory;
+  int FingerprintAllValues;
+
   //BTX
   // PIMPL Encapsulation for STL containers
   vtkKWHistogramSetInternals *Internals;
@@ -150,8 +150,8 @@ void vtkKWKeyBindingsWidget::CreateWidget()
   this->Toolbar->SetToolbarAspectToFlat();
   this->Toolbar->SetWidgetsAspectToFlat();
 
-  this->Script("pack %s -side top -anchor nw -padx 0 -pady 0",
-               this->Toolbar->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -padx 0 -pady 0",
+                    this->Toolbar->GetWidgetName());
   
   // Save Button
 
@@ -208,7 +208,7 @@ void vtkKWKeyBindingsWidget::CreateWidget()
     tablelist->SetColumnEditable(i, 0);
     }
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -fill both -expand true -padx 0 -pady 2",
     this->KeyBindingsList->GetWidgetName());
   
@@ -223,8 +223,8 @@ void vtkKWKeyBindingsWidget::CreateWidget()
   this->DetailFrame->SetLabelText("Selected key binding Description");
 
 #if 0
-  this->Script("pack %s -side top -anchor nw  -fill x  -padx 0 -pady 0",
-               this->DetailFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw  -fill x  -padx 0 -pady 0",
+                    this->DetailFrame->GetWidgetName());
 #endif
   
   // Description Text Box
@@ -239,8 +239,8 @@ void vtkKWKeyBindingsWidget::CreateWidget()
   this->DetailText->GetWidget()->SetReadOnly(1);
 
   // Not used yet
-  this->Script("pack %s -side top -fill both -expand true",
-               this->DetailText->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand true",
+                    this->DetailText->GetWidgetName());
   
   this->Update();
 }
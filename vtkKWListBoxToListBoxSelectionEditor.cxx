@@ -98,7 +98,7 @@ void vtkKWListBoxToListBoxSelectionEditor::CreateWidget()
   this->SourceList->SetLabelVisibility(0);
   this->SourceList->SetLabelPositionToTop();
   this->SourceList->Create();
-  this->Script("pack %s -side left -expand true -fill both",
+  this->QueueScript("pack %s -side left -expand true -fill both",
     this->SourceList->GetWidgetName());
 
   vtkKWListBox *listbox = this->SourceList->GetWidget()->GetWidget();
@@ -147,17 +147,17 @@ void vtkKWListBoxToListBoxSelectionEditor::CreateWidget()
   this->RemoveAllButton->SetWidth(width);
   this->RemoveAllButton->SetCommand(this, "RemoveAllCallback");
 
-  this->Script("pack %s %s %s %s -side top -fill x -padx 4 -pady 0",
-               this->AddButton->GetWidgetName(),
-               this->AddAllButton->GetWidgetName(),
-               this->RemoveButton->GetWidgetName(),
-               this->RemoveAllButton->GetWidgetName());
+  this->QueueScript("pack %s %s %s %s -side top -fill x -padx 4 -pady 0",
+                    this->AddButton->GetWidgetName(),
+                    this->AddAllButton->GetWidgetName(),
+                    this->RemoveButton->GetWidgetName(),
+                    this->RemoveAllButton->GetWidgetName());
 
-  this->Script("pack %s %s -pady 2",
-               this->AddAllButton->GetWidgetName(),
-               this->RemoveAllButton->GetWidgetName());
+  this->QueueScript("pack %s %s -pady 2",
+                    this->AddAllButton->GetWidgetName(),
+                    this->RemoveAllButton->GetWidgetName());
 
-  this->Script("pack %s -side left -expand false -fill y -pady 40",
+  this->QueueScript("pack %s -side left -expand false -fill y -pady 40",
     frame->GetWidgetName());
   frame->Delete();
 
@@ -169,7 +169,7 @@ void vtkKWListBoxToListBoxSelectionEditor::CreateWidget()
   this->FinalList->SetLabelVisibility(0);
   this->FinalList->SetLabelPositionToTop();
   this->FinalList->Create();
-  this->Script("pack %s -side top -expand true -fill both",
+  this->QueueScript("pack %s -side top -expand true -fill both",
     this->FinalList->GetWidgetName());
 
   listbox = this->FinalList->GetWidget()->GetWidget();
@@ -195,24 +195,24 @@ void vtkKWListBoxToListBoxSelectionEditor::CreateWidget()
   this->DownButton->SetHeight(16);
   this->DownButton->SetCommand(this, "DownCallback");
 
-  this->Script("grid %s -column 0 -row 0 -stick ew  -padx 1 -pady 2",
+  this->QueueScript("grid %s -column 0 -row 0 -stick ew  -padx 1 -pady 2",
     this->UpButton->GetWidgetName());
 
-  this->Script("grid %s -column 1 -row 0 -stick ew  -padx 1 -pady 2",
+  this->QueueScript("grid %s -column 1 -row 0 -stick ew  -padx 1 -pady 2",
     this->DownButton->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 0 -weight 1 -uniform col",
-               this->ButtonFrame->GetWidgetName());
-  this->Script("grid columnconfigure %s 1 -weight 1 -uniform col",
-               this->ButtonFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 0 -weight 1 -uniform col",
+                    this->ButtonFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 1 -weight 1 -uniform col",
+                    this->ButtonFrame->GetWidgetName());
 
-  this->Script("pack %s %s -side left -fill x -expand y -padx 1 -pady 2",
+  this->QueueScript("pack %s %s -side left -fill x -expand y -padx 1 -pady 2",
     this->UpButton->GetWidgetName(),
     this->DownButton->GetWidgetName());
 
   this->Pack();
 
-  this->Script("pack %s -side left -expand true -fill both",
+  this->QueueScript("pack %s -side left -expand true -fill both",
     frame->GetWidgetName());
   frame->Delete();
   this->DisplayEllipsis();
@@ -224,7 +224,7 @@ void vtkKWListBoxToListBoxSelectionEditor::Pack()
 {
   if(this->AllowReordering)
     {
-    this->Script("pack %s -side top -expand false -fill x",
+    this->QueueScript("pack %s -side top -expand false -fill x",
       this->ButtonFrame->GetWidgetName());
     }
   else if(this->ButtonFrame->IsPacked())
@@ -78,8 +78,8 @@ void vtkKWLogDialog::CreateWidget()
     }
   this->LogWidget->SetParent(this->GetBottomFrame());
   this->LogWidget->Create();
-  this->Script("pack %s -anchor nw -fill both -expand true -padx 2 -pady 2",
-               this->LogWidget->GetWidgetName());
+  this->QueueScript("pack %s -anchor nw -fill both -expand true -padx 2 -pady 2",
+                    this->LogWidget->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
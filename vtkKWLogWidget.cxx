@@ -291,8 +291,8 @@ void vtkKWLogWidget::CreateRecordList()
   this->RemoveAllButton->SetCommand(this, "RemoveAllRecordsCallback");
   this->Toolbar->AddWidget(this->RemoveAllButton);
 
-  this->Script("pack %s -side top -anchor nw -padx 0 -pady 0",
-               this->Toolbar->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -padx 0 -pady 0",
+                    this->Toolbar->GetWidgetName());
   
   // Email Button
 
@@ -308,8 +308,8 @@ void vtkKWLogWidget::CreateRecordList()
   this->EmailButton->SetCommand(this, "EmailRecordsCallback");
   this->Toolbar->AddWidget(this->EmailButton);
 
-  this->Script("pack %s -side top -anchor nw -padx 0 -pady 0",
-               this->Toolbar->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -padx 0 -pady 0",
+                    this->Toolbar->GetWidgetName());
   
   // Setup multicolumn list
 
@@ -354,7 +354,7 @@ void vtkKWLogWidget::CreateRecordList()
     tablelist->SetColumnEditable(i, 0);
     }
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -fill both -expand true -padx 0 -pady 2",
     this->RecordList->GetWidgetName());
   
@@ -368,8 +368,8 @@ void vtkKWLogWidget::CreateRecordList()
   this->DescriptionFrame->Create();
   this->DescriptionFrame->SetLabelText("Selected Record Description");
 
-  this->Script("pack %s -side top -anchor nw  -fill x  -padx 0 -pady 0",
-               this->DescriptionFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw  -fill x  -padx 0 -pady 0",
+                    this->DescriptionFrame->GetWidgetName());
   
   // Description Text Box
 
@@ -382,8 +382,8 @@ void vtkKWLogWidget::CreateRecordList()
   this->DescriptionText->GetWidget()->SetHeight(8);
   this->DescriptionText->GetWidget()->SetReadOnly(1);
 
-  this->Script("pack %s -side top -fill both -expand true",
-               this->DescriptionText->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand true",
+                    this->DescriptionText->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
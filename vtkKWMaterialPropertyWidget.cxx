@@ -299,8 +299,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
     this->PopupButton->SetBalloonHelpString(
       ks_("Edit Material Properties."));
 
-    this->Script("pack %s -side left -anchor w -fill x",
-                 this->PopupButton->GetWidgetName());
+    this->QueueScript("pack %s -side left -anchor w -fill x",
+                      this->PopupButton->GetWidgetName());
     }
 
   // --------------------------------------------------------------
@@ -321,8 +321,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->MaterialPropertiesFrame->SetLabelText(
     ks_("Material Property Editor|Material Properties"));
 
-  this->Script("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
-               this->MaterialPropertiesFrame->GetWidgetName());
+  this->QueueScript("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
+                    this->MaterialPropertiesFrame->GetWidgetName());
   
   frame = this->MaterialPropertiesFrame->GetFrame();
 
@@ -357,11 +357,11 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->AmbientScale->SetBalloonHelpString(
     k_("Set the ambient coefficient within the range [0,100] for lighting"));
   
-  this->Script("grid %s -padx 2 -pady 2 -sticky news -row %d",
-               this->AmbientScale->GetWidgetName(), row++);
+  this->QueueScript("grid %s -padx 2 -pady 2 -sticky news -row %d",
+                    this->AmbientScale->GetWidgetName(), row++);
   
-  this->Script("grid columnconfigure %s 0 -weight 1",
-               this->AmbientScale->GetParent()->GetWidgetName(), row++);
+  this->QueueScript("grid columnconfigure %s 0 -weight 1",
+                    this->AmbientScale->GetParent()->GetWidgetName(), row++);
   
   // --------------------------------------------------------------
   // Diffuse
@@ -378,8 +378,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->DiffuseScale->SetBalloonHelpString(
     k_("Set the diffuse coefficient within the range [0,100] for lighting"));
   
-  this->Script("grid %s -padx 2 -pady 2 -sticky news -row %d",
-               this->DiffuseScale->GetWidgetName(), row++);
+  this->QueueScript("grid %s -padx 2 -pady 2 -sticky news -row %d",
+                    this->DiffuseScale->GetWidgetName(), row++);
   
   // --------------------------------------------------------------
   // Specular
@@ -397,8 +397,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->SpecularScale->SetBalloonHelpString(
     k_("Set the specular coefficient within the range [0,100] for lighting"));
 
-  this->Script("grid %s -padx 2 -pady 2 -sticky news -row %d",
-               this->SpecularScale->GetWidgetName(), row++);
+  this->QueueScript("grid %s -padx 2 -pady 2 -sticky news -row %d",
+                    this->SpecularScale->GetWidgetName(), row++);
  
   // --------------------------------------------------------------
   // Specular power
@@ -416,8 +416,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->SpecularPowerScale->SetBalloonHelpString(
     k_("Set the specular power within the range [0,50] for lighting"));
   
-  this->Script("grid %s -padx 2 -pady 2 -sticky news -row %d",
-               this->SpecularPowerScale->GetWidgetName(), row++);
+  this->QueueScript("grid %s -padx 2 -pady 2 -sticky news -row %d",
+                    this->SpecularPowerScale->GetWidgetName(), row++);
  
   // --------------------------------------------------------------
   // Presets + Preview frame
@@ -435,8 +435,8 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->PreviewLabel->GetLabel()->SetText(
     ks_("Material Property Editor|Preview:"));
   
-  this->Script("pack %s -side left -padx 2 -pady 2 -anchor nw",
-               this->PreviewLabel->GetWidgetName());
+  this->QueueScript("pack %s -side left -padx 2 -pady 2 -anchor nw",
+                    this->PreviewLabel->GetWidgetName());
   
   // --------------------------------------------------------------
   // Presets
@@ -448,7 +448,7 @@ void vtkKWMaterialPropertyWidget::CreateWidget()
   this->PresetPushButtonSet->Create();
   this->PresetPushButtonSet->ExpandWidgetOff();
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side right -padx 2 -pady 2 -anchor nw",
     this->PresetPushButtonSet->GetWidgetName());
 
@@ -485,20 +485,20 @@ void vtkKWMaterialPropertyWidget::Pack()
 
   if (this->ControlFrame)
     {
-    this->Script("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
-                 this->ControlFrame->GetWidgetName());
+    this->QueueScript("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
+                      this->ControlFrame->GetWidgetName());
     }
   
   if (this->LightingFrame && this->LightingParametersVisibility)
     {
-    this->Script("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
-                 this->LightingFrame->GetWidgetName());
+    this->QueueScript("pack %s -padx 0 -pady 0 -fill x -expand yes -anchor w",
+                      this->LightingFrame->GetWidgetName());
     }
 
   if (this->PresetsFrame)
     {
-    this->Script("pack %s -anchor w -fill x -expand y",
-                 this->PresetsFrame->GetWidgetName());
+    this->QueueScript("pack %s -anchor w -fill x -expand y",
+                      this->PresetsFrame->GetWidgetName());
     }
 }
 
@@ -76,8 +76,8 @@ void vtkKWMatrixWidget::CreateWidget()
   this->EntrySet->SetWidgetsPadY(1);
   this->EntrySet->ExpandWidgetsOff();
 
-  this->Script("pack %s -fill both",
-               this->EntrySet->GetWidgetName());
+  this->QueueScript("pack %s -fill both",
+                    this->EntrySet->GetWidgetName());
 
   this->UpdateWidget();
 }
@@ -102,8 +102,8 @@ void vtkKWMessageDialog::CreateWidget()
   this->MessageDialogFrame->SetParent(this);
   this->MessageDialogFrame->Create();
 
-  this->Script("pack %s -side right -fill both -expand true -pady 0",
-               this->MessageDialogFrame->GetWidgetName());
+  this->QueueScript("pack %s -side right -fill both -expand true -pady 0",
+                    this->MessageDialogFrame->GetWidgetName());
 
   if (this->Options & vtkKWMessageDialog::Beep)
     {
@@ -197,8 +197,8 @@ void vtkKWMessageDialog::CreateWidget()
   this->Icon->SetPadY(0);
   this->Icon->SetBorderWidth(0);
 
-  this->Script("pack %s -side left -fill y", this->Icon->GetWidgetName());
-  this->Script("pack forget %s", this->Icon->GetWidgetName());
+  this->QueueScript("pack %s -side left -fill y", this->Icon->GetWidgetName());
+  this->QueueScript("pack forget %s", this->Icon->GetWidgetName());
 
   this->SetIcon();
 
@@ -224,32 +224,32 @@ void vtkKWMessageDialog::Pack()
 
   if (this->TopFrame->GetNumberOfChildren())
     {
-    this->Script("pack %s -side top -fill both -expand t",
-                 this->TopFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill both -expand t",
+                      this->TopFrame->GetWidgetName());
     }
 
   if (this->Message && this->DialogText && *this->DialogText)
     {
-    this->Script("pack %s -side top -fill x -padx 20 -pady 5 -expand t",
-                 this->Message->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -padx 20 -pady 5 -expand t",
+                      this->Message->GetWidgetName());
     }
 
   if (this->BottomFrame->GetNumberOfChildren())
     {
-    this->Script("pack %s -side top -fill both -expand true",
-                 this->BottomFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill both -expand true",
+                      this->BottomFrame->GetWidgetName());
     }
 
   if (this->CheckButton && this->GetDialogName())
     {
     this->CheckButton->SetText(
       ks_("Message Dialog|Do not show this dialog anymore."));
-    this->Script("pack %s -side top -fill x -padx 20 -pady 5",
-                 this->CheckButton->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -padx 20 -pady 5",
+                      this->CheckButton->GetWidgetName());
     }
 
-  this->Script("pack %s -side bottom -fill x -pady 2 -expand f",
-               this->ButtonFrame->GetWidgetName());
+  this->QueueScript("pack %s -side bottom -fill x -pady 2 -expand f",
+                    this->ButtonFrame->GetWidgetName());
 
   this->PackButtons();
 }
@@ -320,23 +320,23 @@ void vtkKWMessageDialog::PackButtons()
 
   if (has_ok && this->OKButton && this->OKButton->IsCreated())
     {
-    this->Script("pack %s %s %s",
-                 this->OKButton->GetWidgetName(),
-                 this->OKFrame->GetWidgetName(), pack_opt.c_str());
+    this->QueueScript("pack %s %s %s",
+                      this->OKButton->GetWidgetName(),
+                      this->OKFrame->GetWidgetName(), pack_opt.c_str());
     }
 
   if (has_other && this->OtherButton && this->OtherButton->IsCreated())
     {
-    this->Script("pack %s %s %s",
-                 this->OtherButton->GetWidgetName(),
-                 this->OtherFrame->GetWidgetName(), pack_opt.c_str());
+    this->QueueScript("pack %s %s %s",
+                      this->OtherButton->GetWidgetName(),
+                      this->OtherFrame->GetWidgetName(), pack_opt.c_str());
     }
 
   if (has_cancel && this->CancelButton && this->CancelButton->IsCreated())
     {
-    this->Script("pack %s %s %s",
-                 this->CancelButton->GetWidgetName(),
-                 this->CancelFrame->GetWidgetName(), pack_opt.c_str());
+    this->QueueScript("pack %s %s %s",
+                      this->CancelButton->GetWidgetName(),
+                      this->CancelFrame->GetWidgetName(), pack_opt.c_str());
     }
 }
 
@@ -542,7 +542,7 @@ void vtkKWMessageDialog::SetIcon()
     this->Icon->SetPadY(0);
     this->Icon->SetPadX(0);
     this->Icon->SetBorderWidth(0);
-    this->Script("pack forget %s", this->Icon->GetWidgetName());
+    this->QueueScript("pack forget %s", this->Icon->GetWidgetName());
     return;
     }  
   
@@ -551,8 +551,8 @@ void vtkKWMessageDialog::SetIcon()
   this->Icon->SetPadX(4);
   this->Icon->SetBorderWidth(4);
 
-  this->Script("pack %s -pady 17 -side left -fill y", 
-               this->Icon->GetWidgetName());
+  this->QueueScript("pack %s -pady 17 -side left -fill y", 
+                    this->Icon->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
@@ -4289,8 +4289,14 @@ int vtkKWMultiColumnList::SetCellConfigurationOption(
     return 0;
     }
 #else
-  this->Script("tablelist::doCellConfig %d %d %s %s {%s}", 
-               row_index, col_index, this->GetWidgetName(), option, value);
+  vtkKWTkCommandArguments args;
+  args.AddInt(row_index);
+  args.AddInt(col_index);
+  args.AddString(this->GetWidgetName());
+  args.AddString(option);
+  args.AddString(value);
+  vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, "tablelist::doCellConfig", NULL, &args);
 #endif
 
   return 1;
@@ -4312,13 +4318,18 @@ int vtkKWMultiColumnList::SetCellConfigurationOptionAsText(
     return 0;
     }
 
-  const char *val = this->ConvertInternalStringToTclString(
-    value, vtkKWCoreWidget::ConvertStringEscapeInterpretable);
+  // The value is passed as-is, no need to escape it, only to convert it
+
+  const char *val = this->ConvertInternalStringToTclString(value);
 
-  //  const char *res = this->Script("%s cellconfigure %d,%d %s \"%s\"", 
-  this->Script("tablelist::doCellConfig %d %d %s %s \"%s\"", 
-               row_index, col_index, this->GetWidgetName(), 
-               option, val ? val : "");
+  vtkKWTkCommandArguments args;
+  args.AddInt(row_index);
+  args.AddInt(col_index);
+  args.AddString(this->GetWidgetName());
+  args.AddString(option);
+  args.AddString(val);
+  vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, "tablelist::doCellConfig", NULL, &args);
 
 #if 0
   // 'configure' is not supposed to return anything, so let's assume
@@ -4351,9 +4362,14 @@ int vtkKWMultiColumnList::SetCellConfigurationOptionAsInt(
     return 0;
     }
 
-  // const char *res = this->Script("%s cellconfigure %d,%d %s %d", 
-  this->Script("tablelist::doCellConfig %d %d %s %s %d", 
-               row_index, col_index, this->GetWidgetName(), option, value);
+  vtkKWTkCommandArguments args;
+  args.AddInt(row_index);
+  args.AddInt(col_index);
+  args.AddString(this->GetWidgetName());
+  args.AddString(option);
+  args.AddInt(value);
+  vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, "tablelist::doCellConfig", NULL, &args);
 
 #if 0
   // 'configure' is not supposed to return anything, so let's assume
@@ -4386,9 +4402,19 @@ int vtkKWMultiColumnList::SetCellConfigurationOptionAsDouble(
     return 0;
     }
 
-  // const char *res = this->Script("%s cellconfigure %d,%d %s %f", 
-  this->Script("tablelist::doCellConfig %d %d %s %s %f", 
-               row_index, col_index, this->GetWidgetName(), option, value);
+  // Keep the "%f" formatting, the value is usually displayed as text
+
+  char buffer[512];
+  sprintf(buffer, "%f", value);
+
+  vtkKWTkCommandArguments args;
+  args.AddInt(row_index);
+  args.AddInt(col_index);
+  args.AddString(this->GetWidgetName());
+  args.AddString(option);
+  args.AddString(buffer);
+  vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, "tablelist::doCellConfig", NULL, &args);
 
 #if 0
   // 'configure' is not supposed to return anything, so let's assume
@@ -4421,13 +4447,17 @@ int vtkKWMultiColumnList::SetCellConfigurationOptionAsFormattedDouble(
     return 0;
     }
 
-  char format[1024];
-  //sprintf(format, "%%s cellconfigure %%d,%%d %%s %%.%dg", size);
-  sprintf(format, "tablelist::doCellConfig %%d %%d %%s %%s %%.%dg", size);
+  char buffer[512];
+  sprintf(buffer, "%.*g", size, value);
 
-  //const char *res = 
-  this->Script(format, 
-               row_index, col_index, this->GetWidgetName(), option, value);
+  vtkKWTkCommandArguments args;
+  args.AddInt(row_index);
+  args.AddInt(col_index);
+  args.AddString(this->GetWidgetName());
+  args.AddString(option);
+  args.AddString(buffer);
+  vtkKWTkUtilities::EvaluateCommand(
+    this->GetApplication(), this, "tablelist::doCellConfig", NULL, &args);
 
 #if 0
   // 'configure' is not supposed to return anything, so let's assume
@@ -1704,7 +1704,7 @@ void vtkKWNotebook::HidePage(vtkKWNotebook::Page *page)
   
   if (page->TabFrame->IsPacked())
     {
-    this->Script("pack forget %s", page->TabFrame->GetWidgetName());
+    this->QueueScript("pack forget %s", page->TabFrame->GetWidgetName());
     if (this->ShowOnlyMostRecentPages)
       {
       this->RemoveFromMostRecentPages(page);
@@ -2463,10 +2463,10 @@ void vtkKWNotebook::UpdatePageTabAspect(vtkKWNotebook::Page *page)
 
   if (page->TabFrame->IsPacked())
     {
-    this->Script("pack %s -ipadx 0 -ipady %d -padx %d",
-                 page->TabFrame->GetWidgetName(), 
-                 selected ? this->SelectedPageTabPadding : 0, 
-                 VTK_KW_NB_TAB_PADX);
+    this->QueueScript("pack %s -ipadx 0 -ipady %d -padx %d",
+                      page->TabFrame->GetWidgetName(), 
+                      selected ? this->SelectedPageTabPadding : 0, 
+                      VTK_KW_NB_TAB_PADX);
     }
 
   // If the page that has just been update was the selected page, update the
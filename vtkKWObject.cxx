@@ -20,6 +20,7 @@
 #include "vtkCallbackCommand.h"
 
 #include <ctype.h>
+#include <stdio.h>
 #include <vtksys/SystemTools.hxx>
 
 //----------------------------------------------------------------------------
@@ -101,6 +102,26 @@ const char* vtkKWObject::Script(const char* format, ...)
   return NULL;
 }
 
+//----------------------------------------------------------------------------
+void vtkKWObject::QueueScript(const char* format, ...)
+{
+  vtkKWApplication *app = this->GetApplication();
+  if (!app)
+    {
+    vtkWarningMacro(
+      "Attempt to script a command before the application was set!");
+    return;
+    }
+
+  va_list var_args1, var_args2;
+  va_start(var_args1, format);
+  va_start(var_args2, format);
+  vtkKWTkUtilities::QueueStringFromArgs(
+    app, this, format, var_args1, var_args2);
+  va_end(var_args1);
+  va_end(var_args2);
+}
+
 //----------------------------------------------------------------------------
 void vtkKWObject::SetObjectMethodCommand(
   char **command, 
@@ -51,6 +51,14 @@ public:
   // Description:
   // Invoke some Tcl script code and perform argument substitution.
   virtual const char* Script(const char *EventString, ...);
+
+  // Description:
+  // Invoke some Tcl script code whose result is not needed, and perform
+  // argument substitution. If a script batch is in progress (see
+  // vtkKWApplication::BeginScriptBatch), the script is queued and evaluated
+  // later on with the rest of the batch; errors are still reported on
+  // this object.
+  virtual void QueueScript(const char *format, ...);
   //ETX
   
   // Description:
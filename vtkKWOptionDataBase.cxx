@@ -15,6 +15,7 @@
 #include "vtkKWOptionDataBase.h"
 
 #include "vtkKWApplication.h"
+#include "vtkKWCoreWidget.h"
 #include "vtkKWWidget.h"
 #include "vtkObjectFactory.h"
 #include "vtkKWTkUtilities.h"
@@ -200,6 +201,8 @@ int vtkKWOptionDataBase::AddEntry(const char *pattern,
 
   this->Internals->EntryPool[node.ClassName].push_back(node);
 
+  vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches();
+
   return node.Id;
 }
 
@@ -293,6 +296,8 @@ void vtkKWOptionDataBase::DeepCopy(vtkKWOptionDataBase *p)
 void vtkKWOptionDataBase::RemoveAllEntries()
 {
   this->Internals->EntryPool.clear();
+
+  vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches();
 }
 
 //----------------------------------------------------------------------------
@@ -38,6 +38,7 @@
 #include <vtksys/ios/sstream>
 #include <vtksys/stl/string>
 #include <vtksys/stl/vector>
+#include <vtksys/stl/set>
 #include <vtksys/stl/algorithm>
 #include <vtksys/SystemTools.hxx>
 
@@ -77,6 +78,8 @@ const char *vtkKWParameterValueFunctionEditor::SelectedTag = "selected_tag";
 const char *vtkKWParameterValueFunctionEditor::PointTag = "point_tag";
 const char *vtkKWParameterValueFunctionEditor::PointGuidelineTag = "point_guideline_tag";
 const char *vtkKWParameterValueFunctionEditor::LineTag = "line_tag";
+const char *vtkKWParameterValueFunctionEditor::FunctionLODTag = "function_lod_tag";
+const char *vtkKWParameterValueFunctionEditor::SelectionRectangleTag = "selection_rectangle_tag";
 const char *vtkKWParameterValueFunctionEditor::PointTextTag = "point_text_tag";
 const char *vtkKWParameterValueFunctionEditor::HistogramTag = "histogram_tag";
 const char *vtkKWParameterValueFunctionEditor::SecondaryHistogramTag = "secondary_histogram_tag";
@@ -86,6 +89,233 @@ const char *vtkKWParameterValueFunctionEditor::ParameterCursorTag = "cursor_tag"
 const char *vtkKWParameterValueFunctionEditor::ParameterTicksTag = "p_ticks_tag";
 const char *vtkKWParameterValueFunctionEditor::ValueTicksTag = "v_ticks_tag";
 
+//----------------------------------------------------------------------------
+class vtkKWParameterValueFunctionEditorInternals
+{
+public:
+
+  // The canvas items making up the function, as last sent to Tk. Each
+  // point has a text (t<id>), a point (p<id>) and a guideline (g<id>), 
+  // the line between id - 1 and id is l<id>. In level-of-detail mode, the 
+  // whole function is a single line (LODItem). An item with an empty Type 
+  // does not exist in the canvas. This is what allows the redraw to
+  // skip the canvas queries and only send the coordinates/options that
+  // actually changed.
+
+  class CanvasItem
+  {
+  public:
+    vtksys_stl::string Type;
+    vtksys_stl::string Coords;
+    vtksys_stl::string Config;
+    unsigned long Generation;
+
+    CanvasItem() { this->Generation = 0; }
+  };
+
+  // Incremented each time a canvas command stream has been executed, so
+  // that the items that were created before can be told apart from the
+  // ones whose creation is still pending in a stream (see Generation).
+
+  unsigned long CanvasItemsGeneration;
+
+  // The new coordinates of the items that exist in the canvas already, as
+  // tag/coordinates pairs. They are all set in a single evaluation before
+  // the next command stream is executed (see ExecuteCanvasCommands).
+
+  vtksys_stl::vector<vtksys_stl::string> PendingCoords;
+
+  enum
+  {
+    TextItem = 0,
+    PointItem,
+    GuidelineItem,
+    LineItem,
+    NumberOfItemKinds
+  };
+
+  typedef vtksys_stl::vector<CanvasItem> CanvasItemsContainer;
+  CanvasItemsContainer CanvasItems[NumberOfItemKinds];
+  CanvasItem NoCanvasItem;
+  CanvasItem LODItem;
+
+  CanvasItem& GetCanvasItem(int kind, int id);
+  void RemoveCanvasItem(const char *prefix, int id);
+  void RemoveCanvasItems(const char *tag);
+
+  // The redraws and commands scheduled to be processed at idle time (see
+  // CoalesceInteractiveRedraws).
+
+  int ScheduledElements;
+  vtksys_stl::set<int> ScheduledPoints;
+  int ScheduledChangingPoint;
+  int ProcessingScheduledRedraws;
+  vtksys_stl::string ScheduledRedrawsTimerId;
+
+  // The elements redrawn since ProcessScheduledRedraws started, so that
+  // the ones already redrawn by a complete Redraw are not redrawn twice
+
+  int RedrawnElements;
+
+  // The canvas coordinates of the points, and the state they were computed
+  // for (see UpdateFunctionPointsIndex).
+
+  vtksys_stl::vector<int> PointsX;
+  vtksys_stl::vector<int> PointsY;
+  double PointsIndexKey[8];
+  int PointsIndexValid;
+
+  // The points selected in addition to SelectedPoint, and the rubber-band
+  // selection in progress (see SelectPointsInCanvasRectangle).
+
+  vtksys_stl::set<int> ExtraSelectedPoints;
+  int SelectionRectangleActive;
+  int SelectionRectangle[4];
+
+  int InParameterCursorInteraction;
+
+  // The edit transaction in progress, if any (see BeginEditTransaction), 
+  // and the state of the editor when it started.
+
+  int EditTransactionDepth;
+  int EditTransactionDisableRedraw;
+  int EditTransactionSelectedPoint;
+  unsigned long EditTransactionFunctionTime;
+  int EditTransactionFunctionModified;
+  unsigned long EditTransactionTime;
+};
+
+//----------------------------------------------------------------------------
+vtkKWParameterValueFunctionEditorInternals::CanvasItem& 
+vtkKWParameterValueFunctionEditorInternals::GetCanvasItem(int kind, int id)
+{
+  if (id < 0)
+    {
+    this->NoCanvasItem = CanvasItem();
+    return this->NoCanvasItem;
+    }
+  CanvasItemsContainer &items = this->CanvasItems[kind];
+  if (id >= (int)items.size())
+    {
+    items.resize(id + 1);
+    }
+  return items[id];
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditorInternals::RemoveCanvasItem(
+  const char *prefix, int id)
+{
+  static const char *prefixes[NumberOfItemKinds] = { "t", "p", "g", "l" };
+  for (int kind = 0; kind < NumberOfItemKinds; kind++)
+    {
+    if (!strcmp(prefix, prefixes[kind]))
+      {
+      if (id >= 0 && id < (int)this->CanvasItems[kind].size())
+        {
+        this->CanvasItems[kind][id] = CanvasItem();
+        }
+      return;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditorInternals::RemoveCanvasItems(
+  const char *tag)
+{
+  if (!strcmp(tag, vtkKWParameterValueFunctionEditor::FunctionTag))
+    {
+    for (int kind = 0; kind < NumberOfItemKinds; kind++)
+      {
+      this->CanvasItems[kind].clear();
+      }
+    this->LODItem = CanvasItem();
+    }
+  else if (!strcmp(tag, vtkKWParameterValueFunctionEditor::FunctionLODTag))
+    {
+    this->LODItem = CanvasItem();
+    }
+  else if (!strcmp(tag, vtkKWParameterValueFunctionEditor::PointTextTag))
+    {
+    this->CanvasItems[TextItem].clear();
+    }
+  else if (!strcmp(tag, vtkKWParameterValueFunctionEditor::PointTag))
+    {
+    this->CanvasItems[PointItem].clear();
+    }
+  else if (!strcmp(tag, vtkKWParameterValueFunctionEditor::PointGuidelineTag))
+    {
+    this->CanvasItems[GuidelineItem].clear();
+    }
+  else if (!strcmp(tag, vtkKWParameterValueFunctionEditor::LineTag))
+    {
+    this->CanvasItems[LineItem].clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Update the coordinates and options of an existing canvas item, only
+// sending the ones that differ from what the item was last set to.
+// The item is named after 'prefix' and 'id' (or 'prefix' alone if id < 0).
+// The coordinates of an item that is known to exist in the canvas already
+// (i.e. whose creation was executed in a previous generation of commands)
+// are collected in PendingCoords, without going through the stream; the
+// others have to be queued after the command that creates the item.
+static void vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+  vtkKWParameterValueFunctionEditorInternals *internals,
+  vtksys_ios::ostream *tk_cmd, 
+  const char *canv, 
+  const char *prefix, 
+  int id,
+  vtkKWParameterValueFunctionEditorInternals::CanvasItem &item,
+  const vtksys_stl::string &coords,
+  const vtksys_stl::string &config)
+{
+  if (coords.size() && coords != item.Coords)
+    {
+    if (item.Coords.size() && 
+        item.Generation != internals->CanvasItemsGeneration)
+      {
+      char tag[256];
+      if (id >= 0)
+        {
+        sprintf(tag, "%s%d", prefix, id);
+        }
+      else
+        {
+        strcpy(tag, prefix);
+        }
+      internals->PendingCoords.push_back(tag);
+      internals->PendingCoords.push_back(coords);
+      }
+    else
+      {
+      *tk_cmd << canv << " coords " << prefix;
+      if (id >= 0)
+        {
+        *tk_cmd << id;
+        }
+      *tk_cmd << " " << coords << endl;
+      if (!item.Coords.size())
+        {
+        item.Generation = internals->CanvasItemsGeneration;
+        }
+      }
+    item.Coords = coords;
+    }
+  if (config.size() && config != item.Config)
+    {
+    *tk_cmd << canv << " itemconfigure " << prefix;
+    if (id >= 0)
+      {
+      *tk_cmd << id;
+      }
+    *tk_cmd << " " << config << endl;
+    item.Config = config;
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkKWParameterValueFunctionEditor::vtkKWParameterValueFunctionEditor()
 {
@@ -145,6 +375,7 @@ vtkKWParameterValueFunctionEditor::vtkKWParameterValueFunctionEditor()
   this->NumberOfValueTicks          = 6;
   this->ValueTicksCanvasWidth       = VTK_KW_PVFE_TICKS_VALUE_CANVAS_WIDTH;
   this->ChangeMouseCursor          = 1;
+  this->CoalesceInteractiveRedraws = 0;
   this->PointColorStyle      = vtkKWParameterValueFunctionEditor::PointColorStyleFill;
 
   this->ParameterTicksFormat        = NULL;
@@ -244,6 +475,29 @@ vtkKWParameterValueFunctionEditor::vtkKWParameterValueFunctionEditor()
   this->LastRedrawFunctionTime      = 0;
   this->LastRedrawFunctionSize      = 0;
 
+  this->Internals = new vtkKWParameterValueFunctionEditorInternals;
+  this->Internals->ScheduledElements = 0;
+  this->Internals->ScheduledChangingPoint = -1;
+  this->Internals->ProcessingScheduledRedraws = 0;
+  this->Internals->RedrawnElements = 0;
+  this->Internals->PointsIndexValid = 0;
+  this->Internals->SelectionRectangleActive = 0;
+  this->Internals->SelectionRectangle[0] = 
+    this->Internals->SelectionRectangle[1] = 
+    this->Internals->SelectionRectangle[2] = 
+    this->Internals->SelectionRectangle[3] = 0;
+  this->Internals->InParameterCursorInteraction = 0;
+  this->Internals->EditTransactionDepth = 0;
+  this->Internals->CanvasItemsGeneration = 1;
+  this->Internals->EditTransactionDisableRedraw = 0;
+  this->Internals->EditTransactionSelectedPoint = -1;
+  this->Internals->EditTransactionFunctionTime = 0;
+  this->Internals->EditTransactionFunctionModified = 0;
+  this->Internals->EditTransactionTime = 0;
+
+  this->PointLODThreshold = 0;
+  this->PointLODActive = 0;
+
   this->LastSelectionCanvasCoordinateX    = 0;
   this->LastSelectionCanvasCoordinateY    = 0;
   this->LastConstrainedMove               = vtkKWParameterValueFunctionEditor::ConstrainedMoveFree;
@@ -475,6 +729,16 @@ vtkKWParameterValueFunctionEditor::~vtkKWParameterValueFunctionEditor()
   this->SetParameterTicksFormat(NULL);
   this->SetParameterEntryFormat(NULL);
   this->SetValueTicksFormat(NULL);
+
+  if (this->Internals->ScheduledRedrawsTimerId.size())
+    {
+    vtkKWTkUtilities::CancelTimerHandler(
+      this->GetApplication(), 
+      this->Internals->ScheduledRedrawsTimerId.c_str());
+    }
+
+  delete this->Internals;
+  this->Internals = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -723,7 +987,7 @@ int vtkKWParameterValueFunctionEditor::GetFunctionPointColorInCanvas(
 
   if (!this->ComputePointColorFromValue)
     {
-    if (id == this->GetSelectedPoint())
+    if (this->IsPointSelected(id))
       {
       rgb[0] = this->SelectedPointColor[0];
       rgb[1] = this->SelectedPointColor[1];
@@ -798,7 +1062,7 @@ int vtkKWParameterValueFunctionEditor::GetFunctionPointTextColorInCanvas(
 
   if (!this->ComputePointColorFromValue)
     {
-    if (id == this->GetSelectedPoint())
+    if (this->IsPointSelected(id))
       {
       rgb[0] = this->SelectedPointTextColor[0];
       rgb[1] = this->SelectedPointTextColor[1];
@@ -1115,6 +1379,7 @@ int vtkKWParameterValueFunctionEditor::MoveFunctionPoint(
 
   // Replace the parameter / value
 
+  int index_was_up_to_date = this->FunctionPointsIndexIsUpToDate();
   unsigned long mtime = this->GetFunctionMTime();
   if (!this->SetFunctionPoint(id, parameter, values) ||
       this->GetFunctionMTime() <= mtime)
@@ -1122,11 +1387,22 @@ int vtkKWParameterValueFunctionEditor::MoveFunctionPoint(
     return 0;
     }
 
+  // Only that point moved, update it in the points index
+
+  if (index_was_up_to_date)
+    {
+    this->UpdateFunctionPointInIndex(id);
+    }
+
   // Redraw the point
   // the point we just moved will be redrawn by
   // the call to RedrawFunctionDependentElements
 
-  this->RedrawSinglePointDependentElements(id);
+  if (!this->ScheduleRedraw(
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint, id))
+    {
+    this->RedrawSinglePointDependentElements(id);
+    }
 
   // If we are moving the end points and we should rescale
 
@@ -1134,7 +1410,11 @@ int vtkKWParameterValueFunctionEditor::MoveFunctionPoint(
       (id == 0 || id == this->GetFunctionSize() - 1))
     {
     this->RescaleFunctionBetweenEndPoints(id, old_parameter);
-    this->RedrawFunctionDependentElements();
+    if (!this->ScheduleRedraw(
+          vtkKWParameterValueFunctionEditor::ScheduledRedrawFunction))
+      {
+      this->RedrawFunctionDependentElements();
+      }
     }
 
   return 1;
@@ -1274,6 +1554,13 @@ void vtkKWParameterValueFunctionEditor::CreateWidget()
     this->ExpandCanvasWidth ? 0 : this->RequestedCanvasWidth);
   this->Canvas->SetConfigurationOptionAsInt("-takefocus", 0);
 
+  // Set the coordinates of several canvas items in a single evaluation
+  // (see ExecuteCanvasCommands)
+
+  this->Script("proc vtkKWParameterValueFunctionEditorSetCoords "
+               "{canv items} "
+               "{foreach {tag coords} $items {$canv coords $tag $coords}}");
+
   // Both are needed, the first one in case the canvas is not visible, the
   // second because if it is visible, we want it to notify us precisely
   // when it needs re-configuration
@@ -1714,7 +2001,17 @@ void vtkKWParameterValueFunctionEditor::Update()
 
   this->UpdatePointEntries(this->GetSelectedPoint());
 
-  this->Redraw();
+  // Within an edit transaction, redraw once at the end of it
+
+  if (this->IsInEditTransaction())
+    {
+    this->Internals->ScheduledElements |= 
+      vtkKWParameterValueFunctionEditor::ScheduledRedrawAll;
+    }
+  else
+    {
+    this->Redraw();
+    }
 
   this->UpdateHistogramLogModeOptionMenu();
 }
@@ -2086,28 +2383,31 @@ void vtkKWParameterValueFunctionEditor::Bind()
     this->Canvas->SetBinding(
       "<Shift-Any-ButtonPress>", this, "StartInteractionCallback %x %y 1");
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag,
-      "<B1-Motion>", this, "MovePointCallback %x %y 0");
+    // Rubber-band selection, with the left button only since only the
+    // left button motion and release are bound below. Control + left 
+    // button might be used by the parameter cursor already.
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag,
-      "<B1-Motion>", this, "MovePointCallback %x %y 0");
+    if (!(this->ParameterCursorInteractionStyle & 
+          vtkKWParameterValueFunctionEditor::ParameterCursorInteractionStyleSetWithControlLeftButton))
+      {
+      this->Canvas->SetBinding(
+        "<Control-ButtonPress-1>", 
+        this, "StartSelectionRectangleCallback %x %y");
+      }
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag,
-      "<Shift-B1-Motion>", this, "MovePointCallback %x %y 1");
+    // The motion and release are bound to the canvas, not to the point
+    // items: the point being dragged might not have a canvas item of its
+    // own (see PointLODThreshold), and the same bindings drive the 
+    // rubber-band selection. The Start*Callback methods decide what is 
+    // going on.
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag,
-      "<Shift-B1-Motion>", this, "MovePointCallback %x %y 1");
+    this->Canvas->SetBinding(
+      "<B1-Motion>", this, "MovePointCallback %x %y 0");
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag,
-      "<ButtonRelease-1>", this, "EndInteractionCallback %x %y");
+    this->Canvas->SetBinding(
+      "<Shift-B1-Motion>", this, "MovePointCallback %x %y 1");
 
-    this->Canvas->SetCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag,
+    this->Canvas->SetBinding(
       "<ButtonRelease-1>", this, "EndInteractionCallback %x %y");
 
     // Double click on point
@@ -2248,23 +2548,13 @@ void vtkKWParameterValueFunctionEditor::UnBind()
 
     this->Canvas->RemoveBinding("<Any-ButtonPress>");
 
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag, "<B1-Motion>");
-
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag, "<B1-Motion>");
-
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag, "<Shift-B1-Motion>");
+    this->Canvas->RemoveBinding("<Shift-Any-ButtonPress>");
 
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag, "<Shift-B1-Motion>");
+    this->Canvas->RemoveBinding("<B1-Motion>");
 
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTag, "<ButtonRelease-1>");
+    this->Canvas->RemoveBinding("<Shift-B1-Motion>");
 
-    this->Canvas->RemoveCanvasBinding(
-      vtkKWParameterValueFunctionEditor::PointTextTag, "<ButtonRelease-1>");
+    this->Canvas->RemoveBinding("<ButtonRelease-1>");
 
     // Double click on point
 
@@ -3393,7 +3683,11 @@ void vtkKWParameterValueFunctionEditor::SetParameterCursorPosition(double arg)
 
   this->Modified();
 
-  this->RedrawParameterCursor();
+  if (!this->ScheduleRedraw(
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawParameterCursor))
+    {
+    this->RedrawParameterCursor();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -3567,6 +3861,26 @@ void vtkKWParameterValueFunctionEditor::SetSelectedPointRadius(double arg)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::SetPointLODThreshold(int arg)
+{
+  if (arg < 0)
+    {
+    arg = 0;
+    }
+
+  if (this->PointLODThreshold == arg)
+    {
+    return;
+    }
+
+  this->PointLODThreshold = arg;
+
+  this->Modified();
+
+  this->RedrawFunction();
+}
+
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::SetSelectedPointText(const char *arg)
 {
@@ -4504,6 +4818,11 @@ void vtkKWParameterValueFunctionEditor::SetPointAddedCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokePointAddedCommand(int id)
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokePointCommand(this->PointAddedCommand, id);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::PointAddedEvent, &id);
@@ -4519,6 +4838,11 @@ void vtkKWParameterValueFunctionEditor::SetPointChangingCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokePointChangingCommand(int id)
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokePointCommand(this->PointChangingCommand, id);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::PointChangingEvent, &id);
@@ -4534,6 +4858,11 @@ void vtkKWParameterValueFunctionEditor::SetPointChangedCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokePointChangedCommand(int id)
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokePointCommand(this->PointChangedCommand, id);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::PointChangedEvent, &id);
@@ -4567,6 +4896,11 @@ void vtkKWParameterValueFunctionEditor::SetPointRemovedCommand(
 void vtkKWParameterValueFunctionEditor::InvokePointRemovedCommand(
   int id, double parameter)
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   vtksys_ios::ostringstream param_str;
   param_str << parameter;
   this->InvokePointCommand(this->PointRemovedCommand, id, param_str.str().c_str());
@@ -4589,6 +4923,11 @@ void vtkKWParameterValueFunctionEditor::SetSelectionChangedCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokeSelectionChangedCommand()
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->SelectionChangedCommand);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::SelectionChangedEvent);
@@ -4604,6 +4943,11 @@ void vtkKWParameterValueFunctionEditor::SetFunctionChangedCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokeFunctionChangedCommand()
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->FunctionChangedCommand);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::FunctionChangedEvent);
@@ -4619,6 +4963,11 @@ void vtkKWParameterValueFunctionEditor::SetFunctionChangingCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokeFunctionChangingCommand()
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->FunctionChangingCommand);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::FunctionChangingEvent);
@@ -4634,6 +4983,11 @@ void vtkKWParameterValueFunctionEditor::SetFunctionStartChangingCommand(
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::InvokeFunctionStartChangingCommand()
 {
+  if (this->Internals->EditTransactionDepth)
+    {
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->FunctionStartChangingCommand);
 
   this->InvokeEvent(vtkKWParameterValueFunctionEditor::FunctionStartChangingEvent);
@@ -4818,10 +5172,18 @@ void vtkKWParameterValueFunctionEditor::SetHistogram(vtkKWHistogram *arg)
       this->Histogram->GetMTime() > this->LastHistogramBuildTime)
     {
     this->UpdateHistogramLogModeOptionMenu();
-    this->RedrawHistogram();
+    int elements = vtkKWParameterValueFunctionEditor::ScheduledRedrawHistogram;
     if (this->ComputeValueTicksFromHistogram)
       {
-      this->RedrawRangeTicks();
+      elements |= vtkKWParameterValueFunctionEditor::ScheduledRedrawRangeTicks;
+      }
+    if (!this->ScheduleRedraw(elements))
+      {
+      this->RedrawHistogram();
+      if (this->ComputeValueTicksFromHistogram)
+        {
+        this->RedrawRangeTicks();
+        }
       }
     }
 }
@@ -4853,7 +5215,11 @@ void vtkKWParameterValueFunctionEditor::SetSecondaryHistogram(
       this->SecondaryHistogram->GetMTime() > this->LastHistogramBuildTime)
     {
     this->UpdateHistogramLogModeOptionMenu();
-    this->RedrawHistogram();
+    if (!this->ScheduleRedraw(
+          vtkKWParameterValueFunctionEditor::ScheduledRedrawHistogram))
+      {
+      this->RedrawHistogram();
+      }
     }
 }
 
@@ -5202,68 +5568,261 @@ void vtkKWParameterValueFunctionEditor::Redraw()
 }
 
 //----------------------------------------------------------------------------
-void vtkKWParameterValueFunctionEditor::RedrawSizeDependentElements()
+void vtkKWParameterValueFunctionEditor::SetCoalesceInteractiveRedraws(int arg)
 {
-  this->RedrawHistogram();
-  this->RedrawRangeTicks();
-  this->RedrawParameterCursor();
-  this->RedrawFunction();
-  this->RedrawRangeFrame();
-}
+  if (this->CoalesceInteractiveRedraws == arg)
+    {
+    return;
+    }
 
-//----------------------------------------------------------------------------
-void vtkKWParameterValueFunctionEditor::RedrawPanOnlyDependentElements()
-{
-  this->RedrawHistogram();
-  this->RedrawRangeTicks();
+  this->CoalesceInteractiveRedraws = arg;
 
-  // We used to draw the entire function for the whole canvas, even if
-  // a small portion of it was displayed (in zoom mode). This would
-  // use a lot of resources of lines were to be sampled betweem each points
-  // every n-pixel. Now we only redraw the points and line that are
-  // indeed visible. So if we pan, we need to redraw.
+  this->Modified();
 
-  this->RedrawFunction();
+  // Do not leave anything behind
+
+  if (!this->CoalesceInteractiveRedraws)
+    {
+    this->ProcessScheduledRedraws();
+    }
 }
 
 //----------------------------------------------------------------------------
-void vtkKWParameterValueFunctionEditor::RedrawFunctionDependentElements()
+int vtkKWParameterValueFunctionEditor::ScheduleRedraw(int elements, int id)
 {
-  this->RedrawFunction();
-  this->RedrawRangeFrame();
+  // Nothing is redrawn during an edit transaction, EndEditTransaction
+  // processes the requests at once. The Changing commands are not invoked
+  // at all.
 
-  this->UpdatePointEntries(this->GetSelectedPoint());
-}
+  if (this->Internals->EditTransactionDepth)
+    {
+    this->Internals->ScheduledElements |= (elements & 
+      ~vtkKWParameterValueFunctionEditor::ScheduledInvokeChangingCommands);
+    if ((elements & 
+         vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint) && 
+        id >= 0)
+      {
+      this->Internals->ScheduledPoints.insert(id);
+      }
+    return 1;
+    }
 
-//----------------------------------------------------------------------------
-void vtkKWParameterValueFunctionEditor::RedrawSinglePointDependentElements(
-  int id)
-{
-  if (id < 0 || id >= this->GetFunctionSize())
+  if (!this->CoalesceInteractiveRedraws || 
+      !this->IsCreated() ||
+      this->Internals->ProcessingScheduledRedraws)
     {
-    return;
+    return 0;
     }
 
-  this->RedrawPoint(id);
+  this->Internals->ScheduledElements |= elements;
 
-  this->RedrawLine(id - 1, id);
-  this->RedrawLine(id, id + 1);
+  if ((elements & 
+       vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint) && 
+      id >= 0)
+    {
+    this->Internals->ScheduledPoints.insert(id);
+    }
 
-  if (id == this->GetSelectedPoint())
+  if (elements & 
+      vtkKWParameterValueFunctionEditor::ScheduledInvokeChangingCommands)
     {
-    this->UpdatePointEntries(id);
+    this->Internals->ScheduledChangingPoint = id;
     }
 
-  // The range frame uses the two extreme points
-  
-  if ((id == 0 || id == this->GetFunctionSize() - 1))
+  // One timer is enough for all the requests until it fires
+
+  if (!this->Internals->ScheduledRedrawsTimerId.size())
     {
-    this->RedrawRangeFrame(); 
+    this->Internals->ScheduledRedrawsTimerId = 
+      vtkKWTkUtilities::CreateIdleTimerHandler(
+        this->GetApplication(), this, "ScheduledRedrawsCallback");
     }
+
+  return 1;
 }
 
 //----------------------------------------------------------------------------
-void vtkKWParameterValueFunctionEditor::RedrawRangeFrame()
+void vtkKWParameterValueFunctionEditor::ScheduledRedrawsCallback()
+{
+  // The timer has fired, no need to cancel it
+
+  this->Internals->ScheduledRedrawsTimerId = "";
+
+  this->ProcessScheduledRedraws();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::ProcessScheduledRedraws()
+{
+  vtkKWParameterValueFunctionEditorInternals *internals = this->Internals;
+
+  if (internals->ScheduledRedrawsTimerId.size())
+    {
+    vtkKWTkUtilities::CancelTimerHandler(
+      this->GetApplication(), internals->ScheduledRedrawsTimerId.c_str());
+    internals->ScheduledRedrawsTimerId = "";
+    }
+
+  if (!internals->ScheduledElements || internals->ProcessingScheduledRedraws)
+    {
+    return;
+    }
+
+  // Grab the requests first, the redraws and commands below may very well
+  // trigger new ones (which will be processed right away)
+
+  int elements = internals->ScheduledElements;
+  int changing_point = internals->ScheduledChangingPoint;
+  vtksys_stl::set<int> points;
+  points.swap(internals->ScheduledPoints);
+
+  internals->ScheduledElements = 0;
+  internals->ScheduledChangingPoint = -1;
+
+  internals->ProcessingScheduledRedraws = 1;
+
+  // A complete redraw only redraws what needs to be (say, the function if
+  // it was modified), skip the elements it took care of already
+
+  if (elements & vtkKWParameterValueFunctionEditor::ScheduledRedrawAll)
+    {
+    internals->RedrawnElements = 0;
+    this->Redraw();
+    if (internals->RedrawnElements & 
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawFunction)
+      {
+      internals->RedrawnElements |= 
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint;
+      }
+    elements &= ~internals->RedrawnElements;
+    }
+
+  if (elements & vtkKWParameterValueFunctionEditor::ScheduledRedrawFunction)
+    {
+    this->RedrawFunctionDependentElements();
+    }
+  else if (elements & 
+           vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint)
+    {
+    vtksys_stl::set<int>::iterator it = points.begin();
+    vtksys_stl::set<int>::iterator end = points.end();
+    for (; it != end; ++it)
+      {
+      this->RedrawSinglePointDependentElements(*it);
+      }
+    }
+
+  if (elements & vtkKWParameterValueFunctionEditor::ScheduledRedrawHistogram)
+    {
+    this->RedrawHistogram();
+    }
+
+  if (elements & vtkKWParameterValueFunctionEditor::ScheduledRedrawRangeTicks)
+    {
+    this->RedrawRangeTicks();
+    }
+
+  if (elements & 
+      vtkKWParameterValueFunctionEditor::ScheduledRedrawParameterCursor)
+    {
+    this->RedrawParameterCursor();
+    }
+
+  // Only the last position of the point is reported
+
+  if (elements & 
+      vtkKWParameterValueFunctionEditor::ScheduledInvokeChangingCommands)
+    {
+    if (changing_point >= 0 && changing_point < this->GetFunctionSize())
+      {
+      this->InvokePointChangingCommand(changing_point);
+      }
+    this->InvokeFunctionChangingCommand();
+    }
+
+  internals->ProcessingScheduledRedraws = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawSizeDependentElements()
+{
+  this->RedrawHistogram();
+  this->RedrawRangeTicks();
+  this->RedrawParameterCursor();
+  this->RedrawFunction();
+  this->RedrawRangeFrame();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawPanOnlyDependentElements()
+{
+  this->RedrawHistogram();
+  this->RedrawRangeTicks();
+
+  // We used to draw the entire function for the whole canvas, even if
+  // a small portion of it was displayed (in zoom mode). This would
+  // use a lot of resources of lines were to be sampled betweem each points
+  // every n-pixel. Now we only redraw the points and line that are
+  // indeed visible. So if we pan, we need to redraw.
+
+  this->RedrawFunction();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawFunctionDependentElements()
+{
+  this->Internals->RedrawnElements |= 
+    vtkKWParameterValueFunctionEditor::ScheduledRedrawFunction;
+
+  this->RedrawFunction();
+  this->RedrawRangeFrame();
+
+  if (!this->Internals->EditTransactionDepth)
+    {
+    this->UpdatePointEntries(this->GetSelectedPoint());
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawSinglePointDependentElements(
+  int id)
+{
+  if (id < 0 || id >= this->GetFunctionSize())
+    {
+    return;
+    }
+
+  // Only the items that changed are part of the command, send them all at
+  // once
+
+  if (this->IsCreated())
+    {
+    vtksys_ios::ostringstream tk_cmd;
+    this->RedrawPoint(id, &tk_cmd);
+    this->RedrawLine(id - 1, id, &tk_cmd);
+    this->RedrawLine(id, id + 1, &tk_cmd);
+    if (this->PointLODActive)
+      {
+      this->RedrawFunctionLOD(&tk_cmd);
+      }
+    this->ExecuteCanvasCommands(tk_cmd.str().c_str());
+    }
+
+  if (id == this->GetSelectedPoint() && !this->Internals->EditTransactionDepth)
+    {
+    this->UpdatePointEntries(id);
+    }
+
+  // The range frame uses the two extreme points
+  
+  if ((id == 0 || id == this->GetFunctionSize() - 1))
+    {
+    this->RedrawRangeFrame(); 
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawRangeFrame()
 {
   if (!this->IsCreated() || 
       !this->Canvas || 
@@ -5505,6 +6064,9 @@ void vtkKWParameterValueFunctionEditor::RedrawRangeTicks()
     return;
     }
 
+  this->Internals->RedrawnElements |= 
+    vtkKWParameterValueFunctionEditor::ScheduledRedrawRangeTicks;
+
   const char *canv = this->Canvas->GetWidgetName();
 
   const char *v_t_canv = NULL;
@@ -5736,6 +6298,9 @@ void vtkKWParameterValueFunctionEditor::RedrawParameterCursor()
     return;
     }
 
+  this->Internals->RedrawnElements |= 
+    vtkKWParameterValueFunctionEditor::ScheduledRedrawParameterCursor;
+
   const char *canv = this->Canvas->GetWidgetName();
 
   vtksys_ios::ostringstream tk_cmd;
@@ -5824,6 +6389,13 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
   int is_not_visible = 0, is_not_visible_h = 0;
   int is_not_valid = (id < 0 || id >= this->GetFunctionSize());
 
+  // In level-of-detail mode, only the selected points are drawn on their own
+
+  if (this->PointLODActive && !this->IsPointSelected(id))
+    {
+    is_not_valid = 1;
+    }
+
   // Point style
 
   int func_size = this->GetFunctionSize();
@@ -5881,14 +6453,18 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
   double rgb[3];
   char color[10];
 
+  typedef vtkKWParameterValueFunctionEditorInternals Internals;
+
   // Create the text item (index at each point)
   
-  int text_exists = this->CanvasHasTag("t", &id);
+  Internals::CanvasItem &text = 
+    this->Internals->GetCanvasItem(Internals::TextItem, id);
   if (is_not_valid)
     {
-    if (text_exists)
+    if (text.Type.size())
       {
       *tk_cmd << canv << " delete t" << id << endl;
+      text = Internals::CanvasItem();
       }
     }
   else
@@ -5900,28 +6476,29 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
           (this->SelectedPointIndexVisibility && 
            id == this->GetSelectedPoint())))
       {
-      if (text_exists)
+      if (text.Type.size())
         {
-        *tk_cmd << canv << " itemconfigure t" << id << " -state hidden\n"; 
+        vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+          this->Internals, tk_cmd, canv, "t", id, text, "", "-state hidden");
         }
       }
     else
       {
-      if (!text_exists)
+      if (!text.Type.size())
         {
         *tk_cmd << canv << " create text 0 0 -text {} " 
                 << "-tags {t" << id 
                 << " " << vtkKWParameterValueFunctionEditor::PointTextTag
                 << " " << vtkKWParameterValueFunctionEditor::FunctionTag << "}"
                 << endl;
+        text.Type = "text";
         }
     
-      // Update the text coordinates
+      // Update the text coordinates, color and contents
       
-      *tk_cmd << canv << " coords t" << id << " " << x << " " << y << endl;
+      vtksys_ios::ostringstream coords, config;
+      coords << x << " " << y;
 
-      // Update the text color and contents
-      
       if (this->GetFunctionPointTextColorInCanvas(id, rgb))
         {
         int text_size = 7 - (id > 8 ? 1 : 0);
@@ -5931,31 +6508,36 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
         Tcl_GetVersion(&tcl_major, &tcl_minor, &tcl_patch_level, NULL);
         const char *font = (tcl_major < 8 || (tcl_major == 8 && tcl_minor < 5)) 
           ? VTK_KW_PVFE_FIXED_FONT : VTK_KW_PVFE_FIXED_FONT_85;
-        *tk_cmd << canv << " itemconfigure t" << id
-                << " -state normal -font {{" << font << "} " 
-                << text_size << "} -fill " 
-                << color << " -text {";
+        config << "-state normal -font {{" << font << "} " 
+               << text_size << "} -fill " 
+               << color << " -text {";
         if (this->SelectedPointText && id == this->GetSelectedPoint())
           {
-          *tk_cmd << this->SelectedPointText;
+          config << this->SelectedPointText;
           }
         else
           {
-          *tk_cmd << id + 1;
+          config << id + 1;
           }
-        *tk_cmd  << "}" << endl;
+        config << "}";
         }
+
+      vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+        this->Internals, tk_cmd, canv, "t", id, text, 
+        coords.str(), config.str());
       }
     }
 
   // Create the point
 
-  int point_exists = this->CanvasHasTag("p", &id);
+  Internals::CanvasItem &point = 
+    this->Internals->GetCanvasItem(Internals::PointItem, id);
   if (is_not_valid)
     {
-    if (point_exists)
+    if (point.Type.size())
       {
       *tk_cmd << canv << " delete p" << id << endl;
+      point = Internals::CanvasItem();
       }
     }
   else
@@ -5964,9 +6546,10 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
         !this->PointVisibility || 
         !this->CanvasVisibility)
       {
-      if (point_exists)
+      if (point.Type.size())
         {
-        *tk_cmd << canv << " itemconfigure p" << id << " -state hidden\n";
+        vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+          this->Internals, tk_cmd, canv, "p", id, point, "", "-state hidden");
         }
       }
     else
@@ -5974,144 +6557,99 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
       // Get the point style
       // Points are reused. Since each point is of a specific type, it is OK
       // as long as the point styles are not mixed. If they are (i.e., a 
-      // special style for the first or last point for example), we have to
-      // check for the point type. If it is not the right type, the point can
-      // not be reused as the coordinates spec would not match. In that case,
-      // delete the point right now.
-
-      int must_check_for_type = 0;
+      // special style for the first or last point for example), the item
+      // type may not match the style anymore, and the coordinates spec 
+      // would not match either. In that case, delete the point right now.
 
-      if (this->FirstPointStyle != 
-          vtkKWParameterValueFunctionEditor::PointStyleDefault ||
-          this->LastPointStyle != 
-          vtkKWParameterValueFunctionEditor::PointStyleDefault)
+      const char *point_type = "oval";
+      switch (style)
         {
-        must_check_for_type = 1;
-        }
+        case vtkKWParameterValueFunctionEditor::PointStyleRectangle:
+          point_type = "rectangle";
+          break;
 
-      // Check if we need to recreate it
+        case vtkKWParameterValueFunctionEditor::PointStyleCursorDown:
+        case vtkKWParameterValueFunctionEditor::PointStyleCursorUp:
+        case vtkKWParameterValueFunctionEditor::PointStyleCursorLeft:
+        case vtkKWParameterValueFunctionEditor::PointStyleCursorRight:
+          point_type = "polygon";
+          break;
+        }
 
-      if (point_exists && must_check_for_type)
+      if (point.Type.size() && point.Type != point_type)
         {
-        int must_delete_point = 0;
-        switch (style)
-          {
-          case vtkKWParameterValueFunctionEditor::PointStyleDefault:
-          case vtkKWParameterValueFunctionEditor::PointStyleDisc:
-            must_delete_point = 
-              !this->CanvasCheckTagType("p", id, "oval");
-            break;
-
-          case vtkKWParameterValueFunctionEditor::PointStyleRectangle:
-            must_delete_point = 
-              !this->CanvasCheckTagType("p", id, "rectangle");
-            break;
-
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorDown:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorUp:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorLeft:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorRight:
-            must_delete_point = 
-              !this->CanvasCheckTagType("p", id, "polygon");
-            break;
-          }
-        if (must_delete_point)
-          {
-          *tk_cmd << canv << " delete p" << id << endl;
-          point_exists = 0;
-          }
+        *tk_cmd << canv << " delete p" << id << endl;
+        point = Internals::CanvasItem();
         }
 
       // Create the point item
 
-      if (!point_exists)
+      if (!point.Type.size())
         {
-        switch (style)
+        *tk_cmd << canv << " create " << point_type;
+        if (!strcmp(point_type, "polygon"))
           {
-          case vtkKWParameterValueFunctionEditor::PointStyleDefault:
-          case vtkKWParameterValueFunctionEditor::PointStyleDisc:
-            *tk_cmd << canv << " create oval";
-            break;
-
-          case vtkKWParameterValueFunctionEditor::PointStyleRectangle:
-            *tk_cmd << canv << " create rectangle";
-            break;
-
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorDown:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorUp:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorLeft:
-          case vtkKWParameterValueFunctionEditor::PointStyleCursorRight:
-            *tk_cmd << canv << " create polygon 0 0 0 0 0 0";
-            break;
+          *tk_cmd << " 0 0 0 0 0 0";
           }
         *tk_cmd << " 0 0 0 0 -tags {p" << id 
                 << " " << vtkKWParameterValueFunctionEditor::PointTag 
                 << " " << vtkKWParameterValueFunctionEditor::FunctionTag 
                 << "}" << endl;
         *tk_cmd << canv << " lower p" << id << " t" << id << endl;
+        point.Type = point_type;
         }
 
       // Update the point coordinates and style
 
+      vtksys_ios::ostringstream coords, config;
+
       switch (style)
         {
         case vtkKWParameterValueFunctionEditor::PointStyleDefault:
         case vtkKWParameterValueFunctionEditor::PointStyleDisc:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x - rx << " " << y - ry 
-                  << " " << x + rx << " " << y + ry << endl;
+          coords << x - rx << " " << y - ry 
+                 << " " << x + rx << " " << y + ry;
           break;
       
         case vtkKWParameterValueFunctionEditor::PointStyleRectangle:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x - rx << " " << y - ry 
-                  << " " << x + rx + LSTRANGE << " " << y + ry + LSTRANGE 
-                  << endl;
+          coords << x - rx << " " << y - ry 
+                 << " " << x + rx + LSTRANGE << " " << y + ry + LSTRANGE;
           break;
       
         case vtkKWParameterValueFunctionEditor::PointStyleCursorDown:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x - rx << " " << y 
-                  << " " << x      << " " << y + ry
-                  << " " << x + rx << " " << y 
-                  << " " << x + rx << " " << y - ry + 1 
-                  << " " << x - rx << " " << y - ry + 1 
-                  << endl;
+          coords << x - rx << " " << y 
+                 << " " << x      << " " << y + ry
+                 << " " << x + rx << " " << y 
+                 << " " << x + rx << " " << y - ry + 1 
+                 << " " << x - rx << " " << y - ry + 1;
           break;
 
         case vtkKWParameterValueFunctionEditor::PointStyleCursorUp:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x - rx << " " << y 
-                  << " " << x      << " " << y - ry
-                  << " " << x + rx << " " << y 
-                  << " " << x + rx << " " << y + ry - 1 
-                  << " " << x - rx << " " << y + ry - 1 
-                  << endl;
+          coords << x - rx << " " << y 
+                 << " " << x      << " " << y - ry
+                 << " " << x + rx << " " << y 
+                 << " " << x + rx << " " << y + ry - 1 
+                 << " " << x - rx << " " << y + ry - 1;
           break;
 
         case vtkKWParameterValueFunctionEditor::PointStyleCursorLeft:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x          << " " << y + ry
-                  << " " << x - rx     << " " << y
-                  << " " << x          << " " << y - ry
-                  << " " << x + rx - 1 << " " << y - ry 
-                  << " " << x + rx - 1 << " " << y + ry
-                  << endl;
+          coords << x          << " " << y + ry
+                 << " " << x - rx     << " " << y
+                 << " " << x          << " " << y - ry
+                 << " " << x + rx - 1 << " " << y - ry 
+                 << " " << x + rx - 1 << " " << y + ry;
           break;
 
         case vtkKWParameterValueFunctionEditor::PointStyleCursorRight:
-          *tk_cmd << canv << " coords p" << id 
-                  << " " << x          << " " << y + ry
-                  << " " << x + rx     << " " << y
-                  << " " << x          << " " << y - ry
-                  << " " << x - rx + 1 << " " << y - ry 
-                  << " " << x - rx + 1 << " " << y + ry
-                  << endl;
+          coords << x          << " " << y + ry
+                 << " " << x + rx     << " " << y
+                 << " " << x          << " " << y - ry
+                 << " " << x - rx + 1 << " " << y - ry 
+                 << " " << x - rx + 1 << " " << y + ry;
           break;
         }
 
-      *tk_cmd << canv << " itemconfigure p" << id 
-              << " -state normal  -width " << this->PointOutlineWidth << endl;
+      config << "-state normal -width " << this->PointOutlineWidth;
 
       // Update the point color
 
@@ -6119,28 +6657,33 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
         {
         sprintf(color, "#%02x%02x%02x", 
                 (int)(rgb[0]*255.0), (int)(rgb[1]*255.0), (int)(rgb[2]*255.0));
-        *tk_cmd << canv << " itemconfigure p" << id;
         if (this->PointColorStyle == 
             vtkKWParameterValueFunctionEditor::PointColorStyleFill)
           {
-          *tk_cmd << " -outline #000000 -fill " << color << endl;
+          config << " -outline #000000 -fill " << color;
           }
         else
           {
-          *tk_cmd << " -fill {} -outline " << color << endl;
+          config << " -fill {} -outline " << color;
           }
         }
+
+      vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+        this->Internals, tk_cmd, canv, "p", id, point, 
+        coords.str(), config.str());
       }
     }
 
   // Create and/or update the point guideline
 
-  int guide_exists = this->CanvasHasTag("g", &id);
+  Internals::CanvasItem &guide = 
+    this->Internals->GetCanvasItem(Internals::GuidelineItem, id);
   if (is_not_valid)
     {
-    if (guide_exists)
+    if (guide.Type.size())
       {
       *tk_cmd << canv << " delete g" << id << endl;
+      guide = Internals::CanvasItem();
       }
     }
   else
@@ -6149,14 +6692,15 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
         !this->PointGuidelineVisibility || 
         !this->CanvasVisibility)
       {
-      if (guide_exists)
+      if (guide.Type.size())
         {
-        *tk_cmd << canv << " itemconfigure g" << id << " -state hidden\n";
+        vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+          this->Internals, tk_cmd, canv, "g", id, guide, "", "-state hidden");
         }
       }
     else
       {
-      if (!guide_exists)
+      if (!guide.Type.size())
         {
         *tk_cmd << canv << " create line 0 0 0 0 -fill #000000 -width 1 " 
                 << " -tags {g" << id << " " 
@@ -6164,6 +6708,7 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
                 << " " << vtkKWParameterValueFunctionEditor::FunctionTag
                 << "}" << endl;
         *tk_cmd << canv << " lower g" << id << " p" << id << endl;
+        guide.Type = "line";
         }
   
       double factors[2] = {0.0, 0.0};
@@ -6171,19 +6716,15 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
       double *v_w_range = this->GetWholeValueRange();
       int y1 = vtkMath::Round(v_w_range[0] * factors[1]);
       int y2 = vtkMath::Round(v_w_range[1] * factors[1]);
-      *tk_cmd << canv << " coords g" << id << " "
-              << x << " " << y1 << " " << x << " " << y2 << endl;
-      *tk_cmd << canv << " itemconfigure g" << id;
-      if (this->PointGuidelineStyle == 
-          vtkKWParameterValueFunctionEditor::LineStyleDash)
-        {
-        *tk_cmd << " -dash {.}";
-        }
-      else
-        {
-        *tk_cmd << " -dash {}";
-        }
-      *tk_cmd << " -state normal" << endl;
+
+      vtksys_ios::ostringstream coords;
+      coords << x << " " << y1 << " " << x << " " << y2;
+
+      vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+        this->Internals, tk_cmd, canv, "g", id, guide, coords.str(), 
+        (this->PointGuidelineStyle == 
+         vtkKWParameterValueFunctionEditor::LineStyleDash)
+        ? "-dash {.} -state normal" : "-dash {} -state normal");
       }
     }
 
@@ -6191,13 +6732,48 @@ void vtkKWParameterValueFunctionEditor::RedrawPoint(int id,
 
   if (stream_was_created)
     {
-    this->Script(
+    this->ExecuteCanvasCommands(
       static_cast<vtksys_ios::ostringstream*>(tk_cmd)->str().c_str());
 
     delete tk_cmd;
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::ExecuteCanvasCommands(
+  const char *tk_cmd)
+{
+  // Move the items that exist already first, all at once, since their new
+  // coordinates were computed before the commands in the stream
+
+  vtksys_stl::vector<vtksys_stl::string> &pending = 
+    this->Internals->PendingCoords;
+  if (pending.size() && this->IsCreated())
+    {
+    Tcl_Obj *items = Tcl_NewListObj(0, NULL);
+    vtksys_stl::vector<vtksys_stl::string>::iterator it = pending.begin();
+    vtksys_stl::vector<vtksys_stl::string>::iterator end = pending.end();
+    for (; it != end; ++it)
+      {
+      Tcl_ListObjAppendElement(
+        NULL, items, Tcl_NewStringObj((*it).c_str(), -1));
+      }
+    vtkKWTkCommandArguments args;
+    args.AddString(this->Canvas->GetWidgetName());
+    args.AddObject(items);
+    vtkKWTkUtilities::EvaluateCommand(
+      this->GetApplication(), this, 
+      "vtkKWParameterValueFunctionEditorSetCoords", NULL, &args);
+    }
+  pending.clear();
+
+  if (tk_cmd && *tk_cmd)
+    {
+    this->Script(tk_cmd);
+    this->Internals->CanvasItemsGeneration++;
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkKWParameterValueFunctionEditor::FunctionLineIsInVisibleRangeBetweenPoints(
   int id1, int id2)
@@ -6280,12 +6856,15 @@ void vtkKWParameterValueFunctionEditor::RedrawLine(
   
   // Create the line item
   
-  int line_exists = this->CanvasHasTag("l", &id2);
+  typedef vtkKWParameterValueFunctionEditorInternals Internals;
+  Internals::CanvasItem &line = 
+    this->Internals->GetCanvasItem(Internals::LineItem, id2);
   if (is_not_valid)
     {
-    if (line_exists)
+    if (line.Type.size())
       {
       *tk_cmd << canv << " delete l" << id2 << endl;
+      line = Internals::CanvasItem();
       }
     }
   else
@@ -6296,12 +6875,13 @@ void vtkKWParameterValueFunctionEditor::RedrawLine(
 
     if (!this->FunctionLineVisibility || 
         !this->CanvasVisibility ||
+        this->PointLODActive ||
         !this->FunctionLineIsInVisibleRangeBetweenPoints(id1, id2))
       {
-      if (line_exists)
+      if (line.Type.size())
         {
-        //*tk_cmd << canv << " itemconfigure l" << id2 << " -state hidden\n";
         *tk_cmd << canv << " delete l" << id2 << endl;
+        line = Internals::CanvasItem();
         }
       }
     else
@@ -6309,7 +6889,7 @@ void vtkKWParameterValueFunctionEditor::RedrawLine(
       // Create the poly-line between the points
       // The line id is the id of the second end-point (id2)
   
-      if (!line_exists)
+      if (!line.Type.size())
         {
         *tk_cmd << canv << " create line 0 0 0 0 -fill #000000 " 
                 << " -tags {l" << id2 
@@ -6319,29 +6899,31 @@ void vtkKWParameterValueFunctionEditor::RedrawLine(
         *tk_cmd << canv << " lower l" << id2 
                 << " {p" << id1 << "||p" << id2 << "||m_p" << id1
                 << "}" << endl;
+        line.Type = "line";
         }
   
       // Get the point coords
       // Use either a straight line, or sample points
 
-      *tk_cmd << canv << " coords l" << id2;
-      this->GetLineCoordinates(id1, id2, tk_cmd);
-      *tk_cmd << endl;
+      vtksys_ios::ostringstream coords, config;
+      this->GetLineCoordinates(id1, id2, &coords);
 
       // Configure style
       
-      *tk_cmd << canv << " itemconfigure l" << id2 
-              << " -state normal -width " << this->FunctionLineWidth;
+      config << "-state normal -width " << this->FunctionLineWidth;
       if (this->FunctionLineStyle == 
           vtkKWParameterValueFunctionEditor::LineStyleDash)
         {
-        *tk_cmd << " -dash {.}";
+        config << " -dash {.}";
         }
       else
         {
-        *tk_cmd << " -dash {}";
+        config << " -dash {}";
         }
-      *tk_cmd << endl;
+
+      vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+        this->Internals, tk_cmd, canv, "l", id2, line, 
+        coords.str(), config.str());
       }
     }
   
@@ -6349,7 +6931,7 @@ void vtkKWParameterValueFunctionEditor::RedrawLine(
 
   if (stream_was_created)
     {
-    this->Script(
+    this->ExecuteCanvasCommands(
       static_cast<vtksys_ios::ostringstream*>(tk_cmd)->str().c_str());
 
     delete tk_cmd;
@@ -6370,34 +6952,51 @@ void vtkKWParameterValueFunctionEditor::GetLineCoordinates(
 
   *tk_cmd << " " << x1 << " " << y1;
 
-  if (this->FunctionLineIsSampledBetweenPoints(id1, id2))
-    {
-    double id1_p, id2_p;
-    if (this->GetFunctionPointParameter(id1, &id1_p) &&
-        this->GetFunctionPointParameter(id2, &id2_p))
-      {
-      // we want segments no longer than 2 pixels
-      // Also, check that we do not exceed, say 2000 pixels total, that
-      // would be a flag that something not reasonable is happenin, i.e.
-      // a function has just been set but the visible does not match
-      // at all and extreme zooming is happening before the user had the
-      // time to reset the range.
-
-      int max_segment_length = 2;
-          
-      int x, y;
-      int nb_steps = 
-        (int)ceil((double)(x2 - x1) / (double)max_segment_length);
-      if (nb_steps > 1000)
-        {
-        nb_steps = 1000;
-        }
-      for (int i = 1; i < nb_steps; i++)
+  // Sampling only makes sense if the vertical position of the points
+  // follows their (mono-dimensional) value
+
+  double id1_p, id2_p;
+  if (this->PointPositionInValueRange == 
+      vtkKWParameterValueFunctionEditor::PointPositionValue &&
+      this->GetFunctionPointDimensionality() == 1 &&
+      this->FunctionLineIsSampledBetweenPoints(id1, id2) &&
+      this->GetFunctionPointParameter(id1, &id1_p) &&
+      this->GetFunctionPointParameter(id2, &id2_p))
+    {
+    // We want segments no longer than 2 pixels, but only over the visible
+    // part of the line: the number of samples follows the zoom level,
+    // and is bounded by the width of the canvas, however far the end-points
+    // are outside of it.
+
+    double factors[2] = {0.0, 0.0};
+    this->GetCanvasScalingFactors(factors);
+
+    double *p_v_range = this->GetVisibleParameterRange();
+    double p1 = id1_p > p_v_range[0] ? id1_p : p_v_range[0];
+    double p2 = id2_p < p_v_range[1] ? id2_p : p_v_range[1];
+
+    int max_segment_length = 2;
+    int nb_samples = 
+      (int)ceil((p2 - p1) * factors[0] / (double)max_segment_length) + 1;
+    if (p2 > p1 && nb_samples > 2)
+      {
+      // Evaluate all the samples in one pass, then map them to the canvas
+
+      vtksys_stl::vector<double> values(nb_samples);
+      if (this->InterpolateFunctionPointValuesInRange(
+            p1, p2, nb_samples, &values[0]))
         {
-        double p = id1_p + (id2_p - id1_p)*((double)i / (double)nb_steps);
-        if (this->GetFunctionPointCanvasCoordinatesAtParameter(p, &x, &y))
+        double v_w_max = this->GetWholeValueRange()[1];
+        double step = (p2 - p1) / (double)(nb_samples - 1);
+
+        // Do not repeat the end-points
+
+        int first = (p1 == id1_p) ? 1 : 0;
+        int last = (p2 == id2_p) ? nb_samples - 2 : nb_samples - 1;
+        for (int i = first; i <= last; i++)
           {
-          *tk_cmd << " " << x << " " << y;
+          *tk_cmd << " " << vtkMath::Round((p1 + step * i) * factors[0])
+                  << " " << vtkMath::Round((v_w_max - values[i]) * factors[1]);
           }
         }
       }
@@ -6406,6 +7005,29 @@ void vtkKWParameterValueFunctionEditor::GetLineCoordinates(
   *tk_cmd << " " << x2 << " " << y2;
 }
 
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::InterpolateFunctionPointValuesInRange(
+  double p1, double p2, int nb_samples, double *values)
+{
+  if (!this->HasFunction() || !values || nb_samples < 1)
+    {
+    return 0;
+    }
+
+  int dim = this->GetFunctionPointDimensionality();
+  double step = nb_samples > 1 ? (p2 - p1) / (double)(nb_samples - 1) : 0.0;
+  for (int i = 0; i < nb_samples; i++)
+    {
+    if (!this->InterpolateFunctionPointValues(
+          p1 + step * (double)i, values + i * dim))
+      {
+      return 0;
+      }
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::RedrawFunction()
 {
@@ -6424,6 +7046,7 @@ void vtkKWParameterValueFunctionEditor::RedrawFunction()
   if (!this->HasFunction() || !this->GetFunctionSize())
     {
     this->CanvasRemoveTag(vtkKWParameterValueFunctionEditor::FunctionTag);
+    this->PointLODActive = 0;
     return;
     }
 
@@ -6432,6 +7055,14 @@ void vtkKWParameterValueFunctionEditor::RedrawFunction()
   int nb_points_changed = 
     (this->LastRedrawFunctionSize != this->GetFunctionSize());
 
+  // The ids of the points selected along with SelectedPoint do not mean
+  // much anymore if points were added or removed
+
+  if (nb_points_changed)
+    {
+    this->Internals->ExtraSelectedPoints.clear();
+    }
+
   // Try to save the selection before (eventually) creating new points
 
   int s_x = 0, s_y = 0;
@@ -6443,6 +7074,21 @@ void vtkKWParameterValueFunctionEditor::RedrawFunction()
     this->GetCanvasItemCenter(item_id, &s_x, &s_y);
     }
 
+  // Switch to/from level-of-detail mode. Switching to LOD purges all the
+  // individual items at once, the loop below will then only draw the 
+  // selected point.
+
+  int lod = this->FunctionPointsNeedLOD();
+  if (lod && !this->PointLODActive)
+    {
+    this->CanvasRemoveTag(vtkKWParameterValueFunctionEditor::FunctionTag);
+    }
+  else if (!lod && this->PointLODActive)
+    {
+    this->CanvasRemoveTag(vtkKWParameterValueFunctionEditor::FunctionLODTag);
+    }
+  this->PointLODActive = lod;
+
   // Create the points 
   
   vtksys_ios::ostringstream tk_cmd;
@@ -6466,9 +7112,24 @@ void vtkKWParameterValueFunctionEditor::RedrawFunction()
       }
     }
 
-  // Execute all of this
+  if (this->PointLODActive)
+    {
+    this->RedrawFunctionLOD(&tk_cmd);
+    if (this->HasSelection())
+      {
+      tk_cmd << canv << " addtag " 
+             << vtkKWParameterValueFunctionEditor::SelectedTag 
+             << " withtag p" <<  this->GetSelectedPoint() << endl;
+      tk_cmd << canv << " addtag " 
+             << vtkKWParameterValueFunctionEditor::SelectedTag 
+             << " withtag t" <<  this->GetSelectedPoint() << endl;
+      }
+    }
+
+  // Execute all of this (only the items that changed were sent to the 
+  // stream)
 
-  this->Script(tk_cmd.str().c_str());
+  this->ExecuteCanvasCommands(tk_cmd.str().c_str());
 
   this->LastRedrawFunctionSize = this->GetFunctionSize();
   this->LastRedrawFunctionTime = this->GetFunctionMTime();
@@ -6490,6 +7151,219 @@ void vtkKWParameterValueFunctionEditor::RedrawFunction()
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::FunctionPointsNeedLOD()
+{
+  if (this->PointLODThreshold <= 0 || 
+      !this->IsCreated() || 
+      !this->HasFunction() ||
+      this->GetFunctionSize() <= this->PointLODThreshold)
+    {
+    return 0;
+    }
+
+  double c_x1, c_y1, c_x2, c_y2;
+  this->GetCanvasScrollRegion(&c_x1, &c_y1, &c_x2, &c_y2);
+
+  // Points are sorted along x, count the points in each visible column
+
+  int size = this->GetFunctionSize();
+  int x, y, col_x = 0, count = 0;
+  for (int i = 0; i < size; i++)
+    {
+    if (!this->GetFunctionPointCanvasCoordinates(i, &x, &y) ||
+        x < c_x1 || x > c_x2)
+      {
+      continue;
+      }
+    if (count && x == col_x)
+      {
+      if (++count > this->PointLODThreshold)
+        {
+        return 1;
+        }
+      }
+    else
+      {
+      col_x = x;
+      count = 1;
+      }
+    }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Write the coordinates of a pixel column of the LOD polyline: first point,
+// lowest and highest points (in the order closest to the first point),
+// and last point, skipping consecutive duplicates.
+static void vtkKWParameterValueFunctionEditorWriteLODColumn(
+  vtksys_ios::ostream &os, 
+  int x, int y_first, int y_min, int y_max, int y_last,
+  int *nb_points)
+{
+  int ys[4];
+  ys[0] = y_first;
+  if (y_first - y_min < y_max - y_first)
+    {
+    ys[1] = y_min;
+    ys[2] = y_max;
+    }
+  else
+    {
+    ys[1] = y_max;
+    ys[2] = y_min;
+    }
+  ys[3] = y_last;
+  for (int k = 0; k < 4; k++)
+    {
+    if (!k || ys[k] != ys[k - 1])
+      {
+      os << " " << x << " " << ys[k];
+      (*nb_points)++;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::RedrawFunctionLOD(
+  vtksys_ios::ostream *tk_cmd)
+{
+  if (!this->IsCreated() || !this->HasFunction() || this->DisableRedraw)
+    {
+    return;
+    }
+
+  const char *canv = this->Canvas->GetWidgetName();
+
+  vtkKWParameterValueFunctionEditorInternals::CanvasItem &lod = 
+    this->Internals->LODItem;
+
+  // Walk the points column by column. Only the visible columns are drawn, 
+  // along with the closest column on each side so that the polyline 
+  // reaches the edges of the canvas. The polyline stands for the function
+  // line, it follows the same visibility and style rules (see RedrawLine).
+
+  vtksys_ios::ostringstream coords;
+  int nb_points = 0;
+
+  if (this->PointLODActive && 
+      this->CanvasVisibility &&
+      this->FunctionLineVisibility)
+    {
+    double c_x1, c_y1, c_x2, c_y2;
+    this->GetCanvasScrollRegion(&c_x1, &c_y1, &c_x2, &c_y2);
+
+    int size = this->GetFunctionSize();
+    int col[5] = { 0, 0, 0, 0, 0 }, before[5] = { 0, 0, 0, 0, 0 };
+    int in_col = 0, has_before = 0, done = 0;
+    for (int i = 0; i <= size && !done; i++)
+      {
+      int x = 0, y = 0;
+      int valid = 
+        (i < size && this->GetFunctionPointCanvasCoordinates(i, &x, &y));
+      if (in_col && (!valid || x != col[0]))
+        {
+        if (col[0] < c_x1)
+          {
+          memcpy(before, col, sizeof(col));
+          has_before = 1;
+          }
+        else
+          {
+          if (has_before)
+            {
+            vtkKWParameterValueFunctionEditorWriteLODColumn(
+              coords, before[0], before[1], before[2], before[3], before[4],
+              &nb_points);
+            has_before = 0;
+            }
+          vtkKWParameterValueFunctionEditorWriteLODColumn(
+            coords, col[0], col[1], col[2], col[3], col[4], &nb_points);
+          done = (col[0] > c_x2);
+          }
+        in_col = 0;
+        }
+      if (valid)
+        {
+        if (!in_col)
+          {
+          col[0] = x;
+          col[1] = col[2] = col[3] = col[4] = y;
+          in_col = 1;
+          }
+        else
+          {
+          if (y < col[2])
+            {
+            col[2] = y;
+            }
+          if (y > col[3])
+            {
+            col[3] = y;
+            }
+          col[4] = y;
+          }
+        }
+      }
+    if (has_before)
+      {
+      vtkKWParameterValueFunctionEditorWriteLODColumn(
+        coords, before[0], before[1], before[2], before[3], before[4],
+        &nb_points);
+      }
+    }
+
+  // Nothing to draw
+
+  if (!nb_points)
+    {
+    if (lod.Type.size())
+      {
+      *tk_cmd << canv << " delete " 
+              << vtkKWParameterValueFunctionEditor::FunctionLODTag << endl;
+      lod = vtkKWParameterValueFunctionEditorInternals::CanvasItem();
+      }
+    return;
+    }
+
+  // A line needs two points at least
+
+  if (nb_points == 1)
+    {
+    coords << coords.str();
+    }
+
+  if (!lod.Type.size())
+    {
+    *tk_cmd << canv << " create line 0 0 0 0 -fill #000000 -tags {" 
+            << vtkKWParameterValueFunctionEditor::FunctionLODTag
+            << " " << vtkKWParameterValueFunctionEditor::FunctionTag 
+            << "}" << endl;
+    *tk_cmd << "catch {" << canv << " lower " 
+            << vtkKWParameterValueFunctionEditor::FunctionLODTag << " " 
+            << vtkKWParameterValueFunctionEditor::PointTag << "}" << endl;
+    lod.Type = "line";
+    }
+
+  vtksys_ios::ostringstream config;
+  config << "-state normal -width " << this->FunctionLineWidth;
+  if (this->FunctionLineStyle == 
+      vtkKWParameterValueFunctionEditor::LineStyleDash)
+    {
+    config << " -dash {.}";
+    }
+  else
+    {
+    config << " -dash {}";
+    }
+
+  vtkKWParameterValueFunctionEditorUpdateCanvasItem(
+    this->Internals, tk_cmd, canv, 
+    vtkKWParameterValueFunctionEditor::FunctionLODTag, -1, 
+    lod, coords.str(), config.str());
+}
+
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::UpdateHistogramImageDescriptor(
   vtkKWHistogram::ImageDescriptor *desc)
@@ -6523,6 +7397,9 @@ void vtkKWParameterValueFunctionEditor::RedrawHistogram()
     return;
     }
 
+  this->Internals->RedrawnElements |= 
+    vtkKWParameterValueFunctionEditor::ScheduledRedrawHistogram;
+
   const char *canv = this->Canvas->GetWidgetName();
 
   // Main histogram descriptor
@@ -6927,12 +7804,23 @@ int vtkKWParameterValueFunctionEditor::HasSelection()
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::SelectPoint(int id)
 {
-  if (!this->HasFunction() || id < 0 || id >= this->GetFunctionSize() ||
-      this->GetSelectedPoint() == id)
+  if (!this->HasFunction() || id < 0 || id >= this->GetFunctionSize())
     {
     return;
     }
 
+  // Selecting the point that is already selected only reduces the
+  // selection to that point
+
+  if (this->GetSelectedPoint() == id)
+    {
+    if (this->ClearExtraSelection())
+      {
+      this->InvokeSelectionChangedCommand();
+      }
+    return;
+    }
+
   // First deselect any selection
 
   this->ClearSelection();
@@ -6999,9 +7887,10 @@ void vtkKWParameterValueFunctionEditor::ClearSelection()
   int old_selection = this->GetSelectedPoint();
   this->SelectedPoint = -1;
 
-  // Redraw the point that used to be selected and update its aspect
+  // Redraw the point(s) that used to be selected and update their aspect
 
   this->RedrawSinglePointDependentElements(old_selection);
+  this->ClearExtraSelection();
 
   // Show the selected point description in the point label
   // Since nothing is selected, the expected side effect is to clear the
@@ -7013,6 +7902,34 @@ void vtkKWParameterValueFunctionEditor::ClearSelection()
   this->InvokeSelectionChangedCommand();
 }
 
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::ClearExtraSelection()
+{
+  if (!this->Internals->ExtraSelectedPoints.size())
+    {
+    return 0;
+    }
+
+  vtksys_stl::set<int> old_extra_selection;
+  old_extra_selection.swap(this->Internals->ExtraSelectedPoints);
+
+  // Redraw the points that used to be selected
+
+  if (this->IsCreated())
+    {
+    vtksys_ios::ostringstream tk_cmd;
+    vtksys_stl::set<int>::iterator it = old_extra_selection.begin();
+    vtksys_stl::set<int>::iterator end = old_extra_selection.end();
+    for (; it != end; ++it)
+      {
+      this->RedrawPoint(*it, &tk_cmd);
+      }
+    this->ExecuteCanvasCommands(tk_cmd.str().c_str());
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::SelectNextPoint()
 {
@@ -7045,6 +7962,81 @@ void vtkKWParameterValueFunctionEditor::SelectLastPoint()
   this->SelectPoint(this->GetFunctionSize() - 1);
 }
 
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::SelectPointsInCanvasRectangle(
+  int x1, int y1, int x2, int y2)
+{
+  vtkIntArray *ids = vtkIntArray::New();
+  int nb_ids = this->FindPointsInCanvasRectangle(x1, y1, x2, y2, ids);
+
+  // First deselect any selection
+
+  this->ClearSelection();
+
+  // The first point found becomes the selected point, the others are
+  // added to the selection (and redrawn accordingly)
+
+  if (nb_ids)
+    {
+    vtksys_ios::ostringstream tk_cmd;
+    for (int i = 1; i < nb_ids; i++)
+      {
+      this->Internals->ExtraSelectedPoints.insert(ids->GetValue(i));
+      this->RedrawPoint(ids->GetValue(i), &tk_cmd);
+      }
+    this->ExecuteCanvasCommands(tk_cmd.str().c_str());
+    this->SelectPoint(ids->GetValue(0));
+    }
+
+  ids->Delete();
+
+  return nb_ids;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::IsPointSelected(int id)
+{
+  return (id >= 0 && 
+          (id == this->GetSelectedPoint() || 
+           this->Internals->ExtraSelectedPoints.find(id) != 
+           this->Internals->ExtraSelectedPoints.end()));
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::GetNumberOfSelectedPoints()
+{
+  if (!this->HasSelection())
+    {
+    return 0;
+    }
+
+  return 1 + (int)this->Internals->ExtraSelectedPoints.size();
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::GetNthSelectedPoint(int n)
+{
+  if (n < 0 || n >= this->GetNumberOfSelectedPoints())
+    {
+    return -1;
+    }
+
+  // SelectedPoint comes first, then the other points by increasing id
+
+  if (n == 0)
+    {
+    return this->GetSelectedPoint();
+    }
+
+  vtksys_stl::set<int>::iterator it = 
+    this->Internals->ExtraSelectedPoints.begin();
+  while (--n)
+    {
+    ++it;
+    }
+  return *it;
+}
+
 //----------------------------------------------------------------------------
 int vtkKWParameterValueFunctionEditor::RemoveSelectedPoint()
 {
@@ -7053,7 +8045,29 @@ int vtkKWParameterValueFunctionEditor::RemoveSelectedPoint()
     return 0;
     }
 
-  return this->RemovePoint(this->GetSelectedPoint());
+  if (!this->Internals->ExtraSelectedPoints.size())
+    {
+    return this->RemovePoint(this->GetSelectedPoint());
+    }
+
+  // Several points are selected, remove them all, starting from the last
+  // one so that the ids of the points left to remove do not change
+
+  vtksys_stl::vector<int> ids(
+    this->Internals->ExtraSelectedPoints.begin(),
+    this->Internals->ExtraSelectedPoints.end());
+  ids.push_back(this->GetSelectedPoint());
+  vtksys_stl::sort(ids.begin(), ids.end());
+
+  this->ClearSelection();
+
+  int nb_removed = 0;
+  for (int i = (int)ids.size() - 1; i >= 0; i--)
+    {
+    nb_removed += this->RemovePoint(ids[i]);
+    }
+
+  return nb_removed;
 }
 
 //----------------------------------------------------------------------------
@@ -7144,26 +8158,143 @@ int vtkKWParameterValueFunctionEditor::AddPointAtCanvasCoordinates(
 int vtkKWParameterValueFunctionEditor::AddPointAtParameter(
   double parameter, int *id)
 {
-  if (!this->AddFunctionPointAtParameter(parameter, id))
+  if (!this->AddFunctionPointAtParameter(parameter, id))
+    {
+    return 0;
+    }
+
+  // Draw the points (or all the points if the index have changed)
+
+  this->RedrawFunctionDependentElements();
+
+  // If we the point was inserted before the selection, shift the selection
+
+  if (this->HasSelection() && *id <= this->GetSelectedPoint())
+    {
+    this->SelectPoint(this->GetSelectedPoint() + 1);
+    }
+
+  this->InvokePointAddedCommand(*id);
+  this->InvokeFunctionChangedCommand();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::MovePointToParameter(
+  int id, double parameter)
+{
+  if (!this->MoveFunctionPointToParameter(id, parameter))
+    {
+    return 0;
+    }
+
+  this->InvokePointChangedCommand(id);
+  this->InvokeFunctionChangedCommand();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::BeginEditTransaction()
+{
+  vtkKWParameterValueFunctionEditorInternals *internals = this->Internals;
+
+  if (internals->EditTransactionDepth++)
+    {
+    return;
+    }
+
+  // Catch up with what was pending before the transaction
+
+  this->ProcessScheduledRedraws();
+
+  internals->EditTransactionSelectedPoint = this->GetSelectedPoint();
+  internals->EditTransactionFunctionTime = 
+    this->HasFunction() ? this->GetFunctionMTime() : 0;
+  internals->EditTransactionFunctionModified = 0;
+
+  // Set DisableRedraw directly, the editor is not really modified
+
+  internals->EditTransactionDisableRedraw = this->DisableRedraw;
+  this->DisableRedraw = 1;
+
+  internals->EditTransactionTime = this->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::EndEditTransaction()
+{
+  vtkKWParameterValueFunctionEditorInternals *internals = this->Internals;
+
+  if (!internals->EditTransactionDepth || --internals->EditTransactionDepth)
+    {
+    return;
+    }
+
+  this->DisableRedraw = internals->EditTransactionDisableRedraw;
+
+  int function_changed = internals->EditTransactionFunctionModified ||
+    (this->HasFunction() &&
+     this->GetFunctionMTime() > internals->EditTransactionFunctionTime);
+
+  // Redraw what was requested during the transaction, the function if it
+  // was modified, everything if the editor itself was
+
+  if (this->GetMTime() > internals->EditTransactionTime)
+    {
+    internals->ScheduledElements |= 
+      vtkKWParameterValueFunctionEditor::ScheduledRedrawAll;
+    }
+  if (function_changed)
+    {
+    internals->ScheduledElements |= 
+      vtkKWParameterValueFunctionEditor::ScheduledRedrawFunction;
+    }
+
+  this->ProcessScheduledRedraws();
+
+  // Invoke the commands/callbacks
+
+  if (this->GetSelectedPoint() != internals->EditTransactionSelectedPoint)
+    {
+    this->InvokeSelectionChangedCommand();
+    }
+
+  if (function_changed)
+    {
+    this->InvokeFunctionChangedCommand();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::IsInEditTransaction()
+{
+  return this->Internals->EditTransactionDepth ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::ResetEditTransactionFunctionTime()
+{
+  vtkKWParameterValueFunctionEditorInternals *internals = this->Internals;
+
+  if (!internals->EditTransactionDepth)
     {
-    return 0;
+    return;
     }
 
-  // Draw the points (or all the points if the index have changed)
-
-  this->RedrawFunctionDependentElements();
-
-  // If we the point was inserted before the selection, shift the selection
+  // Remember if the previous function was modified before being replaced,
+  // then only consider the modifications made from now on
 
-  if (this->HasSelection() && *id <= this->GetSelectedPoint())
+  if (this->HasFunction() &&
+      this->GetFunctionMTime() > internals->EditTransactionFunctionTime)
     {
-    this->SelectPoint(this->GetSelectedPoint() + 1);
+    internals->EditTransactionFunctionModified = 1;
     }
 
-  this->InvokePointAddedCommand(*id);
-  this->InvokeFunctionChangedCommand();
-
-  return 1;
+  vtkTimeStamp now;
+  now.Modified();
+  internals->EditTransactionFunctionTime = now.GetMTime();
 }
 
 //----------------------------------------------------------------------------
@@ -7271,6 +8402,11 @@ void vtkKWParameterValueFunctionEditor::CanvasRemoveTag(const char *tag,
     canv_name = this->Canvas->GetWidgetName();
     }
 
+  if (!strcmp(canv_name, this->Canvas->GetWidgetName()))
+    {
+    this->Internals->RemoveCanvasItems(tag);
+    }
+
   this->Script("%s delete %s", canv_name, tag);
 }
 
@@ -7289,6 +8425,11 @@ void vtkKWParameterValueFunctionEditor::CanvasRemoveTag(const char *prefix,
     canv_name = this->Canvas->GetWidgetName();
     }
 
+  if (!strcmp(canv_name, this->Canvas->GetWidgetName()))
+    {
+    this->Internals->RemoveCanvasItem(prefix, id);
+    }
+
   this->Script("%s delete %s%d", canv_name, prefix, id);
 }
 
@@ -7938,7 +9079,11 @@ void vtkKWParameterValueFunctionEditor::VisibleParameterRangeChangingCallback(
   double, double)
 {
   this->UpdateRangeLabel();
-  this->Redraw();
+  if (!this->ScheduleRedraw(
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawAll))
+    {
+    this->Redraw();
+    }
 
   this->InvokeVisibleRangeChangingCommand();
 
@@ -7964,7 +9109,11 @@ void vtkKWParameterValueFunctionEditor::VisibleValueRangeChangingCallback(
   double, double)
 {
   this->UpdateRangeLabel();
-  this->Redraw();
+  if (!this->ScheduleRedraw(
+        vtkKWParameterValueFunctionEditor::ScheduledRedrawAll))
+    {
+    this->Redraw();
+    }
 
   this->InvokeVisibleRangeChangingCommand();
 
@@ -8062,27 +9211,369 @@ int vtkKWParameterValueFunctionEditor::FindFunctionPointAtCanvasCoordinates(
     return 0;
     }
 
-  char item[256];
-  if (!this->FindClosestItemWithTagAtCanvasCoordinates(
-        x, y, 3, vtkKWParameterValueFunctionEditor::PointTag, c_x, c_y, item))
+  const char *canv = this->Canvas->GetWidgetName();
+
+  // If we are out of the canvas, clamp the coordinates
+
+  if (x < 0)
+    {
+    x = 0;
+    }
+  else if (x > this->CurrentCanvasWidth - 1)
+    {
+    x = this->CurrentCanvasWidth - 1;
+    }
+
+  if (y < 0)
+    {
+    y = 0;
+    }
+  else if (y > this->CurrentCanvasHeight - 1)
+    {
+    y = this->CurrentCanvasHeight - 1;
+    }
+
+  // Get the real canvas coordinates
+
+  *c_x = atoi(this->Script("%s canvasx %d", canv, x));
+  *c_y = atoi(this->Script("%s canvasy %d", canv, y));
+
+  *id = -1;
+
+  // Hidden points can not be picked (hidden canvas items can not either)
+
+  if (!this->PointVisibility || !this->CanvasVisibility)
+    {
+    return 0;
+    }
+
+  // Find the closest point overlapping the coordinates (within a small
+  // halo). This is computed from the points index instead of the canvas
+  // items, so that it works whether or not the points are drawn
+  // individually (see PointLODThreshold). Points are sorted along x, 
+  // bisect to the first one that can overlap.
+
+  int halo = 3;
+  int margin = (this->PointOutlineWidth + 1) / 2 + halo;
+  double sel_factor = 
+    (this->SelectedPointRadius > 1.0 ? this->SelectedPointRadius : 1.0);
+  int reach_x = (int)ceil((double)this->PointRadiusX * sel_factor) + margin;
+
+  int size = this->UpdateFunctionPointsIndex();
+  const vtksys_stl::vector<int> &points_x = this->Internals->PointsX;
+  const vtksys_stl::vector<int> &points_y = this->Internals->PointsY;
+
+  int i = (int)(vtksys_stl::lower_bound(
+                  points_x.begin(), points_x.end(), *c_x - reach_x) - 
+                points_x.begin());
+
+  int best_dist2 = 0;
+  for (; i < size && points_x[i] <= *c_x + reach_x; i++)
+    {
+    int p_x = points_x[i], p_y = points_y[i];
+    int rx = this->PointRadiusX, ry = this->PointRadiusY;
+    if (i == this->GetSelectedPoint())
+      {
+      rx = (int)ceil((double)rx * this->SelectedPointRadius);
+      ry = (int)ceil((double)ry * this->SelectedPointRadius);
+      }
+    int dx = p_x - *c_x, dy = p_y - *c_y;
+    if (abs(dx) <= rx + margin && abs(dy) <= ry + margin)
+      {
+      int dist2 = dx * dx + dy * dy;
+      if (*id < 0 || dist2 < best_dist2)
+        {
+        *id = i;
+        best_dist2 = dist2;
+        }
+      }
+    }
+
+  return (*id < 0) ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::FindPointClosestToCanvasCoordinates(
+  int x, int y, int *id)
+{
+  int size = this->UpdateFunctionPointsIndex();
+  if (!size || !id)
     {
     return 0;
     }
 
+  const vtksys_stl::vector<int> &points_x = this->Internals->PointsX;
+  const vtksys_stl::vector<int> &points_y = this->Internals->PointsY;
+
+  // Bisect to the first point at or after x, then walk both ways until
+  // the horizontal distance alone is larger than the closest distance
+
+  int next = (int)(vtksys_stl::lower_bound(
+                     points_x.begin(), points_x.end(), x) - points_x.begin());
+  int prev = next - 1;
+
   *id = -1;
+  double best_dist2 = 0.0;
+  while (prev >= 0 || next < size)
+    {
+    int candidates[2] = { prev, next };
+    for (int c = 0; c < 2; c++)
+      {
+      int i = candidates[c];
+      if (i < 0 || i >= size)
+        {
+        continue;
+        }
+      double dx = (double)(points_x[i] - x);
+      if (*id >= 0 && dx * dx > best_dist2)
+        {
+        if (c == 0)
+          {
+          prev = -1;
+          }
+        else
+          {
+          next = size;
+          }
+        continue;
+        }
+      double dy = (double)(points_y[i] - y);
+      double dist2 = dx * dx + dy * dy;
+      if (*id < 0 || dist2 < best_dist2)
+        {
+        *id = i;
+        best_dist2 = dist2;
+        }
+      }
+    if (prev >= 0)
+      {
+      prev--;
+      }
+    if (next < size)
+      {
+      next++;
+      }
+    }
+
+  return (*id < 0) ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::FindPointsInCanvasRectangle(
+  int x1, int y1, int x2, int y2, vtkIntArray *ids)
+{
+  if (!ids)
+    {
+    return 0;
+    }
+
+  ids->Reset();
+
+  if (x1 > x2)
+    {
+    int temp = x1;
+    x1 = x2;
+    x2 = temp;
+    }
+  if (y1 > y2)
+    {
+    int temp = y1;
+    y1 = y2;
+    y2 = temp;
+    }
 
-  // Get its first tag, which should be a point tag (in
-  // the form of ppid or tpid, ex: p0 or t1)
+  int size = this->UpdateFunctionPointsIndex();
+  const vtksys_stl::vector<int> &points_x = this->Internals->PointsX;
+  const vtksys_stl::vector<int> &points_y = this->Internals->PointsY;
+
+  int i = (int)(vtksys_stl::lower_bound(
+                  points_x.begin(), points_x.end(), x1) - points_x.begin());
+  for (; i < size && points_x[i] <= x2; i++)
+    {
+    if (points_y[i] >= y1 && points_y[i] <= y2)
+      {
+      ids->InsertNextValue(i);
+      }
+    }
+
+  return (int)ids->GetNumberOfTuples();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::GetFunctionPointsIndexKey(
+  double key[8])
+{
+  double factors[2] = {0.0, 0.0};
+  this->GetCanvasScalingFactors(factors);
+
+  double *v_w_range = this->GetWholeValueRange();
+  double *v_v_range = this->GetVisibleValueRange();
+
+  key[0] = (double)this->GetFunctionMTime();
+  key[1] = (double)this->GetMTime();
+  key[2] = factors[0];
+  key[3] = factors[1];
+  key[4] = v_w_range[0];
+  key[5] = v_w_range[1];
+  key[6] = v_v_range[0];
+  key[7] = v_v_range[1];
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::FunctionPointsIndexIsUpToDate()
+{
+  if (!this->Internals->PointsIndexValid || 
+      !this->IsCreated() || 
+      !this->HasFunction() ||
+      (int)this->Internals->PointsX.size() != this->GetFunctionSize())
+    {
+    return 0;
+    }
+
+  double key[8];
+  this->GetFunctionPointsIndexKey(key);
+  for (int i = 0; i < 8; i++)
+    {
+    if (key[i] != this->Internals->PointsIndexKey[i])
+      {
+      return 0;
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWParameterValueFunctionEditor::UpdateFunctionPointsIndex()
+{
+  if (this->FunctionPointsIndexIsUpToDate())
+    {
+    return (int)this->Internals->PointsX.size();
+    }
+
+  this->Internals->PointsIndexValid = 0;
+  this->Internals->PointsX.clear();
+  this->Internals->PointsY.clear();
+
+  if (!this->IsCreated() || !this->HasFunction())
+    {
+    return 0;
+    }
+
+  int size = this->GetFunctionSize();
+  this->Internals->PointsX.resize(size);
+  this->Internals->PointsY.resize(size);
+  for (int i = 0; i < size; i++)
+    {
+    if (!this->GetFunctionPointCanvasCoordinates(
+          i, &this->Internals->PointsX[i], &this->Internals->PointsY[i]))
+      {
+      this->Internals->PointsX.clear();
+      this->Internals->PointsY.clear();
+      return 0;
+      }
+    }
+
+  this->GetFunctionPointsIndexKey(this->Internals->PointsIndexKey);
+  this->Internals->PointsIndexValid = 1;
+
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::UpdateFunctionPointInIndex(int id)
+{
+  if (!this->Internals->PointsIndexValid)
+    {
+    return;
+    }
+
+  // The point keeps its place among the others (points can not be moved
+  // beyond their neighbors), only its coordinates need to be updated
+
+  int x, y;
+  if (id < 0 || 
+      id >= (int)this->Internals->PointsX.size() ||
+      (int)this->Internals->PointsX.size() != this->GetFunctionSize() ||
+      !this->GetFunctionPointCanvasCoordinates(id, &x, &y))
+    {
+    this->Internals->PointsIndexValid = 0;
+    return;
+    }
+
+  this->Internals->PointsX[id] = x;
+  this->Internals->PointsY[id] = y;
+  this->GetFunctionPointsIndexKey(this->Internals->PointsIndexKey);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::StartSelectionRectangle(
+  int c_x, int c_y)
+{
+  if (!this->IsCreated())
+    {
+    return;
+    }
+
+  this->Internals->SelectionRectangleActive = 1;
+  this->Internals->SelectionRectangle[0] = 
+    this->Internals->SelectionRectangle[2] = c_x;
+  this->Internals->SelectionRectangle[1] = 
+    this->Internals->SelectionRectangle[3] = c_y;
 
   const char *canv = this->Canvas->GetWidgetName();
-  const char *tag = 
-    this->Script("lindex [%s itemcget %s -tags] 0", canv, item);
-  if (tag && *tag && (tag[0] == 't' || tag[0] == 'p') && isdigit(tag[1]))
+
+  vtksys_ios::ostringstream tk_cmd;
+
+  tk_cmd << canv << " delete " 
+         << vtkKWParameterValueFunctionEditor::SelectionRectangleTag << endl;
+  tk_cmd << canv << " create rectangle " 
+         << c_x << " " << c_y << " " << c_x << " " << c_y 
+         << " -outline black -dash {2 2} -tags {"
+         << vtkKWParameterValueFunctionEditor::SelectionRectangleTag << "}"
+         << endl;
+
+  this->Script(tk_cmd.str().c_str());
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::UpdateSelectionRectangle(
+  int c_x, int c_y)
+{
+  if (!this->IsCreated() || !this->Internals->SelectionRectangleActive)
+    {
+    return;
+    }
+
+  this->Internals->SelectionRectangle[2] = c_x;
+  this->Internals->SelectionRectangle[3] = c_y;
+
+  this->Script("%s coords %s %d %d %d %d", 
+               this->Canvas->GetWidgetName(), 
+               vtkKWParameterValueFunctionEditor::SelectionRectangleTag,
+               this->Internals->SelectionRectangle[0],
+               this->Internals->SelectionRectangle[1],
+               this->Internals->SelectionRectangle[2],
+               this->Internals->SelectionRectangle[3]);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::EndSelectionRectangle()
+{
+  if (!this->Internals->SelectionRectangleActive)
     {
-    *id = atoi(tag + 1);
+    return;
     }
 
-  return (*id < 0 || *id >= this->GetFunctionSize()) ? 0 : 1;
+  this->Internals->SelectionRectangleActive = 0;
+
+  this->CanvasRemoveTag(
+    vtkKWParameterValueFunctionEditor::SelectionRectangleTag);
+
+  this->SelectPointsInCanvasRectangle(this->Internals->SelectionRectangle[0],
+                                      this->Internals->SelectionRectangle[1],
+                                      this->Internals->SelectionRectangle[2],
+                                      this->Internals->SelectionRectangle[3]);
 }
 
 //----------------------------------------------------------------------------
@@ -8124,6 +9615,16 @@ void vtkKWParameterValueFunctionEditor::StartInteractionCallback(
 {
   int id, c_x, c_y;
 
+  // Drop any rubber-band selection that did not get its end event, so that
+  // this interaction is not mistaken for it
+
+  if (this->Internals->SelectionRectangleActive)
+    {
+    this->Internals->SelectionRectangleActive = 0;
+    this->CanvasRemoveTag(
+      vtkKWParameterValueFunctionEditor::SelectionRectangleTag);
+    }
+
   // No point found, then let's add that point
 
   int move_selection_to_click = 0;
@@ -8159,11 +9660,35 @@ void vtkKWParameterValueFunctionEditor::StartInteractionCallback(
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkKWParameterValueFunctionEditor::StartSelectionRectangleCallback(
+  int x, int y)
+{
+  int id, c_x, c_y;
+
+  // Control + click in an empty area starts a rubber-band selection, on a
+  // point it is a regular click
+
+  if (this->FindFunctionPointAtCanvasCoordinates(x, y, &id, &c_x, &c_y) ||
+      !this->HasFunction() || 
+      !this->PointVisibility || 
+      !this->CanvasVisibility)
+    {
+    this->StartInteractionCallback(x, y, 0);
+    return;
+    }
+
+  this->StartSelectionRectangle(c_x, c_y);
+}
+
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::MovePointCallback(
   int x, int y, int shift)
 {  
-  if (!this->IsCreated() || !this->HasSelection() || !this->InUserInteraction)
+  if (!this->IsCreated() || 
+      this->Internals->InParameterCursorInteraction ||
+      (!this->Internals->SelectionRectangleActive && 
+       (!this->HasSelection() || !this->InUserInteraction)))
     {
     return;
     }
@@ -8206,6 +9731,14 @@ void vtkKWParameterValueFunctionEditor::MovePointCallback(
   int c_x = atoi(this->Script("%s canvasx %d", canv, x));
   int c_y = atoi(this->Script("%s canvasy %d", canv, y));
 
+  // Rubber-band selection in progress
+
+  if (this->Internals->SelectionRectangleActive)
+    {
+    this->UpdateSelectionRectangle(c_x, c_y);
+    return;
+    }
+
   // We assume we can not go before or beyond the previous or next point
 
   if (this->GetSelectedPoint() > 0)
@@ -8309,18 +9842,36 @@ void vtkKWParameterValueFunctionEditor::MovePointCallback(
 
   // Invoke the commands/callbacks
 
-  this->InvokePointChangingCommand(this->GetSelectedPoint());
-  this->InvokeFunctionChangingCommand();
+  if (!this->ScheduleRedraw(
+        vtkKWParameterValueFunctionEditor::ScheduledInvokeChangingCommands,
+        this->GetSelectedPoint()))
+    {
+    this->InvokePointChangingCommand(this->GetSelectedPoint());
+    this->InvokeFunctionChangingCommand();
+    }
 }
 
 //----------------------------------------------------------------------------
 void vtkKWParameterValueFunctionEditor::EndInteractionCallback(int x, int y)
 {
+  this->Internals->InParameterCursorInteraction = 0;
+
+  if (this->Internals->SelectionRectangleActive)
+    {
+    this->EndSelectionRectangle();
+    return;
+    }
+
   if (!this->HasSelection() || !this->InUserInteraction)
     {
     return;
     }
 
+  // Catch up with the last position before reporting the end of the 
+  // interaction
+
+  this->ProcessScheduledRedraws();
+
   this->InUserInteraction = 0;
 
   // Invoke the commands/callbacks
@@ -8361,6 +9912,8 @@ void vtkKWParameterValueFunctionEditor::EndInteractionCallback(int x, int y)
 void vtkKWParameterValueFunctionEditor
 ::ParameterCursorStartInteractionCallback( int vtkNotUsed(x) )
 {
+  this->Internals->InParameterCursorInteraction = 1;
+
   if (this->Canvas && this->ChangeMouseCursor)
     {
     this->Canvas->SetConfigurationOption("-cursor", "hand2");
@@ -8371,6 +9924,8 @@ void vtkKWParameterValueFunctionEditor
 void 
 vtkKWParameterValueFunctionEditor::ParameterCursorEndInteractionCallback()
 {
+  this->Internals->InParameterCursorInteraction = 0;
+
   if (this->Canvas && this->ChangeMouseCursor)
     {
     this->Canvas->SetConfigurationOption("-cursor", NULL);
@@ -8504,6 +10059,9 @@ void vtkKWParameterValueFunctionEditor::PrintSelf(
      << (this->EnableDirectMove ? "On" : "Off") << endl;
   os << indent << "ChangeMouseCursor: "
      << (this->ChangeMouseCursor ? "On" : "Off") << endl;
+  os << indent << "CoalesceInteractiveRedraws: "
+     << (this->CoalesceInteractiveRedraws ? "On" : "Off") << endl;
+  os << indent << "PointLODThreshold: " << this->PointLODThreshold << endl;
   os << indent << "SelectedPoint: "<< this->GetSelectedPoint() << endl;
   os << indent << "FrameBackgroundColor: ("
      << this->FrameBackgroundColor[0] << ", " 
@@ -35,6 +35,7 @@
 //ETX
 
 class vtkCallbackCommand;
+class vtkIntArray;
 class vtkKWCanvas;
 class vtkKWFrame;
 class vtkKWIcon;
@@ -42,6 +43,7 @@ class vtkKWLabel;
 class vtkKWEntryWithLabel;
 class vtkKWRange;
 class vtkKWMenuButton;
+class vtkKWParameterValueFunctionEditorInternals;
 
 class KWWidgets_EXPORT vtkKWParameterValueFunctionEditor : public vtkKWParameterValueFunctionInterface
 {
@@ -542,6 +544,19 @@ public:
   virtual void SetSelectedPointRadius(double);
   vtkGetMacro(SelectedPointRadius, double);
 
+  // Description:
+  // Set/Get the level-of-detail threshold for the points (defaults to 0,
+  // i.e. disabled). If more than PointLODThreshold points fall in the same
+  // pixel column of the visible range, the points, their text and the lines
+  // between them are not drawn as individual canvas items anymore: the
+  // whole function is drawn as a single polyline, and only the selected
+  // point is drawn as a point. That polyline is drawn with the function
+  // line style, and only if FunctionLineVisibility is On. Individual points
+  // are drawn again once the visible range is zoomed in enough. Points can
+  // still be picked and moved in that mode.
+  virtual void SetPointLODThreshold(int);
+  vtkGetMacro(PointLODThreshold, int);
+
   // Description:
   // Set/Get the label to display in the selected point instead of its
   // index (if PointIndexVisibility or SetPointIndexVisibility are set
@@ -631,7 +646,34 @@ public:
   virtual void SelectLastPoint();
 
   // Description:
-  // Remove a point
+  // Select all the points inside the canvas rectangle (x1, y1)-(x2, y2).
+  // This is what Control + left button dragging in an empty area of the
+  // canvas does (rubber-band selection), unless that interaction is used
+  // by the parameter cursor (see ParameterCursorInteractionStyle).
+  // The first point found becomes the selected point (SelectedPoint, the
+  // one the entries and the keyboard navigation operate on), the others are
+  // added to the selection. Selecting a single point (even SelectedPoint),
+  // clearing the selection or adding/removing points reduces the selection
+  // back to SelectedPoint at most. Return the number of points selected.
+  virtual int  SelectPointsInCanvasRectangle(int x1, int y1, int x2, int y2);
+  virtual int  IsPointSelected(int id);
+  virtual int  GetNumberOfSelectedPoints();
+  virtual int  GetNthSelectedPoint(int n);
+
+  // Description:
+  // Find the point closest to the canvas coordinates (x, y), or all the
+  // points inside the canvas rectangle (x1, y1)-(x2, y2), sorted by id.
+  // The canvas coordinates are the ones the points are drawn at (see
+  // AddPointAtCanvasCoordinates). These queries do not involve Tk, they
+  // are answered from an index of the points coordinates that is updated
+  // along with the points. Return 1 (resp. the number of points found) on
+  // success, 0 otherwise.
+  virtual int FindPointClosestToCanvasCoordinates(int x, int y, int *id);
+  virtual int FindPointsInCanvasRectangle(
+    int x1, int y1, int x2, int y2, vtkIntArray *ids);
+
+  // Description:
+  // Remove a point (RemoveSelectedPoint removes all the selected points)
   virtual int RemoveSelectedPoint();
   virtual int RemovePoint(int id);
   virtual int RemovePointAtParameter(double parameter);
@@ -641,6 +683,25 @@ public:
   virtual int AddPointAtCanvasCoordinates(int x, int y, int *id);
   virtual int AddPointAtParameter(double parameter, int *id);
 
+  // Description:
+  // Move a point to a given parameter (its value is not changed)
+  virtual int MovePointToParameter(int id, double parameter);
+
+  // Description:
+  // Edit transactions. Between BeginEditTransaction and EndEditTransaction,
+  // points can be added, moved and removed (AddPointAtParameter,
+  // MovePointToParameter, RemovePoint, etc.) without the editor being
+  // redrawn, the point entries being updated, or the point, selection and
+  // function commands and events being invoked. EndEditTransaction then
+  // redraws what needs to be, once, and invokes the SelectionChanged and
+  // FunctionChanged commands and events once if the selection or the
+  // function were modified. Update can be called during a transaction too,
+  // the editor is then redrawn at the end of it. Transactions can be nested,
+  // only the outermost EndEditTransaction has an effect.
+  virtual void BeginEditTransaction();
+  virtual void EndEditTransaction();
+  virtual int  IsInEditTransaction();
+
   // Description:
   // Merge all the points from another function editor.
   // Return the number of points merged.
@@ -840,6 +901,26 @@ public:
   vtkGetMacro(ChangeMouseCursor, int);
   vtkSetMacro(ChangeMouseCursor, int);
 
+  // Description:
+  // Set/Get if interactive redraws should be coalesced (defaults to Off).
+  // If On, moving points, panning/zooming the visible ranges, moving the
+  // parameter cursor or updating the histograms only schedules the
+  // corresponding elements to be redrawn: they are redrawn at most once per
+  // idle cycle of the event loop, no matter how many mouse motion events
+  // were received in between. The PointChanging and FunctionChanging
+  // commands and events (and therefore the synchronized editors) are
+  // coalesced the same way, and only invoked for the latest position of the
+  // point being dragged.
+  virtual void SetCoalesceInteractiveRedraws(int);
+  vtkBooleanMacro(CoalesceInteractiveRedraws, int);
+  vtkGetMacro(CoalesceInteractiveRedraws, int);
+
+  // Description:
+  // Process the redraws and commands that were scheduled but not processed
+  // yet (see CoalesceInteractiveRedraws). This is done automatically when
+  // the application is idle, and at the end of each interaction.
+  virtual void ProcessScheduledRedraws();
+
   // Description:
   // Specifies function-related commands to associate with the widget.
   // 'FunctionStartChanging' is called when the function is starting to 
@@ -1085,6 +1166,8 @@ public:
   static const char *PointGuidelineTag;
   static const char *PointTextTag;
   static const char *LineTag;
+  static const char *FunctionLODTag;
+  static const char *SelectionRectangleTag;
   static const char *HistogramTag;
   static const char *SecondaryHistogramTag;
   static const char *FrameForegroundTag;
@@ -1114,6 +1197,7 @@ public:
   virtual void VisibleValueRangeChangingCallback(double, double);
   virtual void VisibleValueRangeChangedCallback(double, double);
   virtual void StartInteractionCallback(int x, int y, int shift);
+  virtual void StartSelectionRectangleCallback(int x, int y);
   virtual void MovePointCallback(int x, int y, int shift);
   virtual void EndInteractionCallback(int x, int y);
   virtual void ParameterCursorStartInteractionCallback(int x);
@@ -1122,6 +1206,7 @@ public:
   virtual void ParameterEntryCallback(const char*);
   virtual void HistogramLogModeCallback(int mode);
   virtual void DoubleClickOnPointCallback(int x, int y);
+  virtual void ScheduledRedrawsCallback();
 
 protected:
   vtkKWParameterValueFunctionEditor();
@@ -1209,6 +1294,8 @@ protected:
   int   PointRadiusX;
   int   PointRadiusY;
   double SelectedPointRadius;
+  int    PointLODThreshold;
+  int    PointLODActive;
   int   FunctionLineWidth;
   int   FunctionLineStyle;
   int   PointGuidelineStyle;
@@ -1245,6 +1332,7 @@ protected:
   int   NumberOfValueTicks;
   int   ValueTicksCanvasWidth;
   int   ChangeMouseCursor;
+  int   CoalesceInteractiveRedraws;
   char* ValueTicksFormat;
   char* ParameterTicksFormat;
   char* ParameterEntryFormat;
@@ -1404,6 +1492,62 @@ protected:
   virtual void GetLineCoordinates(int id1, int id2, vtksys_ios::ostream *tk_cmd);
   //ETX
 
+  // Description:
+  // Execute a stream of canvas commands built by the methods above. The
+  // items that exist in the canvas already are not moved through the
+  // stream: their new coordinates are collected by the redraw methods and
+  // set in a single evaluation, before the commands.
+  virtual void ExecuteCanvasCommands(const char *tk_cmd);
+
+  // Description:
+  // Interpolate the function at 'nb_samples' parameters evenly spaced
+  // between 'p1' and 'p2' (both included), storing the 'n-tuple' values
+  // one after the other in 'values' (which has to be allocated with enough
+  // room). Used by GetLineCoordinates to sample the line between two
+  // points. The default implementation calls InterpolateFunctionPointValues
+  // for each sample, subclasses should evaluate the function in a single
+  // pass whenever possible.
+  // Return 1 on success, 0 otherwise
+  virtual int InterpolateFunctionPointValuesInRange(
+    double p1, double p2, int nb_samples, double *values);
+
+  // Description:
+  // Level-of-detail (see PointLODThreshold). FunctionPointsNeedLOD
+  // returns 1 if too many points fall in the same pixel column of the
+  // visible range. RedrawFunctionLOD draws the function as a single
+  // polyline, going through the first, lowest, highest and last point of
+  // each pixel column.
+  virtual int FunctionPointsNeedLOD();
+  //BTX
+  virtual void RedrawFunctionLOD(vtksys_ios::ostream *tk_cmd);
+  //ETX
+
+  // Description:
+  // Index of the canvas coordinates of the points, sorted along x like the
+  // points themselves, used to pick points without querying the canvas.
+  // UpdateFunctionPointsIndex rebuilds it if the function, the editor or
+  // the canvas mapping changed since it was last built, and returns the 
+  // number of points indexed. UpdateFunctionPointInIndex updates a single
+  // point after it was moved, it should only be called if the index was up
+  // to date before the move. GetFunctionPointsIndexKey fills 'key' with the
+  // state the index depends on.
+  virtual int  UpdateFunctionPointsIndex();
+  virtual void UpdateFunctionPointInIndex(int id);
+  virtual int  FunctionPointsIndexIsUpToDate();
+  virtual void GetFunctionPointsIndexKey(double key[8]);
+
+  // Description:
+  // Rubber-band selection (see SelectPointsInCanvasRectangle), driven by
+  // the Start/MovePoint/EndInteraction callbacks.
+  virtual void StartSelectionRectangle(int c_x, int c_y);
+  virtual void UpdateSelectionRectangle(int c_x, int c_y);
+  virtual void EndSelectionRectangle();
+
+  // Description:
+  // Reduce the selection to SelectedPoint, redrawing the points that were
+  // selected along with it. Return 1 if the selection changed, 0 otherwise.
+  virtual int ClearExtraSelection();
+
   // Description:
   // Redraw the visible range frame
   virtual void RedrawRangeFrame();
@@ -1446,6 +1590,40 @@ protected:
   int           LastRedrawFunctionSize;
   //ETX
 
+  // PIMPL Encapsulation for STL containers
+  //BTX
+  vtkKWParameterValueFunctionEditorInternals *Internals;
+  //ETX
+
+  // Description:
+  // Schedule elements to be redrawn (or the Changing commands to be invoked)
+  // when the application is idle, see CoalesceInteractiveRedraws. 'id' is
+  // the point to redraw, or the point to invoke the PointChanging command
+  // for. Return 1 if the request was scheduled, 0 if the caller should
+  // process it right away (coalescing is Off, or the scheduled requests are
+  // being processed).
+  //BTX
+  enum
+  {
+    ScheduledRedrawSinglePoint      = 1,
+    ScheduledRedrawFunction         = 2,
+    ScheduledRedrawHistogram        = 4,
+    ScheduledRedrawRangeTicks       = 8,
+    ScheduledRedrawParameterCursor  = 16,
+    ScheduledRedrawAll              = 32,
+    ScheduledInvokeChangingCommands = 64
+  };
+  //ETX
+  virtual int ScheduleRedraw(int elements, int id = -1);
+
+  // Description:
+  // To be called by subclasses right before the function is replaced by
+  // another one. Within an edit transaction, replacing the function is not
+  // a modification of the function (the FunctionChanged command should not
+  // be invoked at the end of the transaction), modifying the previous one
+  // was.
+  virtual void ResetEditTransactionFunctionTime();
+
   double DisplayedWholeParameterRange[2];
 
   //BTX
@@ -899,9 +899,11 @@ void vtkKWParameterValueHermiteFunctionEditor::RedrawLine(
 
   this->Superclass::RedrawLine(id1, id2, tk_cmd);
 
-  // Then redraw the midpoint on this line
+  // Then redraw the midpoint on this line (there is no midpoint in
+  // level-of-detail mode, switching to that mode removed them all)
 
-  if (!this->IsCreated() || !this->HasFunction() || this->DisableRedraw)
+  if (!this->IsCreated() || !this->HasFunction() || this->DisableRedraw ||
+      this->PointLODActive)
     {
     return;
     }
@@ -1729,9 +1731,15 @@ void vtkKWParameterValueHermiteFunctionEditor::MoveMidPointCallback(
 
   if (this->GetFunctionMTime() > mtime)
     {
-    this->RedrawSinglePointDependentElements(this->GetSelectedMidPoint());
-    this->InvokePointChangingCommand(this->GetSelectedMidPoint());
-    this->InvokeFunctionChangingCommand();
+    if (!this->ScheduleRedraw(
+          vtkKWParameterValueFunctionEditor::ScheduledRedrawSinglePoint |
+          vtkKWParameterValueFunctionEditor::ScheduledInvokeChangingCommands,
+          this->GetSelectedMidPoint()))
+      {
+      this->RedrawSinglePointDependentElements(this->GetSelectedMidPoint());
+      this->InvokePointChangingCommand(this->GetSelectedMidPoint());
+      this->InvokeFunctionChangingCommand();
+      }
     }
 }
 
@@ -1744,6 +1752,11 @@ void vtkKWParameterValueHermiteFunctionEditor::EndMidPointInteractionCallback(
     return;
     }
 
+  // Catch up with the last position before reporting the end of the 
+  // interaction
+
+  this->ProcessScheduledRedraws();
+
   // Invoke the commands/callbacks
 
   this->InvokePointChangedCommand(this->GetSelectedMidPoint());
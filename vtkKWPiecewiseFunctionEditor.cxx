@@ -92,6 +92,8 @@ void vtkKWPiecewiseFunctionEditor::SetPiecewiseFunction(
     return;
     }
 
+  this->ResetEditTransactionFunctionTime();
+
   if (this->PiecewiseFunction)
     {
     this->PiecewiseFunction->UnRegister(this);
@@ -129,6 +131,8 @@ void vtkKWPiecewiseFunctionEditor::SetPointColorTransferFunction(
     return;
     }
 
+  this->ResetEditTransactionFunctionTime();
+
   if (this->PointColorTransferFunction)
     {
     this->PointColorTransferFunction->UnRegister(this);
@@ -143,6 +147,14 @@ void vtkKWPiecewiseFunctionEditor::SetPointColorTransferFunction(
 
   this->Modified();
 
+  // The new point color function may be older than the last redraw, in
+  // which case GetRedrawFunctionTime() would not report it: force the
+  // function to be redrawn by the next Redraw() as well (RedrawFunction()
+  // below does nothing within an edit transaction, the redraw is deferred
+  // to its end).
+
+  this->LastRedrawFunctionTime = 0;
+
   this->RedrawFunction();
 }
 
@@ -312,6 +324,24 @@ int vtkKWPiecewiseFunctionEditor::InterpolateFunctionPointValues(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkKWPiecewiseFunctionEditor::InterpolateFunctionPointValuesInRange(
+  double p1, double p2, int nb_samples, double *values)
+{
+  if (!this->HasFunction() || !values || nb_samples < 2)
+    {
+    return this->Superclass::InterpolateFunctionPointValuesInRange(
+      p1, p2, nb_samples, values);
+    }
+
+  // GetTable walks the nodes (and evaluates the midpoint/sharpness curve)
+  // once for all samples, instead of looking up the segment for each one
+
+  this->PiecewiseFunction->GetTable(p1, p2, nb_samples, values);
+  
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkKWPiecewiseFunctionEditor::AddFunctionPoint(
   double parameter, const double *values, int *id)
@@ -872,6 +902,13 @@ void vtkKWPiecewiseFunctionEditor::UpdateEnableState()
 //----------------------------------------------------------------------------
 void vtkKWPiecewiseFunctionEditor::InvokeFunctionChangedCommand()
 {
+  // Nothing is reported during an edit transaction
+
+  if (this->IsInEditTransaction())
+    {
+    return;
+    }
+
   if (this->WindowLevelMode)
     {
     this->UpdateWindowLevelFromPoints();
@@ -887,6 +924,13 @@ void vtkKWPiecewiseFunctionEditor::InvokeFunctionChangedCommand()
 //----------------------------------------------------------------------------
 void vtkKWPiecewiseFunctionEditor::InvokeFunctionChangingCommand()
 {
+  // Nothing is reported during an edit transaction
+
+  if (this->IsInEditTransaction())
+    {
+    return;
+    }
+
   if (this->WindowLevelMode)
     {
     this->UpdateWindowLevelFromPoints();
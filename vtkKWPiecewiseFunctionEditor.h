@@ -170,6 +170,8 @@ protected:
   virtual int GetFunctionPointValues(int id, double *values);
   virtual int SetFunctionPointValues(int id, const double *values);
   virtual int InterpolateFunctionPointValues(double parameter, double *values);
+  virtual int InterpolateFunctionPointValuesInRange(
+    double p1, double p2, int nb_samples, double *values);
   virtual int AddFunctionPoint(double parameter, const double *values,int *id);
   virtual int SetFunctionPoint(int id, double parameter, const double *values);
   virtual int RemoveFunctionPoint(int id);
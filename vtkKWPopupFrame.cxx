@@ -95,8 +95,8 @@ void vtkKWPopupFrame::CreateWidget()
 
   this->Frame->Create();
 
-  this->Script("pack %s -side top -anchor nw -fill both -expand y",
-               this->Frame->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -fill both -expand y",
+                    this->Frame->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
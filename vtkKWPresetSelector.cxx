@@ -506,7 +506,7 @@ void vtkKWPresetSelector::CreateWidget()
   this->PresetList->Create();
   //this->PresetList->HorizontalScrollbarVisibilityOff();
 
-  this->Script(
+  this->QueueScript(
     "pack %s -side top -anchor nw -fill both -expand t -padx 2 -pady 2",
     this->PresetList->GetWidgetName());
 
@@ -551,8 +551,8 @@ void vtkKWPresetSelector::CreateWidget()
   this->PresetControlFrame->SetParent(this);
   this->PresetControlFrame->Create();
 
-  this->Script("pack %s -side top -anchor nw -fill both -expand f",
-               this->PresetControlFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor nw -fill both -expand f",
+                    this->PresetControlFrame->GetWidgetName());
 
   // --------------------------------------------------------------
   // Preset : buttons
@@ -1408,15 +1408,15 @@ void vtkKWPresetSelector::Pack()
 
   if (this->PresetButtons && this->PresetButtons->IsCreated())
     {
-    this->Script("pack %s -side top -anchor nw -fill none -expand t",
-                 this->PresetButtons->GetWidgetName());
+    this->QueueScript("pack %s -side top -anchor nw -fill none -expand t",
+                      this->PresetButtons->GetWidgetName());
     }
 
   if (this->HelpLabelVisibility && this->HelpLabel)
     {
-    this->Script("pack %s -side bottom -anchor nw -fill x -expand n -after %s",
-                 this->HelpLabel->GetWidgetName(),
-                 this->PresetButtons->GetWidgetName());
+    this->QueueScript("pack %s -side bottom -anchor nw -fill x -expand n -after %s",
+                      this->HelpLabel->GetWidgetName(),
+                      this->PresetButtons->GetWidgetName());
     }
   else
     {
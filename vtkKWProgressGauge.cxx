@@ -96,8 +96,8 @@ void vtkKWProgressGauge::CreateWidget()
 
   this->Canvas->SetBinding("<Configure>", this, "ConfigureCallback");
 
-  this->Script("pack %s -fill both -expand yes", 
-               this->Canvas->GetWidgetName());
+  this->QueueScript("pack %s -fill both -expand yes", 
+                    this->Canvas->GetWidgetName());
 
   this->Redraw();
 }
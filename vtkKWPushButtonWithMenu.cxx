@@ -56,16 +56,16 @@ void vtkKWPushButtonWithMenu::CreateWidget()
   this->PushButton->SetParent(this);
   this->PushButton->Create();  
 
-  this->Script("pack %s -side left -expand y -fill both",
-               this->PushButton->GetWidgetName());
+  this->QueueScript("pack %s -side left -expand y -fill both",
+                    this->PushButton->GetWidgetName());
 
   this->MenuButton->SetParent(this);
   this->MenuButton->Create();
   this->MenuButton->IndicatorVisibilityOff();
   this->MenuButton->SetImageToPredefinedIcon(vtkKWIcon::IconExpandMini);
 
-  this->Script("pack %s -side left -fill y",
-               this->MenuButton->GetWidgetName());
+  this->QueueScript("pack %s -side left -fill y",
+                    this->MenuButton->GetWidgetName());
 }
   
 //----------------------------------------------------------------------------
@@ -310,10 +310,10 @@ void vtkKWRenderWidget::CreateWidget()
   vtkKWWidget::CreateSpecificTkWidget(
     this->VTKWidget, "vtkTkRenderWidget", opts);
 
-  this->Script("grid rowconfigure %s 0 -weight 1", this->GetWidgetName());
-  this->Script("grid columnconfigure %s 0 -weight 1", this->GetWidgetName());
-  this->Script("grid %s -row 0 -column 0 -sticky nsew",
-               this->VTKWidget->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 0 -weight 1", this->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 0 -weight 1", this->GetWidgetName());
+  this->QueueScript("grid %s -row 0 -column 0 -sticky nsew",
+                    this->VTKWidget->GetWidgetName());
 
   // When the render window is created by the Tk render widget, it
   // is Render()'ed, which calls Initialize() on the interactor, which
@@ -226,8 +226,8 @@ void vtkKWScalarBarAnnotation::CreateWidget()
   this->ComponentSelectionWidget->SetSelectedComponentChangedCommand(
     this, "SelectedComponentCallback");
 
-  this->Script("pack %s -side top -padx 2 -pady 1 -anchor w", 
-               this->ComponentSelectionWidget->GetWidgetName());
+  this->QueueScript("pack %s -side top -padx 2 -pady 1 -anchor w", 
+                    this->ComponentSelectionWidget->GetWidgetName());
 
   // --------------------------------------------------------------
   // Title frame
@@ -235,8 +235,8 @@ void vtkKWScalarBarAnnotation::CreateWidget()
   this->TitleFrame->SetParent(frame);
   this->TitleFrame->Create();
 
-  this->Script("pack %s -side top -fill both -expand y", 
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand y", 
+                    this->TitleFrame->GetWidgetName());
   
   // --------------------------------------------------------------
   // Scalar Bar title
@@ -251,9 +251,9 @@ void vtkKWScalarBarAnnotation::CreateWidget()
     k_("Set the scalar bar title. The text will automatically scale "
        "to fit within the allocated space"));
 
-  this->Script("pack %s -padx 2 -pady 2 -side %s -anchor nw -expand y -fill x",
-               this->TitleEntry->GetWidgetName(),
-               (!this->PopupMode ? "left" : "top"));
+  this->QueueScript("pack %s -padx 2 -pady 2 -side %s -anchor nw -expand y -fill x",
+                    this->TitleEntry->GetWidgetName(),
+                    (!this->PopupMode ? "left" : "top"));
   
   // --------------------------------------------------------------
   // Scalar Bar title text property : popup button if needed
@@ -276,8 +276,8 @@ void vtkKWScalarBarAnnotation::CreateWidget()
     popupframe->SetBorderWidth(2);
     popupframe->SetReliefToGroove();
 
-    this->Script("pack %s -padx 2 -pady 2 -side left -anchor w", 
-                 this->TitleTextPropertyPopupButton->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side left -anchor w", 
+                      this->TitleTextPropertyPopupButton->GetWidgetName());
 
     this->TitleTextPropertyWidget->SetParent(
       this->TitleTextPropertyPopupButton->GetWidget()->GetPopupFrame());
@@ -299,9 +299,9 @@ void vtkKWScalarBarAnnotation::CreateWidget()
   this->TitleTextPropertyWidget->SetChangedCommand(
     this, "TitleTextPropertyCallback");
 
-  this->Script("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
-               this->TitleTextPropertyWidget->GetWidgetName(),
-               this->TitleTextPropertyWidget->GetLongFormat() ? 0 : 2);
+  this->QueueScript("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
+                    this->TitleTextPropertyWidget->GetWidgetName(),
+                    this->TitleTextPropertyWidget->GetLongFormat() ? 0 : 2);
 
   // --------------------------------------------------------------
   // Label frame
@@ -309,9 +309,9 @@ void vtkKWScalarBarAnnotation::CreateWidget()
   this->LabelFrame->SetParent(frame);
   this->LabelFrame->Create();
 
-  this->Script("pack %s -side top -fill both -expand y -pady %d", 
-               this->LabelFrame->GetWidgetName(),
-               (this->PopupMode ? 6 : 0));
+  this->QueueScript("pack %s -side top -fill both -expand y -pady %d", 
+                    this->LabelFrame->GetWidgetName(),
+                    (this->PopupMode ? 6 : 0));
   
   // --------------------------------------------------------------
   // Scalar Bar label format
@@ -442,7 +442,7 @@ void vtkKWScalarBarAnnotation::PackLabelFrameChildren()
   
   if (this->LabelFormatEntry->IsCreated() && this->LabelFormatVisibility)
     {
-    this->Script(
+    this->QueueScript(
       "pack %s -padx 2 -pady 2 -side %s -anchor nw -expand y -fill x",
       this->LabelFormatEntry->GetWidgetName(),
       (!this->PopupMode ? "left" : "top"));
@@ -452,27 +452,27 @@ void vtkKWScalarBarAnnotation::PackLabelFrameChildren()
       !this->PopupMode && 
       this->LabelTextPropertyPopupButton->IsCreated())
     {
-    this->Script("pack %s -padx 2 -pady 2 -side left -anchor w", 
-                 this->LabelTextPropertyPopupButton->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side left -anchor w", 
+                      this->LabelTextPropertyPopupButton->GetWidgetName());
     }
 
   if (this->LabelTextPropertyWidget->IsCreated())
     {
-    this->Script("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
-                 this->LabelTextPropertyWidget->GetWidgetName(),
-                 this->LabelTextPropertyWidget->GetLongFormat() ? 0 : 2);
+    this->QueueScript("pack %s -padx 2 -pady %d -side top -anchor nw -fill y", 
+                      this->LabelTextPropertyWidget->GetWidgetName(),
+                      this->LabelTextPropertyWidget->GetLongFormat() ? 0 : 2);
     }
 
   if (this->MaximumNumberOfColorsThumbWheel->IsCreated())
     {
-    this->Script("pack %s -padx 2 -pady 2 -side top -anchor w -fill x", 
-                 this->MaximumNumberOfColorsThumbWheel->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side top -anchor w -fill x", 
+                      this->MaximumNumberOfColorsThumbWheel->GetWidgetName());
     }
 
   if (this->NumberOfLabelsScale->IsCreated())
     {
-    this->Script("pack %s -padx 2 -pady 2 -side top -anchor w -fill x", 
-                 this->NumberOfLabelsScale->GetWidgetName());
+    this->QueueScript("pack %s -padx 2 -pady 2 -side top -anchor w -fill x", 
+                      this->NumberOfLabelsScale->GetWidgetName());
     }
 }
 
@@ -107,13 +107,13 @@ void vtkKWScalarComponentSelectionWidget::Pack()
 
   if (this->AllowComponentSelection)
     {
-    this->Script("pack %s -side top -padx 0 -pady 0 -anchor w",
-                 this->SelectedComponentOptionMenu->GetWidgetName());
+    this->QueueScript("pack %s -side top -padx 0 -pady 0 -anchor w",
+                      this->SelectedComponentOptionMenu->GetWidgetName());
     }
   else
     {
-    this->Script("pack forget %s", 
-                 this->SelectedComponentOptionMenu->GetWidgetName());
+    this->QueueScript("pack forget %s", 
+                      this->SelectedComponentOptionMenu->GetWidgetName());
     }
 }
 
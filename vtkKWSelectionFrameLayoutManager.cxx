@@ -207,8 +207,8 @@ void vtkKWSelectionFrameLayoutManager::CreateWidget()
   this->LayoutFrame->Create();
   this->LayoutFrame->SetBackgroundColor(0.2, 0.2, 0.2);
 
-  this->Script("pack %s -side top -expand y -fill both -padx 0 -pady 0",
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -expand y -fill both -padx 0 -pady 0",
+                    this->LayoutFrame->GetWidgetName());
 
   this->LayoutFrame->AddBinding(
     "<Double-1>", this, "DoubleClickOnLayoutFrameCallback");
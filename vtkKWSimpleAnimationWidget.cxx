@@ -904,11 +904,11 @@ void vtkKWSimpleAnimationWidget::CreateAnimationCallback()
   combobox->AddValueAsInt(2160);
   combobox->AddValueAsInt(2540);
 
-  this->Script("pack %s %s -side left -fill both -expand t",
-               width_combobox->GetWidgetName(), 
-               height_combobox->GetWidgetName());
+  this->QueueScript("pack %s %s -side left -fill both -expand t",
+                    width_combobox->GetWidgetName(), 
+                    height_combobox->GetWidgetName());
     
-  this->Script("pack %s -side top -pady 5", frame->GetWidgetName());
+  this->QueueScript("pack %s -side top -pady 5", frame->GetWidgetName());
     
   res = msg_dialog->Invoke();
     
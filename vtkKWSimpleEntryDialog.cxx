@@ -86,10 +86,10 @@ void vtkKWSimpleEntryDialog::Pack()
       {
       before = this->CheckButton;
       }
-    this->Script("pack %s -side top %s %s -padx 4 -fill x -expand yes", 
-                 this->Entry->GetWidgetName(), 
-                 (before ? "-before" : ""),
-                 (before ? before->GetWidgetName() : ""));
+    this->QueueScript("pack %s -side top %s %s -padx 4 -fill x -expand yes", 
+                      this->Entry->GetWidgetName(), 
+                      (before ? "-before" : ""),
+                      (before ? before->GetWidgetName() : ""));
     }
 }
 
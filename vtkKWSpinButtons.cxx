@@ -204,14 +204,14 @@ void vtkKWSpinButtons::Pack()
     }
   if (this->PreviousButton && this->PreviousButton->IsCreated())
     {
-    this->Script(
+    this->QueueScript(
       "pack %s -side %s -expand y -fill both -padx %d -pady %d",
       this->PreviousButton->GetWidgetName(), prev,
       this->ButtonsPadX, this->ButtonsPadY);
     }
   if (this->NextButton && this->NextButton->IsCreated())
     {
-    this->Script(
+    this->QueueScript(
       "pack %s -side %s -expand y -fill both -padx %d -pady %d",
       this->NextButton->GetWidgetName(), next,
       this->ButtonsPadX, this->ButtonsPadY);
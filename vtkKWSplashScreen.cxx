@@ -72,8 +72,8 @@ void vtkKWSplashScreen::CreateWidget()
   this->Canvas->SetBorderWidth(0);
   this->Canvas->SetHighlightThickness(0);
 
-  this->Script("pack %s -side top -fill both -expand y",
-               this->Canvas->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand y",
+                    this->Canvas->GetWidgetName());
 
   this->Canvas->AddBinding("<ButtonPress>", this, "ButtonPressCallback");
 
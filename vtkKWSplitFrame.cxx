@@ -317,11 +317,11 @@ void vtkKWSplitFrame::ConfigureExpandButtons()
     this->Expand2Button->SetImageToPredefinedIcon(
       vtkKWIcon::IconExpandLeftMini);
 
-    this->Script("pack %s %s -side top -expand n -fill both -pady 1",
-                 this->Expand2Button->GetWidgetName(),
-                 this->Expand1Button->GetWidgetName());
-    this->Script("pack %s -side top -expand y -fill both",
-                 this->Separator->GetWidgetName());
+    this->QueueScript("pack %s %s -side top -expand n -fill both -pady 1",
+                      this->Expand2Button->GetWidgetName(),
+                      this->Expand1Button->GetWidgetName());
+    this->QueueScript("pack %s -side top -expand y -fill both",
+                      this->Separator->GetWidgetName());
 
     this->Expand1Button->SetBalloonHelpString(
       ks_("Split Frame|Expand right"));
@@ -335,11 +335,11 @@ void vtkKWSplitFrame::ConfigureExpandButtons()
     this->Expand2Button->SetImageToPredefinedIcon(
       vtkKWIcon::IconExpandMini);
 
-    this->Script("pack %s %s -side left -expand n -fill both -padx 1",
-                 this->Expand2Button->GetWidgetName(),
-                 this->Expand1Button->GetWidgetName());
-    this->Script("pack %s -side left -expand y -fill both",
-                 this->Separator->GetWidgetName());
+    this->QueueScript("pack %s %s -side left -expand n -fill both -padx 1",
+                      this->Expand2Button->GetWidgetName(),
+                      this->Expand1Button->GetWidgetName());
+    this->QueueScript("pack %s -side left -expand y -fill both",
+                      this->Separator->GetWidgetName());
 
     this->Expand1Button->SetBalloonHelpString(
       ks_("Split Frame|Expand up"));
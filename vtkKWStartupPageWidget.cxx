@@ -215,8 +215,8 @@ void vtkKWStartupPageWidget::CreateWidget()
   this->StartupPageCanvas->SetBorderWidth(0);
   this->StartupPageCanvas->SetBackgroundColor(this->GradientColor2);
 
-  this->Script("pack %s -fill both -expand 1", 
-               this->StartupPageCanvas->GetWidgetName());
+  this->QueueScript("pack %s -fill both -expand 1", 
+                    this->StartupPageCanvas->GetWidgetName());
 
   // Update
 
@@ -83,15 +83,15 @@ void vtkKWTclInteractor::CreateWidget()
 
   this->ButtonFrame->SetParent(this);
   this->ButtonFrame->Create();
-  this->Script("pack %s -side bottom -fill both -expand 0 -pady 2m",
-               this->ButtonFrame->GetWidgetName());
+  this->QueueScript("pack %s -side bottom -fill both -expand 0 -pady 2m",
+                    this->ButtonFrame->GetWidgetName());
   
   this->DismissButton->SetParent(this->ButtonFrame);
   this->DismissButton->Create();
   this->DismissButton->SetCommand(this, "Withdraw");
   this->DismissButton->SetText(ks_("Tcl Interactor Dialog|Button|Dismiss"));
-  this->Script("pack %s -side left -expand 1 -fill x",
-               this->DismissButton->GetWidgetName());
+  this->QueueScript("pack %s -side left -expand 1 -fill x",
+                    this->DismissButton->GetWidgetName());
 
   this->CommandFrame->SetParent(this);
   this->CommandFrame->Create();
@@ -107,9 +107,9 @@ void vtkKWTclInteractor::CreateWidget()
 
   this->CommandEntry->SetBinding("<Return>", this, "EvaluateCallback");
   
-  this->Script("pack %s -side left", this->CommandLabel->GetWidgetName());
-  this->Script("pack %s -side left -expand 1 -fill x",
-               this->CommandEntry->GetWidgetName());
+  this->QueueScript("pack %s -side left", this->CommandLabel->GetWidgetName());
+  this->QueueScript("pack %s -side left -expand 1 -fill x",
+                    this->CommandEntry->GetWidgetName());
   
   this->DisplayText->SetParent(this);
   this->DisplayText->Create();
@@ -121,11 +121,11 @@ void vtkKWTclInteractor::CreateWidget()
   text->SetWrapToWord();
   text->ReadOnlyOn();
 
-  this->Script("pack %s -side bottom -expand 1 -fill both",
-               this->DisplayText->GetWidgetName());
+  this->QueueScript("pack %s -side bottom -expand 1 -fill both",
+                    this->DisplayText->GetWidgetName());
 
-  this->Script("pack %s -pady 3m -padx 2m -side bottom -fill x",
-               this->CommandFrame->GetWidgetName());
+  this->QueueScript("pack %s -pady 3m -padx 2m -side bottom -fill x",
+                    this->CommandFrame->GetWidgetName());
 
   this->Script("set commandList \"\"");
 
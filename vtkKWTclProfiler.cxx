@@ -0,0 +1,958 @@
+/*=========================================================================
+
+  Module:    $RCSfile: vtkKWTclProfiler.cxx,v $
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkKWTclProfiler.h"
+
+#include "vtkKWApplication.h"
+#include "vtkObjectFactory.h"
+#include "vtkTclUtil.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/stl/string>
+#include <vtksys/stl/vector>
+#include <vtksys/stl/map>
+#include <vtksys/stl/algorithm>
+
+#include <ctype.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkKWTclProfiler);
+vtkCxxRevisionMacro(vtkKWTclProfiler, "$Revision: 1.1 $");
+
+#define VTK_KW_TCL_PROFILER_ASSOC_DATA "vtkKWTclProfiler"
+
+// Call sites longer than that are truncated
+
+#define VTK_KW_TCL_PROFILER_CALL_SITE_LENGTH 80
+
+int vtkKWTclProfiler::NumberOfEnabledProfilers = 0;
+
+//----------------------------------------------------------------------------
+class vtkKWTclProfilerInternals
+{
+public:
+
+  // The interpreter the profiler is registered with, while enabled
+
+  Tcl_Interp *Interp;
+
+  // Depth of the evaluations in progress, so that nested evaluations are
+  // only counted once in the total time
+
+  int Depth;
+  unsigned long NumberOfEvaluations;
+  double TotalTime;
+  double ResetTime;
+
+  // Call sites, by class and name
+
+  struct CallSiteType
+  {
+    vtksys_stl::string ClassName;
+    vtksys_stl::string Name;
+    unsigned long NumberOfEvaluations;
+    double TotalTime;
+    double MaximumTime;
+    unsigned long MaximumScriptLength;
+  };
+
+  typedef vtksys_stl::map<vtksys_stl::string, CallSiteType>
+  CallSitesContainerType;
+  CallSitesContainerType CallSites;
+
+  // Call sites and classes sorted by decreasing time, rebuilt on demand
+
+  typedef vtksys_stl::vector<CallSiteType*> SortedCallSitesContainerType;
+  SortedCallSitesContainerType SortedCallSites;
+  int SortedCallSitesUpToDate;
+
+  struct ClassType
+  {
+    vtksys_stl::string Name;
+    unsigned long NumberOfEvaluations;
+    double TotalTime;
+  };
+
+  typedef vtksys_stl::vector<ClassType> SortedClassesContainerType;
+  SortedClassesContainerType SortedClasses;
+  int SortedClassesUpToDate;
+
+  // Largest scripts, sorted by decreasing length
+
+  struct ScriptType
+  {
+    vtksys_stl::string Script;
+    unsigned long Length;
+    CallSiteType *CallSite;
+    double Time;
+  };
+
+  typedef vtksys_stl::vector<ScriptType> LargestScriptsContainerType;
+  LargestScriptsContainerType LargestScripts;
+
+  // Trace events (time relative to ResetTime)
+
+  struct TraceEventType
+  {
+    CallSiteType *CallSite;
+    double StartTime;
+    double Duration;
+    int Depth;
+  };
+
+  typedef vtksys_stl::vector<TraceEventType> TraceEventsContainerType;
+  TraceEventsContainerType TraceEvents;
+
+  // Instrumented object commands, by name: the original command procedure
+  // is invoked (and profiled) by ObjectCommand until it is restored
+
+  struct ObjectCommandType
+  {
+    vtkKWTclProfiler *Profiler;
+    vtksys_stl::string ClassName;
+    Tcl_ObjCmdProc *ObjProc;
+    ClientData ObjClientData;
+  };
+
+  typedef vtksys_stl::map<vtksys_stl::string, ObjectCommandType*>
+  ObjectCommandsContainerType;
+  ObjectCommandsContainerType ObjectCommands;
+
+  void UpdateSortedCallSites();
+  void UpdateSortedClasses();
+  void RestoreObjectCommands();
+
+  static void NormalizeCallSite(const char *str, vtksys_stl::string &site);
+  static void WriteJSONString(ostream &os, const char *str);
+
+  static void InterpDeleted(ClientData clientdata, Tcl_Interp *interp);
+  static int ObjectCommand(
+    ClientData clientdata, Tcl_Interp *interp, int objc, Tcl_Obj *CONST objv[]);
+};
+
+//----------------------------------------------------------------------------
+static bool vtkKWTclProfilerCallSiteCompare(
+  const vtkKWTclProfilerInternals::CallSiteType *a,
+  const vtkKWTclProfilerInternals::CallSiteType *b)
+{
+  return a->TotalTime > b->TotalTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfilerInternals::UpdateSortedCallSites()
+{
+  if (this->SortedCallSitesUpToDate)
+    {
+    return;
+    }
+
+  this->SortedCallSites.clear();
+  CallSitesContainerType::iterator it = this->CallSites.begin();
+  CallSitesContainerType::iterator end = this->CallSites.end();
+  for (; it != end; ++it)
+    {
+    this->SortedCallSites.push_back(&it->second);
+    }
+  vtksys_stl::sort(this->SortedCallSites.begin(), this->SortedCallSites.end(),
+                   vtkKWTclProfilerCallSiteCompare);
+
+  this->SortedCallSitesUpToDate = 1;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkKWTclProfilerClassCompare(
+  const vtkKWTclProfilerInternals::ClassType &a,
+  const vtkKWTclProfilerInternals::ClassType &b)
+{
+  return a.TotalTime > b.TotalTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfilerInternals::UpdateSortedClasses()
+{
+  if (this->SortedClassesUpToDate)
+    {
+    return;
+    }
+
+  vtksys_stl::map<vtksys_stl::string, ClassType> classes;
+  CallSitesContainerType::iterator it = this->CallSites.begin();
+  CallSitesContainerType::iterator end = this->CallSites.end();
+  for (; it != end; ++it)
+    {
+    ClassType &cls = classes[it->second.ClassName];
+    if (!cls.Name.size())
+      {
+      cls.Name = it->second.ClassName;
+      cls.NumberOfEvaluations = 0;
+      cls.TotalTime = 0.0;
+      }
+    cls.NumberOfEvaluations += it->second.NumberOfEvaluations;
+    cls.TotalTime += it->second.TotalTime;
+    }
+
+  this->SortedClasses.clear();
+  vtksys_stl::map<vtksys_stl::string, ClassType>::iterator c_it =
+    classes.begin();
+  vtksys_stl::map<vtksys_stl::string, ClassType>::iterator c_end =
+    classes.end();
+  for (; c_it != c_end; ++c_it)
+    {
+    this->SortedClasses.push_back(c_it->second);
+    }
+  vtksys_stl::sort(this->SortedClasses.begin(), this->SortedClasses.end(),
+                   vtkKWTclProfilerClassCompare);
+
+  this->SortedClassesUpToDate = 1;
+}
+
+//----------------------------------------------------------------------------
+// Use the first line of a script (or format) as a call site, replacing the
+// widget names, the VTK Tcl object names and the numbers with placeholders,
+// so that the same call site issued by different objects is counted once.
+
+void vtkKWTclProfilerInternals::NormalizeCallSite(
+  const char *str, vtksys_stl::string &site)
+{
+  site = "";
+  if (!str)
+    {
+    return;
+    }
+
+  while (*str && isspace(*str))
+    {
+    str++;
+    }
+
+  int token_start = 1;
+  while (*str && *str != '\n' && *str != '\r' &&
+         site.size() < VTK_KW_TCL_PROFILER_CALL_SITE_LENGTH)
+    {
+    if (token_start)
+      {
+      if (*str == '.' && (isalnum(str[1]) || str[1] == '_'))
+        {
+        site += "<widget>";
+        str++;
+        while (*str && (isalnum(*str) || *str == '_' || *str == '.'))
+          {
+          str++;
+          }
+        continue;
+        }
+      if (!strncmp(str, "vtkTemp", 7) && isdigit(str[7]))
+        {
+        site += "<object>";
+        str += 7;
+        while (isdigit(*str))
+          {
+          str++;
+          }
+        continue;
+        }
+      if (isdigit(*str) ||
+          ((*str == '-' || *str == '.') && isdigit(str[1])))
+        {
+        site += "<number>";
+        str++;
+        while (*str && (isdigit(*str) || *str == '.' ||
+                        *str == 'e' || *str == 'E' || *str == '-'))
+          {
+          str++;
+          }
+        continue;
+        }
+      }
+    token_start = (isspace(*str) || *str == '{' || *str == '[' ||
+                   *str == '"' || *str == ',');
+    site += *str++;
+    }
+
+  if (*str && *str != '\n' && *str != '\r')
+    {
+    site += "...";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfilerInternals::WriteJSONString(ostream &os, const char *str)
+{
+  os << '"';
+  for (; str && *str; str++)
+    {
+    unsigned char c = static_cast<unsigned char>(*str);
+    if (c == '"' || c == '\\')
+      {
+      os << '\\' << *str;
+      }
+    else if (c < 0x20)
+      {
+      char buffer[8];
+      sprintf(buffer, "\\u%04x", c);
+      os << buffer;
+      }
+    else
+      {
+      os << *str;
+      }
+    }
+  os << '"';
+}
+
+//----------------------------------------------------------------------------
+// Restore the original procedure of the instrumented object commands that
+// still exist (the interpreter is gone if Interp is NULL)
+
+void vtkKWTclProfilerInternals::RestoreObjectCommands()
+{
+  ObjectCommandsContainerType::iterator it = this->ObjectCommands.begin();
+  ObjectCommandsContainerType::iterator end = this->ObjectCommands.end();
+  for (; it != end; ++it)
+    {
+    ObjectCommandType *cmd = it->second;
+    Tcl_CmdInfo info;
+    if (this->Interp &&
+        Tcl_GetCommandInfo(this->Interp, it->first.c_str(), &info) &&
+        info.objProc == vtkKWTclProfilerInternals::ObjectCommand &&
+        info.objClientData == cmd)
+      {
+      info.objProc = cmd->ObjProc;
+      info.objClientData = cmd->ObjClientData;
+      Tcl_SetCommandInfo(this->Interp, it->first.c_str(), &info);
+      }
+    delete cmd;
+    }
+  this->ObjectCommands.clear();
+}
+
+//----------------------------------------------------------------------------
+// Called when the profiler is disabled, or when the interpreter is deleted
+
+void vtkKWTclProfilerInternals::InterpDeleted(
+  ClientData clientdata, Tcl_Interp *)
+{
+  vtkKWTclProfiler *self = static_cast<vtkKWTclProfiler*>(clientdata);
+  if (self && self->Internals->Interp)
+    {
+    self->Internals->Interp = NULL;
+    self->Internals->RestoreObjectCommands();
+    vtkKWTclProfiler::NumberOfEnabledProfilers--;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Invoke the original procedure of an instrumented object command, and
+// profile it as the method (first argument) of the object class. The
+// command entry can be released by the method itself (say, if it disables
+// the profiler), hence the copies.
+
+int vtkKWTclProfilerInternals::ObjectCommand(
+  ClientData clientdata, Tcl_Interp *interp, int objc, Tcl_Obj *CONST objv[])
+{
+  ObjectCommandType *cmd = static_cast<ObjectCommandType*>(clientdata);
+  vtkKWTclProfiler *profiler = cmd->Profiler;
+  Tcl_ObjCmdProc *proc = cmd->ObjProc;
+  ClientData proc_clientdata = cmd->ObjClientData;
+  vtksys_stl::string class_name(cmd->ClassName);
+
+  double start = profiler->BeginEvaluation();
+  int res = (*proc)(proc_clientdata, interp, objc, objv);
+  if (profiler == vtkKWTclProfiler::GetEnabledProfiler(interp))
+    {
+    profiler->EndEvaluation(
+      start, class_name.c_str(), objc > 1 ? Tcl_GetString(objv[1]) : NULL,
+      NULL);
+    }
+
+  return res;
+}
+
+//----------------------------------------------------------------------------
+vtkKWTclProfiler::vtkKWTclProfiler()
+{
+  this->Enabled = 0;
+  this->RecordTraceEvents = 0;
+  this->MaximumNumberOfTraceEvents = 1000000;
+  this->MaximumNumberOfLargestScripts = 10;
+
+  this->Internals = new vtkKWTclProfilerInternals;
+  this->Internals->Interp = NULL;
+
+  this->Reset();
+}
+
+//----------------------------------------------------------------------------
+vtkKWTclProfiler::~vtkKWTclProfiler()
+{
+  this->SetEnabled(0);
+
+  delete this->Internals;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkKWTclProfiler* vtkKWTclProfiler::GetEnabledProfilerInternal(
+  Tcl_Interp *interp)
+{
+  return interp ? static_cast<vtkKWTclProfiler*>(
+    Tcl_GetAssocData(interp, VTK_KW_TCL_PROFILER_ASSOC_DATA, NULL)) : NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfiler::InstrumentObjectCommand(const char *command_name,
+                                               const char *class_name)
+{
+  Tcl_Interp *interp = this->Internals->Interp;
+  if (!this->Enabled || !interp || !command_name)
+    {
+    return;
+    }
+
+  Tcl_CmdInfo info;
+  if (!Tcl_GetCommandInfo(interp, command_name, &info) ||
+      info.objProc == vtkKWTclProfilerInternals::ObjectCommand)
+    {
+    return;
+    }
+
+  // Only the (object) command procedure is replaced, the client data of
+  // the string procedure is left untouched, as the VTK Tcl wrapper uses it
+  // to retrieve the object. An entry left by a deleted command of the same
+  // name is reused.
+
+  vtkKWTclProfilerInternals::ObjectCommandType *&cmd =
+    this->Internals->ObjectCommands[command_name];
+  if (!cmd)
+    {
+    cmd = new vtkKWTclProfilerInternals::ObjectCommandType;
+    }
+  cmd->Profiler = this;
+  cmd->ClassName = class_name ? class_name : "(none)";
+  cmd->ObjProc = info.objProc;
+  cmd->ObjClientData = info.objClientData;
+
+  info.objProc = vtkKWTclProfilerInternals::ObjectCommand;
+  info.objClientData = cmd;
+  Tcl_SetCommandInfo(interp, command_name, &info);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfiler::SetEnabled(int arg)
+{
+  arg = arg ? 1 : 0;
+  if (this->Enabled == arg)
+    {
+    return;
+    }
+
+  if (arg)
+    {
+    Tcl_Interp *interp =
+      this->GetApplication() ? this->GetApplication()->GetMainInterp() : NULL;
+    if (!interp)
+      {
+      vtkErrorMacro("Can not enable the profiler without an application!");
+      return;
+      }
+
+    // Only one profiler per interpreter
+
+    vtkKWTclProfiler *other = vtkKWTclProfiler::GetEnabledProfiler(interp);
+    if (other)
+      {
+      other->SetEnabled(0);
+      }
+
+    Tcl_SetAssocData(interp, VTK_KW_TCL_PROFILER_ASSOC_DATA,
+                     vtkKWTclProfilerInternals::InterpDeleted, this);
+    this->Internals->Interp = interp;
+    this->Internals->Depth = 0;
+    vtkKWTclProfiler::NumberOfEnabledProfilers++;
+    this->Enabled = 1;
+
+    // Instrument the objects of the callbacks that were created before the
+    // profiler was enabled. Nothing keeps track of them while no profiler
+    // is enabled: the Tcl commands created for the objects by
+    // vtkKWTkUtilities::GetTclNameFromPointer are looked up instead.
+
+    vtksys_stl::vector<vtksys_stl::string> names;
+    if (Tcl_GlobalEval(interp, "info commands vtkTemp*") == TCL_OK)
+      {
+      int objc;
+      Tcl_Obj **objv;
+      if (Tcl_ListObjGetElements(
+            interp, Tcl_GetObjResult(interp), &objc, &objv) == TCL_OK)
+        {
+        int i;
+        for (i = 0; i < objc; i++)
+          {
+          names.push_back(Tcl_GetString(objv[i]));
+          }
+        }
+      }
+
+    vtksys_stl::vector<vtksys_stl::string>::iterator it = names.begin();
+    vtksys_stl::vector<vtksys_stl::string>::iterator end = names.end();
+    for (; it != end; ++it)
+      {
+      int error = 0;
+      vtkObject *obj = static_cast<vtkObject*>(
+        vtkTclGetPointerFromObject(it->c_str(), "vtkObject", interp, error));
+      if (obj && !error)
+        {
+        this->InstrumentObjectCommand(it->c_str(), obj->GetClassName());
+        }
+      }
+    Tcl_ResetResult(interp);
+    }
+  else
+    {
+    // This invokes InterpDeleted, which restores the object commands
+
+    if (this->Internals->Interp)
+      {
+      Tcl_DeleteAssocData(
+        this->Internals->Interp, VTK_KW_TCL_PROFILER_ASSOC_DATA);
+      }
+    }
+
+  this->Enabled = arg;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfiler::Reset()
+{
+  vtkKWTclProfilerInternals *internals = this->Internals;
+
+  internals->Depth = 0;
+  internals->NumberOfEvaluations = 0;
+  internals->TotalTime = 0.0;
+  internals->ResetTime = vtkTimerLog::GetUniversalTime();
+
+  internals->LargestScripts.clear();
+  internals->TraceEvents.clear();
+  internals->SortedCallSites.clear();
+  internals->SortedCallSitesUpToDate = 0;
+  internals->SortedClasses.clear();
+  internals->SortedClassesUpToDate = 0;
+  internals->CallSites.clear();
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::BeginEvaluation()
+{
+  this->Internals->Depth++;
+  return vtkTimerLog::GetUniversalTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfiler::EndEvaluation(double start_time,
+                                     const char *class_name,
+                                     const char *call_site,
+                                     const char *script)
+{
+  double duration = vtkTimerLog::GetUniversalTime() - start_time;
+
+  vtkKWTclProfilerInternals *internals = this->Internals;
+  if (internals->Depth > 0)
+    {
+    internals->Depth--;
+    }
+
+  internals->NumberOfEvaluations++;
+  if (!internals->Depth)
+    {
+    internals->TotalTime += duration;
+    }
+
+  // Find the call site
+
+  vtksys_stl::string site;
+  vtkKWTclProfilerInternals::NormalizeCallSite(
+    call_site ? call_site : script, site);
+  if (!class_name)
+    {
+    class_name = "(none)";
+    }
+
+  vtksys_stl::string key(class_name);
+  key += '\t';
+  key += site;
+
+  vtkKWTclProfilerInternals::CallSitesContainerType::iterator it =
+    internals->CallSites.find(key);
+  if (it == internals->CallSites.end())
+    {
+    vtkKWTclProfilerInternals::CallSiteType new_site;
+    new_site.ClassName = class_name;
+    new_site.Name = site;
+    new_site.NumberOfEvaluations = 0;
+    new_site.TotalTime = 0.0;
+    new_site.MaximumTime = 0.0;
+    new_site.MaximumScriptLength = 0;
+    it = internals->CallSites.insert(
+      vtkKWTclProfilerInternals::CallSitesContainerType::value_type(
+        key, new_site)).first;
+    }
+
+  vtkKWTclProfilerInternals::CallSiteType *call_site_ptr = &it->second;
+  call_site_ptr->NumberOfEvaluations++;
+  call_site_ptr->TotalTime += duration;
+  if (duration > call_site_ptr->MaximumTime)
+    {
+    call_site_ptr->MaximumTime = duration;
+    }
+  internals->SortedCallSitesUpToDate = 0;
+  internals->SortedClassesUpToDate = 0;
+
+  // Keep the largest scripts
+
+  if (script)
+    {
+    unsigned long length = (unsigned long)strlen(script);
+    if (length > call_site_ptr->MaximumScriptLength)
+      {
+      call_site_ptr->MaximumScriptLength = length;
+      }
+
+    vtkKWTclProfilerInternals::LargestScriptsContainerType &scripts =
+      internals->LargestScripts;
+    if (this->MaximumNumberOfLargestScripts > 0 &&
+        ((int)scripts.size() < this->MaximumNumberOfLargestScripts ||
+         length > scripts.back().Length))
+      {
+      vtkKWTclProfilerInternals::LargestScriptsContainerType::iterator pos =
+        scripts.begin();
+      while (pos != scripts.end() && (*pos).Length >= length)
+        {
+        ++pos;
+        }
+      vtkKWTclProfilerInternals::ScriptType entry;
+      entry.Script = script;
+      entry.Length = length;
+      entry.CallSite = call_site_ptr;
+      entry.Time = duration;
+      scripts.insert(pos, entry);
+      if ((int)scripts.size() > this->MaximumNumberOfLargestScripts)
+        {
+        scripts.pop_back();
+        }
+      }
+    }
+
+  // Record the trace event
+
+  if (this->RecordTraceEvents &&
+      (int)internals->TraceEvents.size() < this->MaximumNumberOfTraceEvents)
+    {
+    vtkKWTclProfilerInternals::TraceEventType event;
+    event.CallSite = call_site_ptr;
+    event.StartTime = start_time - internals->ResetTime;
+    event.Duration = duration;
+    event.Depth = internals->Depth;
+    internals->TraceEvents.push_back(event);
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkKWTclProfiler::GetNumberOfEvaluations()
+{
+  return this->Internals->NumberOfEvaluations;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::GetTotalTime()
+{
+  return this->Internals->TotalTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTclProfiler::GetNumberOfCallSites()
+{
+  return (int)this->Internals->CallSites.size();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthCallSiteClassName(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return NULL;
+    }
+  return this->Internals->SortedCallSites[i]->ClassName.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthCallSiteName(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return NULL;
+    }
+  return this->Internals->SortedCallSites[i]->Name.c_str();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkKWTclProfiler::GetNthCallSiteNumberOfEvaluations(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return 0;
+    }
+  return this->Internals->SortedCallSites[i]->NumberOfEvaluations;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::GetNthCallSiteTotalTime(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return 0.0;
+    }
+  return this->Internals->SortedCallSites[i]->TotalTime;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::GetNthCallSiteMaximumTime(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return 0.0;
+    }
+  return this->Internals->SortedCallSites[i]->MaximumTime;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkKWTclProfiler::GetNthCallSiteMaximumScriptLength(int i)
+{
+  this->Internals->UpdateSortedCallSites();
+  if (i < 0 || i >= (int)this->Internals->SortedCallSites.size())
+    {
+    return 0;
+    }
+  return this->Internals->SortedCallSites[i]->MaximumScriptLength;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTclProfiler::GetNumberOfClasses()
+{
+  this->Internals->UpdateSortedClasses();
+  return (int)this->Internals->SortedClasses.size();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthClassName(int i)
+{
+  this->Internals->UpdateSortedClasses();
+  if (i < 0 || i >= (int)this->Internals->SortedClasses.size())
+    {
+    return NULL;
+    }
+  return this->Internals->SortedClasses[i].Name.c_str();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkKWTclProfiler::GetNthClassNumberOfEvaluations(int i)
+{
+  this->Internals->UpdateSortedClasses();
+  if (i < 0 || i >= (int)this->Internals->SortedClasses.size())
+    {
+    return 0;
+    }
+  return this->Internals->SortedClasses[i].NumberOfEvaluations;
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::GetNthClassTotalTime(int i)
+{
+  this->Internals->UpdateSortedClasses();
+  if (i < 0 || i >= (int)this->Internals->SortedClasses.size())
+    {
+    return 0.0;
+    }
+  return this->Internals->SortedClasses[i].TotalTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTclProfiler::GetNumberOfLargestScripts()
+{
+  return (int)this->Internals->LargestScripts.size();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthLargestScript(int i)
+{
+  if (i < 0 || i >= (int)this->Internals->LargestScripts.size())
+    {
+    return NULL;
+    }
+  return this->Internals->LargestScripts[i].Script.c_str();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkKWTclProfiler::GetNthLargestScriptLength(int i)
+{
+  if (i < 0 || i >= (int)this->Internals->LargestScripts.size())
+    {
+    return 0;
+    }
+  return this->Internals->LargestScripts[i].Length;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthLargestScriptClassName(int i)
+{
+  if (i < 0 || i >= (int)this->Internals->LargestScripts.size())
+    {
+    return NULL;
+    }
+  return this->Internals->LargestScripts[i].CallSite->ClassName.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTclProfiler::GetNthLargestScriptCallSiteName(int i)
+{
+  if (i < 0 || i >= (int)this->Internals->LargestScripts.size())
+    {
+    return NULL;
+    }
+  return this->Internals->LargestScripts[i].CallSite->Name.c_str();
+}
+
+//----------------------------------------------------------------------------
+double vtkKWTclProfiler::GetNthLargestScriptTime(int i)
+{
+  if (i < 0 || i >= (int)this->Internals->LargestScripts.size())
+    {
+    return 0.0;
+    }
+  return this->Internals->LargestScripts[i].Time;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTclProfiler::WriteCallSitesToCSVFile(const char *filename)
+{
+  if (!filename || !*filename)
+    {
+    return 0;
+    }
+
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Unable to open file " << filename);
+    return 0;
+    }
+
+  os << "class,call_site,evaluations,total_time_ms,maximum_time_ms,"
+     << "maximum_script_length" << endl;
+
+  this->Internals->UpdateSortedCallSites();
+  int i, nb_sites = (int)this->Internals->SortedCallSites.size();
+  for (i = 0; i < nb_sites; i++)
+    {
+    vtkKWTclProfilerInternals::CallSiteType *site =
+      this->Internals->SortedCallSites[i];
+
+    // Quote the call site, doubling the quotes
+
+    vtksys_stl::string name(site->Name);
+    vtksys_stl::string::size_type pos = 0;
+    while ((pos = name.find('"', pos)) != vtksys_stl::string::npos)
+      {
+      name.insert(pos, 1, '"');
+      pos += 2;
+      }
+
+    os << site->ClassName.c_str() << ",\"" << name.c_str() << "\","
+       << site->NumberOfEvaluations << ","
+       << site->TotalTime * 1000.0 << ","
+       << site->MaximumTime * 1000.0 << ","
+       << site->MaximumScriptLength << endl;
+    }
+
+  return os ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTclProfiler::WriteTraceEventsToChromeTraceFile(const char *filename)
+{
+  if (!filename || !*filename)
+    {
+    return 0;
+    }
+
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Unable to open file " << filename);
+    return 0;
+    }
+
+  // Complete events ("ph": "X"), time in microseconds
+
+  os << "{\"traceEvents\":[" << endl;
+
+  vtkKWTclProfilerInternals::TraceEventsContainerType::iterator it =
+    this->Internals->TraceEvents.begin();
+  vtkKWTclProfilerInternals::TraceEventsContainerType::iterator end =
+    this->Internals->TraceEvents.end();
+  char buffer[256];
+  for (; it != end; ++it)
+    {
+    if (it != this->Internals->TraceEvents.begin())
+      {
+      os << "," << endl;
+      }
+    os << "{\"name\":";
+    vtkKWTclProfilerInternals::WriteJSONString(
+      os, (*it).CallSite->Name.c_str());
+    os << ",\"cat\":";
+    vtkKWTclProfilerInternals::WriteJSONString(
+      os, (*it).CallSite->ClassName.c_str());
+    sprintf(buffer,
+            ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,"
+            "\"args\":{\"depth\":%d}}",
+            (*it).StartTime * 1000000.0, (*it).Duration * 1000000.0,
+            (*it).Depth);
+    os << buffer;
+    }
+
+  os << endl << "]}" << endl;
+
+  return os ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTclProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Enabled: " << (this->Enabled ? "On" : "Off") << endl;
+  os << indent << "RecordTraceEvents: "
+     << (this->RecordTraceEvents ? "On" : "Off") << endl;
+  os << indent << "MaximumNumberOfTraceEvents: "
+     << this->MaximumNumberOfTraceEvents << endl;
+  os << indent << "MaximumNumberOfLargestScripts: "
+     << this->MaximumNumberOfLargestScripts << endl;
+  os << indent << "NumberOfEvaluations: "
+     << this->GetNumberOfEvaluations() << endl;
+  os << indent << "TotalTime: " << this->GetTotalTime() << endl;
+}
@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Module:    $RCSfile: vtkKWTclProfiler.h,v $
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkKWTclProfiler - a profiler for the Tcl evaluations
+// .SECTION Description
+// This class records the Tcl evaluations issued by KWWidgets, so that one
+// can find out which widgets are spending time in the interpreter:
+// the scripts evaluated by vtkKWTkUtilities (i.e. vtkKWObject::Script),
+// the commands invoked by vtkKWTkUtilities::EvaluateCommand, the script
+// batches of vtkKWApplication, and the methods invoked by the callbacks
+// created by vtkKWTkUtilities::CreateObjectMethodCommand (say, a vtkKWScale
+// -command invoking a C++ method), whether they were created before or
+// after the profiler was enabled. The callback commands themselves are left
+// unchanged: the Tcl command of their object is instrumented instead, until
+// the profiler is disabled.
+//
+// Each evaluation is attributed to the class of the object that issued it,
+// and to a call site, i.e. the printf-like format passed to Script() or
+// the first line of the script, where widget names and numbers are
+// replaced by placeholders. The number of evaluations, the cumulative
+// and the maximum wall time (in seconds, including nested evaluations),
+// are recorded for each call site, and the largest scripts are kept.
+// Statistics can be queried from C++ or Tcl, or written to a CSV file.
+// Each evaluation can also be recorded as a trace event, to be written
+// to a file that can be loaded in the Chrome trace viewer
+// (chrome://tracing).
+//
+// Each vtkKWApplication has a unique instance of a vtkKWTclProfiler (see
+// vtkKWApplication::GetTclProfiler). The profiler is disabled by default,
+// in which case it costs a single integer test per evaluation.
+// .SECTION See Also
+// vtkKWApplication vtkKWTkUtilities
+
+#ifndef __vtkKWTclProfiler_h
+#define __vtkKWTclProfiler_h
+
+#include "vtkKWObject.h"
+
+class vtkKWTclProfilerInternals;
+
+class KWWidgets_EXPORT vtkKWTclProfiler : public vtkKWObject
+{
+public:
+  static vtkKWTclProfiler* New();
+  vtkTypeRevisionMacro(vtkKWTclProfiler, vtkKWObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Enable/disable the profiler. The statistics recorded so far are kept
+  // when the profiler is disabled (see Reset).
+  virtual void SetEnabled(int);
+  vtkGetMacro(Enabled, int);
+  vtkBooleanMacro(Enabled, int);
+
+  // Description:
+  // Set/Get if each evaluation should be recorded as a trace event (see
+  // WriteTraceEventsToChromeTraceFile), up to MaximumNumberOfTraceEvents
+  // events (the next ones are dropped).
+  vtkSetMacro(RecordTraceEvents, int);
+  vtkGetMacro(RecordTraceEvents, int);
+  vtkBooleanMacro(RecordTraceEvents, int);
+  vtkSetMacro(MaximumNumberOfTraceEvents, int);
+  vtkGetMacro(MaximumNumberOfTraceEvents, int);
+
+  // Description:
+  // Set/Get the number of largest scripts to keep.
+  vtkSetMacro(MaximumNumberOfLargestScripts, int);
+  vtkGetMacro(MaximumNumberOfLargestScripts, int);
+
+  // Description:
+  // Discard all the statistics and trace events recorded so far.
+  virtual void Reset();
+
+  // Description:
+  // Get the total number of evaluations, and their cumulative wall time
+  // (in seconds, not counting the time spent in nested evaluations twice).
+  virtual unsigned long GetNumberOfEvaluations();
+  virtual double GetTotalTime();
+
+  // Description:
+  // Get the statistics of each call site, sorted by decreasing
+  // cumulative time: the class that issued the evaluations, the call site
+  // name, the number of evaluations, their cumulative and maximum time
+  // (in seconds), and the length of the largest script.
+  virtual int GetNumberOfCallSites();
+  virtual const char* GetNthCallSiteClassName(int i);
+  virtual const char* GetNthCallSiteName(int i);
+  virtual unsigned long GetNthCallSiteNumberOfEvaluations(int i);
+  virtual double GetNthCallSiteTotalTime(int i);
+  virtual double GetNthCallSiteMaximumTime(int i);
+  virtual unsigned long GetNthCallSiteMaximumScriptLength(int i);
+
+  // Description:
+  // Get the statistics of each class (i.e. of all its call sites),
+  // sorted by decreasing cumulative time.
+  virtual int GetNumberOfClasses();
+  virtual const char* GetNthClassName(int i);
+  virtual unsigned long GetNthClassNumberOfEvaluations(int i);
+  virtual double GetNthClassTotalTime(int i);
+
+  // Description:
+  // Get the largest scripts, sorted by decreasing length: the script
+  // itself, its length, the class and call site that evaluated it, and
+  // the time it took (in seconds).
+  virtual int GetNumberOfLargestScripts();
+  virtual const char* GetNthLargestScript(int i);
+  virtual unsigned long GetNthLargestScriptLength(int i);
+  virtual const char* GetNthLargestScriptClassName(int i);
+  virtual const char* GetNthLargestScriptCallSiteName(int i);
+  virtual double GetNthLargestScriptTime(int i);
+
+  // Description:
+  // Write the statistics of each call site to a CSV file, or the trace
+  // events to a Chrome trace file (JSON).
+  // Return 1 on success, 0 otherwise.
+  virtual int WriteCallSitesToCSVFile(const char *filename);
+  virtual int WriteTraceEventsToChromeTraceFile(const char *filename);
+
+  // Description:
+  // Get the enabled profiler of a Tcl interpreter, if any. This is meant
+  // to be cheap when no profiler is enabled.
+  //BTX
+  static vtkKWTclProfiler* GetEnabledProfiler(Tcl_Interp *interp)
+    {
+      return vtkKWTclProfiler::NumberOfEnabledProfilers
+        ? vtkKWTclProfiler::GetEnabledProfilerInternal(interp) : NULL;
+    }
+  //ETX
+
+  // Description:
+  // Record an evaluation. BeginEvaluation returns the time the evaluation
+  // started, to be passed to EndEvaluation once it is done, along with the
+  // class of the object that issued it (can be NULL), its call site (can be
+  // NULL, in which case it is computed from 'script'), and the script
+  // itself (can be NULL, in which case it is not considered for the largest
+  // scripts). This is used by vtkKWTkUtilities and vtkKWApplication.
+  virtual double BeginEvaluation();
+  virtual void EndEvaluation(
+    double start_time,
+    const char *class_name, const char *call_site, const char *script);
+
+  // Description:
+  // Instrument the Tcl command of an object (say, "vtkTemp12"), so that
+  // each method invoked through it is profiled as a call site of the
+  // object class, until the profiler is disabled. This does nothing if
+  // the profiler is disabled. This is used by
+  // vtkKWTkUtilities::CreateObjectMethodCommand for the callback objects,
+  // and by SetEnabled for the objects that already have a Tcl command.
+  virtual void InstrumentObjectCommand(
+    const char *command_name, const char *class_name);
+
+protected:
+  vtkKWTclProfiler();
+  ~vtkKWTclProfiler();
+
+  int Enabled;
+  int RecordTraceEvents;
+  int MaximumNumberOfTraceEvents;
+  int MaximumNumberOfLargestScripts;
+
+  // PIMPL Encapsulation for STL containers
+  //BTX
+  vtkKWTclProfilerInternals *Internals;
+  friend class vtkKWTclProfilerInternals;
+
+  static int NumberOfEnabledProfilers;
+  static vtkKWTclProfiler* GetEnabledProfilerInternal(Tcl_Interp *interp);
+  //ETX
+
+private:
+
+  vtkKWTclProfiler(const vtkKWTclProfiler&); // Not implemented
+  void operator=(const vtkKWTclProfiler&); // Not implemented
+};
+
+#endif
@@ -539,9 +539,9 @@ void vtkKWTextPropertyEditor::UpdateLabel()
 {
   if (this->IsCreated() && this->Label)
     {
-    this->Script("grid %s %s",
-                 (this->LabelVisibility ? "" : "remove"), 
-                 this->Label->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      (this->LabelVisibility ? "" : "remove"), 
+                      this->Label->GetWidgetName());
     }
 }
 
@@ -624,9 +624,9 @@ void vtkKWTextPropertyEditor::UpdateColorButton()
       this->ChangeColorButton->SetColor(this->GetColor());
       }
 
-    this->Script("grid %s %s",
-                 (this->ColorVisibility ? "" : "remove"), 
-                 this->ChangeColorButton->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      (this->ColorVisibility ? "" : "remove"), 
+                      this->ChangeColorButton->GetWidgetName());
     }
 }
 
@@ -688,9 +688,9 @@ void vtkKWTextPropertyEditor::UpdateFontFamilyOptionMenu()
           ks_("Font|Times"));
         break;
       }
-    this->Script("grid %s %s",
-                 (this->FontFamilyVisibility ? "" : "remove"), 
-                 this->FontFamilyOptionMenu->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      (this->FontFamilyVisibility ? "" : "remove"), 
+                      this->FontFamilyOptionMenu->GetWidgetName());
     }
 }
 
@@ -733,9 +733,9 @@ void vtkKWTextPropertyEditor::UpdateStylesCheckButtonSet()
 {
   if (this->IsCreated() && this->StylesCheckButtonSet)
     {
-    this->Script("grid %s %s",
-                 (this->StylesVisibility ? "" : "remove"), 
-                 this->StylesCheckButtonSet->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      (this->StylesVisibility ? "" : "remove"), 
+                      this->StylesCheckButtonSet->GetWidgetName());
     }
 
   this->UpdateBoldCheckButton();
@@ -919,9 +919,9 @@ void vtkKWTextPropertyEditor::UpdateOpacityScale()
       this->TextProperty)
     {
     this->OpacityScale->SetValue(this->GetOpacity());
-    this->Script("grid %s %s",
-                 (this->OpacityVisibility ? "" : "remove"), 
-                 this->OpacityScale->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      (this->OpacityVisibility ? "" : "remove"), 
+                      this->OpacityScale->GetWidgetName());
     }
 }
 
@@ -969,10 +969,10 @@ void vtkKWTextPropertyEditor::UpdatePushButtonSet()
     this->PushButtonSet->GetWidget()->SetWidgetVisibility(
       VTK_KW_TEXT_PROP_COPY_ID, this->CopyVisibility);
 
-    this->Script("grid %s %s",
-                 (this->PushButtonSet->GetWidget()
+    this->QueueScript("grid %s %s",
+                      (this->PushButtonSet->GetWidget()
                   ->GetNumberOfVisibleWidgets() ? "" : "remove"), 
-                 this->PushButtonSet->GetWidgetName());
+                      this->PushButtonSet->GetWidgetName());
     }
 }
 
@@ -18,6 +18,7 @@
 #include "vtkKWApplication.h"
 #include "vtkObjectFactory.h"
 #include "vtkKWOptionDataBase.h"
+#include "vtkKWCoreWidget.h"
 #include "vtkKWOptions.h"
 
 //----------------------------------------------------------------------------
@@ -50,6 +51,10 @@ void vtkKWTheme::Install()
 
   this->BackupCurrentOptionDataBase();
 
+  // The theme is likely to change the look of existing widgets
+
+  vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches();
+
   /* Here is the kind of thing you could probably do here.
      Check the Themes example in the Examples/Cxx subdirectory.
    */
@@ -68,6 +73,8 @@ void vtkKWTheme::Install()
 void vtkKWTheme::Uninstall()
 {
   this->RestorePreviousOptionDataBase();
+
+  vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches();
 }
 
 //----------------------------------------------------------------------------
@@ -96,6 +96,8 @@ vtkKWThumbWheel::vtkKWThumbWheel()
   this->TopLevel        = NULL;
   this->PopupPushButton = NULL;
 
+  this->ThumbWheelSurface = new vtkKWTkPhotoSurface;
+
   this->State           = vtkKWThumbWheel::Idle;
 
   this->ThumbWheelShift = 0.0;
@@ -135,6 +137,9 @@ vtkKWThumbWheel::~vtkKWThumbWheel()
     this->ThumbWheel = NULL;
     }
 
+  delete this->ThumbWheelSurface;
+  this->ThumbWheelSurface = NULL;
+
   if (this->Entry)
     {
     this->Entry->Delete();
@@ -559,60 +564,60 @@ void vtkKWThumbWheel::PackWidget()
     {
     if (this->DisplayEntryAndLabelOnTop && !this->PopupMode)
       {
-      this->Script("pack %s -side bottom -fill x -expand %d -pady 0 -padx 0",
-                   this->ThumbWheel->GetWidgetName(),
-                   this->ResizeThumbWheel);
+      this->QueueScript("pack %s -side bottom -fill x -expand %d -pady 0 -padx 0",
+                        this->ThumbWheel->GetWidgetName(),
+                        this->ResizeThumbWheel);
       }
     else
       {
-      this->Script("pack %s -side left -fill x -expand %d -pady 0 -padx 0",
-                   this->ThumbWheel->GetWidgetName(),
-                   this->ResizeThumbWheel);
+      this->QueueScript("pack %s -side left -fill x -expand %d -pady 0 -padx 0",
+                        this->ThumbWheel->GetWidgetName(),
+                        this->ResizeThumbWheel);
       }
     }
 
   if (this->Label && this->Label->IsCreated())
     {
-    this->Script("pack forget %s", this->Label->GetWidgetName());
+    this->QueueScript("pack forget %s", this->Label->GetWidgetName());
     if (this->DisplayLabel)
       {
       if (this->DisplayEntryAndLabelOnTop || this->PopupMode)
         {
-        this->Script("pack %s -side left -padx 0 -fill y", 
-                     this->Label->GetWidgetName());
+        this->QueueScript("pack %s -side left -padx 0 -fill y", 
+                          this->Label->GetWidgetName());
         }
       else
         {
-        this->Script("pack %s -side left -padx 0 -fill y -before %s", 
-                     this->Label->GetWidgetName(), 
-                     this->ThumbWheel->GetWidgetName());
+        this->QueueScript("pack %s -side left -padx 0 -fill y -before %s", 
+                          this->Label->GetWidgetName(), 
+                          this->ThumbWheel->GetWidgetName());
         }
       }
     }
 
   if (this->Entry && this->Entry->IsCreated())
     {
-    this->Script("pack forget %s", this->Entry->GetWidgetName());
+    this->QueueScript("pack forget %s", this->Entry->GetWidgetName());
     if (this->DisplayEntry)
       {
       if (this->PopupMode)
         {
-        this->Script("pack %s -side left -padx 0 %s", 
-                     this->Entry->GetWidgetName(),
-                     (this->ExpandEntry ? "-fill both -expand t" : "-fill y"));
+        this->QueueScript("pack %s -side left -padx 0 %s", 
+                          this->Entry->GetWidgetName(),
+                          (this->ExpandEntry ? "-fill both -expand t" : "-fill y"));
         }
       else
         {
         if (this->DisplayEntryAndLabelOnTop)
           {
-          this->Script("pack %s -side right -padx 0 -fill y", 
-                       this->Entry->GetWidgetName());
+          this->QueueScript("pack %s -side right -padx 0 -fill y", 
+                            this->Entry->GetWidgetName());
           }
         else
           {
-          this->Script("pack %s -side right -padx 0 -fill y -after %s", 
-                       this->Entry->GetWidgetName(), 
-                       this->ThumbWheel->GetWidgetName());
+          this->QueueScript("pack %s -side right -padx 0 -fill y -after %s", 
+                            this->Entry->GetWidgetName(), 
+                            this->ThumbWheel->GetWidgetName());
           }
         }
       }
@@ -621,18 +626,18 @@ void vtkKWThumbWheel::PackWidget()
   if (this->PopupMode && 
       this->PopupPushButton && this->PopupPushButton->IsCreated())
     {
-    this->Script("pack forget %s", this->PopupPushButton->GetWidgetName());
+    this->QueueScript("pack forget %s", this->PopupPushButton->GetWidgetName());
     if (this->DisplayLabel || this->DisplayEntry)
       {
-      this->Script("pack %s -side left -padx 1 -fill y -ipadx 1 -after %s", 
-                   this->PopupPushButton->GetWidgetName(),
-                   (this->Entry ? this->Entry->GetWidgetName() 
+      this->QueueScript("pack %s -side left -padx 1 -fill y -ipadx 1 -after %s", 
+                        this->PopupPushButton->GetWidgetName(),
+                        (this->Entry ? this->Entry->GetWidgetName() 
                                 : this->Label->GetWidgetName()));
       }
     else
       {
-      this->Script("pack %s -side left -padx 1 -fill y -ipadx 1", 
-                   this->PopupPushButton->GetWidgetName());
+      this->QueueScript("pack %s -side left -padx 1 -fill y -ipadx 1", 
+                        this->PopupPushButton->GetWidgetName());
       }
     }
 }
@@ -1235,6 +1240,11 @@ void vtkKWThumbWheel::UpdateEnableState()
 // ---------------------------------------------------------------------------
 void vtkKWThumbWheel::UpdateThumbWheelImage(double pos)
 {
+  if (!this->ThumbWheel->IsCreated())
+    {
+    return;
+    }
+
   // Show position indicator ? Compute range
 
   int posx_start = 0, posx_end = 0;
@@ -1280,9 +1290,14 @@ void vtkKWThumbWheel::UpdateThumbWheelImage(double pos)
   int last_notch = 0;
   int relief_flag = 0;
 
-  // Allocate buffer for the whole wheel
+  // Get the buffer for the whole wheel (only reallocated if it grows)
 
-  unsigned char *img_buffer = new unsigned char[img_buffer_size];
+  if (!this->ThumbWheelSurface->SetSize(
+        this->ThumbWheelWidth, this->ThumbWheelHeight, img_pixel_size))
+    {
+    return;
+    }
+  unsigned char *img_buffer = this->ThumbWheelSurface->GetPixels();
 
     // img_ptr_s0: 1st row = gray - shadow * 2 (i.e. dark shadow)
     // img_ptr_s1: 2nd row = gray - shadow     (i.e. ligh shadow)
@@ -1495,14 +1510,22 @@ void vtkKWThumbWheel::UpdateThumbWheelImage(double pos)
       }
     }
 
-  // Update the Tk photo
+  // Update the Tk photo. The notches move with the wheel, so it has
+  // to be sent as a whole. Only set the -image option the first time.
 
-  this->ThumbWheel->SetImageToPixels(img_buffer,
-                                     this->ThumbWheelWidth, 
-                                     this->ThumbWheelHeight, 
-                                     img_pixel_size);
+  this->ThumbWheelSurface->MarkAsModified();
 
-  delete [] img_buffer;
+  vtksys_stl::string image_name(this->ThumbWheel->GetWidgetName());
+  image_name += ".image";
+  if (this->ThumbWheelSurface->UpdatePhoto(
+        this->GetApplication(), image_name.c_str()))
+    {
+    const char *image = this->ThumbWheel->GetConfigurationOption("-image");
+    if (!image || strcmp(image, image_name.c_str()))
+      {
+      this->ThumbWheel->SetConfigurationOption("-image", image_name.c_str());
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
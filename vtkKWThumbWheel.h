@@ -25,6 +25,7 @@ class vtkKWLabel;
 class vtkKWEntry;
 class vtkKWPushButton;
 class vtkKWTopLevel;
+class vtkKWTkPhotoSurface;
 
 class KWWidgets_EXPORT vtkKWThumbWheel : public vtkKWCompositeWidget
 {
@@ -349,6 +350,9 @@ protected:
   vtkKWTopLevel *TopLevel;
   vtkKWPushButton *PopupPushButton;
 
+  // The wheel image, reused from one update to the next
+  vtkKWTkPhotoSurface *ThumbWheelSurface;
+
   void CreateEntry();
   void CreateLabel();
   void UpdateThumbWheelImage(double pos = -1.0);
@@ -16,6 +16,7 @@
 #include "vtkKWCoreWidget.h"
 #include "vtkKWApplication.h"
 #include "vtkKWResourceUtilities.h"
+#include "vtkKWTclProfiler.h"
 #include "vtkKWIcon.h"
 #include "vtkKWColorPickerDialog.h"
 #include "vtkKWColorPickerWidget.h"
@@ -48,6 +49,325 @@
 vtkStandardNewMacro(vtkKWTkUtilities);
 vtkCxxRevisionMacro(vtkKWTkUtilities, "$Revision: 1.103 $");
 
+//----------------------------------------------------------------------------
+// Evaluate a script in the global scope, after the scripts waiting in a 
+// batch, if any (see vtkKWApplication::BeginScriptBatch), since it may
+// depend on them (say, query the geometry of a widget whose creation or
+// packing was queued)
+static int vtkKWTkUtilitiesGlobalEval(Tcl_Interp *interp, const char *script)
+{
+  vtkKWApplication::FlushPendingScriptBatch(interp);
+  return Tcl_GlobalEval(interp, script);
+}
+
+//----------------------------------------------------------------------------
+vtkKWTkCommandArguments::vtkKWTkCommandArguments()
+{
+  this->Arguments = this->StaticArguments;
+  this->NumberOfArguments = 0;
+  this->Size = vtkKWTkCommandArguments::NumberOfStaticArguments;
+}
+
+//----------------------------------------------------------------------------
+vtkKWTkCommandArguments::~vtkKWTkCommandArguments()
+{
+  this->RemoveAllArguments();
+  if (this->Arguments != this->StaticArguments)
+    {
+    delete [] this->Arguments;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkCommandArguments::AddObject(Tcl_Obj *obj)
+{
+  if (!obj)
+    {
+    return;
+    }
+
+  if (this->NumberOfArguments == this->Size)
+    {
+    Tcl_Obj **arguments = new Tcl_Obj* [this->Size * 2];
+    memcpy(arguments, this->Arguments, this->Size * sizeof(Tcl_Obj*));
+    if (this->Arguments != this->StaticArguments)
+      {
+      delete [] this->Arguments;
+      }
+    this->Arguments = arguments;
+    this->Size *= 2;
+    }
+
+  Tcl_IncrRefCount(obj);
+  this->Arguments[this->NumberOfArguments++] = obj;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkCommandArguments::AddInt(int value)
+{
+  this->AddObject(Tcl_NewIntObj(value));
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkCommandArguments::AddDouble(double value)
+{
+  this->AddObject(Tcl_NewDoubleObj(value));
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkCommandArguments::AddString(const char *value)
+{
+  this->AddObject(Tcl_NewStringObj(value ? value : "", -1));
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkCommandArguments::RemoveAllArguments()
+{
+  for (int i = 0; i < this->NumberOfArguments; i++)
+    {
+    Tcl_DecrRefCount(this->Arguments[i]);
+    }
+  this->NumberOfArguments = 0;
+}
+
+//----------------------------------------------------------------------------
+// Find a Tk photo, create it if it does not exist yet
+
+static Tk_PhotoHandle vtkKWTkUtilitiesFindOrCreatePhoto(
+  Tcl_Interp *interp, const char *photo_name)
+{
+  Tk_PhotoHandle photo = Tk_FindPhoto(interp, const_cast<char *>(photo_name));
+  if (photo)
+    {
+    return photo;
+    }
+
+  vtksys_ios::ostringstream create_photo;
+  create_photo << "image create photo " << photo_name;
+  int res = vtkKWTkUtilitiesGlobalEval(interp, create_photo.str().c_str());
+  if (res != TCL_OK)
+    {
+    vtkGenericWarningMacro(
+      << "Unable to create photo " << photo_name << ": " 
+      << Tcl_GetStringResult(interp));
+    return NULL;
+    }
+
+  photo = Tk_FindPhoto(interp, const_cast<char *>(photo_name));
+  if (!photo)
+    {
+    vtkGenericWarningMacro(<< "Error looking up Tk photo:" << photo_name);
+    }
+  return photo;
+}
+
+//----------------------------------------------------------------------------
+// Tcl/Tk 8.4.8 and before still do not support transparency correctly,
+// they will handle only fully transparent (0) or opaque (255)
+
+static int vtkKWTkUtilitiesSupportsPartialTransparency()
+{
+  int tcl_major, tcl_minor, tcl_patch_level;
+  Tcl_GetVersion(&tcl_major, &tcl_minor, &tcl_patch_level, NULL);
+  return !(tcl_major < 8 ||
+           (tcl_major == 8 && 
+            (tcl_minor < 4 || 
+             (tcl_minor == 4 && tcl_patch_level <= 8))));
+}
+
+//----------------------------------------------------------------------------
+vtkKWTkPhotoSurface::vtkKWTkPhotoSurface()
+{
+  this->Pixels = NULL;
+  this->Capacity = 0;
+  this->Width = 0;
+  this->Height = 0;
+  this->PixelSize = 0;
+  this->ModifiedRegion[0] = this->ModifiedRegion[1] = 0;
+  this->ModifiedRegion[2] = this->ModifiedRegion[3] = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkKWTkPhotoSurface::~vtkKWTkPhotoSurface()
+{
+  delete [] this->Pixels;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTkPhotoSurface::SetSize(int width, int height, int pixel_size)
+{
+  if (width <= 0 || height <= 0 || (pixel_size != 3 && pixel_size != 4))
+    {
+    return 0;
+    }
+
+  if (width == this->Width && 
+      height == this->Height && 
+      pixel_size == this->PixelSize)
+    {
+    return 1;
+    }
+
+  unsigned long size = (unsigned long)width * height * pixel_size;
+  if (size > this->Capacity)
+    {
+    delete [] this->Pixels;
+    this->Pixels = new unsigned char [size];
+    this->Capacity = size;
+    }
+
+  this->Width = width;
+  this->Height = height;
+  this->PixelSize = pixel_size;
+
+  // The previous region may lie outside the new surface, start afresh
+
+  this->ModifiedRegion[0] = this->ModifiedRegion[1] = 0;
+  this->ModifiedRegion[2] = this->ModifiedRegion[3] = 0;
+  this->MarkAsModified();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkPhotoSurface::MarkRegionAsModified(
+  int x, int y, int width, int height)
+{
+  // Clip to the surface
+
+  int x_max = x + width, y_max = y + height;
+  if (x < 0)
+    {
+    x = 0;
+    }
+  if (y < 0)
+    {
+    y = 0;
+    }
+  if (x_max > this->Width)
+    {
+    x_max = this->Width;
+    }
+  if (y_max > this->Height)
+    {
+    y_max = this->Height;
+    }
+  if (x >= x_max || y >= y_max)
+    {
+    return;
+    }
+
+  // Merge with the current region
+
+  if (this->IsModified())
+    {
+    if (x > this->ModifiedRegion[0])
+      {
+      x = this->ModifiedRegion[0];
+      }
+    if (y > this->ModifiedRegion[1])
+      {
+      y = this->ModifiedRegion[1];
+      }
+    if (x_max < this->ModifiedRegion[2])
+      {
+      x_max = this->ModifiedRegion[2];
+      }
+    if (y_max < this->ModifiedRegion[3])
+      {
+      y_max = this->ModifiedRegion[3];
+      }
+    }
+
+  this->ModifiedRegion[0] = x;
+  this->ModifiedRegion[1] = y;
+  this->ModifiedRegion[2] = x_max;
+  this->ModifiedRegion[3] = y_max;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkPhotoSurface::MarkAsModified()
+{
+  this->MarkRegionAsModified(0, 0, this->Width, this->Height);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTkPhotoSurface::IsModified()
+{
+  return (this->ModifiedRegion[0] < this->ModifiedRegion[2] &&
+          this->ModifiedRegion[1] < this->ModifiedRegion[3]);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTkPhotoSurface::UpdatePhoto(Tcl_Interp *interp, 
+                                     const char *photo_name)
+{
+  if (!interp || !photo_name || !photo_name[0] || !this->Pixels)
+    {
+    return 0;
+    }
+
+  // Let UpdatePhoto blend the RGBA pixels if Tk can not do it
+
+  if (this->PixelSize == 4 && !vtkKWTkUtilitiesSupportsPartialTransparency())
+    {
+    this->ModifiedRegion[0] = this->ModifiedRegion[1] = 0;
+    this->ModifiedRegion[2] = this->ModifiedRegion[3] = 0;
+    return vtkKWTkUtilities::UpdatePhoto(
+      interp, photo_name, 
+      this->Pixels, this->Width, this->Height, this->PixelSize);
+    }
+
+  Tk_PhotoHandle photo = vtkKWTkUtilitiesFindOrCreatePhoto(interp, photo_name);
+  if (!photo)
+    {
+    return 0;
+    }
+
+  // Resize the photo if needed (say, it was just created), and send it all
+
+  int photo_width, photo_height;
+  Tk_PhotoGetSize(photo, &photo_width, &photo_height);
+  if (photo_width != this->Width || photo_height != this->Height)
+    {
+    Tk_PhotoSetSize(
+#if (TCL_MAJOR_VERSION == 8) && (TCL_MINOR_VERSION <= 4)
+#else
+      interp,
+#endif
+      photo, this->Width, this->Height);
+    this->MarkAsModified();
+    }
+
+  if (!this->IsModified())
+    {
+    return 1;
+    }
+
+  int res = vtkKWTkUtilities::UpdatePhotoRegion(
+    interp, photo_name, 
+    this->Pixels, this->Width, this->Height, this->PixelSize,
+    this->ModifiedRegion[0], this->ModifiedRegion[1], 
+    this->ModifiedRegion[2] - this->ModifiedRegion[0], 
+    this->ModifiedRegion[3] - this->ModifiedRegion[1]);
+
+  this->ModifiedRegion[0] = this->ModifiedRegion[1] = 0;
+  this->ModifiedRegion[2] = this->ModifiedRegion[3] = 0;
+
+  return res;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTkPhotoSurface::UpdatePhoto(vtkKWApplication *app, 
+                                     const char *photo_name)
+{
+  if (!app)
+    {
+    return 0;
+    }
+  return this->UpdatePhoto(app->GetMainInterp(), photo_name);
+}
+
 //----------------------------------------------------------------------------
 const char* vtkKWTkUtilities::GetTclNameFromPointer(
   Tcl_Interp *interp,
@@ -141,6 +461,54 @@ const char* vtkKWTkUtilities::EvaluateStringFromArgs(
     var_args2);
 }
 
+//----------------------------------------------------------------------------
+// A printf-like string formatted from a variable argument list: 'var_args1'
+// is used to estimate its length, 'var_args2' to print it. The string is 
+// printed on the stack if it fits, on the heap otherwise.
+
+class vtkKWTkUtilitiesFormattedString
+{
+public:
+  vtkKWTkUtilitiesFormattedString(
+    const char *format, va_list var_args1, va_list var_args2)
+    {
+      this->String = this->BufferOnStack;
+
+      // Estimate the length of the result string.  Never underestimates.
+
+      int length = 
+        vtksys::SystemTools::EstimateFormatLength(format, var_args1);
+  
+      // If our stack-allocated buffer is too small, allocate on one on
+      // the heap that will be large enough.
+
+      if (length > BufferOnStackLength - 1)
+        {
+        this->String = new char[length + 1];
+        }
+  
+      // Print to the buffer.
+
+      vsprintf(this->String, format, var_args2);
+    }
+
+  ~vtkKWTkUtilitiesFormattedString()
+    {
+      // Free the buffer from the heap if we allocated it.
+
+      if (this->String != this->BufferOnStack)
+        {
+        delete [] this->String;
+        }
+    }
+
+  char *String;
+
+private:
+  enum { BufferOnStackLength = 1600 };
+  char BufferOnStack[BufferOnStackLength];
+};
+
 //----------------------------------------------------------------------------
 const char* vtkKWTkUtilities::EvaluateStringFromArgsInternal(
   Tcl_Interp *interp,
@@ -149,41 +517,37 @@ const char* vtkKWTkUtilities::EvaluateStringFromArgsInternal(
   va_list var_args1,
   va_list var_args2)
 {
-  const int buffer_on_stack_length = 1600;
-  char buffer_on_stack[buffer_on_stack_length];
-  char* buffer = buffer_on_stack;
-  
-  // Estimate the length of the result string.  Never underestimates.
+  vtkKWTkUtilitiesFormattedString str(format, var_args1, var_args2);
 
-  int length = vtksys::SystemTools::EstimateFormatLength(format, var_args1);
-  
-  // If our stack-allocated buffer is too small, allocate on one on
-  // the heap that will be large enough.
+  // Evaluate the string in Tcl, and return the Tcl result (before the
+  // buffer is freed)
 
-  if(length > buffer_on_stack_length - 1)
+  return vtkKWTkUtilities::EvaluateSimpleStringInternal(
+    interp, obj, str.String, format);
+}
+
+//----------------------------------------------------------------------------
+void vtkKWTkUtilities::QueueStringFromArgs(
+  vtkKWApplication *app,
+  vtkObject *obj,
+  const char* format,
+  va_list var_args1,
+  va_list var_args2)
+{
+  if (!app)
     {
-    buffer = new char[length + 1];
+    return;
     }
-  
-  // Print to the buffer.
-
-  vsprintf(buffer, format, var_args2);
-  
-  // Evaluate the string in Tcl.
 
-  const char *res = 
-    vtkKWTkUtilities::EvaluateSimpleStringInternal(interp, obj, buffer);
-  
-  // Free the buffer from the heap if we allocated it.
-
-  if (buffer != buffer_on_stack)
+  if (app->GetScriptBatchDepth() <= 0)
     {
-    delete [] buffer;
+    vtkKWTkUtilities::EvaluateStringFromArgsInternal(
+      app->GetMainInterp(), app, format, var_args1, var_args2);
+    return;
     }
-  
-  // Convert the Tcl result to its string representation.
 
-  return res;
+  vtkKWTkUtilitiesFormattedString str(format, var_args1, var_args2);
+  app->AddScriptToBatch(obj, str.String);
 }
 
 //----------------------------------------------------------------------------
@@ -196,7 +560,7 @@ const char* vtkKWTkUtilities::EvaluateSimpleString(
     return NULL;
     }
   return vtkKWTkUtilities::EvaluateSimpleStringInternal(
-    app->GetMainInterp(), app, str);
+    app->GetMainInterp(), app, str, NULL);
 }
 
 //----------------------------------------------------------------------------
@@ -205,30 +569,32 @@ const char* vtkKWTkUtilities::EvaluateSimpleString(
   const char* str)
 {
   return vtkKWTkUtilities::EvaluateSimpleStringInternal(
-    interp, NULL, str);
+    interp, NULL, str, NULL);
 }
 
 //----------------------------------------------------------------------------
 const char* vtkKWTkUtilities::EvaluateSimpleStringInternal(
   Tcl_Interp *interp,
   vtkObject *obj,
-  const char *str)
+  const char *str,
+  const char *call_site)
 {
-  static vtksys_stl::string err;
-  static vtksys_stl::string errInfo;
-  
-  if (Tcl_GlobalEval(interp, str) != TCL_OK && obj)
-    {
-    err = Tcl_GetStringResult(interp); // need to save now
-    errInfo = Tcl_GetVar(interp, "errorInfo", 
-        TCL_GLOBAL_ONLY | TCL_LEAVE_ERR_MSG ); // get the error message too
-    vtkErrorWithObjectMacro(
-      obj, "\n    Script: \n" << str
-      << "\n    Returned Error on line "
-      << interp->errorLine << ": \n"  
-      << err.c_str() << "\nStack trace: \n"
-      << errInfo.c_str() << endl);
-    return err.c_str();
+  vtkKWApplication::FlushPendingScriptBatch(interp);
+
+  vtkKWTclProfiler *profiler = vtkKWTclProfiler::GetEnabledProfiler(interp);
+  double start = profiler ? profiler->BeginEvaluation() : 0.0;
+
+  int res = Tcl_GlobalEval(interp, str);
+
+  if (profiler && profiler == vtkKWTclProfiler::GetEnabledProfiler(interp))
+    {
+    profiler->EndEvaluation(
+      start, obj ? obj->GetClassName() : NULL, call_site, str);
+    }
+
+  if (res != TCL_OK && obj)
+    {
+    return vtkKWTkUtilities::ReportEvaluationError(interp, obj, str);
     }
   
   // Convert the Tcl result to its string representation.
@@ -236,6 +602,163 @@ const char* vtkKWTkUtilities::EvaluateSimpleStringInternal(
   return Tcl_GetStringResult(interp);
 }
 
+//----------------------------------------------------------------------------
+const char* vtkKWTkUtilities::ReportEvaluationError(
+  Tcl_Interp *interp,
+  vtkObject *obj,
+  const char *str)
+{
+  static vtksys_stl::string err;
+  static vtksys_stl::string errInfo;
+  
+  err = Tcl_GetStringResult(interp); // need to save now
+  errInfo = Tcl_GetVar(interp, "errorInfo", 
+      TCL_GLOBAL_ONLY | TCL_LEAVE_ERR_MSG ); // get the error message too
+  vtkErrorWithObjectMacro(
+    obj, "\n    Script: \n" << str
+    << "\n    Returned Error on line "
+    << interp->errorLine << ": \n"  
+    << err.c_str() << "\nStack trace: \n"
+    << errInfo.c_str() << endl);
+  return err.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTkUtilities::EvaluateCommand(
+  vtkKWApplication *app,
+  const char *command,
+  const char *subcommand,
+  vtkKWTkCommandArguments *args)
+{
+  if (!app)
+    {
+    return NULL;
+    }
+  return vtkKWTkUtilities::EvaluateCommandInternal(
+    app->GetMainInterp(), app, command, subcommand, args);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTkUtilities::EvaluateCommand(
+  Tcl_Interp *interp,
+  const char *command,
+  const char *subcommand,
+  vtkKWTkCommandArguments *args)
+{
+  return vtkKWTkUtilities::EvaluateCommandInternal(
+    interp, NULL, command, subcommand, args);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTkUtilities::EvaluateCommand(
+  vtkKWApplication *app,
+  vtkObject *obj,
+  const char *command,
+  const char *subcommand,
+  vtkKWTkCommandArguments *args)
+{
+  if (!app)
+    {
+    return NULL;
+    }
+  return vtkKWTkUtilities::EvaluateCommandInternal(
+    app->GetMainInterp(), obj ? obj : app, command, subcommand, args);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkKWTkUtilities::EvaluateCommandInternal(
+  Tcl_Interp *interp,
+  vtkObject *obj,
+  const char *command,
+  const char *subcommand,
+  vtkKWTkCommandArguments *args)
+{
+  if (!interp || !command)
+    {
+    return NULL;
+    }
+
+  const int objv_on_stack_length = 32;
+  Tcl_Obj *objv_on_stack[objv_on_stack_length];
+  Tcl_Obj **objv = objv_on_stack;
+
+  // Build the command vector: command, subcommand, arguments
+
+  int nb_args = args ? args->GetNumberOfArguments() : 0;
+  int objc = 1 + (subcommand ? 1 : 0) + nb_args;
+  if (objc > objv_on_stack_length)
+    {
+    objv = new Tcl_Obj* [objc];
+    }
+
+  int i = 0, j;
+  objv[i] = Tcl_NewStringObj(command, -1);
+  Tcl_IncrRefCount(objv[i++]);
+  if (subcommand)
+    {
+    objv[i] = Tcl_NewStringObj(subcommand, -1);
+    Tcl_IncrRefCount(objv[i++]);
+    }
+  for (j = 0; j < nb_args; j++)
+    {
+    objv[i++] = args->GetArguments()[j];
+    }
+
+  // Invoke it (after the scripts waiting in a batch, if any)
+
+  vtkKWApplication::FlushPendingScriptBatch(interp);
+
+  vtkKWTclProfiler *profiler = vtkKWTclProfiler::GetEnabledProfiler(interp);
+  double start = profiler ? profiler->BeginEvaluation() : 0.0;
+
+  int code = Tcl_EvalObjv(interp, objc, objv, TCL_EVAL_GLOBAL);
+
+  // The call site is the command and subcommand, the script is only
+  // rebuilt from the command vector when profiling
+
+  if (profiler && profiler == vtkKWTclProfiler::GetEnabledProfiler(interp))
+    {
+    vtksys_stl::string call_site(command);
+    if (subcommand)
+      {
+      call_site += " ";
+      call_site += subcommand;
+      }
+    Tcl_Obj *script = Tcl_NewListObj(objc, objv);
+    Tcl_IncrRefCount(script);
+    profiler->EndEvaluation(
+      start, obj ? obj->GetClassName() : NULL,
+      call_site.c_str(), Tcl_GetString(script));
+    Tcl_DecrRefCount(script);
+    }
+
+  const char *res;
+  if (code != TCL_OK && obj)
+    {
+    Tcl_Obj *script = Tcl_NewListObj(objc, objv);
+    Tcl_IncrRefCount(script);
+    res = vtkKWTkUtilities::ReportEvaluationError(
+      interp, obj, Tcl_GetString(script));
+    Tcl_DecrRefCount(script);
+    }
+  else
+    {
+    res = Tcl_GetStringResult(interp);
+    }
+
+  Tcl_DecrRefCount(objv[0]);
+  if (subcommand)
+    {
+    Tcl_DecrRefCount(objv[1]);
+    }
+  if (objv != objv_on_stack)
+    {
+    delete [] objv;
+    }
+
+  return res;
+}
+
 //----------------------------------------------------------------------------
 const char* vtkKWTkUtilities::EvaluateEncodedString(
     Tcl_Interp *interp, 
@@ -312,6 +835,22 @@ void vtkKWTkUtilities::CreateObjectMethodCommand(
   size_t object_len = object_name ? strlen(object_name) + 1 : 0;
   size_t method_len = method ? strlen(method) : 0;
 
+  // Instrument the object command right away if a profiler is enabled, so
+  // that the methods invoked by the callback are profiled (the profiler 
+  // finds the object commands that already exist when it is enabled). 
+  // The callback itself is left unchanged, it can be removed later on by
+  // regenerating it (see vtkKWWidget::RemoveBinding), whether the profiler
+  // is enabled or not.
+
+  if (object_name && interp)
+    {
+    vtkKWTclProfiler *profiler = vtkKWTclProfiler::GetEnabledProfiler(interp);
+    if (profiler)
+      {
+      profiler->InstrumentObjectCommand(object_name, object->GetClassName());
+      }
+    }
+
   *command = new char[object_len + method_len + 1];
   if (object_name && method)
     {
@@ -353,7 +892,7 @@ void vtkKWTkUtilities::GetRGBColor(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream command;
   command << "winfo rgb " << widget << " " << color;
-  if (Tcl_GlobalEval(interp, command.str().c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, command.str().c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to get RGB color: " << Tcl_GetStringResult(interp));
@@ -398,7 +937,7 @@ void vtkKWTkUtilities::GetOptionColor(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream command;
   command << widget << " cget " << option;
-  if (Tcl_GlobalEval(interp, command.str().c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, command.str().c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to get " << option << " option: " 
@@ -450,7 +989,7 @@ void vtkKWTkUtilities::GetDefaultOptionColor(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream command;
   command << "lindex [" << widget << " config " << option << "] 3";
-  if (Tcl_GlobalEval(interp, command.str().c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, command.str().c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to get " << option << " option: " 
@@ -507,7 +1046,7 @@ void vtkKWTkUtilities::SetOptionColor(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream command;
   command << widget << " configure " << option << " " << color;
-  if (Tcl_GlobalEval(interp, command.str().c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, command.str().c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to set " << option << " option: " 
@@ -515,6 +1054,20 @@ void vtkKWTkUtilities::SetOptionColor(Tcl_Interp *interp,
     }
 }
 
+//----------------------------------------------------------------------------
+// The vtkKWWidget helpers that configure a widget directly have to discard
+// the options cached by vtkKWCoreWidget
+
+static void vtkKWTkUtilitiesInvalidateConfigurationOptionCache(
+  vtkKWWidget *widget)
+{
+  vtkKWCoreWidget *core = vtkKWCoreWidget::SafeDownCast(widget);
+  if (core)
+    {
+    core->InvalidateConfigurationOptionCache();
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkKWTkUtilities::SetOptionColor(vtkKWWidget *widget, 
                                       const char *option,
@@ -529,6 +1082,8 @@ void vtkKWTkUtilities::SetOptionColor(vtkKWWidget *widget,
                                    widget->GetWidgetName(),
                                    option,
                                    r, g, b);
+
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
 }
 
 //----------------------------------------------------------------------------
@@ -596,7 +1151,7 @@ int vtkKWTkUtilities::GetGeometry(Tcl_Interp *interp,
 
   vtksys_stl::string geometry("winfo geometry ");
   geometry += widget;
-  if (Tcl_GlobalEval(interp, geometry.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, geometry.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget geometry! " << widget);
     return 0;
@@ -620,7 +1175,7 @@ int vtkKWTkUtilities::GetGeometry(Tcl_Interp *interp,
     {
     geometry = "wm geometry ";
     geometry += widget;
-    if (Tcl_GlobalEval(interp, geometry.c_str()) != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, geometry.c_str()) != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to query widget geometry! " << widget);
       return 0;
@@ -780,27 +1335,10 @@ int vtkKWTkUtilities::UpdatePhoto(Tcl_Interp *interp,
 
   // Find the photo (create it if not found)
 
-  Tk_PhotoHandle photo = Tk_FindPhoto(interp, const_cast<char *>(photo_name));
-
+  Tk_PhotoHandle photo = vtkKWTkUtilitiesFindOrCreatePhoto(interp, photo_name);
   if (!photo)
     {
-    vtksys_ios::ostringstream create_photo;
-    create_photo << "image create photo " << photo_name;
-    int res = Tcl_GlobalEval(interp, create_photo.str().c_str());
-    if (res != TCL_OK)
-      {
-      vtkGenericWarningMacro(
-        << "Unable to create photo " << photo_name << ": " 
-        << Tcl_GetStringResult(interp));
-      return 0;
-      }
-
-    photo = Tk_FindPhoto(interp, const_cast<char *>(photo_name));
-    if (!photo)
-      {
-      vtkGenericWarningMacro(<< "Error looking up Tk photo:" << photo_name);
-      return 0;
-      }
+    return 0;
     }
 
   Tk_PhotoSetSize(
@@ -849,13 +1387,7 @@ int vtkKWTkUtilities::UpdatePhoto(Tcl_Interp *interp,
 
   unsigned char *blended_pixels = NULL;
 
-  int tcl_major, tcl_minor, tcl_patch_level;
-  Tcl_GetVersion(&tcl_major, &tcl_minor, &tcl_patch_level, NULL);
-  if (pixel_size == 4 &&
-      (tcl_major < 8 ||
-       (tcl_major == 8 && 
-        (tcl_minor < 4 || 
-         (tcl_minor == 4 && tcl_patch_level <= 8)))))
+  if (pixel_size == 4 && !vtkKWTkUtilitiesSupportsPartialTransparency())
     {
     int need_blend = 0;
     unsigned char *pixels_ptr = const_cast<unsigned char *>(pixels);
@@ -958,6 +1490,104 @@ int vtkKWTkUtilities::UpdatePhoto(vtkKWApplication *app,
     update_options);
 }
 
+//----------------------------------------------------------------------------
+int vtkKWTkUtilities::UpdatePhotoRegion(Tcl_Interp *interp,
+                                        const char *photo_name,
+                                        const unsigned char *pixels, 
+                                        int width, int height,
+                                        int pixel_size,
+                                        int x, int y, 
+                                        int region_width, int region_height)
+{
+  // Check params
+
+  if (!interp || !photo_name || !photo_name[0] || !pixels)
+    {
+    return 0;
+    }
+
+  if (pixel_size != 3 && pixel_size != 4)
+    {
+    vtkGenericWarningMacro(<< "Unsupported pixel size: " << pixel_size);
+    return 0;
+    }
+
+  if (x < 0 || y < 0 || region_width <= 0 || region_height <= 0 ||
+      x + region_width > width || y + region_height > height)
+    {
+    vtkGenericWarningMacro(
+      << "Invalid region: " << region_width << "x" << region_height 
+      << " at " << x << ", " << y);
+    return 0;
+    }
+
+  // The photo has to exist already, with the same size as the buffer
+
+  Tk_PhotoHandle photo = Tk_FindPhoto(interp, const_cast<char *>(photo_name));
+  if (!photo)
+    {
+    return 0;
+    }
+
+  int photo_width, photo_height;
+  Tk_PhotoGetSize(photo, &photo_width, &photo_height);
+  if (photo_width != width || photo_height != height)
+    {
+    return 0;
+    }
+
+  // Point the block to the region, the pitch is still the buffer's one
+
+  Tk_PhotoImageBlock sblock;
+
+  sblock.width     = region_width;
+  sblock.height    = region_height;
+  sblock.offset[0] = 0;
+  sblock.offset[1] = 1;
+  sblock.offset[2] = 2;
+  sblock.offset[3] = pixel_size > 3 ? 3 : 0;
+  sblock.pixelSize = pixel_size;
+  sblock.pitch     = width * pixel_size;
+  sblock.pixelPtr  = const_cast<unsigned char *>(pixels) + 
+    ((long)y * (long)width + (long)x) * (long)pixel_size;
+
+  Tk_PhotoPutBlock(
+#if (TCL_MAJOR_VERSION == 8) && (TCL_MINOR_VERSION <= 4)
+#else
+    interp,
+#endif
+    photo, &sblock, x, y, region_width, region_height
+#if !defined(USE_COMPOSITELESS_PHOTO_PUT_BLOCK)
+    , TK_PHOTO_COMPOSITE_SET
+#endif
+    );
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWTkUtilities::UpdatePhotoRegion(vtkKWApplication *app,
+                                        const char *photo_name,
+                                        const unsigned char *pixels, 
+                                        int width, int height,
+                                        int pixel_size,
+                                        int x, int y, 
+                                        int region_width, int region_height)
+{
+  if (!app)
+    {
+    return 0;
+    }
+  return vtkKWTkUtilities::UpdatePhotoRegion(
+    app->GetMainInterp(),
+    photo_name,
+    pixels, 
+    width, height,
+    pixel_size,
+    x, y,
+    region_width, region_height);
+}
+
 //----------------------------------------------------------------------------
 int vtkKWTkUtilities::UpdatePhotoFromIcon(vtkKWApplication *app,
                                           const char *photo_name,
@@ -1187,7 +1817,7 @@ int vtkKWTkUtilities::GetPhotoHeight(vtkKWWidget *widget)
   vtksys_stl::string cmd(widget->GetWidgetName());
   cmd += " cget -image";
   
-  if (Tcl_GlobalEval(interp, cmd.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, cmd.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to get -image option: " << Tcl_GetStringResult(interp));
@@ -1254,7 +1884,7 @@ int vtkKWTkUtilities::GetRealActualFont(Tcl_Interp *interp,
     script = "font actual \"";
     script += font;
     script += "\"";
-    res = Tcl_GlobalEval(interp, script.c_str());
+    res = vtkKWTkUtilitiesGlobalEval(interp, script.c_str());
     if (res != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to get actual font! ("
@@ -1281,7 +1911,7 @@ int vtkKWTkUtilities::GetRealActualFont(Tcl_Interp *interp,
     script += "\" } else { unset -nocomplain __tmp__; set __tmp__ \"";
     script += font;
     script += "\" }}";
-    res = Tcl_GlobalEval(interp, script.c_str());
+    res = vtkKWTkUtilitiesGlobalEval(interp, script.c_str());
     if (res != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to fix -size attribute! ("
@@ -1310,7 +1940,7 @@ int vtkKWTkUtilities::ChangeFontWeight(Tcl_Interp *interp,
          << font << "\" {\\1" << (weight ? "bold" : "medium") 
          << "\\3} __tmp__";
 
-  res = Tcl_GlobalEval(interp, regsub.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, regsub.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to regsub!");
@@ -1318,7 +1948,7 @@ int vtkKWTkUtilities::ChangeFontWeight(Tcl_Interp *interp,
     }
   if (atoi(Tcl_GetStringResult(interp)) == 1)
     {
-    res = Tcl_GlobalEval(interp, "set __tmp__");
+    res = vtkKWTkUtilitiesGlobalEval(interp, "set __tmp__");
     if (res != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to replace result of regsub! ("
@@ -1344,7 +1974,7 @@ int vtkKWTkUtilities::ChangeFontWeight(Tcl_Interp *interp,
   script += "\" ; set __tmp__(-weight) ";
   script += (weight ? "bold" : "normal");
   script += "; array get __tmp__";
-  res = Tcl_GlobalEval(interp, script.c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, script.c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace -weight attribute! ("
@@ -1385,7 +2015,7 @@ int vtkKWTkUtilities::ChangeFontWeight(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream getfont;
   getfont << widget << " cget -font";
-  res = Tcl_GlobalEval(interp, getfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, getfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to getfont!");
@@ -1404,7 +2034,7 @@ int vtkKWTkUtilities::ChangeFontWeight(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream setfont;
   setfont << widget << " configure -font \"" << new_font << "\"";
-  res = Tcl_GlobalEval(interp, setfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, setfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace font ! ("
@@ -1430,9 +2060,11 @@ int vtkKWTkUtilities::ChangeFontWeightToBold(vtkKWWidget *widget)
     return 0;
     }
   
-  return vtkKWTkUtilities::ChangeFontWeightToBold(
+  int res = vtkKWTkUtilities::ChangeFontWeightToBold(
     widget->GetApplication()->GetMainInterp(),
     widget->GetWidgetName());
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -1450,9 +2082,11 @@ int vtkKWTkUtilities::ChangeFontWeightToNormal(vtkKWWidget *widget)
     return 0;
     }
   
-  return vtkKWTkUtilities::ChangeFontWeightToNormal(
+  int res = vtkKWTkUtilities::ChangeFontWeightToNormal(
     widget->GetApplication()->GetMainInterp(),
     widget->GetWidgetName());
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -1470,7 +2104,7 @@ int vtkKWTkUtilities::ChangeFontSlant(Tcl_Interp *interp,
   regsub << "unset -nocomplain __tmp__; regsub -- {(-[^-]*\\S-[^-]*\\S-[^-]*\\S-)([^-]*)(-.*)} \""
          << font << "\" {\\1" << (slant ? "i" : "r") << "\\3} __tmp__";
 
-  res = Tcl_GlobalEval(interp, regsub.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, regsub.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to regsub!");
@@ -1478,7 +2112,7 @@ int vtkKWTkUtilities::ChangeFontSlant(Tcl_Interp *interp,
     }
   if (atoi(Tcl_GetStringResult(interp)) == 1)
     {
-    res = Tcl_GlobalEval(interp, "set __tmp__");
+    res = vtkKWTkUtilitiesGlobalEval(interp, "set __tmp__");
     if (res != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to replace result of regsub! ("
@@ -1504,7 +2138,7 @@ int vtkKWTkUtilities::ChangeFontSlant(Tcl_Interp *interp,
   script += "\" ; set __tmp__(-slant) ";
   script += (slant ? "italic" : "roman");
   script += "; array get __tmp__";
-  res = Tcl_GlobalEval(interp, script.c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, script.c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace -slant attribute! ("
@@ -1545,7 +2179,7 @@ int vtkKWTkUtilities::ChangeFontSlant(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream getfont;
   getfont << widget << " cget -font";
-  res = Tcl_GlobalEval(interp, getfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, getfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to getfont!");
@@ -1564,7 +2198,7 @@ int vtkKWTkUtilities::ChangeFontSlant(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream setfont;
   setfont << widget << " configure -font \"" << new_font << "\"";
-  res = Tcl_GlobalEval(interp, setfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, setfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace font ! ("
@@ -1590,9 +2224,11 @@ int vtkKWTkUtilities::ChangeFontSlantToItalic(vtkKWWidget *widget)
     return 0;
     }
   
-  return vtkKWTkUtilities::ChangeFontSlantToItalic(
+  int res = vtkKWTkUtilities::ChangeFontSlantToItalic(
     widget->GetApplication()->GetMainInterp(),
     widget->GetWidgetName());
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -1610,9 +2246,11 @@ int vtkKWTkUtilities::ChangeFontSlantToRoman(vtkKWWidget *widget)
     return 0;
     }
   
-  return vtkKWTkUtilities::ChangeFontSlantToRoman(
+  int res = vtkKWTkUtilities::ChangeFontSlantToRoman(
     widget->GetApplication()->GetMainInterp(),
     widget->GetWidgetName());
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -1637,7 +2275,7 @@ int vtkKWTkUtilities::ChangeFontSize(Tcl_Interp *interp,
   sprintf(script, 
           "unset -nocomplain __tmp__; array set __tmp__ \"%s\" ; set __tmp__(-size) %d; array get __tmp__",
           real_font, new_size);
-  res = Tcl_GlobalEval(interp, script);
+  res = vtkKWTkUtilitiesGlobalEval(interp, script);
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace -size attribute! ("
@@ -1662,7 +2300,7 @@ int vtkKWTkUtilities::ChangeFontSize(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream getfont;
   getfont << widget << " cget -font";
-  res = Tcl_GlobalEval(interp, getfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, getfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to getfont!");
@@ -1681,7 +2319,7 @@ int vtkKWTkUtilities::ChangeFontSize(Tcl_Interp *interp,
 
   vtksys_ios::ostringstream setfont;
   setfont << widget << " configure -font \"" << new_font << "\"";
-  res = Tcl_GlobalEval(interp, setfont.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, setfont.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to replace font ! ("
@@ -1700,10 +2338,12 @@ int vtkKWTkUtilities::ChangeFontSize(vtkKWWidget *widget, int new_size)
     return 0;
     }
   
-  return vtkKWTkUtilities::ChangeFontSize(
+  int res = vtkKWTkUtilities::ChangeFontSize(
     widget->GetApplication()->GetMainInterp(),
     widget->GetWidgetName(), 
     new_size);
+  vtkKWTkUtilitiesInvalidateConfigurationOptionCache(widget);
+  return res;
 }
 
 //----------------------------------------------------------------------------
@@ -1714,7 +2354,7 @@ int vtkKWTkUtilities::GetGridSize(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream size;
   size << "grid size " << widget;
-  int res = Tcl_GlobalEval(interp, size.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, size.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query grid size!");
@@ -1753,7 +2393,7 @@ int vtkKWTkUtilities::GetWidgetPositionInGrid(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream info;
   info << "grid info " << widget ;
-  int res = Tcl_GlobalEval(interp, info.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, info.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query grid info!");
@@ -1812,7 +2452,7 @@ int vtkKWTkUtilities::GetWidgetPaddingInPack(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream packinfo;
   packinfo << "pack info " << widget;
-  int res = Tcl_GlobalEval(interp, packinfo.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, packinfo.str().c_str());
   const char *result = Tcl_GetStringResult(interp);
   if (res != TCL_OK || !result || !result[0])
     {
@@ -1883,7 +2523,7 @@ int vtkKWTkUtilities::GetMasterInPack(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream packinfo;
   packinfo << "pack info " << widget;
-  int res = Tcl_GlobalEval(interp, packinfo.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, packinfo.str().c_str());
   const char *result = Tcl_GetStringResult(interp);
   if (res != TCL_OK || !result || !result[0])
     {
@@ -1941,7 +2581,7 @@ int vtkKWTkUtilities::GetSlavesBoundingBoxInPack(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream slaves;
   slaves << "pack slaves " << widget;
-  int res = Tcl_GlobalEval(interp, slaves.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, slaves.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to get pack slaves!");
@@ -2047,7 +2687,7 @@ int vtkKWTkUtilities::GetSlaveHorizontalPositionInPack(Tcl_Interp *interp,
 {
   vtksys_ios::ostringstream slaves;
   slaves << "pack slaves " << widget;
-  int res = Tcl_GlobalEval(interp, slaves.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, slaves.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to get pack slaves!");
@@ -2186,7 +2826,7 @@ int vtkKWTkUtilities::GetGridColumnWidths(Tcl_Interp *interp,
       vtksys_ios::ostringstream slave;
       slave << "grid slaves " << widget << " -column " << col
             << " -row " << row;
-      int res = Tcl_GlobalEval(interp, slave.str().c_str());
+      int res = vtkKWTkUtilitiesGlobalEval(interp, slave.str().c_str());
       if (res != TCL_OK)
         {
         vtkGenericWarningMacro(<< "Unable to get grid slave!");
@@ -2282,7 +2922,7 @@ int vtkKWTkUtilities::SynchroniseGridsColumnMinimumSize(
     }
 
   int ok = 1;
-  if (Tcl_GlobalEval(interp, minsize.str().c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, minsize.str().c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to synchronize grid columns!");
     ok = 0;
@@ -2319,7 +2959,7 @@ int vtkKWTkUtilities::SynchroniseLabelsMaximumWidth(
 
     vtksys_ios::ostringstream getwidth;
     getwidth << widgets[widget] << " cget -width";
-    int res = Tcl_GlobalEval(interp, getwidth.str().c_str());
+    int res = vtkKWTkUtilitiesGlobalEval(interp, getwidth.str().c_str());
     const char *result = Tcl_GetStringResult(interp);
     if (res != TCL_OK || !result || !result[0])
       {
@@ -2333,7 +2973,7 @@ int vtkKWTkUtilities::SynchroniseLabelsMaximumWidth(
 
     vtksys_ios::ostringstream getlength;
     getlength << widgets[widget] << " cget -text";
-    res = Tcl_GlobalEval(interp, getlength.str().c_str());
+    res = vtkKWTkUtilitiesGlobalEval(interp, getlength.str().c_str());
     if (res != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to get label -text! " 
@@ -2367,13 +3007,17 @@ int vtkKWTkUtilities::SynchroniseLabelsMaximumWidth(
       }
     setwidth << endl;
     }
-  int res = Tcl_GlobalEval(interp, setwidth.str().c_str());
+  int res = vtkKWTkUtilitiesGlobalEval(interp, setwidth.str().c_str());
   if (res != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to synchronize labels width! " 
                            << Tcl_GetStringResult(interp));
     }
 
+  // The labels are only known by name, discard all the cached options
+
+  vtkKWCoreWidget::InvalidateAllConfigurationOptionCaches();
+
   return 1;
 }
 
@@ -2403,7 +3047,7 @@ int vtkKWTkUtilities::GetSlavesInPack(
 
   vtksys_ios::ostringstream nb_slaves_str;
   nb_slaves_str << "llength [pack slaves " << widget << "]";
-  res = Tcl_GlobalEval(interp, nb_slaves_str.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, nb_slaves_str.str().c_str());
   const char *result = Tcl_GetStringResult(interp);
   if (res != TCL_OK || !result || !result[0])
     {
@@ -2421,7 +3065,7 @@ int vtkKWTkUtilities::GetSlavesInPack(
 
   vtksys_ios::ostringstream slaves_str;
   slaves_str << "pack slaves " << widget;
-  res = Tcl_GlobalEval(interp, slaves_str.str().c_str());
+  res = vtkKWTkUtilitiesGlobalEval(interp, slaves_str.str().c_str());
   result = Tcl_GetStringResult(interp);
   if (res != TCL_OK || !result || !result[0])
     {
@@ -2818,7 +3462,7 @@ int vtkKWTkUtilities::SetTopLevelMouseCursor(Tcl_Interp *interp,
     }
   cmd += "}";
 
-  if (Tcl_GlobalEval(interp, cmd.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, cmd.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to change toplevel mouse cursor: " 
@@ -2856,7 +3500,7 @@ int vtkKWTkUtilities::IsTopLevel(Tcl_Interp *interp,
   vtksys_stl::string cmd("winfo toplevel ");
   cmd += widget;
 
-  if (Tcl_GlobalEval(interp, cmd.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, cmd.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to query toplevel: " << Tcl_GetStringResult(interp));
@@ -2891,7 +3535,7 @@ void vtkKWTkUtilities::WithdrawTopLevel(Tcl_Interp *interp,
   vtksys_stl::string cmd("wm withdraw ");
   cmd += widget;
 
-  if (Tcl_GlobalEval(interp, cmd.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, cmd.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to withdraw toplevel: " << Tcl_GetStringResult(interp));
@@ -2917,7 +3561,7 @@ const char* vtkKWTkUtilities::GetCurrentScript(
 {
   if (interp)
     {
-    if (Tcl_GlobalEval(interp, "info script") == TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, "info script") == TCL_OK)
       {
       return Tcl_GetStringResult(interp);
       }
@@ -2954,7 +3598,7 @@ const char* vtkKWTkUtilities::CreateTimerHandler(
     interp, &command, object, method);
   char *after_command = new char[strlen(command) + 50];
   sprintf(after_command, "after %ld {%s}", ms, command);
-  if (Tcl_GlobalEval(interp, after_command) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, after_command) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to create timer handler " << Tcl_GetStringResult(interp));
@@ -2988,7 +3632,7 @@ const char* vtkKWTkUtilities::CreateIdleTimerHandler(
   vtkKWTkUtilities::CreateObjectMethodCommand(interp, &command, object, method);
   char *after_command = new char[strlen(command) + 50];
   sprintf(after_command, "after idle {%s}", command);
-  if (Tcl_GlobalEval(interp, after_command) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, after_command) != TCL_OK)
     {
     vtkGenericWarningMacro(
       << "Unable to create timer handler " << Tcl_GetStringResult(interp));
@@ -3016,7 +3660,7 @@ void vtkKWTkUtilities::CancelTimerHandler(Tcl_Interp *interp,
     char cmd[256];
     sprintf(cmd, "after cancel %s", id);
 
-    if (Tcl_GlobalEval(interp, cmd) != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, cmd) != TCL_OK)
       {
       vtkGenericWarningMacro(
         << "Unable to cancel timer handler " << id << ": " 
@@ -3040,7 +3684,7 @@ void vtkKWTkUtilities::CancelAllTimerHandlers(Tcl_Interp *interp)
 {
   if (interp)
     { 
-    if (Tcl_GlobalEval(
+    if (vtkKWTkUtilitiesGlobalEval(
           interp, "foreach a [after info] {after cancel $a}") != TCL_OK)
       {
       vtkGenericWarningMacro(
@@ -3064,7 +3708,7 @@ void vtkKWTkUtilities::Bell(Tcl_Interp *interp)
 {
   if (interp)
     { 
-    if (Tcl_GlobalEval(interp, "bell") != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, "bell") != TCL_OK)
       {
       vtkGenericWarningMacro(
         << "Unable to ring a bell: " << Tcl_GetStringResult(interp));
@@ -3086,7 +3730,7 @@ void vtkKWTkUtilities::ProcessPendingEvents(Tcl_Interp *interp)
 {
   if (interp)
     { 
-    if (Tcl_GlobalEval(interp, "update") != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, "update") != TCL_OK)
       {
       vtkGenericWarningMacro(
         << "Unable to process pending events: " <<Tcl_GetStringResult(interp));
@@ -3115,7 +3759,7 @@ void vtkKWTkUtilities::ProcessIdleTasks(Tcl_Interp *interp)
 {
   if (interp)
     { 
-    if (Tcl_GlobalEval(interp, "update idletasks") != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, "update idletasks") != TCL_OK)
       {
       vtkGenericWarningMacro(
         << "Unable to process pending events: " <<Tcl_GetStringResult(interp));
@@ -3281,7 +3925,7 @@ int vtkKWTkUtilities::GetMousePointerCoordinates(
 
   vtksys_stl::string pointerxy("winfo pointerxy ");
   pointerxy += widget;
-  if (Tcl_GlobalEval(interp, pointerxy.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, pointerxy.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query mouse coordinates! " 
                            << Tcl_GetStringResult(interp));
@@ -3336,7 +3980,7 @@ int vtkKWTkUtilities::GetWidgetCoordinates(
   widgetxy += "] [winfo rooty ";
   widgetxy += widget;
   widgetxy += "]";
-  if (Tcl_GlobalEval(interp, widgetxy.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetxy.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget coordinates! " 
                            << Tcl_GetStringResult(interp));
@@ -3390,7 +4034,7 @@ int vtkKWTkUtilities::GetWidgetRelativeCoordinates(
   widgetxy += "] [winfo y ";
   widgetxy += widget;
   widgetxy += "]";
-  if (Tcl_GlobalEval(interp, widgetxy.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetxy.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget relative coordinates! " 
                            << Tcl_GetStringResult(interp));
@@ -3444,7 +4088,7 @@ int vtkKWTkUtilities::GetWidgetSize(
   widgetwh += "] [winfo height ";
   widgetwh += widget;
   widgetwh += "]";
-  if (Tcl_GlobalEval(interp, widgetwh.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetwh.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget size! " 
                            << Tcl_GetStringResult(interp));
@@ -3498,7 +4142,7 @@ int vtkKWTkUtilities::GetWidgetRequestedSize(
   widgetwh += "] [winfo reqheight ";
   widgetwh += widget;
   widgetwh += "]";
-  if (Tcl_GlobalEval(interp, widgetwh.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetwh.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget requested size! " 
                            << Tcl_GetStringResult(interp));
@@ -3549,7 +4193,7 @@ const char* vtkKWTkUtilities::GetWidgetClass(
 
   vtksys_stl::string widgetclass("winfo class ");
   widgetclass += widget;
-  if (Tcl_GlobalEval(interp, widgetclass.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetclass.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query widget class! " 
                            << Tcl_GetStringResult(interp));
@@ -3586,7 +4230,7 @@ int vtkKWTkUtilities::GetScreenSize(
   widgetwh += "] [winfo screenheight ";
   widgetwh += widget;
   widgetwh += "]";
-  if (Tcl_GlobalEval(interp, widgetwh.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, widgetwh.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to query screen size! " 
                            << Tcl_GetStringResult(interp));
@@ -3641,7 +4285,7 @@ const char* vtkKWTkUtilities::GetWindowingSystem(Tcl_Interp *interp)
 {
   if (interp)
     {
-    if (Tcl_GlobalEval(interp, "tk windowingsystem") != TCL_OK)
+    if (vtkKWTkUtilitiesGlobalEval(interp, "tk windowingsystem") != TCL_OK)
       {
       vtkGenericWarningMacro(<< "Unable to query windowing system! " 
                              << Tcl_GetStringResult(interp));
@@ -3682,7 +4326,7 @@ int vtkKWTkUtilities::GetFontMeasure(
   fontm += " {";
   fontm += txt;
   fontm += "}";
-  if (Tcl_GlobalEval(interp, fontm.c_str()) != TCL_OK)
+  if (vtkKWTkUtilitiesGlobalEval(interp, fontm.c_str()) != TCL_OK)
     {
     vtkGenericWarningMacro(<< "Unable to compute font measure! " 
                            << Tcl_GetStringResult(interp));
@@ -37,6 +37,114 @@ class vtkKWApplication;
 class vtkKWIcon;
 class vtkRenderWindow;
 struct Tcl_Interp;
+struct Tcl_Obj;
+
+//BTX
+// Description:
+// A list of typed arguments, to be passed to a Tcl command by
+// vtkKWTkUtilities::EvaluateCommand. Each argument is converted to a Tcl
+// object when it is added, so that numbers are not formatted to text and
+// parsed back, and strings are passed as-is (no quoting, no substitution).
+class KWWidgets_EXPORT vtkKWTkCommandArguments
+{
+public:
+  vtkKWTkCommandArguments();
+  ~vtkKWTkCommandArguments();
+
+  // Description:
+  // Add an argument. AddObject increments the reference count of 'obj'.
+  void AddInt(int value);
+  void AddDouble(double value);
+  void AddString(const char *value);
+  void AddObject(Tcl_Obj *obj);
+
+  // Description:
+  // Remove all the arguments, so that the list can be reused.
+  void RemoveAllArguments();
+
+  // Description:
+  // Get the arguments.
+  int GetNumberOfArguments() { return this->NumberOfArguments; }
+  Tcl_Obj** GetArguments() { return this->Arguments; }
+
+protected:
+  enum
+  {
+    NumberOfStaticArguments = 16
+  };
+  Tcl_Obj *StaticArguments[NumberOfStaticArguments];
+  Tcl_Obj **Arguments;
+  int NumberOfArguments;
+  int Size;
+
+private:
+  vtkKWTkCommandArguments(const vtkKWTkCommandArguments&); // Not implemented
+  void operator=(const vtkKWTkCommandArguments&); // Not implemented
+};
+
+// Description:
+// A reusable pixel buffer, to be sent to Tk photos. Widgets that update
+// an image over and over (say, while the user is dragging something) can
+// write directly into GetPixels() instead of allocating a new buffer each
+// time, mark the region they modified, and call UpdatePhoto: only that
+// region is sent to Tk (Tk_PhotoPutBlock with offsets).
+// Pixels are stored from top to bottom, 'pixel_size' bytes per pixel (3 for
+// RGB, 4 for RGBA), without any padding between rows.
+class KWWidgets_EXPORT vtkKWTkPhotoSurface
+{
+public:
+  vtkKWTkPhotoSurface();
+  ~vtkKWTkPhotoSurface();
+
+  // Description:
+  // Set the size of the surface. Memory is only reallocated if the buffer
+  // has to grow. If the size changed, the contents of the buffer is
+  // undefined and the whole surface is marked as modified.
+  // Return 1 on success, 0 otherwise.
+  int SetSize(int width, int height, int pixel_size);
+  int GetWidth() { return this->Width; }
+  int GetHeight() { return this->Height; }
+  int GetPixelSize() { return this->PixelSize; }
+  int GetPitch() { return this->Width * this->PixelSize; }
+
+  // Description:
+  // Get a writable pointer to the pixels, or to the pixel at ('x', 'y').
+  unsigned char* GetPixels() { return this->Pixels; }
+  unsigned char* GetPixels(int x, int y)
+    { return this->Pixels + ((long)y * this->Width + x) * this->PixelSize; }
+
+  // Description:
+  // Mark a region, or the whole surface, as modified. Regions accumulate
+  // (as their bounding box) until the next call to UpdatePhoto.
+  void MarkRegionAsModified(int x, int y, int width, int height);
+  void MarkAsModified();
+  int IsModified();
+
+  // Description:
+  // Send the modified region to the Tk photo 'photo_name', and mark the
+  // surface as not modified. The photo is created if it does not exist, or
+  // resized if it does not have the size of the surface, in which case the
+  // whole surface is sent. If the same surface is used to update several
+  // photos, mark it as modified before each call.
+  // Older Tk versions can not blend RGBA pixels: the whole surface is then
+  // sent through vtkKWTkUtilities::UpdatePhoto, which blends them manually.
+  // Return 1 on success, 0 otherwise.
+  int UpdatePhoto(Tcl_Interp *interp, const char *photo_name);
+  int UpdatePhoto(vtkKWApplication *app, const char *photo_name);
+
+protected:
+  unsigned char *Pixels;
+  unsigned long Capacity;
+  int Width;
+  int Height;
+  int PixelSize;
+  int ModifiedRegion[4]; // x min, y min, x max, y max (exclusive)
+
+private:
+  vtkKWTkPhotoSurface(const vtkKWTkPhotoSurface&); // Not implemented
+  void operator=(const vtkKWTkPhotoSurface&); // Not implemented
+};
+//ETX
 
 class KWWidgets_EXPORT vtkKWTkUtilities : public vtkObject
 {
@@ -79,6 +187,40 @@ public:
   static const char* EvaluateSimpleString(
     vtkKWApplication *app, const char *str);
 
+  // Description:
+  // Same as EvaluateStringFromArgs, for a script whose result is not
+  // needed: if a script batch is in progress (see
+  // vtkKWApplication::BeginScriptBatch), the script is queued on behalf of
+  // 'obj' (where its errors are reported) instead of being evaluated.
+  // This is used by vtkKWObject::QueueScript.
+  static void QueueStringFromArgs(
+    vtkKWApplication *app, vtkObject *obj, const char *format, 
+    va_list var_args1, va_list var_args2);
+
+  // Description:
+  // Invoke a Tcl command directly, without going through a script: the
+  // command name (say, a widget name), the subcommand (say, "configure",
+  // or NULL if none) and the arguments are passed to the command as a
+  // vector of Tcl objects. This is faster than EvaluateString (no printf,
+  // no parsing, no substitution) and safer for arbitrary strings.
+  // Convenience methods are provided to specify a vtkKWApplication
+  // instead of the Tcl interpreter, and the object issuing the command
+  // (errors are reported on that object instead of the application).
+  // Return a pointer to the Tcl interpreter result buffer (or to the error
+  // message if the command failed and the errors were reported).
+  //BTX
+  static const char* EvaluateCommand(
+    Tcl_Interp *interp, const char *command, const char *subcommand,
+    vtkKWTkCommandArguments *args);
+  static const char* EvaluateCommand(
+    vtkKWApplication *app, const char *command, const char *subcommand,
+    vtkKWTkCommandArguments *args);
+  static const char* EvaluateCommand(
+    vtkKWApplication *app, vtkObject *obj,
+    const char *command, const char *subcommand,
+    vtkKWTkCommandArguments *args);
+  //ETX
+
   // Description:
   // Evaluate a Tcl string that was encoded in a buffer using zlib 
   // and/or base64. 
@@ -228,6 +370,33 @@ public:
                          unsigned long buffer_length = 0,
                          int update_options = 0);
 
+  // Description:
+  // Update a region of an existing Tk photo given by its name 'photo_name'.
+  // 'pixels' is a 'width' x 'height' x 'pixel_size' buffer covering the
+  // whole photo, which should already be of that size (see UpdatePhoto).
+  // Only the 'region_width' x 'region_height' block of pixels at ('x', 'y')
+  // is sent to Tk, which is much cheaper than updating the whole photo when
+  // only a few pixels changed. Note that the alpha channel of RGBA pixels
+  // is not blended manually for older Tk versions, as UpdatePhoto does.
+  // A convenience method is provided to specify the vtkKWApplication this
+  // photo belongs to, instead of the Tcl interpreter.
+  // Return 1 on success, 0 otherwise (say, if the photo does not exist or
+  // does not have the expected size).
+  static int UpdatePhotoRegion(Tcl_Interp *interp,
+                               const char *photo_name,
+                               const unsigned char *pixels, 
+                               int width, int height,
+                               int pixel_size,
+                               int x, int y, 
+                               int region_width, int region_height);
+  static int UpdatePhotoRegion(vtkKWApplication *app,
+                               const char *photo_name,
+                               const unsigned char *pixels, 
+                               int width, int height,
+                               int pixel_size,
+                               int x, int y, 
+                               int region_width, int region_height);
+
   // Description:
   // Update a Tk photo given by its name 'photo_name' using pixels stored in
   // the icon 'icon'. 
@@ -325,7 +494,8 @@ public:
 
   // Description:
   // Change the weight attribute of a 'widget' -font option.
-  // A convenience method is provided to query a vtkKWWidget directly.
+  // A convenience method is provided to query a vtkKWWidget directly (it
+  // also discards the options cached by a vtkKWCoreWidget).
   // Return 1 on success, 0 otherwise.
   static int ChangeFontWeightToBold(Tcl_Interp *interp, const char *widget);
   static int ChangeFontWeightToBold(vtkKWWidget *widget);
@@ -344,7 +514,8 @@ public:
 
   // Description:
   // Change the slant attribute of a 'widget' -font option.
-  // A convenience method is provided to query a vtkKWWidget directly.
+  // A convenience method is provided to query a vtkKWWidget directly (it
+  // also discards the options cached by a vtkKWCoreWidget).
   // Return 1 on success, 0 otherwise.
   static int ChangeFontSlantToItalic(Tcl_Interp *interp, const char *widget);
   static int ChangeFontSlantToItalic(vtkKWWidget *widget);
@@ -361,7 +532,8 @@ public:
 
   // Description:
   // Change the size attribute of a 'widget' -font option.
-  // A convenience method is provided to query a vtkKWWidget directly.
+  // A convenience method is provided to query a vtkKWWidget directly (it
+  // also discards the options cached by a vtkKWCoreWidget).
   // Return 1 on success, 0 otherwise.
   static int ChangeFontSize(
     Tcl_Interp *interp, const char *widget, int new_size);
@@ -727,7 +899,14 @@ protected:
     Tcl_Interp *interp, vtkObject *obj, const char *format, 
     va_list var_args1, va_list var_args2);
   static const char* EvaluateSimpleStringInternal(
+    Tcl_Interp *interp, vtkObject *obj, const char *str,
+    const char *call_site);
+  static const char* ReportEvaluationError(
     Tcl_Interp *interp, vtkObject *obj, const char *str);
+  static const char* EvaluateCommandInternal(
+    Tcl_Interp *interp, vtkObject *obj, 
+    const char *command, const char *subcommand,
+    vtkKWTkCommandArguments *args);
 
 private:
   vtkKWTkUtilities(const vtkKWTkUtilities&); // Not implemented
@@ -900,8 +900,8 @@ void vtkKWToolbar::UpdateWidgetsLayout()
     this->Script(grid_forget_tk.str().c_str());
     }
 
-  this->Script("grid rowconfigure %s 0 -weight 1",
-               this->GetFrame()->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 0 -weight 1",
+                    this->GetFrame()->GetWidgetName());
 }
 
 //----------------------------------------------------------------------------
@@ -1037,20 +1037,20 @@ void vtkKWToolbar::UpdateToolbarFrameAspect()
     {
     this->SetReliefToFlat();
     this->SetBorderWidth(0);
-    this->Script("pack %s -ipadx 0 -ipady 0 -padx 0 -pady 0 %s",
-                 this->Frame->GetWidgetName(), common_opts);
+    this->QueueScript("pack %s -ipadx 0 -ipady 0 -padx 0 -pady 0 %s",
+                      this->Frame->GetWidgetName(), common_opts);
     }
   else if (this->ToolbarAspect == vtkKWToolbar::ToolbarAspectRelief)
     {
     this->SetReliefToRaised();
     this->SetBorderWidth(1);
-    this->Script("pack %s -ipadx 1 -ipady 1 -padx 0 -pady 0 %s",
-                 this->Frame->GetWidgetName(), common_opts);
+    this->QueueScript("pack %s -ipadx 1 -ipady 1 -padx 0 -pady 0 %s",
+                      this->Frame->GetWidgetName(), common_opts);
     }
   else
     {
-    this->Script("pack %s -ipadx 0 -ipady 0 -padx 0 -pady 0 %s",
-                 this->Frame->GetWidgetName(), common_opts);
+    this->QueueScript("pack %s -ipadx 0 -ipady 0 -padx 0 -pady 0 %s",
+                      this->Frame->GetWidgetName(), common_opts);
     }
 }
 
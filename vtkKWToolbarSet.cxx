@@ -249,7 +249,7 @@ void vtkKWToolbarSet::Pack()
             this->Internals->PreviousPackInfo += next_slave.str();
             }
           }
-        this->Script("pack forget %s", this->GetWidgetName());
+        this->QueueScript("pack forget %s", this->GetWidgetName());
         this->Internals->PreviousGridInfo.assign("");
         }
       else
@@ -260,7 +260,7 @@ void vtkKWToolbarSet::Pack()
           {
           this->Internals->PreviousPackInfo.assign("");
           this->Internals->PreviousGridInfo = grid_info;
-          this->Script("grid forget %s", this->GetWidgetName());
+          this->QueueScript("grid forget %s", this->GetWidgetName());
           }
         }
       }
@@ -274,15 +274,15 @@ void vtkKWToolbarSet::Pack()
 
       if (!this->Internals->PreviousPackInfo.empty())
         {
-        this->Script("pack %s %s", this->GetWidgetName(), 
-                     this->Internals->PreviousPackInfo.c_str());
+        this->QueueScript("pack %s %s", this->GetWidgetName(), 
+                          this->Internals->PreviousPackInfo.c_str());
         this->Internals->PreviousPackInfo.assign("");
         this->Internals->PreviousGridInfo.assign("");
         }
       else if (!this->Internals->PreviousGridInfo.empty())
         {
-        this->Script("grid %s %s", this->GetWidgetName(), 
-                     this->Internals->PreviousGridInfo.c_str());
+        this->QueueScript("grid %s %s", this->GetWidgetName(), 
+                          this->Internals->PreviousGridInfo.c_str());
         this->Internals->PreviousPackInfo.assign("");
         this->Internals->PreviousGridInfo.assign("");
         }
@@ -302,7 +302,7 @@ void vtkKWToolbarSet::PackBottomSeparator()
     {
     if (this->BottomSeparatorVisibility && this->GetNumberOfVisibleToolbars())
       {
-      this->Script(
+      this->QueueScript(
         "pack %s -side top -fill x -expand y -padx 0 -pady 2 -after %s",
         this->BottomSeparator->GetWidgetName(),
         this->ToolbarsFrame->GetWidgetName());
@@ -326,7 +326,7 @@ void vtkKWToolbarSet::PackTopSeparator()
     {
     if (this->TopSeparatorVisibility && this->GetNumberOfVisibleToolbars())
       {
-      this->Script(
+      this->QueueScript(
         "pack %s -side top -fill x -expand y -padx 0 -pady 2 -before %s",
         this->TopSeparator->GetWidgetName(),
         this->ToolbarsFrame->GetWidgetName());
@@ -14,6 +14,7 @@
 
 #include "vtkKWUserInterfaceManager.h"
 
+#include "vtkKWApplication.h"
 #include "vtkKWWidget.h"
 #include "vtkKWUserInterfacePanel.h"
 #include "vtkObjectFactory.h"
@@ -221,6 +222,26 @@ void vtkKWUserInterfaceManager::Create()
   this->ManagerIsCreated = 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkKWUserInterfaceManager::CreatePanel(vtkKWUserInterfacePanel *panel)
+{
+  if (!panel || panel->IsCreated())
+    {
+    return;
+    }
+
+  vtkKWApplication *app = this->GetApplication();
+  if (app)
+    {
+    app->BeginScriptBatch();
+    }
+  panel->Create();
+  if (app)
+    {
+    app->EndScriptBatch();
+    }
+}
+
 // ---------------------------------------------------------------------------
 int vtkKWUserInterfaceManager::IsCreated()
 {
@@ -187,6 +187,12 @@ protected:
   virtual int RemovePageWidgets(vtkKWUserInterfacePanel *) 
     { return 1; };
 
+  // Description:
+  // Create a panel. The scripts that do not need a result are evaluated
+  // as a batch (see vtkKWApplication::BeginScriptBatch), since creating a
+  // panel usually involves configuring, packing and binding many widgets.
+  virtual void CreatePanel(vtkKWUserInterfacePanel *panel);
+
   int IdCounter;
 
   //BTX
@@ -154,8 +154,8 @@ void vtkKWUserInterfaceManagerDialog::Create()
   this->SplitFrame->SetFrame1Size(220);
   this->SplitFrame->SetFrame1MinimumSize(this->SplitFrame->GetFrame1Size());
   
-  this->Script("pack %s -side top -expand y -fill both -padx 2 -pady 4", 
-               this->SplitFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -expand y -fill both -padx 2 -pady 4", 
+                    this->SplitFrame->GetWidgetName());
   
   // Create the tree
 
@@ -175,16 +175,16 @@ void vtkKWUserInterfaceManagerDialog::Create()
   tree->SetWidth(350 / 8);
   tree->SetSelectionChangedCommand(this, "SelectionChangedCallback");
 
-  this->Script("pack %s -side top -expand y -fill both -padx 1", 
-               this->Tree->GetWidgetName());
+  this->QueueScript("pack %s -side top -expand y -fill both -padx 1", 
+                    this->Tree->GetWidgetName());
     
   // Separator
 
   this->Separator->SetParent(parent);
   this->Separator->Create();
   
-  this->Script("pack %s -side top -fill x  -padx 2 -pady 0", 
-               this->Separator->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill x  -padx 2 -pady 0", 
+                    this->Separator->GetWidgetName());
   
   // Close button
 
@@ -195,8 +195,8 @@ void vtkKWUserInterfaceManagerDialog::Create()
   this->CloseButton->SetWidth(20);
   this->CloseButton->SetCommand(this->TopLevel, "Withdraw");
   
-  this->Script("pack %s -side top -anchor e -fill none -padx 2 -pady 4", 
-               this->CloseButton->GetWidgetName());
+  this->QueueScript("pack %s -side top -anchor e -fill none -padx 2 -pady 4", 
+                    this->CloseButton->GetWidgetName());
   
   // Create the notebook
   // Don't pack it though, it's just here fore storage
@@ -544,7 +544,7 @@ int vtkKWUserInterfaceManagerDialog::CreateAllPanels()
     vtkKWUserInterfacePanel *panel = this->GetNthPanel(i);
     if (panel && !panel->IsCreated())
       {
-      panel->Create();
+      this->CreatePanel(panel);
       nb_created++;
       }
     }
@@ -912,9 +912,9 @@ int vtkKWUserInterfaceManagerDialog::ShowSelectedNodeSection()
   if (this->Internals->SelectedSection.size() &&
       this->Internals->SelectedSectionOldPackingPosition.size())
     {
-    this->Script("pack %s -in %s", 
-                 this->Internals->SelectedSection.c_str(), 
-                 this->Internals->SelectedSectionOldPackingPosition.c_str());
+    this->QueueScript("pack %s -in %s", 
+                      this->Internals->SelectedSection.c_str(), 
+                      this->Internals->SelectedSectionOldPackingPosition.c_str());
     }
 
   // Then pack the selected section
@@ -938,9 +938,9 @@ int vtkKWUserInterfaceManagerDialog::ShowSelectedNodeSection()
         {
         selected_section_old_pos = in_str.str();
         tree->SeeNode(selected_node.c_str());
-        this->Script("pack %s -in %s", 
-                     selected_section.c_str(), 
-                     this->SplitFrame->GetFrame2()->GetWidgetName());
+        this->QueueScript("pack %s -in %s", 
+                          selected_section.c_str(), 
+                          this->SplitFrame->GetFrame2()->GetWidgetName());
         res = 1;
         }
       }
@@ -438,7 +438,7 @@ int vtkKWUserInterfaceManagerNotebook::RaisePanel(
 
   if (!panel->IsCreated())
     {
-    panel->Create();
+    this->CreatePanel(panel);
     }
 
   // Show the pages that share the same tag (i.e. the pages that belong to the 
@@ -511,7 +511,7 @@ int vtkKWUserInterfaceManagerNotebook::ShowPanel(
 
   if (!panel->IsCreated())
     {
-    panel->Create();
+    this->CreatePanel(panel);
     }
 
   // Show the pages that share the same tag (i.e. the pages that belong to the 
@@ -1151,7 +1151,7 @@ int vtkKWUserInterfaceManagerNotebook::DragAndDropWidget(
     {
     if (!from_panel->IsCreated())
       {
-      from_panel->Create();
+      this->CreatePanel(from_panel);
       }
     int from_panel_id = this->GetPanelId(from_panel);
     if (this->Notebook->HasPage(from_page_title, from_panel_id))
@@ -1191,7 +1191,7 @@ int vtkKWUserInterfaceManagerNotebook::DragAndDropWidget(
     {
     if (!to_panel->IsCreated())
       {
-      to_panel->Create();
+      this->CreatePanel(to_panel);
       }
     int to_panel_id = this->GetPanelId(to_panel);
     if (this->Notebook->HasPage(to_page_title, to_panel_id))
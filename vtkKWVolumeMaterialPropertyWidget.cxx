@@ -133,8 +133,8 @@ void vtkKWVolumeMaterialPropertyWidget::CreateWidget()
     this->ComponentSelectionWidget->GetSelectedComponentOptionMenu();
   menubuttonwl->SetLabelWidth(label_width);
 
-  this->Script("pack %s -side top -padx 2 -pady 2 -anchor w",
-               this->ComponentSelectionWidget->GetWidgetName());
+  this->QueueScript("pack %s -side top -padx 2 -pady 2 -anchor w",
+                    this->ComponentSelectionWidget->GetWidgetName());
 
   // --------------------------------------------------------------
   // Enable Shading
@@ -172,13 +172,13 @@ void vtkKWVolumeMaterialPropertyWidget::Pack()
     {
     if (this->AllowEnableShading)
       {
-      this->Script("pack %s -side top -padx 2 -pady 2 -anchor w",
-                   this->EnableShadingCheckButton->GetWidgetName());
+      this->QueueScript("pack %s -side top -padx 2 -pady 2 -anchor w",
+                        this->EnableShadingCheckButton->GetWidgetName());
       }
     else
       {
-      this->Script("pack forget %s",
-                   this->EnableShadingCheckButton->GetWidgetName());
+      this->QueueScript("pack forget %s",
+                        this->EnableShadingCheckButton->GetWidgetName());
       }
     }
 }
@@ -22,17 +22,32 @@
 #include "vtkKWMultiColumnList.h"
 #include "vtkKWMultiColumnListWithScrollbars.h"
 #include "vtkKWIcon.h"
+#include "vtkKWApplication.h"
 #include "vtkKWVolumePropertyHelper.h"
 #include "vtkKWToolbar.h"
 #include "vtkKWPushButton.h"
 #include "vtkKWPushButtonSet.h"
 #include "vtkKWMenu.h"
+#include "vtkKWTkUtilities.h"
+#include "vtkMultiThreader.h"
 #include "vtkVolumeMapper.h"
 
 #include <vtksys/stl/string>
+#include <vtksys/stl/map>
+#include <vtksys/stl/vector>
+#include <vtksys/stl/algorithm>
 
 #define VTK_KW_WLPS_TOLERANCE 0.005
 
+// Number of thumbnails built by each thread before the batch is displayed
+
+#define VTK_KW_VPPS_THUMBNAILS_PER_THREAD 4
+
+// Maximum number of thumbnails kept in the cache (least recently used
+// thumbnails are discarded first)
+
+#define VTK_KW_VPPS_THUMBNAIL_CACHE_SIZE 256
+
 const char *vtkKWVolumePropertyPresetSelector::TypeColumnName  = "Type";
 
 //----------------------------------------------------------------------------
@@ -55,8 +70,58 @@ public:
 
   double RangeConstraint[2];
   int HasRangeConstraint;
+
+  // Thumbnails built from the volume properties, keyed by the contents of
+  // the functions they picture (the raw values, so that different
+  // functions can not share a thumbnail). Each entry is stamped with the
+  // last time it was used, so that the cache can be trimmed.
+
+  struct ThumbnailCacheEntry
+  {
+    vtkKWIcon *Icon;
+    unsigned long LastUsed;
+  };
+
+  typedef vtksys_stl::map<vtksys_stl::string, ThumbnailCacheEntry> ThumbnailCacheType;
+  typedef vtksys_stl::map<vtksys_stl::string, ThumbnailCacheEntry>::iterator ThumbnailCacheIterator;
+  ThumbnailCacheType ThumbnailCache;
+  unsigned long ThumbnailCacheTime;
+
+  void TrimThumbnailCache(size_t max_size);
+
+  // Presets waiting for their thumbnail to be built. The thumbnails
+  // requested while building others (say, by the idle tasks processed
+  // between two batches) wait for the next idle pass.
+
+  vtksys_stl::vector<int> PendingThumbnailIds;
+  vtksys_stl::string ScheduleBuildPendingThumbnailsTimerId;
+  int InBuildThumbnails;
 };
 
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyPresetSelectorInternals::TrimThumbnailCache(
+  size_t max_size)
+{
+  while (this->ThumbnailCache.size() > max_size)
+    {
+    ThumbnailCacheIterator it = this->ThumbnailCache.begin();
+    ThumbnailCacheIterator end = this->ThumbnailCache.end();
+    ThumbnailCacheIterator oldest = it;
+    for (++it; it != end; ++it)
+      {
+      if ((*it).second.LastUsed < (*oldest).second.LastUsed)
+        {
+        oldest = it;
+        }
+      }
+    if ((*oldest).second.Icon)
+      {
+      (*oldest).second.Icon->Delete();
+      }
+    this->ThumbnailCache.erase(oldest);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkKWVolumePropertyPresetSelector::vtkKWVolumePropertyPresetSelector()
 {
@@ -70,6 +135,10 @@ vtkKWVolumePropertyPresetSelector::vtkKWVolumePropertyPresetSelector()
   this->Internals->BlendModeSlotName = 
     "DefaultBlendModeSlot";
   this->Internals->HasRangeConstraint = 0;
+  this->Internals->ThumbnailCacheTime = 0;
+  this->Internals->InBuildThumbnails = 0;
+
+  this->AutoBuildPresetThumbnails = 0;
 
   this->FilterButtonVisibility = 0; // not 1 since the Type column is hidden;
   this->SetFilterButtonSlotName(this->GetPresetTypeSlotName());
@@ -81,6 +150,8 @@ vtkKWVolumePropertyPresetSelector::vtkKWVolumePropertyPresetSelector()
 //----------------------------------------------------------------------------
 vtkKWVolumePropertyPresetSelector::~vtkKWVolumePropertyPresetSelector()
 {
+  this->Internals->TrimThumbnailCache(0);
+
   delete this->Internals;
   this->Internals = NULL;
 }
@@ -162,6 +233,557 @@ int vtkKWVolumePropertyPresetSelector::IsPresetRangeInsideRange(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// A thumbnail to build, from copies of the preset functions (so that they
+// can be evaluated safely outside the main thread)
+
+class vtkKWVolumePropertyPresetThumbnailJob
+{
+public:
+  int Id;
+  vtksys_stl::string Key;
+  vtkColorTransferFunction *Color;
+  vtkPiecewiseFunction *Gray;
+  vtkPiecewiseFunction *Opacity;
+  double Range[2];
+  unsigned char *Pixels;
+};
+
+class vtkKWVolumePropertyPresetThumbnailInfo
+{
+public:
+  vtkKWVolumePropertyPresetThumbnailJob **Jobs;
+  int NumberOfJobs;
+  int Width;
+  int Height;
+};
+
+//----------------------------------------------------------------------------
+static void vtkKWVolumePropertyPresetSelectorAppendKey(
+  vtksys_stl::string &key, const void *data, size_t length)
+{
+  key.append(static_cast<const char*>(data), length);
+}
+
+//----------------------------------------------------------------------------
+static void vtkKWVolumePropertyPresetSelectorAppendKeyFunction(
+  vtksys_stl::string &key, vtkPiecewiseFunction *func)
+{
+  int size = func ? func->GetSize() : -1;
+  vtkKWVolumePropertyPresetSelectorAppendKey(key, &size, sizeof(size));
+  if (size <= 0)
+    {
+    return;
+    }
+
+  int clamping = func->GetClamping();
+  vtkKWVolumePropertyPresetSelectorAppendKey(
+    key, &clamping, sizeof(clamping));
+
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+  double node_value[4];
+  for (int i = 0; i < size; i++)
+    {
+    func->GetNodeValue(i, node_value);
+    vtkKWVolumePropertyPresetSelectorAppendKey(
+      key, node_value, sizeof(node_value));
+    }
+#else
+  vtkKWVolumePropertyPresetSelectorAppendKey(
+    key, func->GetDataPointer(), size * 2 * sizeof(double));
+#endif
+}
+
+//----------------------------------------------------------------------------
+static void vtkKWVolumePropertyPresetSelectorAppendKeyFunction(
+  vtksys_stl::string &key, vtkColorTransferFunction *func)
+{
+  int size = func ? func->GetSize() : -1;
+  vtkKWVolumePropertyPresetSelectorAppendKey(key, &size, sizeof(size));
+  if (size <= 0)
+    {
+    return;
+    }
+
+  int settings[2];
+  settings[0] = func->GetClamping();
+  settings[1] = func->GetColorSpace();
+  vtkKWVolumePropertyPresetSelectorAppendKey(
+    key, settings, sizeof(settings));
+
+#if VTK_MAJOR_VERSION > 5 || (VTK_MAJOR_VERSION == 5 && VTK_MINOR_VERSION > 0)
+  double node_value[6];
+  for (int i = 0; i < size; i++)
+    {
+    func->GetNodeValue(i, node_value);
+    vtkKWVolumePropertyPresetSelectorAppendKey(
+      key, node_value, sizeof(node_value));
+    }
+#else
+  vtkKWVolumePropertyPresetSelectorAppendKey(
+    key, func->GetDataPointer(), size * 4 * sizeof(double));
+#endif
+}
+
+//----------------------------------------------------------------------------
+static void vtkKWVolumePropertyPresetSelectorRenderThumbnail(
+  vtkKWVolumePropertyPresetThumbnailJob *job, int width, int height)
+{
+  // Leave 1 pixel for the black frame border
+
+  int ramp_width = width - 2;
+  int ramp_height = height - 2;
+
+  double *colors = new double [ramp_width * 3];
+  double *opacities = new double [ramp_width];
+  int i, j;
+
+  if (job->Color)
+    {
+    job->Color->GetTable(job->Range[0], job->Range[1], ramp_width, colors);
+    }
+  else if (job->Gray)
+    {
+    job->Gray->GetTable(
+      job->Range[0], job->Range[1], ramp_width, colors, 3);
+    for (i = 0; i < ramp_width; i++)
+      {
+      colors[i * 3 + 1] = colors[i * 3 + 2] = colors[i * 3];
+      }
+    }
+  else
+    {
+    for (i = 0; i < ramp_width * 3; i++)
+      {
+      colors[i] = 1.0;
+      }
+    }
+
+  if (job->Opacity)
+    {
+    job->Opacity->GetTable(
+      job->Range[0], job->Range[1], ramp_width, opacities);
+    }
+  else
+    {
+    for (i = 0; i < ramp_width; i++)
+      {
+      opacities[i] = 1.0;
+      }
+    }
+
+  // Fill the area under the opacity curve with the colors, over a light
+  // background
+
+  int bytes_in_row = width * 3;
+  unsigned char *ptr = job->Pixels;
+
+  memset(ptr, 0, bytes_in_row);
+  ptr += bytes_in_row;
+
+  for (j = ramp_height - 1; j >= 0; j--)
+    {
+    *ptr++ = 0;
+    *ptr++ = 0;
+    *ptr++ = 0;
+    for (i = 0; i < ramp_width; i++)
+      {
+      double opacity = opacities[i];
+      if (opacity > 1.0)
+        {
+        opacity = 1.0;
+        }
+      if ((double)j < opacity * (double)ramp_height)
+        {
+        double *rgb = colors + i * 3;
+        *ptr++ = (unsigned char)(rgb[0] * 255.0 + 0.5);
+        *ptr++ = (unsigned char)(rgb[1] * 255.0 + 0.5);
+        *ptr++ = (unsigned char)(rgb[2] * 255.0 + 0.5);
+        }
+      else
+        {
+        *ptr++ = 224;
+        *ptr++ = 224;
+        *ptr++ = 224;
+        }
+      }
+    *ptr++ = 0;
+    *ptr++ = 0;
+    *ptr++ = 0;
+    }
+
+  memset(ptr, 0, bytes_in_row);
+
+  delete [] colors;
+  delete [] opacities;
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkKWVolumePropertyPresetSelectorThumbnailThreadedExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *thread_info = 
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkKWVolumePropertyPresetThumbnailInfo *info = 
+    static_cast<vtkKWVolumePropertyPresetThumbnailInfo*>(
+      thread_info->UserData);
+
+  // Split the jobs evenly between threads
+
+  int nb_threads = thread_info->NumberOfThreads;
+  int thread_id = thread_info->ThreadID;
+  int start_job = (info->NumberOfJobs * thread_id) / nb_threads;
+  int end_job = (info->NumberOfJobs * (thread_id + 1)) / nb_threads;
+
+  for (int i = start_job; i < end_job; i++)
+    {
+    vtkKWVolumePropertyPresetSelectorRenderThumbnail(
+      info->Jobs[i], info->Width, info->Height);
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+int vtkKWVolumePropertyPresetSelector::BuildPresetThumbnailFromVolumeProperty(
+  int id)
+{
+  return this->BuildPresetThumbnailsForIds(1, &id);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWVolumePropertyPresetSelector::BuildPresetThumbnailsFromVolumeProperties()
+{
+  vtksys_stl::vector<int> ids;
+  int nb_presets = this->GetNumberOfPresets();
+  for (int i = 0; i < nb_presets; i++)
+    {
+    int id = this->GetIdOfNthPreset(i);
+    if (!this->GetPresetThumbnail(id))
+      {
+      ids.push_back(id);
+      }
+    }
+
+  return ids.empty() ? 0 : 
+    this->BuildPresetThumbnailsForIds((int)ids.size(), &ids[0]);
+}
+
+//----------------------------------------------------------------------------
+int vtkKWVolumePropertyPresetSelector::BuildPresetThumbnailsForIds(
+  int nb_ids, const int *ids)
+{
+  int width = this->GetThumbnailSize();
+  int height = width / 2;
+  if (nb_ids <= 0 || !ids || height < 4)
+    {
+    return 0;
+    }
+
+  int nb_built = 0, i;
+
+  // Requested while building (say, by the idle tasks processed between
+  // batches): wait for the next idle pass
+
+  if (this->Internals->InBuildThumbnails)
+    {
+    for (i = 0; i < nb_ids; i++)
+      {
+      this->ScheduleBuildPresetThumbnail(ids[i]);
+      }
+    return 0;
+    }
+
+  this->Internals->InBuildThumbnails = 1;
+
+  vtkKWVolumePropertyPresetSelectorInternals::ThumbnailCacheIterator it;
+  vtkKWVolumePropertyPresetSelectorInternals::ThumbnailCacheIterator end = 
+    this->Internals->ThumbnailCache.end();
+
+  // Copy the functions of the presets that are not in the cache already,
+  // and assign the others right away
+
+  vtksys_stl::vector<vtkKWVolumePropertyPresetThumbnailJob> jobs;
+
+  for (i = 0; i < nb_ids; i++)
+    {
+    vtkVolumeProperty *vprop = this->GetPresetVolumeProperty(ids[i]);
+    if (!vprop)
+      {
+      continue;
+      }
+
+    vtkKWVolumePropertyPresetThumbnailJob job;
+    job.Id = ids[i];
+    job.Color = NULL;
+    job.Gray = NULL;
+    job.Opacity = NULL;
+    job.Pixels = NULL;
+
+    vtkPiecewiseFunction *opacity = vprop->GetScalarOpacity(0);
+    vtkPiecewiseFunction *gray = NULL;
+    vtkColorTransferFunction *color = NULL;
+    if (vprop->GetColorChannels(0) == 1)
+      {
+      gray = vprop->GetGrayTransferFunction(0);
+      }
+    else
+      {
+      color = vprop->GetRGBTransferFunction(0);
+      }
+
+    vtkKWVolumePropertyPresetSelectorAppendKey(
+      job.Key, &width, sizeof(width));
+    vtkKWVolumePropertyPresetSelectorAppendKeyFunction(job.Key, color);
+    vtkKWVolumePropertyPresetSelectorAppendKeyFunction(job.Key, gray);
+    vtkKWVolumePropertyPresetSelectorAppendKeyFunction(job.Key, opacity);
+
+    it = this->Internals->ThumbnailCache.find(job.Key);
+    if (it != end && (*it).second.Icon)
+      {
+      (*it).second.LastUsed = ++this->Internals->ThumbnailCacheTime;
+      this->SetPresetThumbnail(job.Id, (*it).second.Icon);
+      nb_built++;
+      continue;
+      }
+
+    job.Range[0] = VTK_DOUBLE_MAX;
+    job.Range[1] = VTK_DOUBLE_MIN;
+    if (color && color->GetSize())
+      {
+      job.Color = vtkColorTransferFunction::New();
+      job.Color->DeepCopy(color);
+      if (color->GetRange()[0] < job.Range[0])
+        {
+        job.Range[0] = color->GetRange()[0];
+        }
+      if (color->GetRange()[1] > job.Range[1])
+        {
+        job.Range[1] = color->GetRange()[1];
+        }
+      }
+    if (gray && gray->GetSize())
+      {
+      job.Gray = vtkPiecewiseFunction::New();
+      job.Gray->DeepCopy(gray);
+      if (gray->GetRange()[0] < job.Range[0])
+        {
+        job.Range[0] = gray->GetRange()[0];
+        }
+      if (gray->GetRange()[1] > job.Range[1])
+        {
+        job.Range[1] = gray->GetRange()[1];
+        }
+      }
+    if (opacity && opacity->GetSize())
+      {
+      job.Opacity = vtkPiecewiseFunction::New();
+      job.Opacity->DeepCopy(opacity);
+      if (opacity->GetRange()[0] < job.Range[0])
+        {
+        job.Range[0] = opacity->GetRange()[0];
+        }
+      if (opacity->GetRange()[1] > job.Range[1])
+        {
+        job.Range[1] = opacity->GetRange()[1];
+        }
+      }
+    if (job.Range[0] > job.Range[1])
+      {
+      job.Range[0] = 0.0;
+      job.Range[1] = 1.0;
+      }
+
+    job.Pixels = new unsigned char [width * height * 3];
+    jobs.push_back(job);
+    }
+
+  // Evaluate the functions in batches, and display each batch as soon as
+  // it is complete. Identical presets in the same batch are evaluated only
+  // once: each job points to the first job with the same key.
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  int nb_threads = threader->GetNumberOfThreads();
+  int batch_size = nb_threads * VTK_KW_VPPS_THUMBNAILS_PER_THREAD;
+  int nb_jobs = (int)jobs.size();
+
+  vtksys_stl::vector<vtkKWVolumePropertyPresetThumbnailJob*> batch;
+  vtkKWVolumePropertyPresetThumbnailInfo info;
+  info.Width = width;
+  info.Height = height;
+
+  int start_job = 0;
+  while (start_job < nb_jobs)
+    {
+    int end_job = start_job + batch_size;
+    if (end_job > nb_jobs)
+      {
+      end_job = nb_jobs;
+      }
+
+    batch.clear();
+    for (i = start_job; i < end_job; i++)
+      {
+      if (this->Internals->ThumbnailCache.find(jobs[i].Key) == end)
+        {
+        vtkKWVolumePropertyPresetSelectorInternals::ThumbnailCacheEntry entry;
+        entry.Icon = NULL;
+        entry.LastUsed = ++this->Internals->ThumbnailCacheTime;
+        this->Internals->ThumbnailCache[jobs[i].Key] = entry;
+        batch.push_back(&jobs[i]);
+        }
+      }
+
+    info.Jobs = batch.empty() ? NULL : &batch[0];
+    info.NumberOfJobs = (int)batch.size();
+    if (info.NumberOfJobs > 1 && nb_threads > 1)
+      {
+      threader->SetNumberOfThreads(
+        info.NumberOfJobs < nb_threads ? info.NumberOfJobs : nb_threads);
+      threader->SetSingleMethod(
+        vtkKWVolumePropertyPresetSelectorThumbnailThreadedExecute, &info);
+      threader->SingleMethodExecute();
+      }
+    else if (info.NumberOfJobs)
+      {
+      vtkMultiThreader::ThreadInfo thread_info;
+      thread_info.ThreadID = 0;
+      thread_info.NumberOfThreads = 1;
+      thread_info.UserData = &info;
+      vtkKWVolumePropertyPresetSelectorThumbnailThreadedExecute(&thread_info);
+      }
+
+    // Store the new thumbnails in the cache, then assign them
+
+    int j;
+    for (j = 0; j < info.NumberOfJobs; j++)
+      {
+      vtkKWIcon *icon = vtkKWIcon::New();
+      icon->SetImage(batch[j]->Pixels, width, height, 3);
+      vtkKWVolumePropertyPresetSelectorInternals::ThumbnailCacheEntry &entry =
+        this->Internals->ThumbnailCache[batch[j]->Key];
+      entry.Icon = icon;
+      entry.LastUsed = ++this->Internals->ThumbnailCacheTime;
+      }
+
+    for (i = start_job; i < end_job; i++)
+      {
+      it = this->Internals->ThumbnailCache.find(jobs[i].Key);
+      if (it != end && (*it).second.Icon)
+        {
+        this->SetPresetThumbnail(jobs[i].Id, (*it).second.Icon);
+        nb_built++;
+        }
+      }
+
+    if (this->IsCreated())
+      {
+      vtkKWTkUtilities::ProcessIdleTasks(this->GetApplication());
+      }
+
+    start_job = end_job;
+    }
+
+  threader->Delete();
+
+  for (i = 0; i < nb_jobs; i++)
+    {
+    if (jobs[i].Color)
+      {
+      jobs[i].Color->Delete();
+      }
+    if (jobs[i].Gray)
+      {
+      jobs[i].Gray->Delete();
+      }
+    if (jobs[i].Opacity)
+      {
+      jobs[i].Opacity->Delete();
+      }
+    delete [] jobs[i].Pixels;
+    }
+
+  this->Internals->TrimThumbnailCache(VTK_KW_VPPS_THUMBNAIL_CACHE_SIZE);
+
+  this->Internals->InBuildThumbnails = 0;
+
+  // Schedule the thumbnails requested in the meantime
+
+  vtksys_stl::vector<int> pending;
+  pending.swap(this->Internals->PendingThumbnailIds);
+  vtksys_stl::vector<int>::iterator p_it = pending.begin();
+  vtksys_stl::vector<int>::iterator p_end = pending.end();
+  for (; p_it != p_end; ++p_it)
+    {
+    this->ScheduleBuildPresetThumbnail(*p_it);
+    }
+
+  return nb_built;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyPresetSelector::ScheduleBuildPresetThumbnail(int id)
+{
+  vtksys_stl::vector<int> &pending = this->Internals->PendingThumbnailIds;
+  if (vtksys_stl::find(pending.begin(), pending.end(), id) == pending.end())
+    {
+    pending.push_back(id);
+    }
+
+  // Already scheduled, or to be scheduled once the current build is done
+  // (the idle tasks are processed between batches)
+
+  if (this->Internals->ScheduleBuildPendingThumbnailsTimerId.size() ||
+      this->Internals->InBuildThumbnails)
+    {
+    return;
+    }
+
+  this->Internals->ScheduleBuildPendingThumbnailsTimerId =
+    this->Script("after idle {catch {%s BuildPendingPresetThumbnailsCallback}}",
+                 this->GetTclName());
+}
+
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyPresetSelector::BuildPendingPresetThumbnailsCallback()
+{
+  this->Internals->ScheduleBuildPendingThumbnailsTimerId = "";
+
+  // Invoked while building (see BuildPresetThumbnailsForIds): the pending
+  // thumbnails will be scheduled again once that build is done
+
+  if (this->Internals->InBuildThumbnails)
+    {
+    return;
+    }
+
+  vtksys_stl::vector<int> pending;
+  pending.swap(this->Internals->PendingThumbnailIds);
+
+  if (!this->GetApplication() || this->GetApplication()->GetInExit() ||
+      !this->IsAlive())
+    {
+    return;
+    }
+
+  // Skip the presets that were removed or given a thumbnail in the meantime
+
+  vtksys_stl::vector<int> ids;
+  vtksys_stl::vector<int>::iterator it = pending.begin();
+  vtksys_stl::vector<int>::iterator end = pending.end();
+  for (; it != end; ++it)
+    {
+    if (this->HasPreset(*it) && !this->GetPresetThumbnail(*it))
+      {
+      ids.push_back(*it);
+      }
+    }
+
+  if (!ids.empty())
+    {
+    this->BuildPresetThumbnailsForIds((int)ids.size(), &ids[0]);
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkKWVolumePropertyPresetSelector::SetPresetType(
   int id, const char *val)
@@ -446,6 +1068,18 @@ int vtkKWVolumePropertyPresetSelector::UpdatePresetRow(int id)
 
   list->SetCellText(
     row, this->GetTypeColumnIndex(), this->GetPresetType(id));
+
+  // Presets without a thumbnail can get one built from their volume
+  // property (all the rows updated at once are built in a single batch, at
+  // idle time)
+
+  if (this->AutoBuildPresetThumbnails &&
+      this->GetThumbnailColumnVisibility() && 
+      !this->GetPresetThumbnail(id) && 
+      this->GetPresetVolumeProperty(id))
+    {
+    this->ScheduleBuildPresetThumbnail(id);
+    }
   
   return 1;
 }
@@ -667,4 +1301,7 @@ void vtkKWVolumePropertyPresetSelector::AddDefaultNormalizedPresets(
 void vtkKWVolumePropertyPresetSelector::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "AutoBuildPresetThumbnails: "
+     << (this->AutoBuildPresetThumbnails ? "On" : "Off") << endl;
 }
@@ -96,6 +96,34 @@ public:
   // Return 1 on success (or HistogramFlag is On), 0 on error
   virtual int IsPresetRangeInsideRange(int id, double range[2]);
 
+  // Description:
+  // Build the thumbnail of a preset from its volume property, i.e. a
+  // picture of the opacity transfer function of the first component, filled
+  // with the colors of its color transfer function.
+  // BuildPresetThumbnailsFromVolumeProperties builds the thumbnails of all
+  // the presets that do not have one yet. The functions are copied first,
+  // then evaluated in parallel, and the thumbnails are displayed batch by
+  // batch as they complete. Thumbnails are cached by function contents, so
+  // that identical presets are only evaluated once (the least recently used
+  // thumbnails are discarded when the cache is full). Thumbnails requested
+  // while others are being built (say, by an idle task) are built at the
+  // next idle pass instead.
+  // Return 1 (or the number of thumbnails built) on success, 0 otherwise
+  virtual int BuildPresetThumbnailFromVolumeProperty(int id);
+  virtual int BuildPresetThumbnailsFromVolumeProperties();
+
+  // Description:
+  // Set/Get if the presets that do not have a thumbnail should get one
+  // built from their volume property automatically (see
+  // BuildPresetThumbnailsFromVolumeProperties). If On, and the thumbnail
+  // column is visible, UpdatePresetRow schedules the presets that do not
+  // have a thumbnail, and builds them in a single batch at idle time.
+  // Thumbnails set by the application (see SetPresetThumbnail) before that
+  // time are left untouched. Off by default.
+  vtkSetMacro(AutoBuildPresetThumbnails, int);
+  vtkGetMacro(AutoBuildPresetThumbnails, int);
+  vtkBooleanMacro(AutoBuildPresetThumbnails, int);
+
   // Description:
   // Set/Get the visibility of the type column. Hidden by default.
   // No effect if called before Create().
@@ -147,6 +175,10 @@ public:
   static const char *TypeColumnName;
   //ETX
 
+  // Description:
+  // Callbacks. Internal, do not use.
+  virtual void BuildPendingPresetThumbnailsCallback();
+
 protected:
   vtkKWVolumePropertyPresetSelector();
   ~vtkKWVolumePropertyPresetSelector();
@@ -182,6 +214,19 @@ protected:
   // preset buttons.
   virtual void PopulatePresetContextMenu(vtkKWMenu *menu, int id);
 
+  // Description:
+  // Build the thumbnails of 'nb_ids' presets (see
+  // BuildPresetThumbnailsFromVolumeProperties).
+  // Return the number of thumbnails built.
+  virtual int BuildPresetThumbnailsForIds(int nb_ids, const int *ids);
+
+  // Description:
+  // Schedule the thumbnail of a preset to be built at idle time, along
+  // with the other presets scheduled in the meantime.
+  virtual void ScheduleBuildPresetThumbnail(int id);
+
+  int AutoBuildPresetThumbnails;
+
   // PIMPL Encapsulation for STL containers
   //BTX
   vtkKWVolumePropertyPresetSelectorInternals *Internals;
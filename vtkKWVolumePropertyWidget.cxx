@@ -85,6 +85,10 @@ vtkKWVolumePropertyWidget::vtkKWVolumePropertyWidget()
     vtkKWVolumePropertyWidget::WholeRangeComputationMethodData;
 
   this->UseScalarColorFunctionInScalarOpacityEditor        = 0;
+  this->CoalesceInteractiveRedraws    = 0;
+
+  this->EditTransactionDepth          = 0;
+  this->EditTransactionPending        = 0;
 
   this->VolumePropertyChangedCommand  = NULL;
   this->VolumePropertyChangingCommand = NULL;
@@ -854,6 +858,19 @@ void vtkKWVolumePropertyWidget::Pack()
 //----------------------------------------------------------------------------
 void vtkKWVolumePropertyWidget::Update()
 {
+  // The editors are synchronized together, redraw them once, at the end.
+  // Updating the widget from the volume property is not an edit: if the
+  // transaction is ours, it does not notify the listeners (which would
+  // likely call Update again).
+
+  int outermost = !this->EditTransactionDepth;
+  this->BeginEditTransaction();
+  if (outermost)
+    {
+    this->EditTransactionPending |= 
+      vtkKWVolumePropertyWidget::PendingNoNotification;
+    }
+
   // Update enable state
 
   this->UpdateEnableState();
@@ -1412,6 +1429,8 @@ void vtkKWVolumePropertyWidget::Update()
     {
     this->Script(tk_cmd.str().c_str());
     }
+
+  this->EndEditTransaction();
 }
 
 //----------------------------------------------------------------------------
@@ -1904,6 +1923,137 @@ void vtkKWVolumePropertyWidget::SetUseScalarColorFunctionInScalarOpacityEditor(i
   this->Update();
 }
 
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyWidget::SetCoalesceInteractiveRedraws(int arg)
+{
+  if (this->CoalesceInteractiveRedraws == arg)
+    {
+    return;
+    }
+
+  this->CoalesceInteractiveRedraws = arg;
+
+  this->Modified();
+
+  if (this->ScalarOpacityFunctionEditor)
+    {
+    this->ScalarOpacityFunctionEditor->SetCoalesceInteractiveRedraws(arg);
+    }
+  if (this->ScalarColorFunctionEditor)
+    {
+    this->ScalarColorFunctionEditor->SetCoalesceInteractiveRedraws(arg);
+    }
+  if (this->GradientOpacityFunctionEditor)
+    {
+    this->GradientOpacityFunctionEditor->SetCoalesceInteractiveRedraws(arg);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyWidget::BeginEditTransaction()
+{
+  if (this->EditTransactionDepth++)
+    {
+    return;
+    }
+
+  this->EditTransactionPending = 0;
+
+  if (this->ScalarOpacityFunctionEditor)
+    {
+    this->ScalarOpacityFunctionEditor->BeginEditTransaction();
+    }
+  if (this->ScalarColorFunctionEditor)
+    {
+    this->ScalarColorFunctionEditor->BeginEditTransaction();
+    }
+  if (this->GradientOpacityFunctionEditor)
+    {
+    this->GradientOpacityFunctionEditor->BeginEditTransaction();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyWidget::EndEditTransaction()
+{
+  if (!this->EditTransactionDepth || this->EditTransactionDepth > 1)
+    {
+    if (this->EditTransactionDepth)
+      {
+      this->EditTransactionDepth--;
+      }
+    return;
+    }
+
+  // End the editors transactions first. They redraw and invoke their
+  // commands, which end up in our callbacks: we are still in the
+  // transaction, their requests are only recorded.
+
+  if (this->ScalarOpacityFunctionEditor)
+    {
+    this->ScalarOpacityFunctionEditor->EndEditTransaction();
+    }
+  if (this->ScalarColorFunctionEditor)
+    {
+    this->ScalarColorFunctionEditor->EndEditTransaction();
+    }
+  if (this->GradientOpacityFunctionEditor)
+    {
+    this->GradientOpacityFunctionEditor->EndEditTransaction();
+    }
+
+  int pending = this->EditTransactionPending;
+  this->EditTransactionPending = 0;
+  this->EditTransactionDepth = 0;
+
+  if (pending & vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor)
+    {
+    this->RequestUpdate(
+      vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor);
+    }
+
+  // A single notification, Changed supersedes Changing
+
+  if (pending & vtkKWVolumePropertyWidget::PendingNoNotification)
+    {
+    return;
+    }
+  if (pending & vtkKWVolumePropertyWidget::PendingVolumePropertyChangedCommand)
+    {
+    this->InvokeVolumePropertyChangedCommand();
+    }
+  else if (pending & 
+           vtkKWVolumePropertyWidget::PendingVolumePropertyChangingCommand)
+    {
+    this->InvokeVolumePropertyChangingCommand();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkKWVolumePropertyWidget::IsInEditTransaction()
+{
+  return this->EditTransactionDepth ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkKWVolumePropertyWidget::RequestUpdate(int elements)
+{
+  if (this->EditTransactionDepth)
+    {
+    this->EditTransactionPending |= elements;
+    return;
+    }
+
+  if (elements & vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor)
+    {
+    if (this->UseScalarColorFunctionInScalarOpacityEditor &&
+        this->ScalarOpacityFunctionEditor)
+      {
+      this->ScalarOpacityFunctionEditor->Update();
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkKWVolumePropertyWidget::MergeScalarOpacityAndColorEditors()
 {
@@ -1963,6 +2113,13 @@ void vtkKWVolumePropertyWidget::SetVolumePropertyChangedCommand(
 //----------------------------------------------------------------------------
 void vtkKWVolumePropertyWidget::InvokeVolumePropertyChangedCommand()
 {
+  if (this->EditTransactionDepth)
+    {
+    this->EditTransactionPending |= 
+      vtkKWVolumePropertyWidget::PendingVolumePropertyChangedCommand;
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->VolumePropertyChangedCommand);
 
   this->InvokeEvent(vtkKWEvent::VolumePropertyChangedEvent, NULL);
@@ -1979,6 +2136,13 @@ void vtkKWVolumePropertyWidget::SetVolumePropertyChangingCommand(
 //----------------------------------------------------------------------------
 void vtkKWVolumePropertyWidget::InvokeVolumePropertyChangingCommand()
 {
+  if (this->EditTransactionDepth)
+    {
+    this->EditTransactionPending |= 
+      vtkKWVolumePropertyWidget::PendingVolumePropertyChangingCommand;
+    return;
+    }
+
   this->InvokeObjectMethodCommand(this->VolumePropertyChangingCommand);
 
   this->InvokeEvent(vtkKWEvent::VolumePropertyChangingEvent, NULL);
@@ -2205,11 +2369,8 @@ void vtkKWVolumePropertyWidget::RGBTransferFunctionChangedCallback()
 {
   this->UpdateHSVColorSelectorFromScalarColorFunctionEditor();
 
-  if (this->UseScalarColorFunctionInScalarOpacityEditor &&
-      this->ScalarOpacityFunctionEditor)
-    {
-    this->ScalarOpacityFunctionEditor->Update();
-    }
+  this->RequestUpdate(
+    vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor);
 
   this->InvokeVolumePropertyChangedCommand();
 }
@@ -2219,11 +2380,8 @@ void vtkKWVolumePropertyWidget::RGBTransferFunctionChangingCallback()
 {
   this->UpdateHSVColorSelectorFromScalarColorFunctionEditor();
 
-  if (this->UseScalarColorFunctionInScalarOpacityEditor &&
-      this->ScalarOpacityFunctionEditor)
-    {
-    this->ScalarOpacityFunctionEditor->Update();
-    }
+  this->RequestUpdate(
+    vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor);
 
   if (this->InteractiveApplyMode)
     {
@@ -2340,11 +2498,8 @@ void vtkKWVolumePropertyWidget::HSVColorSelectionChangedCallback(
   this->ScalarColorFunctionEditor->SetPointColorAsHSV(
     this->ScalarColorFunctionEditor->GetSelectedPoint(), h, s, v);
 
-  if (this->UseScalarColorFunctionInScalarOpacityEditor &&
-      this->ScalarOpacityFunctionEditor)
-    {
-    this->ScalarOpacityFunctionEditor->Update();
-    }
+  this->RequestUpdate(
+    vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor);
 
   this->InvokeVolumePropertyChangedCommand();
 }
@@ -2369,12 +2524,9 @@ void vtkKWVolumePropertyWidget::HSVColorSelectionChangingCallback(
   if (this->ScalarColorFunctionEditor->GetColorTransferFunction()->GetMTime() >
       mtime)
     {
-    if (this->UseScalarColorFunctionInScalarOpacityEditor &&
-        this->ScalarOpacityFunctionEditor)
-      {
-      this->ScalarOpacityFunctionEditor->Update();
-      }
-  if (this->InteractiveApplyMode)
+    this->RequestUpdate(
+      vtkKWVolumePropertyWidget::UpdateScalarOpacityFunctionEditor);
+    if (this->InteractiveApplyMode)
       {
       this->InvokeVolumePropertyChangingCommand();
       }
@@ -2432,6 +2584,8 @@ void vtkKWVolumePropertyWidget::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComponentSelectionVisibility ? "On" : "Off") << endl;
   os << indent << "InteractiveApplyMode: "
      << (this->InteractiveApplyMode ? "On" : "Off") << endl;
+  os << indent << "CoalesceInteractiveRedraws: "
+     << (this->CoalesceInteractiveRedraws ? "On" : "Off") << endl;
   os << indent << "InteractiveApplyButtonVisibility: "
      << (this->InteractiveApplyButtonVisibility ? "On" : "Off") << endl;
   os << indent << "ScalarOpacityUnitDistanceVisibility: "
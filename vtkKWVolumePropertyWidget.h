@@ -227,6 +227,36 @@ public:
   vtkGetMacro(DisableCommands, int);
   vtkBooleanMacro(DisableCommands, int);
 
+  // Description:
+  // Edit transactions. Between BeginEditTransaction and EndEditTransaction,
+  // the volume property can be modified through this widget and its
+  // function editors without the editors being redrawn, or the
+  // VolumePropertyChanged and VolumePropertyChanging commands and events
+  // being invoked. EndEditTransaction then redraws each editor once, and
+  // invokes a single VolumePropertyChanged command and event (or a single
+  // VolumePropertyChanging one if only interactive changes were made).
+  // The widget uses transactions itself in Update, so that editors that are
+  // synchronized together are not redrawn each time one of them is. The
+  // transaction opened by Update does not invoke any command or event, the
+  // volume property was not edited; if Update is called within another
+  // transaction, that transaction notifies as usual.
+  // Transactions can be nested, only the outermost EndEditTransaction has
+  // an effect.
+  virtual void BeginEditTransaction();
+  virtual void EndEditTransaction();
+  virtual int  IsInEditTransaction();
+
+  // Description:
+  // Set/Get if the interactive redraws of the function editors should be
+  // coalesced (defaults to Off). If On, the editors, which are synchronized
+  // together, are redrawn at most once per idle cycle of the event loop
+  // while a point is dragged, and the VolumePropertyChanging command is
+  // invoked accordingly. See
+  // vtkKWParameterValueFunctionEditor::CoalesceInteractiveRedraws.
+  virtual void SetCoalesceInteractiveRedraws(int);
+  vtkBooleanMacro(CoalesceInteractiveRedraws, int);
+  vtkGetMacro(CoalesceInteractiveRedraws, int);
+
   // Description:
   // Set the method used to compute the whole range of the various transfer
   // function editors. If set to Data, the scalar range of the data is used.
@@ -323,6 +353,7 @@ protected:
   int   GradientOpacityFunctionVisibility;
   int   ComponentWeightsVisibility;
   int   UseScalarColorFunctionInScalarOpacityEditor;
+  int   CoalesceInteractiveRedraws;
 
   // Commands
 
@@ -332,6 +363,34 @@ protected:
   virtual void InvokeObjectMethodCommand(const char *command);
   virtual void InvokeVolumePropertyChangedCommand();
   virtual void InvokeVolumePropertyChangingCommand();
+
+  // Description:
+  // Update the scalar opacity editor (when it uses the scalar color
+  // function to color its points), right away or at the end of the current
+  // edit transaction.
+  //BTX
+  enum
+  {
+    UpdateScalarOpacityFunctionEditor = 1
+  };
+  //ETX
+  virtual void RequestUpdate(int elements);
+
+  // Description:
+  // Edit transaction depth, and what has to be done at the end of the
+  // outermost transaction (a combination of the RequestUpdate elements and
+  // the values below). PendingNoNotification drops the notifications of a
+  // transaction opened by Update.
+  //BTX
+  enum
+  {
+    PendingVolumePropertyChangedCommand  = 4,
+    PendingVolumePropertyChangingCommand = 8,
+    PendingNoNotification                = 16
+  };
+  //ETX
+  int EditTransactionDepth;
+  int EditTransactionPending;
   
   // GUI
 
@@ -26,6 +26,7 @@
 
 #include "vtkKWWidgetsConfigure.h" // for KWWidgets_USE_TKDND
 
+#include <vtksys/stl/string>
 #include <vtksys/stl/vector>
 #include <vtksys/stl/algorithm>
 #include <vtksys/SystemTools.hxx>
@@ -298,7 +299,23 @@ int vtkKWWidget::CreateSpecificTkWidget(vtkKWWidget *obj,
     }
   else
     {
-    if (args)
+    // In a script batch, the creation command is queued like the rest. It
+    // can not be checked right now: if it fails, the batch reports the 
+    // error and resets WidgetIsCreated (see TkWidgetCreationFailed).
+
+    if (app->GetScriptBatchDepth() > 0)
+      {
+      vtksys_stl::string cmd(type);
+      cmd += " ";
+      cmd += obj->GetWidgetName();
+      if (args)
+        {
+        cmd += " ";
+        cmd += args;
+        }
+      app->AddWidgetCreationToBatch(obj, cmd.c_str());
+      }
+    else if (args)
       {
       ret = obj->Script("%s %s %s", type, obj->GetWidgetName(), args);
       }
@@ -331,6 +348,12 @@ int vtkKWWidget::IsCreated()
   return (this->GetApplication() != NULL && this->WidgetIsCreated);
 }
 
+// ---------------------------------------------------------------------------
+void vtkKWWidget::TkWidgetCreationFailed()
+{
+  this->WidgetIsCreated = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkKWWidget::AddChild(vtkKWWidget *child) 
 {
@@ -833,7 +856,7 @@ void vtkKWWidget::SetGenericBinding(
 {
   char *command = NULL;
   this->SetObjectMethodCommand(&command, object, method);
-  this->Script("bind %s %s {%s}", target, event, command);
+  this->QueueScript("bind %s %s {%s}", target, event, command);
   delete [] command;
 }
 
@@ -870,7 +893,7 @@ void vtkKWWidget::AddGenericBinding(
 {
   char *command = NULL;
   this->SetObjectMethodCommand(&command, object, method);
-  this->Script("bind %s %s {+%s}", target, event, command);
+  this->QueueScript("bind %s %s {+%s}", target, event, command);
   delete [] command;
 }
 
@@ -88,6 +88,13 @@ public:
   // Query if the widget was created successfully.
   virtual int IsCreated();
 
+  // Description:
+  // Notify the widget that its Tk widget was not created after all: its
+  // creation command was queued in a script batch (see
+  // CreateSpecificTkWidget) and failed when the batch was evaluated.
+  // IsCreated() returns 0 from then on. This is used by vtkKWApplication.
+  virtual void TkWidgetCreationFailed();
+
   // Description:
   // Query if the widget is "alive" (i.e. IsCreated()) and has not been 
   // deleted as far as Tk is concerned.
@@ -339,6 +346,10 @@ protected:
   // (i.e. SetConfigurationOptions()), and therefore that have to be passed
   // at widget's creation time. For example the -visual and -class options 
   // of the 'toplevel' widget.
+  // Within a script batch (see vtkKWApplication::BeginScriptBatch), the
+  // creation command is queued and the widget is considered created; if
+  // the command fails when the batch is flushed, the error is reported on
+  // 'obj' and the widget is not considered created anymore.
   // Return 1 on success, 0 otherwise.
   static int CreateSpecificTkWidget(
     vtkKWWidget *obj, const char *type, const char *args = NULL);
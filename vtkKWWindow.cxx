@@ -281,10 +281,10 @@ void vtkKWWindow::CreateWidget()
     this->MainSplitFrame->Create();
     }
 
-  this->Script("pack %s -side top -fill both -expand t",
-               this->MainSplitFrame->GetWidgetName());
-  this->Script("pack %s -side top -fill both -expand t",
-               this->SecondarySplitFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand t",
+                    this->MainSplitFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand t",
+                    this->SecondarySplitFrame->GetWidgetName());
 
   this->AddCallbackCommandObservers();
 }
@@ -441,16 +441,16 @@ void vtkKWWindow::Pack()
       }
     if (this->StatusFrameVisibility && in && in->IsCreated())
       {
-      this->Script("pack %s -side bottom -fill x -pady 0 -in %s",
-                   this->StatusFrame->GetWidgetName(),
-                   in->GetWidgetName());
+      this->QueueScript("pack %s -side bottom -fill x -pady 0 -in %s",
+                        this->StatusFrame->GetWidgetName(),
+                        in->GetWidgetName());
 
       if (this->StatusFrameSeparator && 
           this->StatusFrameSeparator->IsCreated())
         {
-        this->Script("pack %s -side bottom -fill x -pady 2 -in %s",
-                     this->StatusFrameSeparator->GetWidgetName(),
-                     in->GetWidgetName());
+        this->QueueScript("pack %s -side bottom -fill x -pady 2 -in %s",
+                          this->StatusFrameSeparator->GetWidgetName(),
+                          in->GetWidgetName());
         }
       }
     }
@@ -489,7 +489,7 @@ vtkKWToolbarSet* vtkKWWindow::GetSecondaryToolbarSet()
       after += this->ViewNotebook->GetWidgetName();
       }
 
-    this->Script(
+    this->QueueScript(
       "pack %s -padx 0 -pady 0 -side bottom -fill x -expand no %s",
       this->SecondaryToolbarSet->GetWidgetName(), after.c_str());
     }
@@ -646,8 +646,8 @@ vtkKWNotebook* vtkKWWindow::GetMainNotebook()
     {
     this->MainNotebook->SetParent(this->GetMainPanelFrame());
     this->MainNotebook->Create();
-    this->Script("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
-                 this->MainNotebook->GetWidgetName());
+    this->QueueScript("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
+                      this->MainNotebook->GetWidgetName());
     }
 
   return this->MainNotebook;
@@ -800,8 +800,8 @@ vtkKWNotebook* vtkKWWindow::GetSecondaryNotebook()
     {
     this->SecondaryNotebook->SetParent(this->GetSecondaryPanelFrame());
     this->SecondaryNotebook->Create();
-    this->Script("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
-                 this->SecondaryNotebook->GetWidgetName());
+    this->QueueScript("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
+                      this->SecondaryNotebook->GetWidgetName());
     }
 
   return this->SecondaryNotebook;
@@ -970,8 +970,8 @@ vtkKWNotebook* vtkKWWindow::GetViewNotebook()
     {
     this->ViewNotebook->SetParent(this->GetViewPanelFrame());
     this->ViewNotebook->Create();
-    this->Script("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
-                 this->ViewNotebook->GetWidgetName());
+    this->QueueScript("pack %s -pady 0 -padx 0 -fill both -expand yes -anchor n",
+                      this->ViewNotebook->GetWidgetName());
     }
 
   return this->ViewNotebook;
@@ -418,8 +418,8 @@ void vtkKWWindowBase::CreateWidget()
   this->TrayImageError->SetBorderWidth(1);
   this->TrayImageError->SetImageToPredefinedIcon(vtkKWIcon::IconEmpty16x16);
 
-  this->Script("pack %s -fill both -ipadx 2 -ipady 0 -pady 0", 
-               this->TrayImageError->GetWidgetName());
+  this->QueueScript("pack %s -fill both -ipadx 2 -ipady 0 -pady 0", 
+                    this->TrayImageError->GetWidgetName());
 
   // Pack and restore geometry
 
@@ -563,8 +563,8 @@ void vtkKWWindowBase::Pack()
   
   if (this->MenuBarSeparator && this->MenuBarSeparator->IsCreated())
     {
-    this->Script("pack %s -side top -fill x -pady 2",
-                 this->MenuBarSeparator->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -pady 2",
+                      this->MenuBarSeparator->GetWidgetName());
     }
 
   // Toolbars
@@ -578,7 +578,7 @@ void vtkKWWindowBase::Pack()
       after = " -after ";
       after += this->MenuBarSeparator->GetWidgetName();
       }
-    this->Script(
+    this->QueueScript(
       "pack %s -padx 0 -pady 0 -side top -fill x -expand no %s",
       this->MainToolbarSet->GetWidgetName(), after.c_str());
     }
@@ -587,8 +587,8 @@ void vtkKWWindowBase::Pack()
 
   if (this->MainFrame && this->MainFrame->IsCreated())
     {
-    this->Script("pack %s -side top -fill both -expand t",
-                 this->MainFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill both -expand t",
+                      this->MainFrame->GetWidgetName());
     }
 
   // Status frame and status frame separator
@@ -597,14 +597,14 @@ void vtkKWWindowBase::Pack()
     {
     if (this->StatusFrameVisibility)
       {
-      this->Script("pack %s -side bottom -fill x -pady 0",
-                   this->StatusFrame->GetWidgetName());
+      this->QueueScript("pack %s -side bottom -fill x -pady 0",
+                        this->StatusFrame->GetWidgetName());
 
       if (this->StatusFrameSeparator && 
           this->StatusFrameSeparator->IsCreated())
         {
-        this->Script("pack %s -side bottom -fill x -pady 2",
-                     this->StatusFrameSeparator->GetWidgetName());
+        this->QueueScript("pack %s -side bottom -fill x -pady 2",
+                          this->StatusFrameSeparator->GetWidgetName());
         }
       }
 
@@ -623,8 +623,8 @@ void vtkKWWindowBase::Pack()
 
     if (this->StatusLabel && this->StatusLabel)
       {
-      this->Script("pack %s -side left -padx 1 -expand yes -fill both",
-                   this->StatusLabel->GetWidgetName());
+      this->QueueScript("pack %s -side left -padx 1 -expand yes -fill both",
+                        this->StatusLabel->GetWidgetName());
       }
 
     // Progress gauge
@@ -633,9 +633,9 @@ void vtkKWWindowBase::Pack()
         this->ProgressGaugePosition == 
         vtkKWWindowBase::ProgressGaugePositionStatusFrame)
       {
-      this->Script("pack %s -side left -padx 0 -pady 0 -fill y -in %s", 
-                   this->ProgressGauge->GetWidgetName(),
-                   this->StatusFrame->GetWidgetName());
+      this->QueueScript("pack %s -side left -padx 0 -pady 0 -fill y -in %s", 
+                        this->ProgressGauge->GetWidgetName(),
+                        this->StatusFrame->GetWidgetName());
       }
 
     // Tray frame (error icon, etc.)
@@ -644,7 +644,7 @@ void vtkKWWindowBase::Pack()
         this->TrayFramePosition == 
         vtkKWWindowBase::TrayFramePositionStatusFrame)
       {
-      this->Script(
+      this->QueueScript(
       "pack %s -side left -ipadx 0 -ipady 0 -padx 0 -pady 0 -fill both -in %s",
         this->TrayFrame->GetWidgetName(), 
         this->StatusFrame->GetWidgetName());
@@ -1165,8 +1165,8 @@ void vtkKWWindowBase::DisplayKeyBindingsCallback()
   kbw->SetKeyBindingsManager(this->KeyBindingsManager);
   kbw->Create();
   kbw->Update();
-  this->Script("pack %s -padx 2 -pady 2 -side top -fill both -expand t", 
-               kbw->GetWidgetName());
+  this->QueueScript("pack %s -padx 2 -pady 2 -side top -fill both -expand t", 
+                    kbw->GetWidgetName());
   
   dialog->Invoke();
   kbw->Delete();
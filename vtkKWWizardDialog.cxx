@@ -71,12 +71,12 @@ void vtkKWWizardDialog::CreateWidget()
   this->WizardWidget->GetCancelButton()->SetCommand(this, "Cancel");
   this->WizardWidget->GetOKButton()->SetCommand(this, "OK");
   
-  this->Script("pack %s -side top -fill both -expand y -pady 1", 
-               this->WizardWidget->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand y -pady 1", 
+                    this->WizardWidget->GetWidgetName());
 
   // I'm going to add a little more space
 
-  this->Script(
+  this->QueueScript(
     "pack %s -pady 4", 
     this->WizardWidget->GetSeparatorBeforeButtons()->GetWidgetName());
 }
@@ -227,8 +227,8 @@ void vtkKWWizardWidget::CreateWidget()
   this->TitleFrame->SetParent(this);
   this->TitleFrame->Create();
   
-  this->Script("pack %s -side top -fill x", 
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill x", 
+                    this->TitleFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Title frame: Title label
@@ -243,14 +243,14 @@ void vtkKWWizardWidget::CreateWidget()
 
   vtkKWTkUtilities::ChangeFontWeightToBold(this->TitleLabel);
 
-  this->Script("grid %s -row 0 -column 0 -sticky news -padx 4 -pady 1",
-               this->TitleLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 0 -column 0 -sticky news -padx 4 -pady 1",
+                    this->TitleLabel->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 0 -weight 0",
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 0 -weight 0",
+                    this->TitleFrame->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 0 -weight 1",
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 0 -weight 1",
+                    this->TitleFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Title frame: SubTitle label
@@ -265,11 +265,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->SubTitleLabel->AdjustWrapLengthToWidthOn();
   this->SubTitleLabel->SetAnchorToNorthWest();
 
-  this->Script("grid %s -row 1 -column 0 -sticky news -padx 4 -pady 2",
-               this->SubTitleLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 1 -column 0 -sticky news -padx 4 -pady 2",
+                    this->SubTitleLabel->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 1 -weight 1",
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 1 -weight 1",
+                    this->TitleFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Title frame: Icon
@@ -285,11 +285,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->TitleIconLabel->SetPadX(0);
   this->TitleIconLabel->SetPadY(0);
 
-  this->Script("grid %s -row 0 -column 1 -sticky nsew -rowspan 2 -padx 8",
-               this->TitleIconLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 0 -column 1 -sticky nsew -rowspan 2 -padx 8",
+                    this->TitleIconLabel->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 1 -weight 0",
-               this->TitleFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 1 -weight 0",
+                    this->TitleFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Separator (between title frame and layout frame
@@ -301,7 +301,7 @@ void vtkKWWizardWidget::CreateWidget()
   this->SeparatorAfterTitleArea->SetParent(this);
   this->SeparatorAfterTitleArea->Create();
 
-  this->Script("pack %s -side top -fill x", this->SeparatorAfterTitleArea->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill x", this->SeparatorAfterTitleArea->GetWidgetName());
 
   // -------------------------------------------------------------------
   //  Layout frame
@@ -314,11 +314,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->LayoutFrame->Create();
   this->LayoutFrame->SetBorderWidth(0);
 
-  this->Script("pack %s -side top -fill both -expand y -padx 0 -pady 0", 
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("pack %s -side top -fill both -expand y -padx 0 -pady 0", 
+                    this->LayoutFrame->GetWidgetName());
 
-  this->Script("grid columnconfigure %s 0 -weight 1", 
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("grid columnconfigure %s 0 -weight 1", 
+                    this->LayoutFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Layout frame: Pre-text
@@ -333,11 +333,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->PreTextLabel->SetJustificationToLeft();
   this->PreTextLabel->SetAnchorToNorthWest();
 
-  this->Script("grid %s -row 0 -sticky nsew -padx 2 -pady 4",
-               this->PreTextLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 0 -sticky nsew -padx 2 -pady 4",
+                    this->PreTextLabel->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 0 -weight 0",
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 0 -weight 0",
+                    this->LayoutFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Layout frame: Client area
@@ -349,11 +349,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->ClientArea->SetParent(this->LayoutFrame);
   this->ClientArea->Create();
 
-  this->Script("grid %s -row 1 -sticky nsew -padx 0 -pady 0",
-               this->ClientArea->GetWidgetName());
+  this->QueueScript("grid %s -row 1 -sticky nsew -padx 0 -pady 0",
+                    this->ClientArea->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 1 -weight 1",
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 1 -weight 1",
+                    this->LayoutFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Layout frame: Post-text
@@ -368,11 +368,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->PostTextLabel->SetJustificationToLeft();
   this->PostTextLabel->SetAnchorToNorthWest();
   
-  this->Script("grid %s -row 2 -sticky ew -padx 2 -pady 4",
-               this->PostTextLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 2 -sticky ew -padx 2 -pady 4",
+                    this->PostTextLabel->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 2 -weight 0",
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 2 -weight 0",
+                    this->LayoutFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Layout frame: Error-text
@@ -389,11 +389,11 @@ void vtkKWWizardWidget::CreateWidget()
   this->ErrorTextLabel->GetWidget()->SetAnchorToNorthWest();
   this->ErrorTextLabel->GetWidget()->AdjustWrapLengthToWidthOn();
   
-  this->Script("grid %s -row 3 -sticky ew -padx 2 -pady 2",
-               this->ErrorTextLabel->GetWidgetName());
+  this->QueueScript("grid %s -row 3 -sticky ew -padx 2 -pady 2",
+                    this->ErrorTextLabel->GetWidgetName());
 
-  this->Script("grid rowconfigure %s 3 -weight 0",
-               this->LayoutFrame->GetWidgetName());
+  this->QueueScript("grid rowconfigure %s 3 -weight 0",
+                    this->LayoutFrame->GetWidgetName());
 
   // -------------------------------------------------------------------
   // Separator (between layout frame and buttons frame)
@@ -503,10 +503,10 @@ void vtkKWWizardWidget::CreateWidget()
   // The pre and post text will initially not be visible. They will pop into
   // existence if they are configured to have a value
 
-  this->Script("grid remove %s %s",
-               this->PreTextLabel->GetWidgetName(),
-               this->PostTextLabel->GetWidgetName()
-               );
+  this->QueueScript("grid remove %s %s",
+                    this->PreTextLabel->GetWidgetName(),
+                    this->PostTextLabel->GetWidgetName()
+                    );
 
   this->SetTitleAreaBackgroundColor(1.0, 1.0, 1.0);
 
@@ -576,23 +576,23 @@ void vtkKWWizardWidget::PackButtons()
 {
   if (this->ButtonsPosition == vtkKWWizardWidget::ButtonsPositionBottom)
     {
-    this->Script("pack %s -side top -fill x -pady 2 -after %s", 
-                 this->SeparatorBeforeButtons->GetWidgetName(),
-                 this->LayoutFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -pady 2 -after %s", 
+                      this->SeparatorBeforeButtons->GetWidgetName(),
+                      this->LayoutFrame->GetWidgetName());
     
-    this->Script("pack %s -side top -fill x -padx 0 -pady 0 -after %s", 
-                 this->ButtonFrame->GetWidgetName(),
-                 this->SeparatorBeforeButtons->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -padx 0 -pady 0 -after %s", 
+                      this->ButtonFrame->GetWidgetName(),
+                      this->SeparatorBeforeButtons->GetWidgetName());
     }
   else
     {
-    this->Script("pack %s -side top -fill x -pady {2 1} -before %s", 
-                 this->SeparatorBeforeButtons->GetWidgetName(),
-                 this->TitleFrame->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -pady {2 1} -before %s", 
+                      this->SeparatorBeforeButtons->GetWidgetName(),
+                      this->TitleFrame->GetWidgetName());
     
-    this->Script("pack %s -side top -fill x -padx 0 -pady 0 -before %s", 
-                 this->ButtonFrame->GetWidgetName(),
-                 this->SeparatorBeforeButtons->GetWidgetName());
+    this->QueueScript("pack %s -side top -fill x -padx 0 -pady 0 -before %s", 
+                      this->ButtonFrame->GetWidgetName(),
+                      this->SeparatorBeforeButtons->GetWidgetName());
     }
 
   this->ButtonFrame->UnpackChildren();
@@ -605,46 +605,46 @@ void vtkKWWizardWidget::PackButtons()
   if (this->HelpButtonVisibility && 
       this->HelpButton && this->HelpButton->IsCreated())
     {
-    this->Script("pack %s -side right", 
-                 this->HelpButton->GetWidgetName());
+    this->QueueScript("pack %s -side right", 
+                      this->HelpButton->GetWidgetName());
     }
 
   if (this->CancelButtonVisibility && 
       this->CancelButton && this->CancelButton->IsCreated())
     {
-    this->Script("pack %s -side right -padx %d", 
-                 this->CancelButton->GetWidgetName(),
-                 this->HelpButtonVisibility ? 4 : 0);
+    this->QueueScript("pack %s -side right -padx %d", 
+                      this->CancelButton->GetWidgetName(),
+                      this->HelpButtonVisibility ? 4 : 0);
     }
 
   if (this->OKButtonVisibility && 
       current_step && current_step == finish_step &&
       this->OKButton && this->OKButton->IsCreated())
     {
-    this->Script("pack %s -side right -padx 4", 
-                 this->OKButton->GetWidgetName());
+    this->QueueScript("pack %s -side right -padx 4", 
+                      this->OKButton->GetWidgetName());
     }
 
   if (this->FinishButtonVisibility && 
       current_step && current_step != finish_step &&
       this->FinishButton && this->FinishButton->IsCreated())
     {
-    this->Script("pack %s -side right -padx 4", 
-                 this->FinishButton->GetWidgetName());
+    this->QueueScript("pack %s -side right -padx 4", 
+                      this->FinishButton->GetWidgetName());
     }
 
   if (this->NextButtonVisibility && 
       this->NextButton && this->NextButton->IsCreated())
     {
-    this->Script("pack %s -side right", 
-                 this->NextButton->GetWidgetName());
+    this->QueueScript("pack %s -side right", 
+                      this->NextButton->GetWidgetName());
     }
   
   if (this->BackButtonVisibility && 
       this->BackButton && this->BackButton->IsCreated())
     {
-    this->Script("pack %s -side right", 
-                 this->BackButton->GetWidgetName());
+    this->QueueScript("pack %s -side right", 
+                      this->BackButton->GetWidgetName());
     }
 }
 
@@ -677,8 +677,8 @@ void vtkKWWizardWidget::SetClientAreaMinimumHeight(int arg)
 {
   if (this->LayoutFrame && this->LayoutFrame->IsCreated())
     {
-    this->Script("grid rowconfigure %s 1 -minsize %d",
-                 this->LayoutFrame->GetWidgetName(), arg);
+    this->QueueScript("grid rowconfigure %s 1 -minsize %d",
+                      this->LayoutFrame->GetWidgetName(), arg);
     }
 }
 
@@ -865,9 +865,9 @@ void vtkKWWizardWidget::SetPreText(const char* str)
 
   if (this->IsCreated())
     {
-    this->Script("grid %s %s",
-                 ((str && *str) ? "" : "remove"),
-                 this->PreTextLabel->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      ((str && *str) ? "" : "remove"),
+                      this->PreTextLabel->GetWidgetName());
     }
 }
 
@@ -884,9 +884,9 @@ void vtkKWWizardWidget::SetPostText(const char* str)
 
   if (this->IsCreated())
     {
-    this->Script("grid %s %s",
-                 ((str && *str) ? "" : "remove"),
-                 this->PostTextLabel->GetWidgetName());
+    this->QueueScript("grid %s %s",
+                      ((str && *str) ? "" : "remove"),
+                      this->PostTextLabel->GetWidgetName());
     }
 }
 